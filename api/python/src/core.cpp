@@ -1,10 +1,12 @@
 #include <pybind11/pybind11.h>
+#include <pybind11/numpy.h>
 #include <pybind11/stl.h>  // Necessary for automatic conversion of e.g. std::vectors
 
 #define STRINGIFY(x) #x
 #define MACRO_STRINGIFY(x) STRINGIFY(x)
 
 #include "../../../include/dlplan/core.h"
+#include "../../../include/dlplan/utils/cancellation_token.h"
 
 namespace py = pybind11;
 
@@ -13,6 +15,15 @@ using namespace dlplan::core;
 
 
 void init_core(py::module_ &m_core) {
+    py::register_exception<utils::OperationCancelled>(m_core, "OperationCancelled", PyExc_RuntimeError);
+
+    py::class_<utils::CancellationToken, std::shared_ptr<utils::CancellationToken>>(m_core, "CancellationToken")
+        .def(py::init<>())
+        .def("cancel", &utils::CancellationToken::cancel)
+        .def("reset", &utils::CancellationToken::reset)
+        .def("is_cancelled", &utils::CancellationToken::is_cancelled)
+    ;
+
     py::class_<ConceptDenotation, std::shared_ptr<ConceptDenotation>>(m_core, "ConceptDenotation")
         .def(py::init<int>())
         .def("__eq__", &ConceptDenotation::are_equal_impl)
@@ -51,6 +62,16 @@ void init_core(py::module_ &m_core) {
 
     py::class_<DenotationsCaches, std::shared_ptr<DenotationsCaches>>(m_core, "DenotationsCaches")
         .def(py::init<>())
+        .def(py::init<int>(), py::arg("num_shards"))
+        .def("get_num_bytes", &DenotationsCaches::get_num_bytes)
+        .def("get_num_shards", &DenotationsCaches::get_num_shards)
+        .def("set_memory_limit", &DenotationsCaches::set_memory_limit)
+        .def("get_memory_limit", &DenotationsCaches::get_memory_limit)
+        .def("get_num_hits", &DenotationsCaches::get_num_hits)
+        .def("get_num_misses", &DenotationsCaches::get_num_misses)
+        .def("get_num_evictions", &DenotationsCaches::get_num_evictions)
+        .def("get_hit_rate", &DenotationsCaches::get_hit_rate)
+        .def("reset_statistics", &DenotationsCaches::reset_statistics)
     ;
 
     py::class_<Constant>(m_core, "Constant")
@@ -143,8 +164,14 @@ void init_core(py::module_ &m_core) {
         .def("evaluate", py::overload_cast<const State&>(&Concept::evaluate, py::const_))
         .def("evaluate", py::overload_cast<const State&, DenotationsCaches&>(&Concept::evaluate, py::const_))
         .def("evaluate", [](const Concept& self, const States& states, DenotationsCaches& caches) {
-            // std::shared_ptr<const std::vector<std::shared_ptr<const ConcepDenotation>>> is not registered so we must dereference to obtain a registered type
-            return *self.evaluate(states, caches);
+            // ConceptDenotations stores ids, which are not registered, so we return the denotations with shared ownership
+            auto denotations = self.evaluate(states, caches);
+            std::vector<std::shared_ptr<const ConceptDenotation>> result;
+            result.reserve(denotations->size());
+            for (std::size_t i = 0; i < denotations->size(); ++i) {
+                result.push_back(denotations->get_shared(i));
+            }
+            return result;
         })
     ;
 
@@ -156,8 +183,14 @@ void init_core(py::module_ &m_core) {
         .def("evaluate", py::overload_cast<const State&>(&Role::evaluate, py::const_))
         .def("evaluate", py::overload_cast<const State&, DenotationsCaches&>(&Role::evaluate, py::const_))
         .def("evaluate", [](const Role& self, const States& states, DenotationsCaches& caches) {
-            // std::shared_ptr<const std::vector<std::shared_ptr<const RoleDenotation>>> is not registered so we must dereference to obtain a registered type
-            return *self.evaluate(states, caches);
+            // RoleDenotations stores ids, which are not registered, so we return the denotations with shared ownership
+            auto denotations = self.evaluate(states, caches);
+            std::vector<std::shared_ptr<const RoleDenotation>> result;
+            result.reserve(denotations->size());
+            for (std::size_t i = 0; i < denotations->size(); ++i) {
+                result.push_back(denotations->get_shared(i));
+            }
+            return result;
         })
     ;
 
@@ -195,6 +228,14 @@ void init_core(py::module_ &m_core) {
         .def("parse_numerical", py::overload_cast<const std::string&, const std::string&>(&SyntacticElementFactory::parse_numerical), py::arg("description"), py::arg("filename") = "")
         .def("parse_boolean", py::overload_cast<const std::string&, const std::string&>(&SyntacticElementFactory::parse_boolean), py::arg("description"), py::arg("filename") = "")
 
+        .def("parse_elements", &SyntacticElementFactory::parse_elements, py::arg("descriptions"), py::arg("num_threads") = 1, py::call_guard<py::gil_scoped_release>())
+        .def("serialize", [](const SyntacticElementFactory& factory, const ElementCollection& elements) {
+            return py::bytes(factory.serialize(elements));
+        })
+        .def("deserialize", [](SyntacticElementFactory& factory, const py::bytes& data) {
+            return factory.deserialize(data);
+        })
+
         .def("make_empty_boolean", py::overload_cast<const std::shared_ptr<const Concept>&>(&SyntacticElementFactory::make_empty_boolean))
         .def("make_empty_boolean", py::overload_cast<const std::shared_ptr<const Role>&>(&SyntacticElementFactory::make_empty_boolean))
         .def("make_inclusion_boolean", py::overload_cast<const std::shared_ptr<const Concept>&, const std::shared_ptr<const Concept>&>(&SyntacticElementFactory::make_inclusion_boolean))
@@ -237,5 +278,89 @@ void init_core(py::module_ &m_core) {
         .def("make_transitive_reflexive_closure", &SyntacticElementFactory::make_transitive_reflexive_closure)
 
         .def("get_vocabulary_info", &SyntacticElementFactory::get_vocabulary_info)
+        .def("get_num_bytes", &SyntacticElementFactory::get_num_bytes)
     ;
+
+    m_core.def("evaluate_features", [](
+        const std::vector<std::shared_ptr<const Boolean>>& booleans,
+        const std::vector<std::shared_ptr<const Numerical>>& numericals,
+        const States& states,
+        py::object out,
+        int num_threads) {
+            // The C++ side writes directly into the buffer of the returned array.
+            using Array = py::array_t<int32_t, py::array::c_style>;
+            const py::ssize_t num_rows = states.size();
+            const py::ssize_t num_columns = booleans.size() + numericals.size();
+            Array values;
+            if (out.is_none()) {
+                values = Array({num_rows, num_columns});
+            } else {
+                if (!py::isinstance<Array>(out)) {
+                    throw std::runtime_error("evaluate_features - out must be a C-contiguous int32 array.");
+                }
+                values = out.cast<Array>();
+                if (values.ndim() != 2 || values.shape(0) != num_rows || values.shape(1) != num_columns) {
+                    throw std::runtime_error("evaluate_features - out must have shape (len(states), len(booleans) + len(numericals)).");
+                }
+                if (!values.writeable()) {
+                    throw std::runtime_error("evaluate_features - out must be writeable.");
+                }
+            }
+            std::span<int32_t> data(values.mutable_data(), values.size());
+            {
+                py::gil_scoped_release release;
+                evaluate_features(booleans, numericals, states, data, num_threads);
+            }
+            return values;
+        },
+        py::arg("booleans"), py::arg("numericals"), py::arg("states"), py::arg("out") = py::none(), py::arg("num_threads") = 1);
+
+    py::class_<ElementProfile>(m_core, "ElementProfile")
+        .def_readonly("element_index", &ElementProfile::element_index)
+        .def_readonly("element_description", &ElementProfile::element_description)
+        .def_readonly("num_calls", &ElementProfile::num_calls)
+        .def_readonly("num_cache_hits", &ElementProfile::num_cache_hits)
+        .def_readonly("num_cache_misses", &ElementProfile::num_cache_misses)
+        .def_readonly("inclusive_ns", &ElementProfile::inclusive_ns)
+        .def_readonly("exclusive_ns", &ElementProfile::exclusive_ns)
+        .def_readonly("allocated_bytes", &ElementProfile::allocated_bytes)
+        .def("__repr__", [](const ElementProfile& profile) {
+            return "ElementProfile(" + std::to_string(profile.element_index) + ", " + profile.element_description
+                + ", calls=" + std::to_string(profile.num_calls)
+                + ", exclusive_ns=" + std::to_string(profile.exclusive_ns) + ")";
+        })
+    ;
+
+    m_core.def("is_profiling_enabled", &is_profiling_enabled);
+    m_core.def("get_element_profiles", &get_element_profiles);
+    m_core.def("reset_element_profiles", &reset_element_profiles);
+    m_core.def("format_element_profiles", py::overload_cast<const ElementProfiles&>(&core::to_string));
+
+    py::enum_<ElementKind> element_kind(m_core, "ElementKind");
+    for (int kind = 0; kind < NUM_ELEMENT_KINDS; ++kind) {
+        element_kind.value(get_element_kind_name(static_cast<ElementKind>(kind)).c_str(), static_cast<ElementKind>(kind));
+    }
+
+    py::class_<OperatorCost>(m_core, "OperatorCost")
+        .def_readonly("degree", &OperatorCost::degree)
+        .def_readonly("constant", &OperatorCost::constant)
+        .def_readonly("linear", &OperatorCost::linear)
+        .def_readonly("density", &OperatorCost::density)
+        .def("compute_cost", &OperatorCost::compute_cost)
+    ;
+
+    py::class_<CostModel>(m_core, "CostModel")
+        .def(py::init<>())
+        .def("__str__", &CostModel::str)
+        .def("compute_cost", &CostModel::compute_cost)
+        .def("compute_score", &CostModel::compute_score)
+        .def("get_operator_cost", &CostModel::get_operator_cost)
+        .def("get_reference_num_objects", &CostModel::get_reference_num_objects)
+        .def("get_reference_density", &CostModel::get_reference_density)
+        .def_static("parse", &CostModel::parse)
+    ;
+
+    m_core.def("get_cost_model", &get_cost_model);
+    m_core.def("set_cost_model", &set_cost_model);
+    m_core.def("calibrate_cost_model", &calibrate_cost_model, py::arg("states"), py::arg("num_repetitions") = 5, py::call_guard<py::gil_scoped_release>());
 }
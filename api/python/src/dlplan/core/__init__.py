@@ -1,4 +1,9 @@
 from _dlplan import ConceptDenotation, RoleDenotation, DenotationsCaches, \
     Constant, Predicate, VocabularyInfo, Object, Atom, \
     InstanceInfo, State, Concept, Role, Boolean, Numerical, \
-    SyntacticElementFactory
+    SyntacticElementFactory, evaluate_features, \
+    CancellationToken, OperationCancelled, \
+    ElementProfile, is_profiling_enabled, get_element_profiles, \
+    reset_element_profiles, format_element_profiles, \
+    ElementKind, OperatorCost, CostModel, get_cost_model, set_cost_model, \
+    calibrate_cost_model
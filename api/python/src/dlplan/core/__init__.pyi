@@ -1,4 +1,16 @@
-from typing import Overload, List, Tuple
+from typing import Overload, List, Optional, Tuple
+
+import numpy as np
+
+
+class OperationCancelled(RuntimeError): ...
+
+
+class CancellationToken:
+    def __init__(self) -> None: ...
+    def cancel(self) -> None: ...
+    def reset(self) -> None: ...
+    def is_cancelled(self) -> bool: ...
 
 
 class ConceptDenotation:
@@ -38,7 +50,19 @@ class RoleDenotation:
 
 
 class DenotationsCaches:
+    @overload
     def __init__(self) -> None: ...
+    @overload
+    def __init__(self, num_shards: int) -> None: ...
+    def get_num_bytes(self) -> int: ...
+    def get_num_shards(self) -> int: ...
+    def set_memory_limit(self, num_bytes: int) -> None: ...
+    def get_memory_limit(self) -> int: ...
+    def get_num_hits(self) -> int: ...
+    def get_num_misses(self) -> int: ...
+    def get_num_evictions(self) -> int: ...
+    def get_hit_rate(self) -> float: ...
+    def reset_statistics(self) -> None: ...
 
 
 class Constant:
@@ -188,6 +212,9 @@ class SyntacticElementFactory:
     def parse_role(self, description: str, filename: str = "") -> Role: ...
     def parse_boolean(self, description: str, filename: str = "") -> Boolean: ...
     def parse_numerical(self, description: str, filename: str = "") -> Numerical: ...
+    def parse_elements(self, descriptions: List[str], num_threads: int = 1) -> Tuple[List[Boolean], List[Numerical], List[Concept], List[Role]]: ...
+    def serialize(self, elements: Tuple[List[Boolean], List[Numerical], List[Concept], List[Role]]) -> bytes: ...
+    def deserialize(self, data: bytes) -> Tuple[List[Boolean], List[Numerical], List[Concept], List[Role]]: ...
 
     @overload
     def make_empty_boolean(self, concept: Concept) -> Boolean: ...
@@ -236,4 +263,56 @@ class SyntacticElementFactory:
     def make_transitive_closure(self, role: Role) -> Role: ...
     def make_transitive_reflexive_closure(self, role: Role) -> Role: ...
 
-    def get_vocabulary_info(self): VocabularyInfo: ...
\ No newline at end of file
+    def get_vocabulary_info(self): VocabularyInfo: ...
+    def get_num_bytes(self) -> int: ...
+
+
+def evaluate_features(booleans: List[Boolean], numericals: List[Numerical], states: List[State], out: Optional[np.ndarray] = None, num_threads: int = 1) -> np.ndarray: ...
+
+
+class ElementProfile:
+    element_index: int
+    element_description: str
+    num_calls: int
+    num_cache_hits: int
+    num_cache_misses: int
+    inclusive_ns: int
+    exclusive_ns: int
+    allocated_bytes: int
+
+
+def is_profiling_enabled() -> bool: ...
+def get_element_profiles() -> List[ElementProfile]: ...
+def reset_element_profiles() -> None: ...
+def format_element_profiles(profiles: List[ElementProfile]) -> str: ...
+
+
+class ElementKind:
+    """Identifies an operator by names such as c_and or n_count_role."""
+    name: str
+    value: int
+
+
+class OperatorCost:
+    degree: int
+    constant: float
+    linear: float
+    density: float
+    def compute_cost(self, num_objects: int, denotation_density: float) -> float: ...
+
+
+class CostModel:
+    def __init__(self) -> None: ...
+    def __str__(self) -> str: ...
+    def compute_cost(self, kind: ElementKind, num_objects: int, denotation_density: float) -> float: ...
+    def compute_score(self, kind: ElementKind) -> int: ...
+    def get_operator_cost(self, kind: ElementKind) -> OperatorCost: ...
+    def get_reference_num_objects(self) -> int: ...
+    def get_reference_density(self) -> float: ...
+    @staticmethod
+    def parse(description: str) -> "CostModel": ...
+
+
+def get_cost_model() -> CostModel: ...
+def set_cost_model(cost_model: CostModel) -> None: ...
+def calibrate_cost_model(states: List[State], num_repetitions: int = 5) -> CostModel: ...
@@ -1,6 +1,6 @@
-from typing import List
+from typing import List, Optional
 
-from ..core import SyntacticElementFactory, State
+from ..core import CancellationToken, SyntacticElementFactory, State
 
 
 class FeatureGenerator:
@@ -13,7 +13,9 @@ class FeatureGenerator:
         count_numerical_complexity_limit: int = 9,
         distance_numerical_complexity_limit: int = 9,
         time_limit: int = 3600,
-        feature_limit: int = 10000) -> List[str]: ...
+        feature_limit: int = 10000,
+        cancellation_token: Optional[CancellationToken] = None) -> List[str]: ...
+    def set_memory_limit(self, num_bytes: int) -> None: ...
     def set_generate_empty_boolean(self, enable: bool) -> None: ...
     def set_generate_inclusion_boolean(self, enable: bool) -> None: ...
     def set_generate_nullary_boolean(self, enable: bool) -> None: ...
@@ -87,4 +89,5 @@ def generate_features(self,
     generate_til_c_role: bool = True,
     generate_top_role: bool = False,
     generate_transitive_closure_role: bool = True,
-    generate_transitive_reflexive_closure_role: bool = False) -> List[str]: ...
+    generate_transitive_reflexive_closure_role: bool = False,
+    cancellation_token: Optional[CancellationToken] = None) -> List[str]: ...
@@ -1,5 +1,6 @@
-from typing import List, Overload
+from typing import List, Optional, Overload
 
+from ..core import CancellationToken
 from ..state_space import StateSpace
 
 
@@ -38,7 +39,7 @@ class TupleNode:
 
 
 class TupleGraph:
-    def __init__(self, novelty_base: NoveltyBase, state_space: StateSpace, root_state_index: int) -> None: ...
+    def __init__(self, novelty_base: NoveltyBase, state_space: StateSpace, root_state_index: int, cancellation_token: Optional[CancellationToken] = None) -> None: ...
     def __repr__(self) -> str: ...
     def __str__(self) -> str: ...
     def to_dot(self, verbosity_level: int) -> str: ...
@@ -1,6 +1,7 @@
 from _dlplan import NamedBoolean, NamedNumerical, NamedConcept, NamedRole, \
     BaseCondition, BaseEffect, Rule, Policy, PolicyFactory, \
-    PolicyMinimizer, \
+    PolicyMinimizer, PolicyDecisionDiagram, \
+    PolicyVerificationResult, PolicyVerifier, \
     PositiveBooleanCondition, NegativeBooleanCondition, \
     GreaterNumericalCondition, EqualNumericalCondition, \
     PositiveBooleanEffect, NegativeBooleanEffect, UnchangedBooleanEffect, \
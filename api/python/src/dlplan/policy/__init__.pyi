@@ -1,6 +1,7 @@
-from typing import List, Overload, Union, MutableSet, Tuple
+from typing import List, Optional, Overload, Union, MutableSet, Tuple
 
-from ..core import State, DenotationsCaches, Boolean, Numerical, Concept, Role, SyntacticElementFactory
+from ..core import CancellationToken, State, DenotationsCaches, Boolean, Numerical, Concept, Role, SyntacticElementFactory
+from ..state_space import StateSpace
 
 
 
@@ -123,6 +124,10 @@ class Policy:
     def evaluate_effects(self, source_state: State, target_state: State, rules: List[Rule]) -> bool: ...
     @overload
     def evaluate_effects(self, source_state: State, target_state: State, rules: List[Rule], caches: DenotationsCaches) -> bool: ...
+    @overload
+    def evaluate_successors(self, source_state: State, target_states: List[State], num_threads: int = 1) -> List[Tuple[int, Rule]]: ...
+    @overload
+    def evaluate_successors(self, source_state: State, target_states: List[State], caches: DenotationsCaches, num_threads: int = 1) -> List[Tuple[int, Rule]]: ...
     def get_rules(self) -> MutableSet[Rule]: ...
     def get_booleans(self) -> MutableSet[NamedBoolean]: ...
     def get_numericals(self) -> MutableSet[NamedNumerical]: ...
@@ -154,9 +159,40 @@ class PolicyFactory:
     def parse_policy(self, description: str, filename: str = "") -> Policy: ...
 
 
+class PolicyDecisionDiagram:
+    def __init__(self, policy: Policy) -> None: ...
+    @overload
+    def evaluate(self, source_state: State, target_state: State) -> Union[None, Rule]: ...
+    @overload
+    def evaluate(self, source_state: State, target_state: State, caches: DenotationsCaches) -> Union[None, Rule]: ...
+    def get_num_nodes(self) -> int: ...
+    def get_num_predicates(self) -> int: ...
+    def get_policy(self) -> Policy: ...
+
+
 class PolicyMinimizer:
+    @overload
     def __init__(self) -> None: ...
     @overload
-    def minimize(self, policy: Policy, policy_factory: PolicyFactory) -> Policy: ...
+    def __init__(self, num_threads: int) -> None: ...
+    @overload
+    def minimize(self, policy: Policy, policy_factory: PolicyFactory, cancellation_token: Optional[CancellationToken] = None) -> Policy: ...
+    @overload
+    def minimize(self, policy: Policy, true_state_pairs: List[Tuple[State, State]], false_state_pairs: List[Tuple[State, State]], policy_factory: PolicyFactory, cancellation_token: Optional[CancellationToken] = None) -> Policy: ...
+
+
+class PolicyVerificationResult:
+    num_alive_states: int
+    num_compatible_transitions: int
+    unsolved_state_indices: List[int]
+    unsafe_state_indices: List[int]
+    cycles: List[List[int]]
+    def is_sound(self) -> bool: ...
+
+
+class PolicyVerifier:
+    @overload
+    def __init__(self) -> None: ...
     @overload
-    def minimize(self, policy: Policy, true_state_pairs: List[Tuple[State, State]], false_state_pairs: List[Tuple[State, State]], policy_factory: PolicyFactory) -> Policy: ...
+    def __init__(self, num_threads: int) -> None: ...
+    def verify(self, policy: Policy, state_space: StateSpace) -> PolicyVerificationResult: ...
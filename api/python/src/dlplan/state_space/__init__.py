@@ -1,2 +1,3 @@
-from _dlplan import StateSpace, GeneratorExitCode, GeneratorResult, \
-    generate_state_space
+from _dlplan import CompressedAdjacencyList, StateHandle, StatePool, StateSpace, GeneratorExitCode, GeneratorResult, \
+    GroundAction, generate_state_space, generate_grounded_state_space, \
+    write_binary_state_space, read_binary_state_space
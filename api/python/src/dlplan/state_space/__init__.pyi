@@ -1,8 +1,42 @@
 from enum import Enum
 
-from typing import Overload, Dict, List, MutableSet
+from typing import Overload, Dict, List, MutableSet, Optional, Tuple
 
-from ..core import VocabularyInfo, InstanceInfo, State
+from ..core import CancellationToken, VocabularyInfo, InstanceInfo, State
+
+
+class CompressedAdjacencyList:
+    def __init__(self, num_state_indices: int, adjacency_list: Dict[int, MutableSet[int]]) -> None: ...
+    def compute_inverse(self) -> "CompressedAdjacencyList": ...
+    def to_adjacency_list(self) -> Dict[int, MutableSet[int]]: ...
+    def get_targets(self, source: int) -> List[int]: ...
+    def get_num_state_indices(self) -> int: ...
+    def get_num_edges(self) -> int: ...
+    def get_offsets(self) -> List[int]: ...
+
+
+class StateHandle:
+    def __eq__(self, other: "StateHandle") -> bool: ...
+    def __ne__(self, other: "StateHandle") -> bool: ...
+    def __hash__(self) -> int: ...
+    def get_index(self) -> int: ...
+    def contains(self, atom_index: int) -> bool: ...
+    def get_atom_indices(self) -> List[int]: ...
+    def to_state(self) -> State: ...
+
+
+class StatePool:
+    def __init__(self, instance_info: InstanceInfo) -> None: ...
+    def insert(self, atom_indices: List[int]) -> Tuple[StateHandle, bool]: ...
+    def find(self, atom_indices: List[int]) -> Optional[StateHandle]: ...
+    def contains(self, index: int, atom_index: int) -> bool: ...
+    def get_atom_indices(self, index: int) -> List[int]: ...
+    def get_state(self, index: int) -> State: ...
+    def get_handle(self, index: int) -> StateHandle: ...
+    def size(self) -> int: ...
+    def get_num_atoms(self) -> int: ...
+    def get_memory_usage(self) -> int: ...
+    def get_instance_info(self) -> InstanceInfo: ...
 
 
 class StateSpace:
@@ -16,17 +50,25 @@ class StateSpace:
     @overload
     def __init__(self, state_space: "StateSpace", state_indices: MutableSet[int]) -> None: ...
     def __str__(self) -> str: ...
+    def compute_dense_distances(self, state_indices: List[int], forward: bool, stop_if_goal: bool, num_threads: int = 1) -> List[int]: ...
+    def compute_dense_goal_distances(self, num_threads: int = 1) -> List[int]: ...
     def compute_distances(self, state_indices: MutableSet[int], forward: bool, stop_if_goal: bool) -> Dict[int, int]: ...
     def compute_goal_distances(self) -> Dict[int, int]: ...
     def is_goal(self, state_index: int) -> bool: ...
+    def has_state(self, state_index: int) -> bool: ...
     def to_dot(self, verbosity_level: int) -> str: ...
     def set_initial_state_index(self, index: int) -> None: ...
     def set_goal_state_indices(self, state_indices: MutableSet[int]) -> None: ...
+    def get_state(self, state_index: int) -> State: ...
+    def get_state_vector(self) -> List[State]: ...
     def get_states(self) -> Dict[int, State]: ...
     def get_initial_state_index(self) -> int: ...
     def get_forward_successor_state_indices(self) -> Dict[int, MutableSet[int]]: ...
     def get_backward_successor_state_indices(self) -> Dict[int, MutableSet[int]]: ...
+    def get_forward_successors(self) -> CompressedAdjacencyList: ...
+    def get_backward_successors(self) -> CompressedAdjacencyList: ...
     def get_goal_state_indices(self) -> MutableSet[int]: ...
+    def get_num_state_indices(self) -> int: ...
     def get_instance_info(self) -> InstanceInfo: ...
 
 
@@ -41,4 +83,22 @@ class GeneratorResult:
     state_space: StateSpace
 
 
-def generate_state_space(domain_file: str, instance_file: str, vocabulary_info: VocabularyInfo = None, index: int = -1, max_time: int = 2147483646, max_num_states: int = 2147483646) -> GeneratorResult: ...
+def generate_state_space(domain_file: str, instance_file: str, vocabulary_info: VocabularyInfo = None, index: int = -1, max_time: int = 2147483646, max_num_states: int = 2147483646, cancellation_token: Optional[CancellationToken] = None) -> GeneratorResult: ...
+
+
+class GroundAction:
+    name: str
+    precondition: List[int]
+    add_effect: List[int]
+    delete_effect: List[int]
+
+    def __init__(self, name: str, precondition: List[int], add_effect: List[int], delete_effect: List[int]) -> None: ...
+
+
+def generate_grounded_state_space(instance_info: InstanceInfo, initial_atom_indices: List[int], actions: List[GroundAction], goal_atom_indices: List[int], max_time: int = 2147483646, max_num_states: int = 2147483646, cancellation_token: Optional[CancellationToken] = None) -> GeneratorResult: ...
+
+
+def write_binary_state_space(state_space: StateSpace, filename: str) -> None: ...
+
+
+def read_binary_state_space(filename: str, vocabulary_info: VocabularyInfo = None, index: int = -1) -> StateSpace: ...
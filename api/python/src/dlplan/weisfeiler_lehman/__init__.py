@@ -0,0 +1 @@
+from _dlplan import WeisfeilerLehman
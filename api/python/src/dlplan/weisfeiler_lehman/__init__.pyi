@@ -0,0 +1,13 @@
+from typing import List, overload
+
+from ..core import State
+from ..state_space import StateSpace
+
+
+class WeisfeilerLehman:
+    @overload
+    def __init__(self) -> None: ...
+    @overload
+    def __init__(self, num_threads: int) -> None: ...
+    def compute_colors(self, states: List[State]) -> List[int]: ...
+    def compute_colors_for_state_space(self, state_space: StateSpace) -> List[int]: ...
@@ -14,7 +14,8 @@ using namespace dlplan::generator;
 void init_generator(py::module_ &m_generator) {
     py::class_<FeatureGenerator>(m_generator, "FeatureGenerator")
         .def(py::init<>())
-        .def("generate", &FeatureGenerator::generate, py::arg("factory"), py::arg("states"), py::arg("concept_complexity_limit") = 9, py::arg("role_complexity_limit") = 9, py::arg("boolean_complexity_limit") = 9, py::arg("count_numerical_complexity_limit") = 9, py::arg("distance_numerical_complexity_limit") = 9, py::arg("time_limit") = 3600, py::arg("feature_limit") = 10000)
+        .def("generate", &FeatureGenerator::generate, py::arg("factory"), py::arg("states"), py::arg("concept_complexity_limit") = 9, py::arg("role_complexity_limit") = 9, py::arg("boolean_complexity_limit") = 9, py::arg("count_numerical_complexity_limit") = 9, py::arg("distance_numerical_complexity_limit") = 9, py::arg("time_limit") = 3600, py::arg("feature_limit") = 10000, py::arg("cancellation_token") = nullptr, py::call_guard<py::gil_scoped_release>())
+        .def("set_memory_limit", &FeatureGenerator::set_memory_limit)
         .def("set_generate_empty_boolean", &FeatureGenerator::set_generate_empty_boolean)
         .def("set_generate_inclusion_boolean", &FeatureGenerator::set_generate_inclusion_boolean)
         .def("set_generate_nullary_boolean", &FeatureGenerator::set_generate_nullary_boolean)
@@ -88,5 +89,7 @@ void init_generator(py::module_ &m_generator) {
         py::arg("generate_til_c_role") = true,
         py::arg("generate_top_role") = false,
         py::arg("generate_transitive_closure_role") = true,
-        py::arg("generate_transitive_reflexive_closure_role") = false);
+        py::arg("generate_transitive_reflexive_closure_role") = false,
+        py::arg("cancellation_token") = nullptr,
+        py::call_guard<py::gil_scoped_release>());
 }
@@ -11,6 +11,7 @@ void init_generator(py::module_ &);
 void init_novelty(py::module_ &);
 void init_policy(py::module_ &);
 void init_state_space(py::module_ &);
+void init_weisfeiler_lehman(py::module_ &);
 
 PYBIND11_MODULE(_dlplan, m) {
     m.doc() = "Python bindings for the dlplan description logics first-order features for planning";
@@ -20,12 +21,14 @@ PYBIND11_MODULE(_dlplan, m) {
     py::module_ m_novelty = m.def_submodule("novelty", "The novelty submodule.");
     py::module_ m_policy = m.def_submodule("policy", "The policy submodule.");
     py::module_ m_state_space = m.def_submodule("state_space", "The state_space submodule.");
+    py::module_ m_weisfeiler_lehman = m.def_submodule("weisfeiler_lehman", "The weisfeiler_lehman submodule.");
 
     init_core(m);
     init_generator(m);
     init_novelty(m);
     init_policy(m);
     init_state_space(m);
+    init_weisfeiler_lehman(m);
 
 #ifdef VERSION_INFO
     m.attr("__version__") = MACRO_STRINGIFY(VERSION_INFO);
@@ -43,7 +43,7 @@ void init_novelty(py::module_ &m_novelty) {
     ;
 
     py::class_<TupleGraph, std::shared_ptr<TupleGraph>>(m_novelty, "TupleGraph")
-        .def(py::init<std::shared_ptr<const NoveltyBase>, std::shared_ptr<const StateSpace>, StateIndex>())
+        .def(py::init<std::shared_ptr<const NoveltyBase>, std::shared_ptr<const StateSpace>, StateIndex, std::shared_ptr<const dlplan::utils::CancellationToken>>(), py::arg("novelty_base"), py::arg("state_space"), py::arg("root_state_index"), py::arg("cancellation_token") = nullptr, py::call_guard<py::gil_scoped_release>())
         .def("__repr__", &TupleGraph::compute_repr)
         .def("__str__", &TupleGraph::str)
         .def("to_dot", &TupleGraph::to_dot)
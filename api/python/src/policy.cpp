@@ -121,6 +121,8 @@ void init_policy(py::module_ &m_policy) {
         .def("evaluate_conditions", py::overload_cast<const core::State&, core::DenotationsCaches&>(&policy::Policy::evaluate_conditions, py::const_))
         .def("evaluate_effects", py::overload_cast<const core::State&, const core::State&, const std::vector<std::shared_ptr<const policy::Rule>>&>(&policy::Policy::evaluate_effects, py::const_))
         .def("evaluate_effects", py::overload_cast<const core::State&, const core::State&, const std::vector<std::shared_ptr<const policy::Rule>>&, core::DenotationsCaches&>(&policy::Policy::evaluate_effects, py::const_))
+        .def("evaluate_successors", [](const policy::Policy& policy, const core::State& source_state, const core::States& target_states, int num_threads){ return policy.evaluate_successors(source_state, target_states, num_threads); }, py::arg("source_state"), py::arg("target_states"), py::arg("num_threads") = 1)
+        .def("evaluate_successors", [](const policy::Policy& policy, const core::State& source_state, const core::States& target_states, core::DenotationsCaches& caches, int num_threads){ return policy.evaluate_successors(source_state, target_states, caches, num_threads); }, py::arg("source_state"), py::arg("target_states"), py::arg("caches"), py::arg("num_threads") = 1)
         .def("get_rules", &policy::Policy::get_rules)
         .def("get_booleans", &policy::Policy::get_booleans)
         .def("get_numericals", &policy::Policy::get_numericals)
@@ -169,9 +171,34 @@ void init_policy(py::module_ &m_policy) {
         .def("parse_policy", py::overload_cast<const std::string&, const std::string&>(&policy::PolicyFactory::parse_policy), py::arg("description"), py::arg("filename") = "")
     ;
 
+    py::class_<policy::PolicyDecisionDiagram>(m_policy, "PolicyDecisionDiagram")
+        .def(py::init<std::shared_ptr<const policy::Policy>>())
+        .def("evaluate", py::overload_cast<const core::State&, const core::State&>(&policy::PolicyDecisionDiagram::evaluate, py::const_))
+        .def("evaluate", py::overload_cast<const core::State&, const core::State&, core::DenotationsCaches&>(&policy::PolicyDecisionDiagram::evaluate, py::const_))
+        .def("get_num_nodes", &policy::PolicyDecisionDiagram::get_num_nodes)
+        .def("get_num_predicates", &policy::PolicyDecisionDiagram::get_num_predicates)
+        .def("get_policy", &policy::PolicyDecisionDiagram::get_policy)
+    ;
+
     py::class_<policy::PolicyMinimizer>(m_policy, "PolicyMinimizer")
         .def(py::init<>())
-        .def("minimize", py::overload_cast<const std::shared_ptr<const policy::Policy>&, policy::PolicyFactory&>(&policy::PolicyMinimizer::minimize, py::const_))
-        .def("minimize", py::overload_cast<const std::shared_ptr<const policy::Policy>&, const policy::StatePairs&, const policy::StatePairs&, policy::PolicyFactory&>(&policy::PolicyMinimizer::minimize, py::const_))
+        .def(py::init<int>(), py::arg("num_threads"))
+        .def("minimize", py::overload_cast<const std::shared_ptr<const policy::Policy>&, policy::PolicyFactory&, std::shared_ptr<const utils::CancellationToken>>(&policy::PolicyMinimizer::minimize, py::const_), py::arg("policy"), py::arg("policy_factory"), py::arg("cancellation_token") = nullptr, py::call_guard<py::gil_scoped_release>())
+        .def("minimize", py::overload_cast<const std::shared_ptr<const policy::Policy>&, const policy::StatePairs&, const policy::StatePairs&, policy::PolicyFactory&, std::shared_ptr<const utils::CancellationToken>>(&policy::PolicyMinimizer::minimize, py::const_), py::arg("policy"), py::arg("true_state_pairs"), py::arg("false_state_pairs"), py::arg("policy_factory"), py::arg("cancellation_token") = nullptr, py::call_guard<py::gil_scoped_release>())
+    ;
+
+    py::class_<policy::PolicyVerificationResult>(m_policy, "PolicyVerificationResult")
+        .def_readwrite("num_alive_states", &policy::PolicyVerificationResult::num_alive_states)
+        .def_readwrite("num_compatible_transitions", &policy::PolicyVerificationResult::num_compatible_transitions)
+        .def_readwrite("unsolved_state_indices", &policy::PolicyVerificationResult::unsolved_state_indices)
+        .def_readwrite("unsafe_state_indices", &policy::PolicyVerificationResult::unsafe_state_indices)
+        .def_readwrite("cycles", &policy::PolicyVerificationResult::cycles)
+        .def("is_sound", &policy::PolicyVerificationResult::is_sound)
+    ;
+
+    py::class_<policy::PolicyVerifier>(m_policy, "PolicyVerifier")
+        .def(py::init<>())
+        .def(py::init<int>(), py::arg("num_threads"))
+        .def("verify", &policy::PolicyVerifier::verify)
     ;
 }
\ No newline at end of file
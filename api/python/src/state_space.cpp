@@ -17,21 +17,80 @@ using namespace dlplan::state_space;
 
 
 void init_state_space(py::module_ &m_state_space) {
+    py::class_<CompressedAdjacencyList>(m_state_space, "CompressedAdjacencyList")
+        .def(py::init<int, const AdjacencyList&>())
+        .def("compute_inverse", &CompressedAdjacencyList::compute_inverse)
+        .def("to_adjacency_list", &CompressedAdjacencyList::to_adjacency_list)
+        .def("get_targets", [](const CompressedAdjacencyList& adjacency_list, StateIndex source){
+            auto targets = adjacency_list.get_targets(source);
+            return StateIndices(targets.begin(), targets.end());
+        })
+        .def("get_num_state_indices", &CompressedAdjacencyList::get_num_state_indices)
+        .def("get_num_edges", &CompressedAdjacencyList::get_num_edges)
+        .def("get_offsets", &CompressedAdjacencyList::get_offsets)
+    ;
+
+    py::class_<StateHandle>(m_state_space, "StateHandle")
+        .def("__eq__", &StateHandle::operator==)
+        .def("__ne__", &StateHandle::operator!=)
+        .def("__hash__", &StateHandle::hash)
+        .def("get_index", &StateHandle::get_index)
+        .def("contains", &StateHandle::contains)
+        .def("get_atom_indices", &StateHandle::get_atom_indices)
+        .def("to_state", &StateHandle::to_state)
+    ;
+
+    // Handles refer to the states in the pool, hence, they keep the pool alive.
+    py::class_<StatePool>(m_state_space, "StatePool")
+        .def(py::init<std::shared_ptr<InstanceInfo>>(), py::arg("instance_info"))
+        .def("insert", [](py::object self, const AtomIndices& atom_indices) {
+            auto [handle, inserted] = self.cast<StatePool&>().insert(atom_indices);
+            py::object result = py::cast(handle);
+            py::detail::keep_alive_impl(result, self);
+            return py::make_tuple(result, inserted);
+        })
+        .def("find", [](py::object self, const AtomIndices& atom_indices) -> py::object {
+            auto handle = self.cast<const StatePool&>().find(atom_indices);
+            if (!handle) {
+                return py::none();
+            }
+            py::object result = py::cast(*handle);
+            py::detail::keep_alive_impl(result, self);
+            return result;
+        })
+        .def("contains", &StatePool::contains)
+        .def("get_atom_indices", &StatePool::get_atom_indices)
+        .def("get_state", &StatePool::get_state)
+        .def("get_handle", &StatePool::get_handle, py::keep_alive<0, 1>())
+        .def("size", &StatePool::size)
+        .def("get_num_atoms", &StatePool::get_num_atoms)
+        .def("get_memory_usage", &StatePool::get_memory_usage)
+        .def("get_instance_info", &StatePool::get_instance_info)
+    ;
+
     py::class_<StateSpace, std::shared_ptr<StateSpace>>(m_state_space, "StateSpace")
         .def(py::init<std::shared_ptr<InstanceInfo>, StateMapping, StateIndex, AdjacencyList, StateIndicesSet>())
         .def(py::init<const StateSpace&, const StateIndicesSet&>())
         .def("__str__", &StateSpace::str)
+        .def("compute_dense_distances", &StateSpace::compute_dense_distances, py::arg("state_indices"), py::arg("forward"), py::arg("stop_if_goal"), py::arg("num_threads") = 1)
+        .def("compute_dense_goal_distances", &StateSpace::compute_dense_goal_distances, py::arg("num_threads") = 1)
         .def("compute_distances", &StateSpace::compute_distances)
         .def("compute_goal_distances", &StateSpace::compute_goal_distances)
         .def("is_goal", &StateSpace::is_goal)
+        .def("has_state", &StateSpace::has_state)
         .def("to_dot", &StateSpace::to_dot)
         .def("set_initial_state_index", &StateSpace::set_initial_state_index)
         .def("set_goal_state_indices", &StateSpace::set_goal_state_indices)
+        .def("get_state", &StateSpace::get_state)
+        .def("get_state_vector", &StateSpace::get_state_vector)
         .def("get_states", &StateSpace::get_states)
         .def("get_initial_state_index", &StateSpace::get_initial_state_index)
         .def("get_forward_successor_state_indices", &StateSpace::get_forward_successor_state_indices)
         .def("get_backward_successor_state_indices", &StateSpace::get_backward_successor_state_indices)
+        .def("get_forward_successors", &StateSpace::get_forward_successors)
+        .def("get_backward_successors", &StateSpace::get_backward_successors)
         .def("get_goal_state_indices", &StateSpace::get_goal_state_indices)
+        .def("get_num_state_indices", &StateSpace::get_num_state_indices)
         .def("get_instance_info", &StateSpace::get_instance_info)
     ;
 
@@ -45,6 +104,17 @@ void init_state_space(py::module_ &m_state_space) {
         .def_readwrite("state_space", &GeneratorResult::state_space)
     ;
 
-    m_state_space.def("generate_state_space", &generate_state_space, py::arg("domain_file"), py::arg("instance_file"), py::arg("vocabulary_info") = nullptr, py::arg("index") = -1, py::arg("max_time") = std::numeric_limits<int>::max()-1, py::arg("max_num_states") = std::numeric_limits<int>::max()-1)
+    m_state_space.def("generate_state_space", &generate_state_space, py::arg("domain_file"), py::arg("instance_file"), py::arg("vocabulary_info") = nullptr, py::arg("index") = -1, py::arg("max_time") = std::numeric_limits<int>::max()-1, py::arg("max_num_states") = std::numeric_limits<int>::max()-1, py::arg("cancellation_token") = nullptr, py::call_guard<py::gil_scoped_release>())
     ;
+    py::class_<GroundAction>(m_state_space, "GroundAction")
+        .def(py::init<std::string, AtomIndices, AtomIndices, AtomIndices>(), py::arg("name"), py::arg("precondition"), py::arg("add_effect"), py::arg("delete_effect"))
+        .def_readwrite("name", &GroundAction::name)
+        .def_readwrite("precondition", &GroundAction::precondition)
+        .def_readwrite("add_effect", &GroundAction::add_effect)
+        .def_readwrite("delete_effect", &GroundAction::delete_effect)
+    ;
+
+    m_state_space.def("generate_grounded_state_space", &generate_grounded_state_space, py::arg("instance_info"), py::arg("initial_atom_indices"), py::arg("actions"), py::arg("goal_atom_indices"), py::arg("max_time") = std::numeric_limits<int>::max()-1, py::arg("max_num_states") = std::numeric_limits<int>::max()-1, py::arg("cancellation_token") = nullptr, py::call_guard<py::gil_scoped_release>());
+    m_state_space.def("write_binary_state_space", &write_binary_state_space, py::arg("state_space"), py::arg("filename"));
+    m_state_space.def("read_binary_state_space", &read_binary_state_space, py::arg("filename"), py::arg("vocabulary_info") = nullptr, py::arg("index") = -1);
 }
@@ -0,0 +1,18 @@
+#include <pybind11/pybind11.h>
+#include <pybind11/stl.h>  // Necessary for automatic conversion of e.g. std::vectors
+
+#include "../../../include/dlplan/weisfeiler_lehman.h"
+
+namespace py = pybind11;
+
+using namespace dlplan::weisfeiler_lehman;
+
+
+void init_weisfeiler_lehman(py::module_ &m_weisfeiler_lehman) {
+    py::class_<WeisfeilerLehman>(m_weisfeiler_lehman, "WeisfeilerLehman")
+        .def(py::init<>())
+        .def(py::init<int>(), py::arg("num_threads"))
+        .def("compute_colors", &WeisfeilerLehman::compute_colors)
+        .def("compute_colors_for_state_space", &WeisfeilerLehman::compute_colors_for_state_space)
+    ;
+}
@@ -0,0 +1,27 @@
+import numpy as np
+
+from dlplan.core import VocabularyInfo, InstanceInfo, \
+    SyntacticElementFactory, State, evaluate_features
+
+
+def test_feature_evaluation():
+    vocabulary = VocabularyInfo()
+    vocabulary.add_predicate("role", 2)
+    instance = InstanceInfo(0, vocabulary)
+    atom_0 = instance.add_atom("role", ["A", "B"])
+    atom_1 = instance.add_atom("role", ["B", "A"])
+
+    states = [State(0, instance, []), State(1, instance, [atom_0]), State(2, instance, [atom_0, atom_1])]
+
+    factory = SyntacticElementFactory(vocabulary)
+    booleans = [factory.parse_boolean("b_empty(r_primitive(role, 0, 1))")]
+    numericals = [factory.parse_numerical("n_count(r_primitive(role, 0, 1))")]
+
+    values = evaluate_features(booleans, numericals, states, num_threads=2)
+    assert values.dtype == np.int32
+    assert values.tolist() == [[1, 0], [0, 1], [0, 2]]
+
+    out = np.zeros((3, 2), dtype=np.int32)
+    result = evaluate_features(booleans, numericals, states, out=out)
+    assert np.shares_memory(result, out)
+    assert out.tolist() == [[1, 0], [0, 1], [0, 2]]
@@ -0,0 +1,198 @@
+#include <benchmark/benchmark.h>
+
+#include "instances.h"
+
+#include <random>
+#include <thread>
+
+
+namespace dlplan::benchmarks {
+
+/// @brief Evaluates the element on all states without caches such that
+///        the time of each constructor includes its children.
+template<typename Element>
+static void evaluate_on_states(benchmark::State& bm_state, std::shared_ptr<const Element> element, std::shared_ptr<const state_space::StateSpace> state_space) {
+    const auto& states = state_space->get_state_vector();
+    for (auto _ : bm_state) {
+        for (const auto& state : states) {
+            benchmark::DoNotOptimize(element->evaluate(state));
+        }
+    }
+    bm_state.SetItemsProcessed(bm_state.iterations() * states.size());
+}
+
+/// @brief Evaluates the element on all states with a fresh cache per iteration.
+template<typename Element>
+static void evaluate_on_states_cached(benchmark::State& bm_state, std::shared_ptr<const Element> element, std::shared_ptr<const state_space::StateSpace> state_space) {
+    const auto& states = state_space->get_state_vector();
+    for (auto _ : bm_state) {
+        core::DenotationsCaches caches;
+        benchmark::DoNotOptimize(element->evaluate(states, caches));
+    }
+    bm_state.SetItemsProcessed(bm_state.iterations() * states.size());
+}
+
+/// @brief Evaluates the role on all states with a fresh cache per iteration
+///        where role denotations are always dense if range(0) is 0 and adapt
+///        their form otherwise, and reports the bytes of the cache.
+static void evaluate_role_forms(benchmark::State& bm_state, std::shared_ptr<const core::Role> role, std::shared_ptr<const state_space::StateSpace> state_space) {
+    const double sparse_density = core::RoleDenotation::get_sparse_density();
+    if (bm_state.range(0) == 0) {
+        core::RoleDenotation::set_sparse_density(0);
+    }
+    const auto& states = state_space->get_state_vector();
+    std::size_t num_bytes = 0;
+    for (auto _ : bm_state) {
+        core::DenotationsCaches caches;
+        benchmark::DoNotOptimize(role->evaluate(states, caches));
+        num_bytes = caches.get_num_bytes();
+    }
+    core::RoleDenotation::set_sparse_density(sparse_density);
+    bm_state.SetItemsProcessed(bm_state.iterations() * states.size());
+    bm_state.counters["cache_bytes"] = num_bytes;
+}
+
+/// @brief Inserts random pairs over range(0) objects with a density of
+///        1/range(1) into two role denotations, intersects and unites them,
+///        and reports the bytes of a denotation, where denotations are always
+///        dense if range(2) is 0 and always sparse otherwise.
+static void evaluate_role_denotation_forms(benchmark::State& bm_state) {
+    const int num_objects = bm_state.range(0);
+    const std::size_t num_pairs = static_cast<std::size_t>(num_objects) * num_objects / bm_state.range(1);
+    const double sparse_density = core::RoleDenotation::get_sparse_density();
+    core::RoleDenotation::set_sparse_density(bm_state.range(2) == 0 ? 0 : 1);
+    std::mt19937 generator(0);
+    std::uniform_int_distribution<int> distribution(0, num_objects - 1);
+    core::PairsOfObjectIndices left_pairs;
+    core::PairsOfObjectIndices right_pairs;
+    for (std::size_t i = 0; i < num_pairs; ++i) {
+        left_pairs.emplace_back(distribution(generator), distribution(generator));
+        right_pairs.emplace_back(distribution(generator), distribution(generator));
+    }
+    std::size_t num_bytes = 0;
+    for (auto _ : bm_state) {
+        core::RoleDenotation left(num_objects);
+        core::RoleDenotation right(num_objects);
+        left.insert_all(left_pairs);
+        right.insert_all(right_pairs);
+        num_bytes = right.get_num_bytes();
+        core::RoleDenotation intersection = left;
+        intersection &= right;
+        left |= right;
+        benchmark::DoNotOptimize(intersection.size() + left.size());
+    }
+    core::RoleDenotation::set_sparse_density(sparse_density);
+    bm_state.counters["bytes"] = num_bytes;
+}
+
+/// @brief Evaluates the element on all states with range(0) threads that
+///        each evaluate a contiguous part of the states. The threads share
+///        caches with one shard per thread if range(1) is 1 and use their
+///        own caches otherwise.
+template<typename Element>
+static void evaluate_on_states_concurrent(benchmark::State& bm_state, std::shared_ptr<const Element> element, std::shared_ptr<const state_space::StateSpace> state_space) {
+    const int num_threads = bm_state.range(0);
+    const bool share_caches = bm_state.range(1) == 1;
+    const auto& states = state_space->get_state_vector();
+    const int num_states = states.size();
+    double hit_rate = 0;
+    for (auto _ : bm_state) {
+        core::DenotationsCaches shared_caches(num_threads);
+        std::vector<std::thread> threads;
+        for (int t = 0; t < num_threads; ++t) {
+            threads.emplace_back([&, t]() {
+                core::DenotationsCaches local_caches;
+                auto& caches = share_caches ? shared_caches : local_caches;
+                for (int i = static_cast<long>(num_states) * t / num_threads; i < static_cast<long>(num_states) * (t + 1) / num_threads; ++i) {
+                    benchmark::DoNotOptimize(element->evaluate(states[i], caches));
+                }
+            });
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+        hit_rate = shared_caches.get_hit_rate();
+    }
+    bm_state.SetItemsProcessed(bm_state.iterations() * states.size());
+    bm_state.counters["hit_rate"] = hit_rate;
+}
+
+template<typename Element>
+static void register_element(const Instance& instance, const std::string& name, std::shared_ptr<const Element> element) {
+    benchmark::RegisterBenchmark(("BM_Core/" + instance.name + "/" + name).c_str(), evaluate_on_states<Element>, element, instance.state_space);
+    benchmark::RegisterBenchmark(("BM_CoreCached/" + instance.name + "/" + name).c_str(), evaluate_on_states_cached<Element>, element, instance.state_space);
+}
+
+void register_core_benchmarks(const Instance& instance) {
+    auto& factory = *instance.factory;
+    const auto& c = instance.concept_left;
+    const auto& d = instance.concept_right;
+    const auto& r = instance.role_left;
+    const auto& s = instance.role_right;
+    const std::vector<std::pair<std::string, std::string>> concepts = {
+        {"c_all", "c_all(" + r + "," + c + ")"},
+        {"c_and", "c_and(" + c + "," + d + ")"},
+        {"c_bot", "c_bot"},
+        {"c_diff", "c_diff(" + c + "," + d + ")"},
+        {"c_equal", "c_equal(" + r + "," + s + ")"},
+        {"c_not", "c_not(" + c + ")"},
+        {"c_or", "c_or(" + c + "," + d + ")"},
+        {"c_primitive", c},
+        {"c_projection", "c_projection(" + r + ",0)"},
+        {"c_some", "c_some(" + r + "," + c + ")"},
+        {"c_subset", "c_subset(" + r + "," + s + ")"},
+        {"c_top", "c_top"},
+    };
+    const std::vector<std::pair<std::string, std::string>> roles = {
+        {"r_and", "r_and(" + r + "," + s + ")"},
+        {"r_compose", "r_compose(" + r + "," + s + ")"},
+        {"r_diff", "r_diff(" + r + "," + s + ")"},
+        {"r_identity", "r_identity(" + c + ")"},
+        {"r_inverse", s},
+        {"r_not", "r_not(" + r + ")"},
+        {"r_or", "r_or(" + r + "," + s + ")"},
+        {"r_primitive", r},
+        {"r_restrict", "r_restrict(" + r + "," + c + ")"},
+        {"r_til_c", "r_til_c(" + r + "," + c + ")"},
+        {"r_top", "r_top"},
+        {"r_transitive_closure", "r_transitive_closure(" + r + ")"},
+        {"r_transitive_reflexive_closure", "r_transitive_reflexive_closure(" + r + ")"},
+    };
+    const std::vector<std::pair<std::string, std::string>> booleans = {
+        {"b_empty", "b_empty(" + c + ")"},
+        {"b_inclusion", "b_inclusion(" + c + "," + d + ")"},
+    };
+    const std::vector<std::pair<std::string, std::string>> numericals = {
+        {"n_concept_distance", "n_concept_distance(" + c + "," + r + "," + d + ")"},
+        {"n_count", "n_count(" + r + ")"},
+        {"n_role_distance", "n_role_distance(" + r + "," + r + "," + s + ")"},
+        {"n_sum_concept_distance", "n_sum_concept_distance(" + c + "," + r + "," + d + ")"},
+        {"n_sum_role_distance", "n_sum_role_distance(" + r + "," + r + "," + s + ")"},
+    };
+    for (const auto& [name, description] : concepts) {
+        register_element(instance, name, factory.parse_concept(description));
+    }
+    for (const auto& [name, description] : roles) {
+        auto role = factory.parse_role(description);
+        register_element(instance, name, role);
+        benchmark::RegisterBenchmark(("BM_CoreRoleForm/" + instance.name + "/" + name).c_str(), evaluate_role_forms, role, instance.state_space)
+            ->ArgName("sparse")->Arg(0)->Arg(1);
+    }
+    for (const auto& [name, description] : booleans) {
+        register_element(instance, name, factory.parse_boolean(description));
+    }
+    for (const auto& [name, description] : numericals) {
+        auto numerical = factory.parse_numerical(description);
+        register_element(instance, name, numerical);
+        benchmark::RegisterBenchmark(("BM_CoreConcurrent/" + instance.name + "/" + name).c_str(), evaluate_on_states_concurrent<core::Numerical>, numerical, instance.state_space)
+            ->ArgNames({"threads", "shared"})->ArgsProduct({benchmark::CreateRange(1, 64, 2), {0, 1}})->UseRealTime();
+    }
+}
+
+void register_role_denotation_benchmarks() {
+    benchmark::RegisterBenchmark("BM_RoleDenotationForm", evaluate_role_denotation_forms)
+        ->ArgNames({"objects", "inverse_density", "sparse"})
+        ->ArgsProduct({{256, 1024}, {512, 128, 32, 8}, {0, 1}});
+}
+
+}
@@ -0,0 +1,32 @@
+#include <benchmark/benchmark.h>
+
+#include "instances.h"
+
+#include "../include/dlplan/generator.h"
+
+
+namespace dlplan::benchmarks {
+
+static void generate_features(benchmark::State& bm_state, std::shared_ptr<const state_space::StateSpace> state_space) {
+    const int complexity_limit = bm_state.range(0);
+    const auto& states = state_space->get_state_vector();
+    size_t num_features = 0;
+    for (auto _ : bm_state) {
+        // A fresh factory such that elements are not shared across iterations.
+        core::SyntacticElementFactory factory(state_space->get_instance_info()->get_vocabulary_info());
+        auto [booleans, numericals, concepts, roles] = generator::generate_features(
+            factory, states,
+            complexity_limit, complexity_limit, complexity_limit, complexity_limit, complexity_limit);
+        num_features = booleans.size() + numericals.size() + concepts.size() + roles.size();
+    }
+    bm_state.counters["features"] = num_features;
+    bm_state.counters["states"] = states.size();
+}
+
+void register_generator_benchmarks(const Instance& instance) {
+    benchmark::RegisterBenchmark(("BM_Generator/" + instance.name).c_str(), generate_features, instance.state_space)
+        ->Arg(3)->Arg(5)
+        ->Unit(benchmark::kMillisecond);
+}
+
+}
@@ -0,0 +1,134 @@
+#include "instances.h"
+
+#include <iostream>
+
+
+namespace dlplan::benchmarks {
+
+// Pairs of domain directory and small instance.
+static const std::vector<std::pair<std::string, std::string>> INSTANCES = {
+    {"blocksworld_4", "p-4-0.pddl"},
+    {"childsnack", "p-2-1.0-0.0-1-0.pddl"},
+    {"delivery", "instance_2_2_0.pddl"},
+    {"gripper", "p-2-0.pddl"},
+    {"miconic", "p-2-2-0.pddl"},
+    {"reward", "instance_3x3_0.pddl"},
+    {"spanner", "p-3-3-3-0.pddl"},
+    {"visitall", "p-2-0.5-2-0.pddl"},
+};
+
+/// @brief Returns the first predicate with the given arity where dynamic predicates are preferred.
+static const core::Predicate* find_predicate(const core::VocabularyInfo& vocabulary_info, int arity) {
+    const core::Predicate* result = nullptr;
+    for (const auto& predicate : vocabulary_info.get_predicates()) {
+        if (predicate.get_arity() != arity) {
+            continue;
+        }
+        if (!predicate.is_static()) {
+            return &predicate;
+        }
+        if (!result) {
+            result = &predicate;
+        }
+    }
+    return result;
+}
+
+/// @brief Returns the state space of gripper with two rooms, two grippers, and
+///        the given number of balls, which are moved from rooma to roomb.
+///        The task is grounded here such that no external generator is required.
+static std::shared_ptr<state_space::StateSpace> generate_grounded_gripper_state_space(int num_balls, core::InstanceIndex index) {
+    auto vocabulary_info = std::make_shared<core::VocabularyInfo>();
+    vocabulary_info->add_constant("rooma");
+    vocabulary_info->add_constant("roomb");
+    vocabulary_info->add_predicate("room", 1, true);
+    vocabulary_info->add_predicate("ball", 1, true);
+    vocabulary_info->add_predicate("gripper", 1, true);
+    vocabulary_info->add_predicate("at-robby", 1);
+    vocabulary_info->add_predicate("at", 2);
+    vocabulary_info->add_predicate("free", 1);
+    vocabulary_info->add_predicate("carry", 2);
+    auto instance_info = std::make_shared<core::InstanceInfo>(index, vocabulary_info);
+    const std::vector<std::string> rooms = {"rooma", "roomb"};
+    const std::vector<std::string> grippers = {"left", "right"};
+    std::vector<std::string> balls;
+    for (int i = 0; i < num_balls; ++i) {
+        balls.push_back("ball" + std::to_string(i + 1));
+    }
+    for (const auto& room : rooms) instance_info->add_static_atom("room", {room});
+    for (const auto& ball : balls) instance_info->add_static_atom("ball", {ball});
+    for (const auto& gripper : grippers) instance_info->add_static_atom("gripper", {gripper});
+    auto add_atom = [&](const std::string& predicate_name, const std::vector<std::string>& object_names) {
+        return instance_info->add_atom(predicate_name, object_names).get_index();
+    };
+    state_space::GroundActions actions;
+    for (const auto& from : rooms) {
+        for (const auto& to : rooms) {
+            if (from != to) {
+                actions.push_back({"move", {add_atom("at-robby", {from})}, {add_atom("at-robby", {to})}, {add_atom("at-robby", {from})}});
+            }
+        }
+    }
+    for (const auto& ball : balls) {
+        for (const auto& room : rooms) {
+            for (const auto& gripper : grippers) {
+                const int at_robby = add_atom("at-robby", {room});
+                const int at = add_atom("at", {ball, room});
+                const int free = add_atom("free", {gripper});
+                const int carry = add_atom("carry", {ball, gripper});
+                actions.push_back({"pick", {at, at_robby, free}, {carry}, {at, free}});
+                actions.push_back({"drop", {carry, at_robby}, {at, free}, {carry}});
+            }
+        }
+    }
+    core::AtomIndices initial_atom_indices = {add_atom("at-robby", {"rooma"}), add_atom("free", {"left"}), add_atom("free", {"right"})};
+    core::AtomIndices goal_atom_indices;
+    for (const auto& ball : balls) {
+        initial_atom_indices.push_back(add_atom("at", {ball, "rooma"}));
+        goal_atom_indices.push_back(add_atom("at", {ball, "roomb"}));
+    }
+    return state_space::generate_grounded_state_space(instance_info, initial_atom_indices, actions, goal_atom_indices).state_space;
+}
+
+/// @brief Adds the instance over the state space if its vocabulary has a binary predicate.
+static void add_instance(const std::string& name, std::shared_ptr<state_space::StateSpace> state_space, std::vector<Instance>& instances) {
+    if (!state_space) {
+        std::cerr << "Skipping " << name << ": failed generating state space." << std::endl;
+        return;
+    }
+    const auto& vocabulary_info = *state_space->get_instance_info()->get_vocabulary_info();
+    const auto* unary = find_predicate(vocabulary_info, 1);
+    const auto* binary = find_predicate(vocabulary_info, 2);
+    if (!binary) {
+        std::cerr << "Skipping " << name << ": no binary predicate." << std::endl;
+        return;
+    }
+    Instance instance;
+    instance.name = name;
+    instance.state_space = state_space;
+    instance.factory = std::make_shared<core::SyntacticElementFactory>(state_space->get_instance_info()->get_vocabulary_info());
+    instance.role_left = "r_primitive(" + binary->get_name() + ",0,1)";
+    instance.role_right = "r_inverse(" + instance.role_left + ")";
+    instance.concept_left = (unary) ? "c_primitive(" + unary->get_name() + ",0)" : "c_projection(" + instance.role_left + ",0)";
+    instance.concept_right = "c_projection(" + instance.role_left + ",1)";
+    instances.push_back(std::move(instance));
+}
+
+std::vector<Instance> load_instances() {
+    std::vector<Instance> instances;
+    for (const auto& [domain, instance_file] : INSTANCES) {
+        const std::string directory = std::string(DLPLAN_BENCHMARKS_DIR) + "/" + domain + "/";
+        std::shared_ptr<state_space::StateSpace> state_space;
+        try {
+            state_space = state_space::generate_state_space(directory + "domain.pddl", directory + instance_file, nullptr, instances.size()).state_space;
+        } catch (const std::exception& e) {
+            std::cerr << "Skipping " << domain << ": " << e.what() << std::endl;
+            continue;
+        }
+        add_instance(domain, state_space, instances);
+    }
+    add_instance("gripper_grounded", generate_grounded_gripper_state_space(4, instances.size()), instances);
+    return instances;
+}
+
+}
@@ -0,0 +1,43 @@
+#ifndef DLPLAN_BENCHMARKS_INSTANCES_H_
+#define DLPLAN_BENCHMARKS_INSTANCES_H_
+
+#include "../include/dlplan/core.h"
+#include "../include/dlplan/state_space.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+
+namespace dlplan::benchmarks {
+
+/// @brief Encapsulates the state space of a bundled PDDL instance together
+///        with primitive elements over its predicates that benchmarked
+///        elements are composed of.
+struct Instance {
+    std::string name;
+    std::shared_ptr<const state_space::StateSpace> state_space;
+    std::shared_ptr<core::SyntacticElementFactory> factory;
+    std::string concept_left;
+    std::string concept_right;
+    std::string role_left;
+    std::string role_right;
+};
+
+/// @brief Generates the state spaces of the bundled instances and skips
+///        instances that could not be generated. The last instance is a
+///        gripper task that is generated in process and hence always loads.
+extern std::vector<Instance> load_instances();
+
+extern void register_core_benchmarks(const Instance& instance);
+extern void register_generator_benchmarks(const Instance& instance);
+extern void register_novelty_benchmarks(const Instance& instance);
+/// @brief Parsing only depends on a vocabulary and is registered once.
+extern void register_parsing_benchmarks();
+/// @brief Compares the forms of role denotations on random pairs and is registered once.
+extern void register_role_denotation_benchmarks();
+extern void register_policy_benchmarks(const Instance& instance);
+
+}
+
+#endif
@@ -0,0 +1,33 @@
+#include <benchmark/benchmark.h>
+
+#include "instances.h"
+
+#include <iostream>
+
+
+/// Benchmarks are registered per bundled instance because the
+/// benchmarked elements depend on the predicates of the domain.
+/// Use --benchmark_filter to select benchmarks and
+/// --benchmark_out=<file> --benchmark_out_format=json to store results.
+int main(int argc, char** argv) {
+    benchmark::Initialize(&argc, argv);
+    if (benchmark::ReportUnrecognizedArguments(argc, argv)) {
+        return 1;
+    }
+    const auto instances = dlplan::benchmarks::load_instances();
+    if (instances.empty()) {
+        std::cerr << "No instance could be loaded." << std::endl;
+        return 1;
+    }
+    for (const auto& instance : instances) {
+        dlplan::benchmarks::register_core_benchmarks(instance);
+        dlplan::benchmarks::register_generator_benchmarks(instance);
+        dlplan::benchmarks::register_novelty_benchmarks(instance);
+        dlplan::benchmarks::register_policy_benchmarks(instance);
+    }
+    dlplan::benchmarks::register_parsing_benchmarks();
+    dlplan::benchmarks::register_role_denotation_benchmarks();
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+    return 0;
+}
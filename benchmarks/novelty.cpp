@@ -0,0 +1,30 @@
+#include <benchmark/benchmark.h>
+
+#include "instances.h"
+
+#include "../include/dlplan/novelty.h"
+
+
+namespace dlplan::benchmarks {
+
+/// @brief Constructs the tuple graphs rooted at all states.
+static void construct_tuple_graphs(benchmark::State& bm_state, std::shared_ptr<const state_space::StateSpace> state_space) {
+    const int arity = bm_state.range(0);
+    auto novelty_base = std::make_shared<const novelty::NoveltyBase>(state_space->get_instance_info()->get_atoms().size(), arity);
+    const auto& states = state_space->get_state_vector();
+    for (auto _ : bm_state) {
+        for (const auto& state : states) {
+            novelty::TupleGraph tuple_graph(novelty_base, state_space, state.get_index());
+            benchmark::DoNotOptimize(tuple_graph.get_tuple_nodes().size());
+        }
+    }
+    bm_state.SetItemsProcessed(bm_state.iterations() * states.size());
+}
+
+void register_novelty_benchmarks(const Instance& instance) {
+    benchmark::RegisterBenchmark(("BM_TupleGraph/" + instance.name).c_str(), construct_tuple_graphs, instance.state_space)
+        ->Arg(0)->Arg(1)->Arg(2)
+        ->Unit(benchmark::kMillisecond);
+}
+
+}
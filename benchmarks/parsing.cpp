@@ -0,0 +1,104 @@
+#include <benchmark/benchmark.h>
+
+#include "instances.h"
+
+
+namespace dlplan::benchmarks {
+
+/// @brief Returns the vocabulary of blocksworld with goal predicates.
+static std::shared_ptr<core::VocabularyInfo> construct_vocabulary_info() {
+    auto vocabulary_info = std::make_shared<core::VocabularyInfo>();
+    vocabulary_info->add_predicate("clear", 1);
+    vocabulary_info->add_predicate("holding", 1);
+    vocabulary_info->add_predicate("ontable", 1);
+    vocabulary_info->add_predicate("on", 2);
+    vocabulary_info->add_predicate("on_g", 2, true);
+    return vocabulary_info;
+}
+
+/// @brief Returns descriptions of elements composed of up to three operators
+///        over the primitives, which share many subterms like generated features.
+static std::shared_ptr<const std::vector<std::string>> construct_descriptions() {
+    std::vector<std::string> primitive_concepts = {
+        "c_primitive(clear,0)", "c_primitive(holding,0)", "c_primitive(ontable,0)",
+        "c_primitive(on,0)", "c_primitive(on,1)", "c_primitive(on_g,0)", "c_primitive(on_g,1)"};
+    std::vector<std::string> roles = {
+        "r_primitive(on,0,1)", "r_primitive(on_g,0,1)", "r_inverse(r_primitive(on,0,1))", "r_inverse(r_primitive(on_g,0,1))"};
+    std::vector<std::string> composite_concepts;
+    for (size_t i = 0; i < primitive_concepts.size(); ++i) {
+        const auto& concept_ = primitive_concepts[i];
+        composite_concepts.push_back("c_not(" + concept_ + ")");
+        for (const auto& role : roles) {
+            composite_concepts.push_back("c_some(" + role + "," + concept_ + ")");
+            composite_concepts.push_back("c_all(" + role + "," + concept_ + ")");
+        }
+        for (size_t j = i + 1; j < primitive_concepts.size(); ++j) {
+            composite_concepts.push_back("c_and(" + concept_ + "," + primitive_concepts[j] + ")");
+        }
+    }
+    std::vector<std::string> concepts = primitive_concepts;
+    concepts.insert(concepts.end(), composite_concepts.begin(), composite_concepts.end());
+    for (const auto& concept_ : composite_concepts) {
+        for (const auto& role : roles) {
+            concepts.push_back("c_some(" + role + "," + concept_ + ")");
+        }
+        for (const auto& primitive_concept : primitive_concepts) {
+            concepts.push_back("c_and(" + primitive_concept + "," + concept_ + ")");
+        }
+    }
+    auto descriptions = std::make_shared<std::vector<std::string>>(concepts);
+    descriptions->insert(descriptions->end(), roles.begin(), roles.end());
+    for (const auto& concept_ : concepts) {
+        descriptions->push_back("n_count(" + concept_ + ")");
+        descriptions->push_back("b_empty(" + concept_ + ")");
+    }
+    return descriptions;
+}
+
+static void set_throughput(benchmark::State& bm_state, const std::vector<std::string>& descriptions) {
+    size_t num_bytes = 0;
+    for (const auto& description : descriptions) {
+        num_bytes += description.size();
+    }
+    bm_state.SetItemsProcessed(bm_state.iterations() * descriptions.size());
+    bm_state.SetBytesProcessed(bm_state.iterations() * num_bytes);
+}
+
+/// @brief Parses the descriptions one by one with a fresh factory per iteration.
+static void parse_single(benchmark::State& bm_state, std::shared_ptr<core::VocabularyInfo> vocabulary_info, std::shared_ptr<const std::vector<std::string>> descriptions) {
+    for (auto _ : bm_state) {
+        core::SyntacticElementFactory factory(vocabulary_info);
+        for (const auto& description : *descriptions) {
+            switch (description.front()) {
+                case 'b': benchmark::DoNotOptimize(factory.parse_boolean(description)); break;
+                case 'n': benchmark::DoNotOptimize(factory.parse_numerical(description)); break;
+                case 'c': benchmark::DoNotOptimize(factory.parse_concept(description)); break;
+                default: benchmark::DoNotOptimize(factory.parse_role(description)); break;
+            }
+        }
+    }
+    set_throughput(bm_state, *descriptions);
+}
+
+/// @brief Parses the descriptions in bulk on range(0) threads with a fresh
+///        factory per iteration.
+static void parse_bulk(benchmark::State& bm_state, std::shared_ptr<core::VocabularyInfo> vocabulary_info, std::shared_ptr<const std::vector<std::string>> descriptions) {
+    const int num_threads = bm_state.range(0);
+    for (auto _ : bm_state) {
+        core::SyntacticElementFactory factory(vocabulary_info);
+        benchmark::DoNotOptimize(factory.parse_elements(*descriptions, num_threads));
+    }
+    set_throughput(bm_state, *descriptions);
+}
+
+void register_parsing_benchmarks() {
+    auto vocabulary_info = construct_vocabulary_info();
+    auto descriptions = construct_descriptions();
+    benchmark::RegisterBenchmark("BM_Parse", parse_single, vocabulary_info, descriptions)
+        ->Unit(benchmark::kMillisecond);
+    benchmark::RegisterBenchmark("BM_ParseBulk", parse_bulk, vocabulary_info, descriptions)
+        ->Arg(1)->Arg(4)
+        ->Unit(benchmark::kMillisecond);
+}
+
+}
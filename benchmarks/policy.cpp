@@ -0,0 +1,56 @@
+#include <benchmark/benchmark.h>
+
+#include "instances.h"
+
+#include "../include/dlplan/policy.h"
+
+
+namespace dlplan::benchmarks {
+
+/// @brief Creates a policy with a few rules over features of the instance.
+static std::shared_ptr<const policy::Policy> create_policy(const Instance& instance, policy::PolicyFactory& policy_factory) {
+    auto& factory = *instance.factory;
+    auto b0 = policy_factory.make_boolean("b0", factory.parse_boolean("b_empty(" + instance.concept_left + ")"));
+    auto n0 = policy_factory.make_numerical("n0", factory.parse_numerical("n_count(" + instance.role_left + ")"));
+    auto n1 = policy_factory.make_numerical("n1", factory.parse_numerical("n_concept_distance(" + instance.concept_left + "," + instance.role_left + "," + instance.concept_right + ")"));
+    policy::Rules rules{
+        policy_factory.make_rule({policy_factory.make_neg_condition(b0)}, {policy_factory.make_dec_effect(n0)}),
+        policy_factory.make_rule({policy_factory.make_gt_condition(n1)}, {policy_factory.make_dec_effect(n1), policy_factory.make_bot_effect(n0)}),
+        policy_factory.make_rule({policy_factory.make_pos_condition(b0)}, {policy_factory.make_neg_effect(b0)}),
+    };
+    return policy_factory.make_policy(rules);
+}
+
+/// @brief Evaluates the policy on all transitions with a shared cache per iteration.
+static void evaluate_policy(benchmark::State& bm_state, std::shared_ptr<const policy::Policy> policy, std::shared_ptr<const state_space::StateSpace> state_space) {
+    const auto& successors = state_space->get_forward_successors();
+    for (auto _ : bm_state) {
+        core::DenotationsCaches caches;
+        for (const auto& state : state_space->get_state_vector()) {
+            for (auto target : successors.get_targets(state.get_index())) {
+                benchmark::DoNotOptimize(policy->evaluate(state, state_space->get_state(target), caches));
+            }
+        }
+    }
+    bm_state.SetItemsProcessed(bm_state.iterations() * successors.get_num_edges());
+}
+
+static void verify_policy(benchmark::State& bm_state, std::shared_ptr<const policy::Policy> policy, std::shared_ptr<const state_space::StateSpace> state_space) {
+    policy::PolicyVerifier verifier(bm_state.range(0));
+    for (auto _ : bm_state) {
+        benchmark::DoNotOptimize(verifier.verify(policy, state_space));
+    }
+    bm_state.SetItemsProcessed(bm_state.iterations() * state_space->get_forward_successors().get_num_edges());
+}
+
+void register_policy_benchmarks(const Instance& instance) {
+    policy::PolicyFactory policy_factory(instance.factory);
+    auto policy = create_policy(instance, policy_factory);
+    benchmark::RegisterBenchmark(("BM_PolicyEvaluate/" + instance.name).c_str(), evaluate_policy, policy, instance.state_space)
+        ->Unit(benchmark::kMillisecond);
+    benchmark::RegisterBenchmark(("BM_PolicyVerify/" + instance.name).c_str(), verify_policy, policy, instance.state_space)
+        ->Arg(1)->Arg(4)
+        ->Unit(benchmark::kMillisecond);
+}
+
+}
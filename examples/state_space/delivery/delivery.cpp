@@ -33,9 +33,9 @@ int main() {
         std::cout << "state_index=" << pair.first << " distance=" << pair.second << std::endl;
     }
     std::cout << "Deadends:" << std::endl;
-    for (const auto& pair : state_space_2_1_0.get_states()) {
-        if (!goal_distance_info.count(pair.first)) {
-            std::cout << pair.first << " ";
+    for (const auto& state : state_space_2_1_0.get_state_vector()) {
+        if (!goal_distance_info.count(state.get_index())) {
+            std::cout << state.get_index() << " ";
         }
     }
     std::cout << std::endl << std::endl;
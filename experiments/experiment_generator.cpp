@@ -33,13 +33,12 @@ int main(int argc, char** argv) {
     auto result =  state_space::generate_state_space(domain_filename, instance_filename, nullptr, 0);
     const auto& state_space = *result.state_space;
     std::cout << "Started generating features" << std::endl;
-    std::cout << "Number of states: " << state_space.get_states().size() << std::endl;
+    std::cout << "Number of states: " << state_space.get_state_vector().size() << std::endl;
     std::cout << "Number of dynamic atoms: " << state_space.get_instance_info()->get_atoms().size() << std::endl;
     std::cout << "Number of static atoms: " << state_space.get_instance_info()->get_static_atoms().size() << std::endl;
 
     auto syntactic_element_factory = core::SyntacticElementFactory(state_space.get_instance_info()->get_vocabulary_info());
-    core::States states;
-    std::for_each(state_space.get_states().begin(), state_space.get_states().end(), [&](const auto& pair){ states.push_back(pair.second); });
+    const core::States& states = state_space.get_state_vector();
     auto [generated_booleans, generated_numericals, generated_concepts, generated_roles] = generator::generate_features(
         syntactic_element_factory,
         states,
@@ -58,12 +57,12 @@ int main(int argc, char** argv) {
     {
         auto start = std::chrono::steady_clock::now();
         for (int i = 0; i < num_iterations; ++i) {
-            for (const auto& pair : state_space.get_states()) {
+            for (const auto& state : states) {
                 for (const auto& boolean : generated_booleans) {
-                    boolean->evaluate(pair.second);
+                    boolean->evaluate(state);
                 }
                 for (const auto& numerical : generated_numericals) {
-                    numerical->evaluate(pair.second);
+                    numerical->evaluate(state);
                 }
             }
         }
@@ -77,12 +76,12 @@ int main(int argc, char** argv) {
         auto start = std::chrono::steady_clock::now();
         core::DenotationsCaches caches;
         for (int i = 0; i < std::atoi(argv[10]); ++i) {
-            for (const auto& pair : state_space.get_states()) {
+            for (const auto& state : states) {
                 for (const auto& boolean : generated_booleans) {
-                    boolean->evaluate(pair.second, caches);
+                    boolean->evaluate(state, caches);
                 }
                 for (const auto& numerical : generated_numericals) {
-                    numerical->evaluate(pair.second, caches);
+                    numerical->evaluate(state, caches);
                 }
             }
         }
@@ -0,0 +1,53 @@
+#include <vector>
+#include <iostream>
+#include <chrono>
+#include <thread>
+
+#include "../include/dlplan/state_space.h"
+
+using namespace dlplan;
+
+
+int main(int argc, char** argv) {
+    if (argc != 4) {
+        std::cout << "User error. Expected: ./experiment_state_space <str:domain_filename> <str:instance_filename> <int:num_iterations>" << std::endl;
+        return 1;
+    }
+    std::string domain_filename = argv[1];
+    std::string instance_filename = argv[2];
+    int num_iterations = std::atoi(argv[3]);
+
+    auto generate_start = std::chrono::steady_clock::now();
+    auto result = state_space::generate_state_space(domain_filename, instance_filename, nullptr, 0);
+    auto generate_end = std::chrono::steady_clock::now();
+    if (!result.state_space) {
+        std::cout << "Failed generating state space." << std::endl;
+        return 1;
+    }
+    std::cout << "Time generate and read text state space: "
+        << std::chrono::duration_cast<std::chrono::milliseconds>(generate_end - generate_start).count()
+        << "ms" << std::endl;
+    state_space::write_binary_state_space(*result.state_space, "state_space.bin");
+    auto read_start = std::chrono::steady_clock::now();
+    auto binary_state_space = state_space::read_binary_state_space("state_space.bin", nullptr, 0);
+    auto read_end = std::chrono::steady_clock::now();
+    std::cout << "Time read binary state space: "
+        << std::chrono::duration_cast<std::chrono::milliseconds>(read_end - read_start).count()
+        << "ms" << std::endl;
+    const auto& state_space = *binary_state_space;
+    std::cout << "Number of states: " << state_space.get_state_vector().size() << std::endl;
+    std::cout << "Number of transitions: " << state_space.get_forward_successors().get_num_edges() << std::endl;
+
+    int max_num_threads = std::max(std::thread::hardware_concurrency(), 1u);
+    for (int num_threads = 1; num_threads <= max_num_threads; num_threads *= 2) {
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < num_iterations; ++i) {
+            state_space.compute_dense_goal_distances(num_threads);
+        }
+        auto end = std::chrono::steady_clock::now();
+        std::cout << "Time compute goal distances with " << num_threads << " threads: "
+            << std::chrono::duration_cast<std::chrono::microseconds>(end - start).count() / num_iterations
+            << "us" << std::endl;
+    }
+    return 0;
+}
@@ -0,0 +1,79 @@
+#include <vector>
+#include <iostream>
+#include <chrono>
+
+#include "../include/dlplan/state_space.h"
+
+using namespace dlplan;
+
+
+/// @brief Grounds gripper with the given number of balls
+///        and generates its state space in process.
+int main(int argc, char** argv) {
+    if (argc != 2) {
+        std::cout << "User error. Expected: ./experiment_successor_generator <int:num_balls>" << std::endl;
+        return 1;
+    }
+    int num_balls = std::atoi(argv[1]);
+
+    auto vocabulary_info = std::make_shared<core::VocabularyInfo>();
+    vocabulary_info->add_predicate("at-robby", 1);
+    vocabulary_info->add_predicate("at", 2);
+    vocabulary_info->add_predicate("free", 1);
+    vocabulary_info->add_predicate("carry", 2);
+    auto instance_info = std::make_shared<core::InstanceInfo>(0, vocabulary_info);
+    const std::vector<std::string> rooms = {"rooma", "roomb"};
+    const std::vector<std::string> grippers = {"left", "right"};
+    std::vector<int> at_robby, free;
+    std::vector<std::vector<int>> at(num_balls), carry(num_balls);
+    for (const auto& room : rooms) {
+        at_robby.push_back(instance_info->add_atom("at-robby", {room}).get_index());
+    }
+    for (const auto& gripper : grippers) {
+        free.push_back(instance_info->add_atom("free", {gripper}).get_index());
+    }
+    for (int b = 0; b < num_balls; ++b) {
+        std::string ball = "ball" + std::to_string(b);
+        for (const auto& room : rooms) {
+            at[b].push_back(instance_info->add_atom("at", {ball, room}).get_index());
+        }
+        for (const auto& gripper : grippers) {
+            carry[b].push_back(instance_info->add_atom("carry", {ball, gripper}).get_index());
+        }
+    }
+    state_space::GroundActions actions;
+    for (int r1 = 0; r1 < 2; ++r1) {
+        actions.push_back({"move", {at_robby[r1]}, {at_robby[1-r1]}, {at_robby[r1]}});
+    }
+    for (int b = 0; b < num_balls; ++b) {
+        for (int r = 0; r < 2; ++r) {
+            for (int g = 0; g < 2; ++g) {
+                actions.push_back({"pick", {at[b][r], at_robby[r], free[g]}, {carry[b][g]}, {at[b][r], free[g]}});
+                actions.push_back({"drop", {carry[b][g], at_robby[r]}, {at[b][r], free[g]}, {carry[b][g]}});
+            }
+        }
+    }
+    core::AtomIndices initial = {at_robby[0], free[0], free[1]};
+    core::AtomIndices goal;
+    for (int b = 0; b < num_balls; ++b) {
+        initial.push_back(at[b][0]);
+        goal.push_back(at[b][1]);
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    auto result = state_space::generate_grounded_state_space(instance_info, initial, actions, goal);
+    auto end = std::chrono::steady_clock::now();
+    if (!result.state_space) {
+        std::cout << "Failed generating state space." << std::endl;
+        return 1;
+    }
+    const auto& state_space = *result.state_space;
+    double seconds = std::chrono::duration<double>(end - start).count();
+    std::cout << "Number of states: " << state_space.get_state_vector().size() << std::endl;
+    std::cout << "Number of transitions: " << state_space.get_forward_successors().get_num_edges() << std::endl;
+    std::cout << "Time generate grounded state space: "
+        << std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count()
+        << "ms" << std::endl;
+    std::cout << "States per second: " << state_space.get_state_vector().size() / seconds << std::endl;
+    return 0;
+}
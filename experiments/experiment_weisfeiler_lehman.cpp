@@ -0,0 +1,44 @@
+#include <vector>
+#include <iostream>
+#include <chrono>
+#include <thread>
+#include <unordered_set>
+
+#include "../include/dlplan/weisfeiler_lehman.h"
+
+using namespace dlplan;
+
+
+int main(int argc, char** argv) {
+    if (argc != 4) {
+        std::cout << "User error. Expected: ./experiment_weisfeiler_lehman <str:domain_filename> <str:instance_filename> <int:num_iterations>" << std::endl;
+        return 1;
+    }
+    std::string domain_filename = argv[1];
+    std::string instance_filename = argv[2];
+    int num_iterations = std::atoi(argv[3]);
+
+    auto result = state_space::generate_state_space(domain_filename, instance_filename, nullptr, 0);
+    if (!result.state_space) {
+        std::cout << "Failed generating state space." << std::endl;
+        return 1;
+    }
+    const auto& state_space = *result.state_space;
+    std::cout << "Number of states: " << state_space.get_state_vector().size() << std::endl;
+
+    int max_num_threads = std::max(std::thread::hardware_concurrency(), 1u);
+    for (int num_threads = 1; num_threads <= max_num_threads; num_threads *= 2) {
+        weisfeiler_lehman::WeisfeilerLehman weisfeiler_lehman(num_threads);
+        weisfeiler_lehman::CompressedColors colors;
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < num_iterations; ++i) {
+            colors = weisfeiler_lehman.compute_colors_for_state_space(state_space);
+        }
+        auto end = std::chrono::steady_clock::now();
+        std::cout << "Time compute colors with " << num_threads << " threads: "
+            << std::chrono::duration_cast<std::chrono::microseconds>(end - start).count() / num_iterations
+            << "us" << std::endl;
+        std::cout << "Number of colors: " << std::unordered_set<int>(colors.begin(), colors.end()).size() << std::endl;
+    }
+    return 0;
+}
@@ -4,8 +4,11 @@
 #ifndef DLPLAN_INCLUDE_DLPLAN_CORE_H_
 #define DLPLAN_INCLUDE_DLPLAN_CORE_H_
 
+#include <cstdint>
 #include <memory>
+#include <span>
 #include <string>
+#include <tuple>
 #include <unordered_set>
 #include <unordered_map>
 #include <vector>
@@ -15,7 +18,11 @@
 #include "common/parsers/config.hpp"
 #include "utils/pimpl.h"
 #include "utils/dynamic_bitset.h"
+#include "utils/lazy_bitset.h"
 #include "utils/cache.h"
+#include "core/cost_model.h"
+#include "core/denotation_ids.h"
+#include "core/profiler.h"
 
 
 // Forward declarations of this header
@@ -33,9 +40,10 @@ class InstanceInfo;
 class State;
 class SyntacticElementFactory;
 class SyntacticElementFactoryImpl;
+class ElementSerializer;
 
-using ConceptDenotations = std::vector<std::shared_ptr<const ConceptDenotation>>;
-using RoleDenotations = std::vector<std::shared_ptr<const RoleDenotation>>;
+using ConceptDenotations = DenotationIds<ConceptDenotation>;
+using RoleDenotations = DenotationIds<RoleDenotation>;
 using BooleanDenotations = std::vector<bool>;
 using NumericalDenotations = std::vector<int>;
 
@@ -104,6 +112,37 @@ namespace std {
     };
 }
 
+namespace dlplan {
+    template<>
+    struct SharedObjectSize<core::ConceptDenotation> {
+        std::size_t operator()(const core::ConceptDenotation& denotation) const;
+    };
+    template<>
+    struct SharedObjectSize<core::RoleDenotation> {
+        std::size_t operator()(const core::RoleDenotation& denotation) const;
+    };
+    template<>
+    struct SharedObjectSize<core::ConceptDenotations> {
+        std::size_t operator()(const core::ConceptDenotations& denotations) const;
+    };
+    template<>
+    struct SharedObjectSize<core::RoleDenotations> {
+        std::size_t operator()(const core::RoleDenotations& denotations) const;
+    };
+    template<>
+    struct SharedObjectSize<core::BooleanDenotations> {
+        std::size_t operator()(const core::BooleanDenotations& denotations) const;
+    };
+    template<>
+    struct SharedObjectSize<core::NumericalDenotations> {
+        std::size_t operator()(const core::NumericalDenotations& denotations) const;
+    };
+    template<>
+    struct SharedObjectPinned<core::DenotationsCacheKey> {
+        bool operator()(const core::DenotationsCacheKey& key) const;
+    };
+}
+
 namespace dlplan::core {
 /// @brief Encapsulates the result of the evaluation of a concept on a state
 ///        and provides functionality to access and modify it.
@@ -115,7 +154,7 @@ namespace dlplan::core {
 class ConceptDenotation : public Base<ConceptDenotation> {
 private:
     int m_num_objects;
-    DynamicBitset<unsigned> m_data;
+    LazyBitset<unsigned> m_data;
 
 public:
     ConceptDenotation(int num_objects);
@@ -144,6 +183,20 @@ public:
     bool intersects(const ConceptDenotation& other) const;
     bool is_subset_of(const ConceptDenotation& other) const;
 
+    /// @brief Returns true iff the denotation is the empty or full set
+    ///        without allocated bits, e.g., after set() or for a fresh denotation.
+    bool is_symbolic() const;
+
+    /// @brief Returns true iff the denotation is stored by its complement.
+    bool is_complemented() const;
+
+    /// @brief Allocates explicit bits for kernels that need them.
+    ///        The represented set does not change.
+    void materialize();
+
+    /// @brief Returns the number of bytes allocated for the object indices.
+    std::size_t get_num_bytes() const;
+
     /// @brief Compute a vector representation of this concept denotation.
     /// @return A vector of object indices.
     ObjectIndices to_vector() const;
@@ -163,10 +216,24 @@ public:
 /// The set of pairs of object indices represent the elements in the binary
 /// relation of the role that are true in a given state. Each object index
 /// refers to an object of a common instance info.
+///
+/// A role denotation is sparse, i.e., a sorted list of encoded pairs, while
+/// its density is below the sparse density and dense, i.e., a bitset over
+/// all pairs, otherwise. The form changes automatically and equal sets are
+/// equal and hash equally regardless of their forms.
 class RoleDenotation : public Base<RoleDenotation> {
 private:
     int m_num_objects;
-    DynamicBitset<unsigned> m_data;
+    bool m_sparse;
+    // Sorted keys first * num_objects + second of the pairs if sparse.
+    std::vector<uint32_t> m_pairs;
+    // The pairs if dense.
+    LazyBitset<unsigned> m_data;
+
+    std::size_t get_max_num_sparse_pairs() const;
+    void to_dense();
+    void try_to_sparse();
+    bool contains_key(uint32_t key) const;
 
 public:
     explicit RoleDenotation(int num_objects);
@@ -190,11 +257,32 @@ public:
     void insert(const PairOfObjectIndices& value);
     void erase(const PairOfObjectIndices& value);
 
+    /// @brief Inserts all pairs at once, which is faster than inserting
+    ///        them one by one into a sparse denotation.
+    void insert_all(const PairsOfObjectIndices& values);
+
     int size() const;
     bool empty() const;
     bool intersects(const RoleDenotation& other) const;
     bool is_subset_of(const RoleDenotation& other) const;
 
+    /// @brief Returns true iff the pairs are stored as a sorted list.
+    bool is_sparse() const;
+
+    /// @brief Returns true iff the denotation is the empty or full set
+    ///        without allocated bits, e.g., after set() or for a fresh denotation.
+    bool is_symbolic() const;
+
+    /// @brief Returns true iff the denotation is stored by its complement.
+    bool is_complemented() const;
+
+    /// @brief Allocates explicit bits for kernels that need them.
+    ///        The represented set does not change.
+    void materialize();
+
+    /// @brief Returns the number of bytes allocated for the pairs of object indices.
+    std::size_t get_num_bytes() const;
+
     /// @brief Compute a vector representation of this role denotation.
     /// @return A vector of pairs of object indices.
     PairsOfObjectIndices to_vector() const;
@@ -204,6 +292,14 @@ public:
     PairsOfObjectIndices to_sorted_vector() const;
 
     int get_num_objects() const;
+
+    /// @brief Returns the density up to which role denotations are sparse.
+    static double get_sparse_density();
+
+    /// @brief Sets the density up to which role denotations are sparse.
+    ///        A density of 0 makes all role denotations dense.
+    ///        Must not be called concurrently with evaluation.
+    static void set_sparse_density(double density);
 };
 
 /// @brief Encapsulates a key to store and retrieve denotations from the cache.
@@ -220,16 +316,50 @@ struct DenotationsCacheKey {
 
 /// @brief Encapsulates caches for denotations and provides functionality to
 ///        insert and retrieve denotations into and respectively from the cache.
+///
+/// Caches with several shards are thread-safe such that threads can share
+/// the denotations that they compute, where more shards reduce lock
+/// contention. Caches with a single shard, which is the default, are not
+/// locked and must only be used by one thread at a time.
 class DenotationsCaches {
 public:
 
     DenotationsCaches();
+    /// @param num_shards The number of independently locked shards,
+    ///        rounded up to a power of two.
+    explicit DenotationsCaches(int num_shards);
     ~DenotationsCaches();
     DenotationsCaches(const DenotationsCaches& other) = delete;
     DenotationsCaches& operator=(const DenotationsCaches& other) = delete;
     DenotationsCaches(DenotationsCaches&& other);
     DenotationsCaches& operator=(DenotationsCaches&& other);
 
+    /// @brief Returns the number of bytes of the cached denotations
+    ///        and of the hash tables that store them.
+    std::size_t get_num_bytes() const;
+
+    /// @brief Sets the number of bytes above which denotations of single
+    ///        non-static states are evicted. By default, memory is unlimited.
+    ///        Denotations of static elements and of sequences of states are
+    ///        never evicted.
+    void set_memory_limit(std::size_t num_bytes);
+    std::size_t get_memory_limit() const;
+
+    int get_num_shards() const;
+
+    std::size_t get_num_hits() const;
+    std::size_t get_num_misses() const;
+    std::size_t get_num_evictions() const;
+    /// @brief Returns the fraction of lookups that were hits.
+    double get_hit_rate() const;
+    void reset_statistics();
+
+    /// @brief Returns a view of the denotations that keeps them alive.
+    template<typename T>
+    DenotationsView<T> make_view(std::shared_ptr<const DenotationIds<T>> ids) const {
+        return DenotationsView<T>(data.get_pool<T>(), std::move(ids));
+    }
+
     // Caches denotations by key, same denotations are shared.
     SharedObjectCache<DenotationsCacheKey,
         ConceptDenotation,
@@ -434,6 +564,7 @@ private:
     const Atom& add_atom(PredicateIndex predicate_index, const ObjectIndices& object_indices, bool is_static);
     const Atom& add_atom(const Predicate& predicate, const std::vector<Object>& objects, bool is_static);
     const Atom& add_atom(const std::string& predicate_name, const std::vector<std::string>& object_names, bool is_static);
+    const Atom& insert_atom(PredicateIndex predicate_index, const ObjectIndices& object_indices, const std::string& name, bool is_static);
 
 public:
     InstanceInfo(InstanceIndex index, std::shared_ptr<VocabularyInfo> vocabulary_info);
@@ -464,6 +595,13 @@ public:
      */
     const Atom& add_atom(const std::string& predicate_name, const std::vector<std::string>& object_names);
     const Atom& add_static_atom(const std::string& predicate_name, const std::vector<std::string>& object_names);
+    /**
+     * Alternative 4 to add atoms with names that were computed before, e.g.,
+     * when loading atoms from a file, which avoids building the names.
+     * The name must be the one that the other alternatives compute.
+     */
+    const Atom& add_atom_with_name(PredicateIndex predicate_index, const ObjectIndices& object_indices, const std::string& name);
+    const Atom& add_static_atom_with_name(PredicateIndex predicate_index, const ObjectIndices& object_indices, const std::string& name);
 
     /// @brief Removes all atoms from the instance.
     void clear_atoms();
@@ -559,24 +697,34 @@ public:
     virtual bool are_equal_impl(const Element& other) const = 0;
     virtual size_t hash_impl() const = 0;
     virtual void str_impl(std::stringstream& out) const = 0;
+    /// @brief Writes the kind and the arguments of the element.
+    virtual void serialize_impl(ElementSerializer& out) const = 0;
     virtual int compute_complexity_impl() const = 0;
     virtual int compute_evaluate_time_score_impl() const = 0;
 
     virtual Denotation evaluate(const State& ) const = 0;
     std::shared_ptr<const Denotation> evaluate(const State& state, DenotationsCaches& caches) const {
         auto key = DenotationsCacheKey{ Base<Element<Denotation, DenotationList>>::get_index(), state.get_instance_info()->get_index(), BaseElement<Element<Denotation, DenotationList>>::is_static() ? -1 : state.get_index() };
+        DLPLAN_PROFILE_ELEMENT(profile_scope, *this);
         auto cached = caches.data.get<Denotation>(key);
-        if (cached) return cached;
-        auto denotation = caches.data.insert_unique(evaluate_impl(state, caches));
-        caches.data.insert_mapping(key, denotation);
+        if (cached) {
+            DLPLAN_PROFILE_CACHE_HIT(profile_scope);
+            return cached;
+        }
+        auto denotation = caches.data.insert_unique_mapping(key, evaluate_impl(state, caches));
+        DLPLAN_PROFILE_CACHE_MISS(profile_scope, *denotation);
         return denotation;
     }
     std::shared_ptr<const DenotationList> evaluate(const States& states, DenotationsCaches& caches) const {
         auto key = DenotationsCacheKey{ Base<Element<Denotation, DenotationList>>::get_index(), -1, -1 };
+        DLPLAN_PROFILE_ELEMENT(profile_scope, *this);
         auto cached = caches.data.get<DenotationList>(key);
-        if (cached) return cached;
-        auto result_denotations = caches.data.insert_unique(evaluate_impl(states, caches));
-        caches.data.insert_mapping(key, result_denotations);
+        if (cached) {
+            DLPLAN_PROFILE_CACHE_HIT(profile_scope);
+            return cached;
+        }
+        auto result_denotations = caches.data.insert_unique_mapping(key, evaluate_impl(states, caches));
+        DLPLAN_PROFILE_CACHE_MISS(profile_scope, *result_denotations);
         return result_denotations;
     }
 };
@@ -602,26 +750,36 @@ public:
     virtual bool are_equal_impl(const ElementLight& other) const = 0;
     virtual size_t hash_impl() const = 0;
     virtual void str_impl(std::stringstream& out) const = 0;
+    /// @brief Writes the kind and the arguments of the element.
+    virtual void serialize_impl(ElementSerializer& out) const = 0;
     virtual int compute_complexity_impl() const = 0;
     virtual int compute_evaluate_time_score_impl() const = 0;
 
     virtual Denotation evaluate(const State& ) const = 0;
     Denotation evaluate(const State& state, DenotationsCaches& caches) const {
         auto key = DenotationsCacheKey{ Base<ElementLight<Denotation, DenotationList>>::get_index(), state.get_instance_info()->get_index(), BaseElement<ElementLight<Denotation, DenotationList>>::is_static() ? -1 : state.get_index() };
+        DLPLAN_PROFILE_ELEMENT(profile_scope, *this);
         auto cached = caches.data.get<Denotation>(key);
         // ElementLight dereferences the denotation because it is cheap to copy,
         // e.g. std::shared_ptr<const int> -> int
-        if (cached) return *cached;  // dereference the cached value
-        auto denotation = caches.data.insert_unique(evaluate_impl(state, caches));
-        caches.data.insert_mapping(key, denotation);
+        if (cached) {
+            DLPLAN_PROFILE_CACHE_HIT(profile_scope);
+            return *cached;  // dereference the cached value
+        }
+        auto denotation = caches.data.insert_unique_mapping(key, evaluate_impl(state, caches));
+        DLPLAN_PROFILE_CACHE_MISS(profile_scope, *denotation);
         return *denotation;  // dereference the newly inserted denoation
     }
     std::shared_ptr<const DenotationList> evaluate(const States& states, DenotationsCaches& caches) const {
         auto key = DenotationsCacheKey{ Base<ElementLight<Denotation, DenotationList>>::get_index(), -1, -1 };
+        DLPLAN_PROFILE_ELEMENT(profile_scope, *this);
         auto cached = caches.data.get<DenotationList>(key);
-        if (cached) return cached;
-        auto result_denotations = caches.data.insert_unique(evaluate_impl(states, caches));
-        caches.data.insert_mapping(key, result_denotations);
+        if (cached) {
+            DLPLAN_PROFILE_CACHE_HIT(profile_scope);
+            return cached;
+        }
+        auto result_denotations = caches.data.insert_unique_mapping(key, evaluate_impl(states, caches));
+        DLPLAN_PROFILE_CACHE_MISS(profile_scope, *result_denotations);
         return result_denotations;
     }
 };
@@ -643,6 +801,35 @@ using Boolean = ElementLight<bool, BooleanDenotations>;
 ///        on a given state. It can also make use of a cache during evaluation.
 using Numerical = ElementLight<int, NumericalDenotations>;
 
+/// @brief Groups Booleans, numericals, concepts, and roles,
+///        e.g., a set of generated features.
+using ElementCollection = std::tuple<
+    std::vector<std::shared_ptr<const Boolean>>,
+    std::vector<std::shared_ptr<const Numerical>>,
+    std::vector<std::shared_ptr<const Concept>>,
+    std::vector<std::shared_ptr<const Role>>
+>;
+
+
+/// @brief Evaluates the Booleans followed by the numericals on the states
+///        and writes the values into a row-major matrix with one row per
+///        state where Booleans evaluate to 0 or 1.
+///
+/// Consecutive blocks of states are evaluated with a fresh cache per block
+/// on num_threads threads.
+/// @param values A matrix with states.size() * (booleans.size() + numericals.size()) entries.
+extern void evaluate_features(
+    const std::vector<std::shared_ptr<const Boolean>>& booleans,
+    const std::vector<std::shared_ptr<const Numerical>>& numericals,
+    const States& states,
+    std::span<int32_t> values,
+    int num_threads=1);
+extern std::vector<int32_t> evaluate_features(
+    const std::vector<std::shared_ptr<const Boolean>>& booleans,
+    const std::vector<std::shared_ptr<const Numerical>>& numericals,
+    const States& states,
+    int num_threads=1);
+
 
 /// @brief Provides functionality for the syntactically unique creation of elements.
 class SyntacticElementFactory {
@@ -659,6 +846,12 @@ public:
 
     std::shared_ptr<VocabularyInfo> get_vocabulary_info() const;
 
+    /**
+     * Returns the number of bytes of the elements that are currently alive,
+     * excluding the denotations, which are stored in DenotationsCaches.
+     */
+    std::size_t get_num_bytes() const;
+
     /**
      * Returns a Concept if the description is correct.
      * If description is incorrect, throw an error with human readable information.
@@ -699,6 +892,30 @@ public:
     std::shared_ptr<const Boolean> parse_boolean(
         iterator_type& iter, iterator_type end, const std::string& filename="");
 
+    /**
+     * Parses many descriptions, e.g., a file of generated features, and
+     * groups the elements by type preserving the order within each type.
+     * Subterms are memoised by their text such that repeated subterms are
+     * built once. With num_threads > 1, blocks of descriptions are parsed
+     * into per-thread factories that are merged into this factory afterwards.
+     * Throws the same errors as parse_* for incorrect descriptions.
+     */
+    ElementCollection parse_elements(
+        const std::vector<std::string>& descriptions, int num_threads=1);
+
+    /**
+     * Returns a compact binary representation of the elements that stores
+     * shared subterms once and refers to predicates and constants by name.
+     */
+    std::string serialize(const ElementCollection& elements) const;
+
+    /**
+     * Creates the elements from their binary representation without parsing.
+     * The vocabulary must contain the referenced predicates and constants.
+     * Throws an error if the data is malformed or has a different version.
+     */
+    ElementCollection deserialize(const std::string& data);
+
     std::shared_ptr<const Boolean> make_empty_boolean(const std::shared_ptr<const Concept>& concept_);
     std::shared_ptr<const Boolean> make_empty_boolean(const std::shared_ptr<const Role>& role);
     std::shared_ptr<const Boolean> make_inclusion_boolean(const std::shared_ptr<const Concept>& concept_left, const std::shared_ptr<const Concept>& concept_right);
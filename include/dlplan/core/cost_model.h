@@ -0,0 +1,134 @@
+/// @brief Provides a cost model for the time of evaluating elements
+///        that can be calibrated by measurements.
+
+#ifndef DLPLAN_INCLUDE_DLPLAN_CORE_COST_MODEL_H_
+#define DLPLAN_INCLUDE_DLPLAN_CORE_COST_MODEL_H_
+
+#include <array>
+#include <string>
+#include <vector>
+
+
+namespace dlplan::core {
+class State;
+
+/// @brief Identifies the operator of an element, where operators over
+///        concepts and roles are distinguished.
+enum class ElementKind {
+    EMPTY_BOOLEAN_CONCEPT,
+    EMPTY_BOOLEAN_ROLE,
+    INCLUSION_BOOLEAN_CONCEPT,
+    INCLUSION_BOOLEAN_ROLE,
+    NULLARY_BOOLEAN,
+    ALL_CONCEPT,
+    AND_CONCEPT,
+    BOT_CONCEPT,
+    DIFF_CONCEPT,
+    EQUAL_CONCEPT,
+    NOT_CONCEPT,
+    ONE_OF_CONCEPT,
+    OR_CONCEPT,
+    PRIMITIVE_CONCEPT,
+    PROJECTION_CONCEPT,
+    SOME_CONCEPT,
+    SUBSET_CONCEPT,
+    TOP_CONCEPT,
+    CONCEPT_DISTANCE_NUMERICAL,
+    COUNT_NUMERICAL_CONCEPT,
+    COUNT_NUMERICAL_ROLE,
+    ROLE_DISTANCE_NUMERICAL,
+    SUM_CONCEPT_DISTANCE_NUMERICAL,
+    SUM_ROLE_DISTANCE_NUMERICAL,
+    AND_ROLE,
+    COMPOSE_ROLE,
+    DIFF_ROLE,
+    IDENTITY_ROLE,
+    INVERSE_ROLE,
+    NOT_ROLE,
+    OR_ROLE,
+    PRIMITIVE_ROLE,
+    RESTRICT_ROLE,
+    TIL_C_ROLE,
+    TOP_ROLE,
+    TRANSITIVE_CLOSURE_ROLE,
+    TRANSITIVE_REFLEXIVE_CLOSURE_ROLE,
+};
+const int NUM_ELEMENT_KINDS = static_cast<int>(ElementKind::TRANSITIVE_REFLEXIVE_CLOSURE_ROLE) + 1;
+
+/// @brief Returns the name of the kind, e.g., "c_and" or "n_count_role".
+extern const std::string& get_element_kind_name(ElementKind kind);
+
+
+/// @brief Represents the cost of a single operator excluding its children
+///        as function of the number of objects n and the density d of
+///        the denotations of its children:
+///        constant + linear * n^degree + density * n^degree * d
+struct OperatorCost {
+    int degree;
+    double constant;
+    double linear;
+    double density;
+
+    double compute_cost(int num_objects, double denotation_density) const;
+};
+
+
+/// @brief Estimates the time of evaluating elements with caches.
+///
+/// The default model only reflects the asymptotic complexity of each
+/// operator. calibrate_cost_model replaces it by a model fitted to
+/// measured evaluation times in nanoseconds.
+class CostModel {
+private:
+    std::array<OperatorCost, NUM_ELEMENT_KINDS> m_operator_costs;
+    int m_reference_num_objects;
+    double m_reference_density;
+
+public:
+    CostModel();
+    CostModel(const std::array<OperatorCost, NUM_ELEMENT_KINDS>& operator_costs, int reference_num_objects, double reference_density);
+
+    /// @brief Returns the cost of the operator on an instance with the given
+    ///        number of objects and denotations of the given density.
+    double compute_cost(ElementKind kind, int num_objects, double denotation_density) const;
+
+    /// @brief Returns the cost of the operator at the reference number of
+    ///        objects and density rounded to a positive integer.
+    int compute_score(ElementKind kind) const;
+
+    const OperatorCost& get_operator_cost(ElementKind kind) const;
+    int get_reference_num_objects() const;
+    double get_reference_density() const;
+
+    /// @brief Returns a textual representation with one operator per line
+    ///        that can be parsed with CostModel::parse.
+    std::string str() const;
+
+    /// @brief Parses the textual representation of a cost model.
+    static CostModel parse(const std::string& description);
+};
+
+
+/// @brief Returns the cost model that is used for scoring elements.
+extern const CostModel& get_cost_model();
+
+/// @brief Sets the cost model that is used for scoring elements.
+///
+/// Containers that are ordered by scores, e.g., the rules of a policy,
+/// do not reorder themselves. Hence, the model should be set before
+/// constructing policies. Must not be called concurrently with scoring.
+extern void set_cost_model(const CostModel& cost_model);
+
+/// @brief Measures the time of evaluating each kind of element on the
+///        states and fits the costs of the operators by least squares.
+///
+/// All states must share the vocabulary. Instances with different numbers
+/// of objects yield better estimates of the dependency on n. The reference
+/// number of objects and density are the medians over the states.
+/// @param num_repetitions The minimum over this number of measurements
+///        is taken for each state and operator to reduce noise.
+extern CostModel calibrate_cost_model(const std::vector<State>& states, int num_repetitions=5);
+
+}
+
+#endif
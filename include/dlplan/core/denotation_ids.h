@@ -0,0 +1,176 @@
+/// @brief Provides compact vectors of denotations that refer to the
+///        denotations owned by the caches by 32-bit ids.
+
+#ifndef DLPLAN_INCLUDE_DLPLAN_CORE_DENOTATION_IDS_H_
+#define DLPLAN_INCLUDE_DLPLAN_CORE_DENOTATION_IDS_H_
+
+#include "../utils/cache.h"
+#include "../utils/hash.h"
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+
+namespace dlplan::core {
+
+/// @brief Encapsulates the denotations of an element on a sequence of states
+///        as 32-bit ids into the pool of the caches that owns them.
+///
+/// Accessing the denotations does not change reference counts and hence the
+/// denotations are only valid as long as the caches exist. Use a
+/// DenotationsView to keep them alive.
+template<typename T>
+class DenotationIds {
+private:
+    const SharedObjectPool<T>* m_pool;
+    std::vector<uint32_t> m_ids;
+
+public:
+    /// @brief Iterates over the denotations in the order of the states.
+    class const_iterator {
+    private:
+        const DenotationIds* m_ids;
+        std::size_t m_pos;
+
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = const T*;
+        using difference_type = std::ptrdiff_t;
+        using pointer = void;
+        using reference = const T*;
+
+        const_iterator(const DenotationIds* ids, std::size_t pos) : m_ids(ids), m_pos(pos) { }
+
+        const T* operator*() const {
+            return (*m_ids)[m_pos];
+        }
+
+        const_iterator& operator++() {
+            ++m_pos;
+            return *this;
+        }
+
+        const_iterator operator++(int) {
+            const_iterator prev = *this;
+            ++m_pos;
+            return prev;
+        }
+
+        bool operator==(const const_iterator& other) const {
+            return m_ids == other.m_ids && m_pos == other.m_pos;
+        }
+
+        bool operator!=(const const_iterator& other) const {
+            return !(*this == other);
+        }
+    };
+
+    DenotationIds() : m_pool(nullptr) { }
+
+    explicit DenotationIds(const std::shared_ptr<const SharedObjectPool<T>>& pool)
+        : m_pool(pool.get()) { }
+
+    bool operator==(const DenotationIds& other) const {
+        return m_pool == other.m_pool && m_ids == other.m_ids;
+    }
+
+    bool operator!=(const DenotationIds& other) const {
+        return !(*this == other);
+    }
+
+    std::size_t hash() const {
+        return hash_vector(m_ids);
+    }
+
+    void reserve(std::size_t size) {
+        m_ids.reserve(size);
+    }
+
+    void push_back(uint32_t id) {
+        assert(m_pool && m_pool->get(id));
+        m_ids.push_back(id);
+    }
+
+    std::size_t size() const {
+        return m_ids.size();
+    }
+
+    bool empty() const {
+        return m_ids.empty();
+    }
+
+    /// @brief Returns the denotation on the i-th state.
+    const T* operator[](std::size_t i) const {
+        return m_pool->get(m_ids[i]).get();
+    }
+
+    const_iterator begin() const {
+        return const_iterator(this, 0);
+    }
+
+    const_iterator end() const {
+        return const_iterator(this, m_ids.size());
+    }
+
+    /// @brief Returns shared ownership of the denotation on the i-th state.
+    std::shared_ptr<const T> get_shared(std::size_t i) const {
+        return m_pool->get(m_ids[i]);
+    }
+
+    uint32_t get_id(std::size_t i) const {
+        return m_ids[i];
+    }
+
+    const std::vector<uint32_t>& get_ids() const {
+        return m_ids;
+    }
+
+    const SharedObjectPool<T>* get_pool() const {
+        return m_pool;
+    }
+
+    /// @brief Returns the number of bytes of the ids.
+    std::size_t get_num_bytes() const {
+        return m_ids.capacity() * sizeof(uint32_t);
+    }
+};
+
+
+/// @brief Gives access to the denotations of an element on a sequence of
+///        states and keeps them alive, also beyond the lifetime of the caches.
+template<typename T>
+class DenotationsView {
+private:
+    std::shared_ptr<const SharedObjectPool<T>> m_pool;
+    std::shared_ptr<const DenotationIds<T>> m_ids;
+
+public:
+    DenotationsView(std::shared_ptr<const SharedObjectPool<T>> pool, std::shared_ptr<const DenotationIds<T>> ids)
+        : m_pool(std::move(pool)), m_ids(std::move(ids)) {
+        if (m_ids->get_pool() != m_pool.get()) {
+            throw std::runtime_error("DenotationsView::DenotationsView - ids refer to a different pool.");
+        }
+    }
+
+    std::size_t size() const {
+        return m_ids->size();
+    }
+
+    /// @brief Returns the denotation on the i-th state.
+    const T& operator[](std::size_t i) const {
+        return *(*m_ids)[i];
+    }
+
+    const DenotationIds<T>& get_ids() const {
+        return *m_ids;
+    }
+};
+
+}
+
+#endif
@@ -42,7 +42,7 @@ private:
     evaluate_impl(const States& states, DenotationsCaches& caches) const override {
         BooleanDenotations denotations;
         auto element_left_denotations = m_element_left->evaluate(states, caches);
-        auto element_right_denotations = m_element_left->evaluate(states, caches);
+        auto element_right_denotations = m_element_right->evaluate(states, caches);
         for (size_t i = 0; i < states.size(); ++i) {
             bool denotation;
             compute_result(
@@ -99,12 +99,24 @@ public:
        out << ")";
     }
 
+    void serialize_impl(ElementSerializer& out) const override {
+        if (std::is_same<T, Concept>::value) {
+            out.write_kind(ElementKind::INCLUSION_BOOLEAN_CONCEPT);
+        } else if (std::is_same<T, Role>::value) {
+            out.write_kind(ElementKind::INCLUSION_BOOLEAN_ROLE);
+        } else {
+            throw std::runtime_error("InclusionBoolean::serialize_impl - unknown template parameter.");
+        }
+        out.write_element(*m_element_left);
+        out.write_element(*m_element_right);
+    }
+
     int compute_evaluate_time_score_impl() const override {
         int score = m_element_left->compute_evaluate_time_score() + m_element_right->compute_evaluate_time_score();
         if (std::is_same<T, Concept>::value) {
-            score += SCORE_LINEAR;
+            score += get_cost_model().compute_score(ElementKind::INCLUSION_BOOLEAN_CONCEPT);
         } else if (std::is_same<T, Role>::value) {
-            score += SCORE_QUADRATIC;
+            score += get_cost_model().compute_score(ElementKind::INCLUSION_BOOLEAN_ROLE);
         } else {
             throw std::runtime_error("Inclusion::compute_evaluate_time_score - unknown template parameter.");
         }
@@ -94,12 +94,23 @@ public:
         out << ")";
     }
 
+    void serialize_impl(ElementSerializer& out) const override {
+        if (std::is_same<T, Concept>::value) {
+            out.write_kind(ElementKind::COUNT_NUMERICAL_CONCEPT);
+        } else if (std::is_same<T, Role>::value) {
+            out.write_kind(ElementKind::COUNT_NUMERICAL_ROLE);
+        } else {
+            throw std::runtime_error("CountNumerical::serialize_impl - unknown template parameter.");
+        }
+        out.write_element(*m_element);
+    }
+
     int compute_evaluate_time_score_impl() const override {
         int score = m_element->compute_evaluate_time_score();
         if (std::is_same<T, Concept>::value) {
-            score += SCORE_LINEAR;
+            score += get_cost_model().compute_score(ElementKind::COUNT_NUMERICAL_CONCEPT);
         } else if (std::is_same<T, Role>::value) {
-            score += SCORE_QUADRATIC;
+            score += get_cost_model().compute_score(ElementKind::COUNT_NUMERICAL_ROLE);
         } else {
             throw std::runtime_error("Inclusion::compute_evaluate_time_score - unknown template parameter.");
         }
@@ -45,6 +45,8 @@ public:
 
     void str_impl(std::stringstream& out) const override;
 
+    void serialize_impl(ElementSerializer& out) const override;
+
     int compute_evaluate_time_score_impl() const override;
 };
 
@@ -1,14 +1,11 @@
 #ifndef DLPLAN_INCLUDE_DLPLAN_CORE_ELEMENTS_UTILS_H_
 #define DLPLAN_INCLUDE_DLPLAN_CORE_ELEMENTS_UTILS_H_
 
+#include "../cost_model.h"
+#include "../serialization.h"
 #include "../../core.h"
 
 
-const int SCORE_CONSTANT = 1;
-const int SCORE_LINEAR = 100;
-const int SCORE_QUADRATIC = SCORE_LINEAR * SCORE_LINEAR;
-const int SCORE_QUBIC = SCORE_LINEAR * SCORE_LINEAR * SCORE_LINEAR;
-
 const int INF = std::numeric_limits<int>::max();
 
 namespace dlplan::core::utils {
@@ -24,6 +21,10 @@ extern Distances compute_multi_source_multi_target_shortest_distances(const Conc
 
 extern PairwiseDistances compute_floyd_warshall(const RoleDenotation& edges);
 
+/// @brief Returns the sorted pairs (a,c) without repetitions with (a,b) in left_pairs
+///        and (b,c) in right_pairs, where both must be sorted by the first element.
+extern PairsOfObjectIndices compute_composition(const PairsOfObjectIndices& left_pairs, const PairsOfObjectIndices& right_pairs, int num_objects);
+
 }
 
 #endif
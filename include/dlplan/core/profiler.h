@@ -0,0 +1,121 @@
+/// @brief Provides an opt-in profiler for the evaluation of elements with caches.
+///
+/// Profiling is compiled out unless the library is built with
+/// -DENABLE_PROFILING=ON, which defines DLPLAN_ENABLE_PROFILING.
+
+#ifndef DLPLAN_INCLUDE_DLPLAN_CORE_PROFILER_H_
+#define DLPLAN_INCLUDE_DLPLAN_CORE_PROFILER_H_
+
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+
+namespace dlplan::core {
+class ConceptDenotation;
+class RoleDenotation;
+
+/// @brief Accumulates the statistics of evaluating a single element
+///        with DenotationsCaches over all threads.
+struct ElementProfile {
+    int element_index;
+    std::string element_description;
+    uint64_t num_calls;
+    uint64_t num_cache_hits;
+    uint64_t num_cache_misses;
+    // Time spent in evaluate including the evaluation of children.
+    uint64_t inclusive_ns;
+    // Time spent in evaluate excluding the evaluation of children.
+    uint64_t exclusive_ns;
+    // Size of the denotations computed on cache misses.
+    uint64_t allocated_bytes;
+};
+using ElementProfiles = std::vector<ElementProfile>;
+
+
+/// @brief Returns true iff the library was compiled with profiling.
+extern bool is_profiling_enabled();
+
+/// @brief Returns the profiles of all evaluated elements sorted by exclusive
+///        time in descending order, i.e., the sum of the exclusive times is
+///        the total time spent in evaluation.
+///
+/// Elements are identified by their index. Hence, elements from different
+/// factories should not be profiled at the same time.
+/// Returns an empty report if the library was compiled without profiling.
+extern ElementProfiles get_element_profiles();
+
+/// @brief Discards all profiles collected so far.
+extern void reset_element_profiles();
+
+/// @brief Writes the profiles as a table with one element per line.
+extern std::string to_string(const ElementProfiles& profiles);
+
+
+/// @brief Returns the number of bytes owned by a denotation.
+extern uint64_t compute_allocated_bytes(const ConceptDenotation& denotation);
+extern uint64_t compute_allocated_bytes(const RoleDenotation& denotation);
+extern uint64_t compute_allocated_bytes(const std::vector<std::shared_ptr<const ConceptDenotation>>& denotations);
+extern uint64_t compute_allocated_bytes(const std::vector<std::shared_ptr<const RoleDenotation>>& denotations);
+extern uint64_t compute_allocated_bytes(const std::vector<bool>& denotations);
+extern uint64_t compute_allocated_bytes(const std::vector<int>& denotations);
+inline uint64_t compute_allocated_bytes(bool) { return sizeof(bool); }
+inline uint64_t compute_allocated_bytes(int) { return sizeof(int); }
+
+
+/// @brief Measures a single call to evaluate of an element in its lifetime
+///        and adds it to the profile of the element in the current thread.
+///
+/// Nested scopes on the same thread are the evaluation of children and
+/// their time is subtracted from the exclusive time of the parent.
+class ElementProfileScope {
+private:
+    int m_element_index;
+    const void* m_element;
+    std::string (*m_describe)(const void*);
+    std::chrono::steady_clock::time_point m_start;
+    bool m_is_cache_hit;
+    uint64_t m_allocated_bytes;
+
+public:
+    template<typename E>
+    explicit ElementProfileScope(const E& element)
+        : m_element_index(element.get_index()),
+          m_element(&element),
+          m_describe([](const void* element) { return static_cast<const E*>(element)->str(); }),
+          m_is_cache_hit(false),
+          m_allocated_bytes(0) {
+        start();
+    }
+    ~ElementProfileScope();
+    ElementProfileScope(const ElementProfileScope& other) = delete;
+    ElementProfileScope& operator=(const ElementProfileScope& other) = delete;
+
+    void start();
+
+    void record_cache_hit() {
+        m_is_cache_hit = true;
+    }
+
+    template<typename Denotation>
+    void record_cache_miss(const Denotation& denotation) {
+        m_allocated_bytes += compute_allocated_bytes(denotation);
+    }
+};
+
+}
+
+
+#ifdef DLPLAN_ENABLE_PROFILING
+#define DLPLAN_PROFILE_ELEMENT(scope, element) ::dlplan::core::ElementProfileScope scope(element)
+#define DLPLAN_PROFILE_CACHE_HIT(scope) scope.record_cache_hit()
+#define DLPLAN_PROFILE_CACHE_MISS(scope, denotation) scope.record_cache_miss(denotation)
+#else
+#define DLPLAN_PROFILE_ELEMENT(scope, element) ((void)0)
+#define DLPLAN_PROFILE_CACHE_HIT(scope) ((void)0)
+#define DLPLAN_PROFILE_CACHE_MISS(scope, denotation) ((void)0)
+#endif
+
+#endif
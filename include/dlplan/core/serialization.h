@@ -0,0 +1,83 @@
+/// @brief Provides a compact binary format for elements that stores shared
+///        subterms once and refers to the vocabulary by name.
+///
+/// The format is
+///   magic "DLPE", version (uint32, little endian),
+///   predicates (name, arity, is_static), constants (name),
+///   nodes in topological order (kind, arguments),
+///   roots of the Booleans, numericals, concepts, and roles.
+/// Counts, node references, and integers are written as varints.
+
+#ifndef DLPLAN_INCLUDE_DLPLAN_CORE_SERIALIZATION_H_
+#define DLPLAN_INCLUDE_DLPLAN_CORE_SERIALIZATION_H_
+
+#include "cost_model.h"
+#include "../core.h"
+
+#include <array>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+
+namespace dlplan::core {
+
+/// @brief The version of the binary format. It must be increased whenever
+///        the layout or the numbering of ElementKind changes.
+const uint32_t ELEMENT_SERIALIZATION_VERSION = 1;
+
+/// @brief Writes elements into the binary format.
+///
+/// Each element writes its kind followed by its arguments in serialize_impl.
+/// Syntactically equal elements, which are the same objects within a factory,
+/// are written once. Nodes are ordered by element index, which places children
+/// before their parents and lets a fresh factory reproduce the order of the
+/// operands of commutative operators.
+class ElementSerializer {
+private:
+    struct Field {
+        bool is_node;
+        uint64_t value;
+    };
+    struct NodeRecord {
+        ElementIndex element_index;
+        std::vector<Field> fields;
+    };
+
+    std::vector<NodeRecord> m_nodes;
+    std::unordered_map<const void*, uint32_t> m_node_ids;
+    // Fields of the elements that are currently written, innermost last.
+    std::vector<std::vector<Field>> m_records;
+
+    std::vector<Predicate> m_predicates;
+    std::unordered_map<std::string, uint32_t> m_predicate_ids;
+    std::vector<std::string> m_constants;
+    std::unordered_map<std::string, uint32_t> m_constant_ids;
+
+    // Node ids of the Booleans, numericals, concepts, and roles.
+    std::array<std::vector<uint32_t>, 4> m_roots;
+
+    template<typename E>
+    uint32_t write_node(const E& element);
+
+public:
+    void write_kind(ElementKind kind);
+    void write_element(const Concept& concept_);
+    void write_element(const Role& role);
+    void write_predicate(const Predicate& predicate);
+    void write_constant(const Constant& constant);
+    void write_integer(int value);
+
+    void add_root(const Boolean& boolean);
+    void add_root(const Numerical& numerical);
+    void add_root(const Concept& concept_);
+    void add_root(const Role& role);
+
+    /// @brief Returns the binary representation of the roots added so far.
+    std::string get_data() const;
+};
+
+}
+
+#endif
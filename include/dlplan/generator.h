@@ -9,18 +9,14 @@
 #include <tuple>
 
 #include "core.h"
+#include "utils/cancellation_token.h"
 #include "utils/pimpl.h"
 
 
 namespace dlplan::generator {
 class FeatureGeneratorImpl;
 using States = std::vector<core::State>;
-using GeneratedFeatures = std::tuple<
-    std::vector<std::shared_ptr<const core::Boolean>>,
-    std::vector<std::shared_ptr<const core::Numerical>>,
-    std::vector<std::shared_ptr<const core::Concept>>,
-    std::vector<std::shared_ptr<const core::Role>>
->;
+using GeneratedFeatures = core::ElementCollection;
 
 /// @brief Provides functionality for automatically generating state features
 ///        that are distinguishable on a finite set of states.
@@ -36,6 +32,11 @@ public:
     FeatureGenerator& operator=(FeatureGenerator&& other);
     ~FeatureGenerator();
 
+    /**
+     * Throws utils::OperationCancelled if the cancellation_token is cancelled
+     * when generation reaches the next rule or complexity layer.
+     * Without cancellation_token, SIGINT terminates the process during generation.
+     */
     GeneratedFeatures generate(
         core::SyntacticElementFactory& factory,
         const core::States& states,
@@ -45,7 +46,16 @@ public:
         int count_numerical_complexity_limit=9,
         int distance_numerical_complexity_limit=9,
         int time_limit=3600,
-        int feature_limit=10000);
+        int feature_limit=10000,
+        std::shared_ptr<const utils::CancellationToken> cancellation_token=nullptr);
+
+    /**
+     * Stops generation after the complexity layer during which the
+     * denotations, elements, and intermediate results reach num_bytes
+     * bytes. The features of the completed layers are returned.
+     * By default, memory is unlimited.
+     */
+    void set_memory_limit(std::size_t num_bytes);
 
     void set_generate_empty_boolean(bool enable);
     void set_generate_inclusion_boolean(bool enable);
@@ -122,7 +132,8 @@ extern GeneratedFeatures generate_features(
     bool generate_til_c_role=true,
     bool generate_top_role=false,
     bool generate_transitive_closure_role=true,
-    bool generate_transitive_reflexive_closure_role=false);
+    bool generate_transitive_reflexive_closure_role=false,
+    std::shared_ptr<const utils::CancellationToken> cancellation_token=nullptr);
 }
 
 #endif
@@ -215,10 +215,15 @@ private:
     std::vector<state_space::StateIndices> m_state_indices_by_distance;
 
 public:
+    /// @brief Constructs the tuple graph rooted at the given state.
+    ///
+    /// Throws utils::OperationCancelled if the cancellation_token is cancelled
+    /// when construction reaches the next layer.
     TupleGraph(
         std::shared_ptr<const NoveltyBase> novelty_base,
         std::shared_ptr<const state_space::StateSpace> state_space,
-        state_space::StateIndex root_state_index);
+        state_space::StateIndex root_state_index,
+        std::shared_ptr<const utils::CancellationToken> cancellation_token=nullptr);
     TupleGraph(const TupleGraph &other);
     TupleGraph &operator=(const TupleGraph &other);
     TupleGraph(TupleGraph &&other);
@@ -3,6 +3,10 @@
 #ifndef DLPLAN_INCLUDE_DLPLAN_POLICY_H_
 #define DLPLAN_INCLUDE_DLPLAN_POLICY_H_
 
+#include <cstdint>
+#include <functional>
+#include <span>
+#include <unordered_map>
 #include <unordered_set>
 #include <memory>
 #include <set>
@@ -12,6 +16,7 @@
 #include "common/base.h"
 #include "common/parsers/config.hpp"
 #include "core.h"
+#include "state_space.h"
 #include "utils/pimpl.h"
 
 
@@ -23,6 +28,7 @@ class BaseEffect;
 class Rule;
 class Policy;
 class PolicyFactory;
+class PolicyDecisionDiagram;
 class BaseConditionVisitor;
 class BaseEffectVisitor;
 }
@@ -208,9 +214,28 @@ private:
     Numericals m_numericals;
     Concepts m_concepts;
     Rules m_rules;
+    /* Derived information for shared evaluation */
+    // distinct conditions in ascending order of their score and distinct effects of all rules
+    std::vector<std::shared_ptr<const BaseCondition>> m_condition_vector;
+    std::vector<std::shared_ptr<const BaseEffect>> m_effect_vector;
+    // rules of each condition as indices into m_rule_vector
+    std::vector<std::vector<int>> m_condition_rule_indices;
+    // rules in evaluation order with their effects as indices into m_effect_vector
+    std::vector<std::shared_ptr<const Rule>> m_rule_vector;
+    std::vector<std::vector<int>> m_rule_effect_indices;
+    std::unordered_map<const Rule*, int> m_rule_to_index;
+    // features of all effects with int values, i.e., booleans as 0/1 and concepts by their size
+    std::vector<std::function<int(const core::State&, core::DenotationsCaches*)>> m_feature_evaluators;
+    // effects as predicates over the source and target value of a feature
+    std::vector<int> m_effect_feature_indices;
+    std::vector<std::function<bool(int, int)>> m_effect_predicates;
 
     Policy(int identifier, const Rules& rules);
 
+    std::vector<int> compute_matching_rule_indices(const core::State& source_state, core::DenotationsCaches* caches) const;
+    std::shared_ptr<const Rule> find_rule(const core::State& source_state, const core::State& target_state, const std::vector<int>& rule_indices, core::DenotationsCaches* caches) const;
+    std::vector<std::pair<int, std::shared_ptr<const Rule>>> compute_compatible_successors(const core::State& source_state, std::span<const core::State> target_states, core::DenotationsCaches* caches, int num_threads) const;
+
     template<typename... Ts>
     friend class dlplan::ReferenceCountedObjectFactory;
 
@@ -228,7 +253,14 @@ public:
 
 
     /**
-     * Approach 1: naive approach to evaluate (s,s')
+     * Distinct conditions are evaluated at most once per source state in
+     * ascending order of their score, i.e., cheapest first. Conditions of
+     * rules that already have a false condition are skipped. Each distinct
+     * effect is evaluated at most once per pair of states.
+     */
+
+    /**
+     * Approach 1: evaluate (s,s')
      */
     std::shared_ptr<const Rule> evaluate(const core::State& source_state, const core::State& target_state) const;
     std::shared_ptr<const Rule> evaluate(const core::State& source_state, const core::State& target_state, core::DenotationsCaches& caches) const;
@@ -241,6 +273,16 @@ public:
     std::shared_ptr<const Rule> evaluate_effects(const core::State& source_state, const core::State& target_state, const std::vector<std::shared_ptr<const Rule>>& rules) const;
     std::shared_ptr<const Rule> evaluate_effects(const core::State& source_state, const core::State& target_state, const std::vector<std::shared_ptr<const Rule>>& rules, core::DenotationsCaches& caches) const;
 
+    /**
+     * Approach 3: batched approach for evaluating all successors of s, i.e., (s,s1), (s,s2), ..., (s,sn).
+     * Features of the source state are evaluated once and features of the successors in a batch
+     * on num_threads threads. Returns the indices of the successors that are compatible
+     * with some rule together with the first such rule. Threads share the given caches
+     * if they have more than one shard and use their own caches otherwise.
+     */
+    std::vector<std::pair<int, std::shared_ptr<const Rule>>> evaluate_successors(const core::State& source_state, std::span<const core::State> target_states, int num_threads=1) const;
+    std::vector<std::pair<int, std::shared_ptr<const Rule>>> evaluate_successors(const core::State& source_state, std::span<const core::State> target_states, core::DenotationsCaches& caches, int num_threads=1) const;
+
     const Booleans& get_booleans() const;
     const Numericals& get_numericals() const;
     const Concepts& get_concepts() const;
@@ -323,25 +365,133 @@ public:
 };
 
 
+/// @brief Implements a reduced ordered decision diagram over the condition and
+///        effect predicates of a policy that returns the same rule as
+///        Policy::evaluate.
+///
+/// Predicates are ordered by the evaluate time score of their features,
+/// cheapest first, such that evaluating a pair of states tests each predicate
+/// and evaluates each feature at most once and stops as soon as the rule
+/// is determined.
+class PolicyDecisionDiagram {
+private:
+    /// @brief Inner nodes test a predicate and terminals have predicate -1
+    ///        and store the rule index or -1 in high.
+    struct Node {
+        int predicate;
+        int high;
+        int low;
+    };
+
+    std::shared_ptr<const Policy> m_policy;
+    std::vector<std::shared_ptr<const Rule>> m_rules;
+    std::vector<std::function<int(const core::State&, core::DenotationsCaches*)>> m_feature_evaluators;
+    // predicates in diagram order, either a condition or an effect on a feature
+    std::vector<int> m_predicate_feature_indices;
+    std::vector<std::function<bool(int)>> m_condition_predicates;
+    std::vector<std::function<bool(int, int)>> m_effect_predicates;
+    std::vector<Node> m_nodes;
+    int m_root;
+
+    std::shared_ptr<const Rule> evaluate(const core::State& source_state, const core::State& target_state, core::DenotationsCaches* caches) const;
+
+public:
+    explicit PolicyDecisionDiagram(std::shared_ptr<const Policy> policy);
+    PolicyDecisionDiagram(const PolicyDecisionDiagram& other);
+    PolicyDecisionDiagram& operator=(const PolicyDecisionDiagram& other);
+    PolicyDecisionDiagram(PolicyDecisionDiagram&& other);
+    PolicyDecisionDiagram& operator=(PolicyDecisionDiagram&& other);
+    ~PolicyDecisionDiagram();
+
+    std::shared_ptr<const Rule> evaluate(const core::State& source_state, const core::State& target_state) const;
+    std::shared_ptr<const Rule> evaluate(const core::State& source_state, const core::State& target_state, core::DenotationsCaches& caches) const;
+
+    /**
+     * Number of nodes including the terminals.
+     */
+    int get_num_nodes() const;
+    int get_num_predicates() const;
+    std::shared_ptr<const Policy> get_policy() const;
+};
+
+
 /// @brief Provides functionality for the syntactic and empirical minimization
 ///        of policies.
 class PolicyMinimizer {
+private:
+    int m_num_threads;
+
 public:
     PolicyMinimizer();
+    /**
+     * Independent merge and classification candidates are checked on num_threads threads.
+     */
+    explicit PolicyMinimizer(int num_threads);
     PolicyMinimizer(const PolicyMinimizer& other);
     PolicyMinimizer& operator=(const PolicyMinimizer& other);
     PolicyMinimizer(PolicyMinimizer&& other);
     PolicyMinimizer& operator=(PolicyMinimizer&& other);
     ~PolicyMinimizer();
 
+    /**
+     * Throws utils::OperationCancelled if the cancellation_token is cancelled
+     * when minimization reaches the next round of merges or rule candidates.
+     */
     std::shared_ptr<const Policy> minimize(
         const std::shared_ptr<const Policy>& policy,
-        PolicyFactory& policy_factory) const;
+        PolicyFactory& policy_factory,
+        std::shared_ptr<const utils::CancellationToken> cancellation_token=nullptr) const;
     std::shared_ptr<const Policy> minimize(
         const std::shared_ptr<const Policy>& policy,
         const StatePairs& true_state_pairs,
         const StatePairs& false_state_pairs,
-        PolicyFactory& policy_factory) const;
+        PolicyFactory& policy_factory,
+        std::shared_ptr<const utils::CancellationToken> cancellation_token=nullptr) const;
+};
+
+
+/// @brief Encapsulates the result of verifying a policy on a state space.
+///
+/// A state is alive if it is not a goal state and a goal state is reachable from it.
+struct PolicyVerificationResult {
+    int num_alive_states;
+    /// @brief Number of compatible transitions from alive states.
+    int num_compatible_transitions;
+    /// @brief Alive states without a compatible transition.
+    state_space::StateIndices unsolved_state_indices;
+    /// @brief Alive states with a compatible transition into a state that is not alive and no goal.
+    state_space::StateIndices unsafe_state_indices;
+    /// @brief Strongly connected components of alive states that contain a cycle
+    ///        of compatible transitions.
+    std::vector<state_space::StateIndices> cycles;
+
+    /// @brief Returns true iff the policy solves every alive state, i.e.,
+    ///        all compatible transitions eventually lead to a goal state.
+    bool is_sound() const;
+};
+
+
+/// @brief Verifies a policy on all transitions of a state space.
+class PolicyVerifier {
+private:
+    int m_num_threads;
+
+public:
+    PolicyVerifier();
+    explicit PolicyVerifier(int num_threads);
+    PolicyVerifier(const PolicyVerifier& other);
+    PolicyVerifier& operator=(const PolicyVerifier& other);
+    PolicyVerifier(PolicyVerifier&& other);
+    PolicyVerifier& operator=(PolicyVerifier&& other);
+    ~PolicyVerifier();
+
+    /**
+     * Evaluates the features once per state into a table with one column per feature
+     * and the rules on all transitions from alive states on num_threads threads.
+     */
+    PolicyVerificationResult verify(
+        const std::shared_ptr<const Policy>& policy,
+        const std::shared_ptr<const state_space::StateSpace>& state_space) const;
 };
 
 }
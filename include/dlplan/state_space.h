@@ -3,11 +3,15 @@
 #ifndef DLPLAN_INCLUDE_DLPLAN_STATE_SPACE_H_
 #define DLPLAN_INCLUDE_DLPLAN_STATE_SPACE_H_
 
+#include <cstdint>
 #include <functional>
+#include <optional>
+#include <span>
 #include <unordered_map>
 #include <unordered_set>
 
 #include "core.h"
+#include "utils/cancellation_token.h"
 
 
 namespace dlplan::state_space {
@@ -17,23 +21,134 @@ using StateIndicesSet = std::unordered_set<StateIndex>;
 using AdjacencyList = std::unordered_map<StateIndex, StateIndicesSet>;
 using Distance = int;
 using Distances = std::unordered_map<StateIndex, Distance>;
+using DenseDistances = std::vector<Distance>;
 using StateMapping = std::unordered_map<StateIndex, core::State>;
 
 const int UNDEFINED = -1;
 
 
+/// @brief Implements a compressed sparse row (CSR) representation of the
+///        successors of states with state indices 0,...,N-1.
+///
+/// The successors of a state index s are stored contiguously in ascending
+/// order in targets[offsets[s]], ..., targets[offsets[s+1]-1].
+class CompressedAdjacencyList {
+private:
+    std::vector<int> m_offsets;
+    StateIndices m_targets;
+
+public:
+    CompressedAdjacencyList();
+    CompressedAdjacencyList(int num_state_indices, const AdjacencyList& adjacency_list);
+    CompressedAdjacencyList(std::vector<int>&& offsets, StateIndices&& targets);
+    CompressedAdjacencyList(const CompressedAdjacencyList& other);
+    CompressedAdjacencyList& operator=(const CompressedAdjacencyList& other);
+    CompressedAdjacencyList(CompressedAdjacencyList&& other);
+    CompressedAdjacencyList& operator=(CompressedAdjacencyList&& other);
+    ~CompressedAdjacencyList();
+
+    /// @brief Computes the CSR representation with all edges reversed.
+    CompressedAdjacencyList compute_inverse() const;
+
+    /// @brief Converts the CSR representation into a hash-based adjacency list.
+    AdjacencyList to_adjacency_list() const;
+
+    std::span<const StateIndex> get_targets(StateIndex source) const;
+    int get_num_state_indices() const;
+    int get_num_edges() const;
+    const std::vector<int>& get_offsets() const;
+    const StateIndices& get_targets() const;
+};
+
+
+class StatePoolImpl;
+
+
+/// @brief Represents a lightweight handle to a state that was interned
+///        in a StatePool. Handles are compared and hashed in constant time
+///        and remain valid when the pool is moved.
+class StateHandle {
+private:
+    const StatePoolImpl* m_pool;
+    StateIndex m_index;
+
+public:
+    StateHandle(const StatePoolImpl* pool, StateIndex index);
+
+    bool operator==(const StateHandle& other) const;
+    bool operator!=(const StateHandle& other) const;
+    std::size_t hash() const;
+
+    StateIndex get_index() const;
+    bool contains(core::AtomIndex atom_index) const;
+    core::AtomIndices get_atom_indices() const;
+    core::State to_state() const;
+};
+
+
+/// @brief Interns the states of an instance as fixed-width bitsets over its
+///        atoms that are stored contiguously in a single arena.
+///
+/// The number of atoms is fixed when the pool is created. Each state
+/// is identified by its index in order of insertion and inserting the
+/// same set of atoms again returns the same index.
+class StatePool {
+private:
+    // Allocated separately such that handles stay valid when the pool is moved.
+    std::unique_ptr<StatePoolImpl> m_impl;
+
+public:
+    explicit StatePool(std::shared_ptr<core::InstanceInfo> instance_info);
+    StatePool(const StatePool& other) = delete;
+    StatePool& operator=(const StatePool& other) = delete;
+    StatePool(StatePool&& other);
+    StatePool& operator=(StatePool&& other);
+    ~StatePool();
+
+    /// @brief Interns the state with the given atoms.
+    /// @return the handle and whether the state was newly inserted.
+    std::pair<StateHandle, bool> insert(const core::AtomIndices& atom_indices);
+    /// @brief Returns the handle of the state with the given atoms if it exists.
+    std::optional<StateHandle> find(const core::AtomIndices& atom_indices) const;
+
+    bool contains(StateIndex index, core::AtomIndex atom_index) const;
+    std::size_t get_hash(StateIndex index) const;
+    /// @brief Returns the sorted atom indices of the state.
+    core::AtomIndices get_atom_indices(StateIndex index) const;
+    /// @brief Materializes a core::State with the given index.
+    core::State get_state(StateIndex index) const;
+    StateHandle get_handle(StateIndex index) const;
+
+    int size() const;
+    int get_num_atoms() const;
+    /// @brief Returns the number of bytes allocated for states and hash table.
+    std::size_t get_memory_usage() const;
+    std::shared_ptr<core::InstanceInfo> get_instance_info() const;
+};
+
+
 /// @brief Implements a state space in sparse state representation.
+///
+/// States are stored in a vector sorted by state index and transitions
+/// are stored in CSR form over the range of state indices. The hash-based
+/// types StateMapping, AdjacencyList, and Distances are only used as adapters
+/// at the interface.
 class StateSpace {
 private:
     /* Required information. */
     std::shared_ptr<core::InstanceInfo> m_instance_info;
-    StateMapping m_states;
+    core::States m_states;
     StateIndex m_initial_state_index;
-    AdjacencyList m_forward_successor_state_indices;
+    CompressedAdjacencyList m_forward_successors;
     StateIndicesSet m_goal_state_indices;
     /* Derived information */
+    // maps state index to position in m_states or UNDEFINED
+    StateIndices m_state_index_to_position;
+    std::vector<bool> m_is_goal;
     // for backward search
-    AdjacencyList m_backward_successor_state_indices;
+    CompressedAdjacencyList m_backward_successors;
+
+    void initialize();
 
 public:
     StateSpace(
@@ -42,6 +157,16 @@ public:
         StateIndex initial_state_index,
         AdjacencyList&& forward_successor_state_indices,
         StateIndicesSet&& goal_state_indices);
+    /**
+     * States must be sorted by their index and the CSR
+     * must range at least over the state indices 0,...,max index.
+     */
+    StateSpace(
+        std::shared_ptr<core::InstanceInfo>&& instance_info,
+        core::States&& states,
+        StateIndex initial_state_index,
+        CompressedAdjacencyList&& forward_successors,
+        StateIndicesSet&& goal_state_indices);
     StateSpace(const StateSpace& other);
     /**
      * Creates a copy over same InstanceInfo
@@ -57,7 +182,12 @@ public:
 
     /**
      * Run BrFs to compute distances.
+     * The dense variants return a vector indexed by state index
+     * that contains UNDEFINED for unreached states.
+     * With num_threads > 1, a parallel direction-optimizing BrFs is used.
      */
+    DenseDistances compute_dense_distances(const StateIndices& state_indices, bool forward, bool stop_if_goal, int num_threads=1) const;
+    DenseDistances compute_dense_goal_distances(int num_threads=1) const;
     Distances compute_distances(const StateIndicesSet& state_indices, bool forward, bool stop_if_goal) const;
     Distances compute_goal_distances() const;
 
@@ -69,6 +199,7 @@ public:
     void for_each_backward_successor_state_index(std::function<void(int)>&& function, StateIndex state) const;
 
     bool is_goal(StateIndex state) const;
+    bool has_state(StateIndex state) const;
 
     /**
      * Creates a string representations
@@ -82,11 +213,20 @@ public:
     void set_initial_state_index(StateIndex initial_state);
     void set_goal_state_indices(const StateIndicesSet& goal_states);
     std::shared_ptr<core::InstanceInfo> get_instance_info() const;
-    const StateMapping& get_states() const;
+    const core::State& get_state(StateIndex state) const;
+    const core::States& get_state_vector() const;
     StateIndex get_initial_state_index() const;
-    const AdjacencyList& get_forward_successor_state_indices() const;
-    const AdjacencyList& get_backward_successor_state_indices() const;
+    const CompressedAdjacencyList& get_forward_successors() const;
+    const CompressedAdjacencyList& get_backward_successors() const;
     const StateIndicesSet& get_goal_state_indices() const;
+    int get_num_state_indices() const;
+
+    /**
+     * Adapters that materialize hash-based representations.
+     */
+    StateMapping get_states() const;
+    AdjacencyList get_forward_successor_state_indices() const;
+    AdjacencyList get_backward_successor_state_indices() const;
 };
 
 
@@ -111,6 +251,8 @@ struct GeneratorResult {
 /// @param vocabulary_info
 /// @param index
 /// @param max_time
+/// @param max_num_states
+/// @param cancellation_token is checked before and after running the generator process.
 /// @return
 extern GeneratorResult generate_state_space(
     const std::string& domain_file,
@@ -118,8 +260,72 @@ extern GeneratorResult generate_state_space(
     std::shared_ptr<core::VocabularyInfo> vocabulary_info=nullptr,
     core::InstanceIndex index=-1,
     int max_time=std::numeric_limits<int>::max()-1,
-    int max_num_states=std::numeric_limits<int>::max()-1);
+    int max_num_states=std::numeric_limits<int>::max()-1,
+    std::shared_ptr<const utils::CancellationToken> cancellation_token=nullptr);
+
+
+/// @brief Represents a grounded STRIPS action over the atoms of an instance.
+///
+/// Applying the action to a state first removes the delete effect and
+/// then adds the add effect.
+struct GroundAction {
+    std::string name;
+    core::AtomIndices precondition;
+    core::AtomIndices add_effect;
+    core::AtomIndices delete_effect;
+};
+using GroundActions = std::vector<GroundAction>;
+
+
+/// @brief Generates the reachable state space of a grounded STRIPS task
+///        in process with a breadth-first search that interns states
+///        by their atom indices.
+/// @param instance_info the instance whose atoms are referenced by index.
+/// @param initial_atom_indices
+/// @param actions
+/// @param goal_atom_indices
+/// @param max_time time budget in seconds.
+/// @param max_num_states budget on the number of generated states.
+/// @param cancellation_token is checked periodically during the search.
+/// @return INCOMPLETE and no state space if a budget was exceeded.
+extern GeneratorResult generate_grounded_state_space(
+    std::shared_ptr<core::InstanceInfo> instance_info,
+    const core::AtomIndices& initial_atom_indices,
+    const GroundActions& actions,
+    const core::AtomIndices& goal_atom_indices,
+    int max_time=std::numeric_limits<int>::max()-1,
+    int max_num_states=std::numeric_limits<int>::max()-1,
+    std::shared_ptr<const utils::CancellationToken> cancellation_token=nullptr);
+
+
+/// @brief Writes a state space into a versioned binary file that stores
+///        the vocabulary, the atoms, the states, and the transitions.
+/// @param state_space
+/// @param filename
+extern void write_binary_state_space(
+    const StateSpace& state_space,
+    const std::string& filename);
+
+
+/// @brief Reads a state space from a binary file written by
+///        write_binary_state_space. The file is memory mapped and
+///        no atom names are parsed.
+/// @param filename
+/// @param vocabulary_info if given, predicates are matched by name.
+/// @param index
+/// @return
+extern std::shared_ptr<StateSpace> read_binary_state_space(
+    const std::string& filename,
+    std::shared_ptr<core::VocabularyInfo> vocabulary_info=nullptr,
+    core::InstanceIndex index=-1);
+
+}
 
+namespace std {
+    template<>
+    struct hash<dlplan::state_space::StateHandle> {
+        std::size_t operator()(const dlplan::state_space::StateHandle& handle) const;
+    };
 }
 
 #endif
@@ -18,6 +18,9 @@
 #ifndef DLPLAN_INCLUDE_DLPLAN_UTILS_UNIQUE_FACTORY_HPP_
 #define DLPLAN_INCLUDE_DLPLAN_UTILS_UNIQUE_FACTORY_HPP_
 
+#include <array>
+#include <atomic>
+#include <bit>
 #include <utility>
 #include <unordered_map>
 #include <unordered_set>
@@ -27,65 +30,641 @@
 #include <tuple>
 #include <vector>
 #include <cassert>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
 
 
 namespace dlplan {
+/// @brief Returns the number of bytes owned by an object including its
+///        heap storage. Types with heap storage specialize this template.
+template<typename T>
+struct SharedObjectSize {
+    std::size_t operator()(const T&) const {
+        return sizeof(T);
+    }
+};
+
+
+/// @brief Decides whether entries with a key are never evicted from a
+///        SharedObjectCache. Key types with such entries specialize this template.
+template<typename Key>
+struct SharedObjectPinned {
+    bool operator()(const Key&) const {
+        return false;
+    }
+};
+
+
+/// @brief Counts the lookups and evictions of a SharedObjectCache.
+struct SharedObjectCacheStatistics {
+    std::size_t num_hits = 0;
+    std::size_t num_misses = 0;
+    std::size_t num_evictions = 0;
+
+    /// @brief Returns the fraction of lookups that were hits, or 0 without lookups.
+    double get_hit_rate() const {
+        const std::size_t num_lookups = num_hits + num_misses;
+        return num_lookups == 0 ? 0.0 : static_cast<double>(num_hits) / num_lookups;
+    }
+};
+
+
+/// @brief Returns the number of bits to address the given number of shards
+///        rounded up to a power of two.
+inline int compute_num_shard_bits(int num_shards) {
+    if (num_shards < 1) {
+        throw std::runtime_error("compute_num_shard_bits - number of shards must be positive.");
+    }
+    return std::bit_width(static_cast<unsigned>(num_shards - 1));
+}
+
+/// @brief Returns the shard of a hash value using its high bits
+///        because the low bits select the buckets within a shard.
+inline uint32_t compute_shard_index(std::size_t hash, int num_shard_bits) {
+    if (num_shard_bits == 0) return 0;
+    return static_cast<uint32_t>((static_cast<uint64_t>(hash) * 0x9E3779B97F4A7C15ull) >> (64 - num_shard_bits));
+}
+
+/// @brief A mutex that only locks if it is enabled, such that containers
+///        that are used by a single thread avoid the cost of locking.
+class OptionalMutex {
+private:
+    std::mutex m_mutex;
+    bool m_enabled = true;
+
+public:
+    void set_enabled(bool enabled) {
+        m_enabled = enabled;
+    }
+
+    void lock() {
+        if (m_enabled) m_mutex.lock();
+    }
+
+    void unlock() {
+        if (m_enabled) m_mutex.unlock();
+    }
+};
+
+
+/// @brief Stores unique objects at stable addresses and identifies them
+///        by 32-bit ids.
+///
+/// Objects are either pinned, in which case their ids remain valid as long
+/// as the pool exists, or reference counted by the owner of the pool, in
+/// which case they are erased once they are no longer referenced. Ids of
+/// erased objects are reused.
+///
+/// The pool is thread-safe if it has more than one shard. Objects are
+/// partitioned into shards by their hash and each shard has its own lock.
+/// A pool with a single shard is not locked and must only be used by one
+/// thread at a time. Objects are accessed without locking, which is safe
+/// for pinned and referenced objects.
+template<typename T>
+class SharedObjectPool {
+private:
+    struct Slot {
+        std::shared_ptr<const T> object;
+        std::size_t hash = 0;
+        uint32_t num_references = 0;
+        bool pinned = false;
+    };
+
+    /// @brief Stores slots in chunks of geometrically growing size such
+    ///        that slots never move while others are added.
+    class SlotStorage {
+    private:
+        static constexpr std::size_t first_chunk_size = 64;
+
+        std::array<std::unique_ptr<Slot[]>, 32> m_chunks;
+        std::size_t m_size = 0;
+        std::size_t m_num_allocated = 0;
+
+        static std::pair<std::size_t, std::size_t> locate(std::size_t index) {
+            const std::size_t chunk = std::bit_width(index / first_chunk_size + 1) - 1;
+            return std::make_pair(chunk, index - first_chunk_size * ((std::size_t(1) << chunk) - 1));
+        }
+
+    public:
+        Slot& operator[](std::size_t index) {
+            const auto [chunk, offset] = locate(index);
+            return m_chunks[chunk][offset];
+        }
+
+        const Slot& operator[](std::size_t index) const {
+            const auto [chunk, offset] = locate(index);
+            return m_chunks[chunk][offset];
+        }
+
+        void push_back(Slot&& slot) {
+            const auto [chunk, offset] = locate(m_size);
+            if (!m_chunks[chunk]) {
+                m_chunks[chunk] = std::make_unique<Slot[]>(first_chunk_size << chunk);
+                m_num_allocated += first_chunk_size << chunk;
+            }
+            m_chunks[chunk][offset] = std::move(slot);
+            ++m_size;
+        }
+
+        void pop_back() {
+            --m_size;
+            (*this)[m_size] = Slot();
+        }
+
+        std::size_t size() const {
+            return m_size;
+        }
+
+        std::size_t get_num_bytes() const {
+            return m_num_allocated * sizeof(Slot);
+        }
+    };
+
+    struct Shard;
+
+    /// @brief Hashing of the object with the local id.
+    struct IdHash {
+        const Shard* shard;
+        std::size_t operator()(uint32_t local_id) const {
+            return shard->slots[local_id].hash;
+        }
+    };
+
+    /// @brief Equality comparison of the objects with the local ids.
+    struct IdEqual {
+        const Shard* shard;
+        bool operator()(uint32_t left, uint32_t right) const {
+            return *shard->slots[left].object == *shard->slots[right].object;
+        }
+    };
+
+    struct Shard {
+        OptionalMutex mutex;
+        SlotStorage slots;
+        std::vector<uint32_t> free_ids;
+        std::unordered_set<uint32_t, IdHash, IdEqual> unique;
+        std::size_t num_container_bytes = 0;
+
+        Shard() : unique(0, IdHash{this}, IdEqual{this}) { }
+    };
+
+    int m_num_shard_bits;
+    uint32_t m_shard_mask;
+    std::unique_ptr<Shard[]> m_shards;
+    std::atomic<std::size_t> m_num_container_bytes;
+
+    /// @brief Updates the number of bytes after the shard was modified.
+    void update_container_bytes(Shard& shard) {
+        // Nodes with next pointer, id and cached hash value.
+        const std::size_t num_bytes = shard.slots.get_num_bytes()
+            + shard.free_ids.capacity() * sizeof(uint32_t)
+            + shard.unique.size() * (sizeof(void*) + sizeof(uint32_t) + sizeof(std::size_t))
+            + shard.unique.bucket_count() * sizeof(void*);
+        m_num_container_bytes += num_bytes;
+        m_num_container_bytes -= shard.num_container_bytes;
+        shard.num_container_bytes = num_bytes;
+    }
+
+public:
+    explicit SharedObjectPool(int num_shards = 1)
+        : m_num_shard_bits(compute_num_shard_bits(num_shards)),
+          m_shard_mask((uint32_t(1) << m_num_shard_bits) - 1),
+          m_shards(std::make_unique<Shard[]>(std::size_t(1) << m_num_shard_bits)),
+          m_num_container_bytes(0) {
+        for (std::size_t i = 0; i < (std::size_t(1) << m_num_shard_bits); ++i) {
+            m_shards[i].mutex.set_enabled(m_num_shard_bits > 0);
+            update_container_bytes(m_shards[i]);
+        }
+    }
+    // The hash sets refer to the shards.
+    SharedObjectPool(const SharedObjectPool& other) = delete;
+    SharedObjectPool& operator=(const SharedObjectPool& other) = delete;
+
+    /// @brief Inserts the object if there is no equal object.
+    /// @param pinned Pins the unique object if true, otherwise adds a reference to it.
+    /// @return The id of the unique object and true iff it was inserted.
+    std::pair<uint32_t, bool> insert(T&& object, bool pinned) {
+        const std::size_t hash = std::hash<T>()(object);
+        const uint32_t shard_index = compute_shard_index(hash, m_num_shard_bits);
+        auto& shard = m_shards[shard_index];
+        std::lock_guard<OptionalMutex> hold(shard.mutex);
+        // The candidate gets a free id and is removed again if it exists.
+        uint32_t local_id;
+        const bool reuse_id = !shard.free_ids.empty();
+        if (reuse_id) {
+            local_id = shard.free_ids.back();
+            shard.slots[local_id] = Slot{std::make_shared<const T>(std::move(object)), hash};
+        } else {
+            if (shard.slots.size() > (std::numeric_limits<uint32_t>::max() >> m_num_shard_bits)) {
+                throw std::runtime_error("SharedObjectPool::insert - number of objects exceeds 32-bit ids.");
+            }
+            local_id = shard.slots.size();
+            shard.slots.push_back(Slot{std::make_shared<const T>(std::move(object)), hash});
+        }
+        auto result = shard.unique.insert(local_id);
+        if (!result.second) {
+            if (reuse_id) {
+                shard.slots[local_id] = Slot();
+            } else {
+                shard.slots.pop_back();
+            }
+        } else if (reuse_id) {
+            shard.free_ids.pop_back();
+        }
+        auto& slot = shard.slots[*result.first];
+        if (pinned) {
+            slot.pinned = true;
+        } else {
+            ++slot.num_references;
+        }
+        update_container_bytes(shard);
+        return std::make_pair((*result.first << m_num_shard_bits) | shard_index, result.second);
+    }
+
+    /// @brief Removes a reference to the object and erases it if it is
+    ///        neither referenced nor pinned anymore. Shared ownership
+    ///        handed out before remains valid.
+    /// @return The erased object or nullptr.
+    std::shared_ptr<const T> release(uint32_t id) {
+        auto& shard = m_shards[id & m_shard_mask];
+        const uint32_t local_id = id >> m_num_shard_bits;
+        std::lock_guard<OptionalMutex> hold(shard.mutex);
+        auto& slot = shard.slots[local_id];
+        assert(slot.object && slot.num_references > 0);
+        if (--slot.num_references > 0 || slot.pinned) {
+            return nullptr;
+        }
+        shard.unique.erase(local_id);
+        std::shared_ptr<const T> result = std::move(slot.object);
+        slot = Slot();
+        shard.free_ids.push_back(local_id);
+        update_container_bytes(shard);
+        return result;
+    }
+
+    /// @brief Returns the object with the id, which must be pinned or
+    ///        referenced by the caller.
+    const std::shared_ptr<const T>& get(uint32_t id) const {
+        return m_shards[id & m_shard_mask].slots[id >> m_num_shard_bits].object;
+    }
+
+    std::size_t get_num_objects() const {
+        std::size_t result = 0;
+        for (std::size_t i = 0; i < (std::size_t(1) << m_num_shard_bits); ++i) {
+            std::lock_guard<OptionalMutex> hold(m_shards[i].mutex);
+            result += m_shards[i].unique.size();
+        }
+        return result;
+    }
+
+    /// @brief Returns the number of bytes of the slots and the hash sets.
+    std::size_t get_num_container_bytes() const {
+        return m_num_container_bytes.load(std::memory_order_relaxed);
+    }
+};
+
+
+/// @brief Caches unique objects of types Ts by key.
+///
+/// Entries whose keys are not pinned by SharedObjectPinned are evicted with
+/// the CLOCK policy when the cache exceeds its memory limit. Objects are
+/// released when no entry refers to them anymore, unless they were
+/// inserted through insert_unique or insert_unique_id.
+///
+/// The cache is thread-safe if it has more than one shard. Entries are
+/// partitioned into shards by the hash of their key and each shard has its
+/// own lock, which is never held while objects are computed. A cache with
+/// a single shard is not locked and must only be used by one thread at a
+/// time. Threads that compute the object of the same
+/// key concurrently obtain the object that was mapped first.
 template<typename Key, typename... Ts>
 class SharedObjectCache {
 private:
-    // @brief Hashing of the underlying object.
+    static constexpr uint32_t no_clock_slot = std::numeric_limits<uint32_t>::max();
+
+    struct MappingEntry {
+        uint32_t id;
+        uint32_t clock_slot;
+    };
+
+    using Mapping = std::unordered_map<Key, MappingEntry>;
+
+    /// @brief An evictable mapping entry in the clock.
+    struct ClockEntry {
+        Key key;
+        uint8_t type_index;
+        bool referenced;
+        bool occupied;
+    };
+
+    struct Shard {
+        OptionalMutex mutex;
+        // One mapping per object type, indexed by type_index.
+        std::array<Mapping, sizeof...(Ts)> mappings;
+        std::vector<ClockEntry> clock;
+        std::vector<uint32_t> free_clock_slots;
+        std::size_t clock_hand = 0;
+        std::size_t num_evictable = 0;
+        SharedObjectCacheStatistics statistics;
+        std::size_t num_container_bytes = 0;
+    };
+
+    // Allocated separately such that ids stay valid when the cache is moved.
+    std::tuple<std::shared_ptr<SharedObjectPool<Ts>>...> m_pools;
+
+    int m_num_shard_bits;
+    std::unique_ptr<Shard[]> m_shards;
+
+    std::atomic<std::size_t> m_memory_limit;
+
+    // Bytes of the unique objects, their control blocks, the mappings, and the clocks.
+    std::atomic<std::size_t> m_num_bytes;
+
+    // Size of a node in a hash container with cached hash values.
+    static constexpr std::size_t node_size = sizeof(void*) + sizeof(typename Mapping::value_type) + sizeof(std::size_t);
+
+    // Size of the control block of std::make_shared.
+    static constexpr std::size_t control_block_size = 2 * sizeof(int) + sizeof(void*);
+
+    static_assert(sizeof...(Ts) <= std::numeric_limits<uint8_t>::max(), "Too many object types.");
+
+    template<typename T, std::size_t... Is>
+    static constexpr uint8_t compute_type_index(std::index_sequence<Is...>) {
+        return ((std::is_same_v<T, Ts> ? Is : 0) + ...);
+    }
+
+    template<typename T>
+    static constexpr uint8_t type_index = compute_type_index<T>(std::index_sequence_for<Ts...>());
+
+    Shard& get_shard(const Key& key) {
+        return m_shards[compute_shard_index(std::hash<Key>()(key), m_num_shard_bits)];
+    }
+
     template<typename T>
-    struct ValueHash {
-        std::size_t operator()(const std::shared_ptr<const T>& ptr) const {
-            return std::hash<T>()(*ptr);
+    SharedObjectPool<T>& get_pool_ref() {
+        return *std::get<std::shared_ptr<SharedObjectPool<T>>>(m_pools);
+    }
+
+    /// @brief Updates the number of bytes after the shard was modified.
+    void update_container_bytes(Shard& shard) {
+        std::size_t num_bytes = shard.clock.capacity() * sizeof(ClockEntry)
+            + shard.free_clock_slots.capacity() * sizeof(uint32_t);
+        for (const auto& mapping : shard.mappings) {
+            num_bytes += mapping.size() * node_size + mapping.bucket_count() * sizeof(void*);
         }
-    };
+        m_num_bytes += num_bytes;
+        m_num_bytes -= shard.num_container_bytes;
+        shard.num_container_bytes = num_bytes;
+    }
 
-    /// @brief Equality comparison of the objects underlying the pointers.
     template<typename T>
-    struct ValueEqual {
-        bool operator()(const std::shared_ptr<const T>& left, const std::shared_ptr<const T>& right) const {
-            return *left == *right;
+    void add_object_bytes(const T& object) {
+        m_num_bytes += SharedObjectSize<T>()(object) + control_block_size;
+    }
+
+    template<typename T>
+    void release(uint32_t id) {
+        auto erased = get_pool_ref<T>().release(id);
+        if (erased) {
+            m_num_bytes -= SharedObjectSize<T>()(*erased) + control_block_size;
         }
-    };
+    }
 
     template<typename T>
-    struct PerTypeCache {
-        std::unordered_set<std::shared_ptr<const T>, ValueHash<T>, ValueEqual<T>> unique;
-        std::unordered_map<Key, std::shared_ptr<const T>> mapping;
-    };
+    void erase_mapping(Shard& shard, const Key& key) {
+        auto& mapping = shard.mappings[type_index<T>];
+        auto it = mapping.find(key);
+        assert(it != mapping.end());
+        const uint32_t id = it->second.id;
+        mapping.erase(it);
+        release<T>(id);
+    }
+
+    template<std::size_t... Is>
+    void erase_mapping(Shard& shard, uint8_t type_index, const Key& key, std::index_sequence<Is...>) {
+        ((type_index == Is ? erase_mapping<std::tuple_element_t<Is, std::tuple<Ts...>>>(shard, key) : void()), ...);
+    }
 
-    std::tuple<PerTypeCache<Ts>...> m_cache;
+    /// @brief Evicts the first entry of the clock of the locked shard that
+    ///        was not referenced since the hand passed it last.
+    void evict_one(Shard& shard) {
+        assert(shard.num_evictable > 0);
+        while (true) {
+            if (shard.clock_hand >= shard.clock.size()) {
+                shard.clock_hand = 0;
+            }
+            auto& entry = shard.clock[shard.clock_hand];
+            if (entry.occupied) {
+                if (entry.referenced) {
+                    entry.referenced = false;
+                } else {
+                    entry.occupied = false;
+                    shard.free_clock_slots.push_back(shard.clock_hand);
+                    --shard.num_evictable;
+                    ++shard.statistics.num_evictions;
+                    erase_mapping(shard, entry.type_index, entry.key, std::index_sequence_for<Ts...>());
+                    update_container_bytes(shard);
+                    ++shard.clock_hand;
+                    return;
+                }
+            }
+            ++shard.clock_hand;
+        }
+    }
+
+    bool exceeds_memory_limit() const {
+        return get_num_bytes() > m_memory_limit.load(std::memory_order_relaxed);
+    }
+
+    /// @brief Evicts entries starting at the given shard until the memory
+    ///        limit is met or no entry is evictable.
+    void enforce_memory_limit(std::size_t first_shard) {
+        for (std::size_t i = 0; i < get_num_shards() && exceeds_memory_limit(); ++i) {
+            auto& shard = m_shards[(first_shard + i) & (get_num_shards() - 1)];
+            std::lock_guard<OptionalMutex> hold(shard.mutex);
+            while (shard.num_evictable > 0 && exceeds_memory_limit()) {
+                evict_one(shard);
+            }
+        }
+    }
 
 public:
-    SharedObjectCache()  { }
+    /// @param num_shards The number of shards, rounded up to a power of two.
+    explicit SharedObjectCache(int num_shards = 1)
+        : m_pools(std::make_shared<SharedObjectPool<Ts>>(num_shards)...),
+          m_num_shard_bits(compute_num_shard_bits(num_shards)),
+          m_shards(std::make_unique<Shard[]>(std::size_t(1) << m_num_shard_bits)),
+          m_memory_limit(std::numeric_limits<std::size_t>::max()),
+          m_num_bytes(0) {
+        for (std::size_t i = 0; i < get_num_shards(); ++i) {
+            m_shards[i].mutex.set_enabled(m_num_shard_bits > 0);
+            update_container_bytes(m_shards[i]);
+        }
+    }
+    SharedObjectCache(const SharedObjectCache& other) = delete;
+    SharedObjectCache& operator=(const SharedObjectCache& other) = delete;
+    // Must not be called concurrently with other operations.
+    SharedObjectCache(SharedObjectCache&& other)
+        : m_pools(std::move(other.m_pools)),
+          m_num_shard_bits(other.m_num_shard_bits),
+          m_shards(std::move(other.m_shards)),
+          m_memory_limit(other.m_memory_limit.load()),
+          m_num_bytes(other.m_num_bytes.load()) { }
+    SharedObjectCache& operator=(SharedObjectCache&& other) {
+        if (this != &other) {
+            m_pools = std::move(other.m_pools);
+            m_num_shard_bits = other.m_num_shard_bits;
+            m_shards = std::move(other.m_shards);
+            m_memory_limit = other.m_memory_limit.load();
+            m_num_bytes = other.m_num_bytes.load();
+        }
+        return *this;
+    }
+
+    std::size_t get_num_shards() const {
+        return std::size_t(1) << m_num_shard_bits;
+    }
 
+    /// @brief Returns the object with the key or nullptr and counts the lookup.
     template<typename T>
-    std::shared_ptr<const T> get(const Key& key) const {
-        auto& t_mapping = std::get<PerTypeCache<T>>(m_cache).mapping;
-        auto it = t_mapping.find(key);
-        if (it == t_mapping.end()) {
+    std::shared_ptr<const T> get(const Key& key) {
+        auto& shard = get_shard(key);
+        std::lock_guard<OptionalMutex> hold(shard.mutex);
+        const auto& mapping = shard.mappings[type_index<T>];
+        auto it = mapping.find(key);
+        if (it == mapping.end()) {
+            ++shard.statistics.num_misses;
             return nullptr;
         }
-        return it->second;
+        ++shard.statistics.num_hits;
+        if (it->second.clock_slot != no_clock_slot) {
+            shard.clock[it->second.clock_slot].referenced = true;
+        }
+        return get_pool_ref<T>().get(it->second.id);
     }
 
+    /// @brief Inserts the object if there is no equal object and maps the key
+    ///        to it unless the key is mapped already. Evicts entries if the
+    ///        memory limit is exceeded afterwards.
+    /// @return Shared ownership of the object that the key maps to.
     template<typename T>
-    void insert_mapping(const Key& key, std::shared_ptr<const T>& element) {
-        auto& t_cache = std::get<PerTypeCache<T>>(m_cache);
-        auto& t_mapping = t_cache.mapping;
-        if (get<T>(key)) {
-            throw std::runtime_error("Must call get first before insertion.");
+    std::shared_ptr<const T> insert_unique_mapping(const Key& key, T&& object) {
+        auto& pool = get_pool_ref<T>();
+        const auto [id, inserted] = pool.insert(std::move(object), false);
+        if (inserted) {
+            add_object_bytes(*pool.get(id));
+        }
+        const std::size_t shard_index = compute_shard_index(std::hash<Key>()(key), m_num_shard_bits);
+        auto& shard = m_shards[shard_index];
+        std::shared_ptr<const T> result;
+        bool mapped = false;
+        {
+            std::lock_guard<OptionalMutex> hold(shard.mutex);
+            auto& mapping = shard.mappings[type_index<T>];
+            auto it = mapping.find(key);
+            if (it != mapping.end()) {
+                // Another thread computed the object concurrently.
+                result = pool.get(it->second.id);
+                mapped = true;
+            } else {
+                uint32_t clock_slot = no_clock_slot;
+                if (!SharedObjectPinned<Key>()(key)) {
+                    if (shard.free_clock_slots.empty()) {
+                        clock_slot = shard.clock.size();
+                        shard.clock.push_back(ClockEntry{key, type_index<T>, false, true});
+                    } else {
+                        clock_slot = shard.free_clock_slots.back();
+                        shard.free_clock_slots.pop_back();
+                        shard.clock[clock_slot] = ClockEntry{key, type_index<T>, false, true};
+                    }
+                    ++shard.num_evictable;
+                }
+                mapping.emplace(key, MappingEntry{id, clock_slot});
+                update_container_bytes(shard);
+                // Eviction may release the object but the result keeps it alive.
+                result = pool.get(id);
+            }
         }
-        t_mapping.emplace(key, element);
+        if (mapped) {
+            release<T>(id);
+        }
+        if (exceeds_memory_limit()) {
+            enforce_memory_limit(shard_index);
+        }
+        return result;
     }
 
+    /// @brief Inserts the object if there is no equal object and pins it.
+    /// @return Shared ownership of the unique object.
     template<typename T>
     std::shared_ptr<const T> insert_unique(T&& object) {
-        auto& t_cache = std::get<PerTypeCache<T>>(m_cache);
-        auto& t_unique = t_cache.unique;
-        auto result = t_unique.insert(std::make_shared<T>(std::move(object)));
-        return *result.first;
+        return get_pool_ref<T>().get(insert_unique_id(std::move(object)));
+    }
+
+    /// @brief Inserts the object if there is no equal object and pins it.
+    /// @return The id of the unique object in the pool.
+    template<typename T>
+    uint32_t insert_unique_id(T&& object) {
+        auto& pool = get_pool_ref<T>();
+        const auto [id, inserted] = pool.insert(std::move(object), true);
+        if (inserted) {
+            add_object_bytes(*pool.get(id));
+        }
+        return id;
+    }
+
+    /// @brief Returns the pool of the unique objects of type T.
+    template<typename T>
+    std::shared_ptr<const SharedObjectPool<T>> get_pool() const {
+        return std::get<std::shared_ptr<SharedObjectPool<T>>>(m_pools);
+    }
+
+    /// @brief Sets the number of bytes above which entries are evicted.
+    ///        Entries with pinned keys are never evicted.
+    void set_memory_limit(std::size_t num_bytes) {
+        m_memory_limit = num_bytes;
+        enforce_memory_limit(0);
+    }
+
+    std::size_t get_memory_limit() const {
+        return m_memory_limit.load();
+    }
+
+    /// @brief Returns the number of entries that can be evicted.
+    std::size_t get_num_evictable() const {
+        std::size_t result = 0;
+        for (std::size_t i = 0; i < get_num_shards(); ++i) {
+            std::lock_guard<OptionalMutex> hold(m_shards[i].mutex);
+            result += m_shards[i].num_evictable;
+        }
+        return result;
+    }
+
+    SharedObjectCacheStatistics get_statistics() const {
+        SharedObjectCacheStatistics result;
+        for (std::size_t i = 0; i < get_num_shards(); ++i) {
+            std::lock_guard<OptionalMutex> hold(m_shards[i].mutex);
+            result.num_hits += m_shards[i].statistics.num_hits;
+            result.num_misses += m_shards[i].statistics.num_misses;
+            result.num_evictions += m_shards[i].statistics.num_evictions;
+        }
+        return result;
+    }
+
+    void reset_statistics() {
+        for (std::size_t i = 0; i < get_num_shards(); ++i) {
+            std::lock_guard<OptionalMutex> hold(m_shards[i].mutex);
+            m_shards[i].statistics = SharedObjectCacheStatistics();
+        }
+    }
+
+    /// @brief Returns the number of bytes of the cached objects,
+    ///        the hash containers, their buckets, and the clocks.
+    std::size_t get_num_bytes() const {
+        return m_num_bytes.load(std::memory_order_relaxed)
+            + (std::get<std::shared_ptr<SharedObjectPool<Ts>>>(m_pools)->get_num_container_bytes() + ...);
     }
 };
 
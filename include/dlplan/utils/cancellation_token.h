@@ -0,0 +1,59 @@
+#ifndef DLPLAN_INCLUDE_DLPLAN_UTILS_CANCELLATION_TOKEN_H_
+#define DLPLAN_INCLUDE_DLPLAN_UTILS_CANCELLATION_TOKEN_H_
+
+#include <atomic>
+#include <memory>
+#include <stdexcept>
+#include <string>
+
+
+namespace dlplan::utils {
+
+/// @brief Is thrown by a long-running computation that observed a cancellation request.
+class OperationCancelled : public std::runtime_error {
+public:
+    using std::runtime_error::runtime_error;
+};
+
+
+/// @brief Allows a thread to request that a long-running computation
+///        in another thread stops.
+///
+/// Computations check the token cooperatively at boundaries where
+/// stopping is cheap, e.g., between layers or rules, and throw
+/// OperationCancelled if cancellation was requested.
+class CancellationToken {
+private:
+    std::atomic<bool> m_is_cancelled;
+
+public:
+    CancellationToken() : m_is_cancelled(false) { }
+    CancellationToken(const CancellationToken& other) = delete;
+    CancellationToken& operator=(const CancellationToken& other) = delete;
+
+    /// @brief Requests cancellation. Can be called from any thread.
+    void cancel() {
+        m_is_cancelled.store(true, std::memory_order_relaxed);
+    }
+
+    /// @brief Withdraws the request such that the token can be reused.
+    void reset() {
+        m_is_cancelled.store(false, std::memory_order_relaxed);
+    }
+
+    bool is_cancelled() const {
+        return m_is_cancelled.load(std::memory_order_relaxed);
+    }
+};
+
+
+/// @brief Throws OperationCancelled with the given context if the token is cancelled.
+inline void throw_if_cancelled(const std::shared_ptr<const CancellationToken>& cancellation_token, const std::string& context) {
+    if (cancellation_token && cancellation_token->is_cancelled()) {
+        throw OperationCancelled(context + " - cancelled.");
+    }
+}
+
+}
+
+#endif
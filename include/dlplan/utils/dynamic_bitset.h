@@ -3,6 +3,7 @@
 
 #include "hash.h"
 
+#include <bit>
 #include <cassert>
 #include <limits>
 #include <vector>
@@ -48,6 +49,11 @@ class DynamicBitset {
         return bit_index(num_bits);
     }
 
+    Block last_block_mask() const {
+        const int bits_in_last_block = count_bits_in_last_block();
+        return bits_in_last_block == 0 ? ones : ~(ones << bits_in_last_block);
+    }
+
     void zero_unused_bits() {
         const int bits_in_last_block = count_bits_in_last_block();
 
@@ -72,18 +78,40 @@ public:
 
     /*
       Count the number of set bits.
-
-      The computation could be made faster by using a more sophisticated
-      algorithm (see https://en.wikipedia.org/wiki/Hamming_weight).
     */
     int count() const {
         int result = 0;
-        for (std::size_t pos = 0; pos < num_bits; ++pos) {
-            result += static_cast<int>(test(pos));
+        for (std::size_t i = 0; i < blocks.size(); ++i) {
+            result += std::popcount(blocks[i]);
         }
         return result;
     }
 
+    /// @brief Calls f with the position of each set bit in ascending order.
+    template<typename F>
+    void for_each_set(F f) const {
+        for (std::size_t i = 0; i < blocks.size(); ++i) {
+            Block block = blocks[i];
+            while (block) {
+                f(i * bits_per_block + std::countr_zero(block));
+                block &= block - 1;
+            }
+        }
+    }
+
+    /// @brief Calls f with the position of each unset bit in ascending order.
+    template<typename F>
+    void for_each_unset(F f) const {
+        for (std::size_t i = 0; i < blocks.size(); ++i) {
+            Block block = ~blocks[i];
+            if (i + 1 == blocks.size()) block &= last_block_mask();
+            while (block) {
+                f(i * bits_per_block + std::countr_zero(block));
+                block &= block - 1;
+            }
+        }
+    }
+
     bool none() const {
         for (std::size_t i = 0; i < blocks.size(); ++i) {
             if (blocks[i]) return false;
@@ -91,6 +119,18 @@ public:
         return true;
     }
 
+    bool all() const {
+        if (blocks.empty()) return true;
+        for (std::size_t i = 0; i + 1 < blocks.size(); ++i) {
+            if (blocks[i] != ones) return false;
+        }
+        return blocks.back() == last_block_mask();
+    }
+
+    std::size_t get_num_bytes() const {
+        return blocks.capacity() * sizeof(Block);
+    }
+
     void set() {
         std::fill(blocks.begin(), blocks.end(), ones);
         zero_unused_bits();
@@ -154,6 +194,15 @@ public:
         return *this;
     }
 
+    /// @brief Replaces this by the difference of other and this.
+    DynamicBitset& subtract_from(const DynamicBitset& other) {
+        assert(size() == other.size());
+        for (std::size_t i = 0; i < blocks.size(); ++i) {
+            blocks[i] = other.blocks[i] & ~blocks[i];
+        }
+        return *this;
+    }
+
     DynamicBitset& operator~() {
         for (std::size_t i = 0; i < blocks.size(); ++i) {
             blocks[i] = ~blocks[i];
@@ -180,9 +229,55 @@ public:
         return true;
     }
 
+    bool is_union_full(const DynamicBitset &other) const {
+        assert(size() == other.size());
+        if (blocks.empty()) return true;
+        for (std::size_t i = 0; i + 1 < blocks.size(); ++i) {
+            if ((blocks[i] | other.blocks[i]) != ones)
+                return false;
+        }
+        return (blocks.back() | other.blocks.back()) == last_block_mask();
+    }
+
+    bool is_complement_of(const DynamicBitset &other) const {
+        assert(size() == other.size());
+        if (blocks.empty()) return true;
+        for (std::size_t i = 0; i + 1 < blocks.size(); ++i) {
+            if (blocks[i] != static_cast<Block>(~other.blocks[i]))
+                return false;
+        }
+        return (blocks.back() ^ other.blocks.back()) == last_block_mask();
+    }
+
     std::size_t hash() const {
         return hash_vector(blocks);
     }
+
+    /// @brief Returns the hash of this or of its complement, which equals
+    ///        hash() of the complemented bitset.
+    std::size_t hash(bool complemented) const {
+        if (!complemented) return hash();
+        std::size_t aggregated_hash = 0;
+        for (std::size_t i = 0; i < blocks.size(); ++i) {
+            Block block = ~blocks[i];
+            if (i + 1 == blocks.size()) block &= last_block_mask();
+            hash_combine(aggregated_hash, block);
+        }
+        return aggregated_hash;
+    }
+
+    /// @brief Returns hash() of a bitset of num_bits bits that are all set to value.
+    static std::size_t hash_uniform(std::size_t num_bits, bool value) {
+        const std::size_t num_blocks = compute_num_blocks(num_bits);
+        const int bits_in_last_block = num_bits % bits_per_block;
+        std::size_t aggregated_hash = 0;
+        for (std::size_t i = 0; i < num_blocks; ++i) {
+            Block block = value ? ones : zeros;
+            if (value && i + 1 == num_blocks && bits_in_last_block != 0) block &= ~(ones << bits_in_last_block);
+            hash_combine(aggregated_hash, block);
+        }
+        return aggregated_hash;
+    }
 };
 
 template<typename Block>
@@ -58,8 +58,23 @@ private:
         int count = 0;
         // Mutex is shared for thread-safe changes to count that is shared across types
         std::mutex mutex;
+        // Bytes of the live objects, their keys, and map entries
+        std::size_t num_bytes = 0;
     };
 
+    /// @brief Returns the number of bytes for storing an object of type T,
+    ///        i.e., the object with its control block and deleter, the key
+    ///        with its control block, and the nodes in both maps.
+    template<typename T>
+    static constexpr std::size_t compute_num_bytes_per_object() {
+        const std::size_t control_block_size = 2 * sizeof(int) + sizeof(void*);
+        const std::size_t node_overhead = 2 * sizeof(void*);
+        return sizeof(T) + control_block_size + sizeof(std::shared_ptr<Cache>) + sizeof(int)
+            + sizeof(T) + control_block_size
+            + node_overhead + sizeof(std::shared_ptr<const T>) + sizeof(std::weak_ptr<T>)
+            + node_overhead + sizeof(int) + sizeof(std::shared_ptr<const T>);
+    }
+
     std::shared_ptr<Cache> m_cache;
 
 public:
@@ -87,6 +102,7 @@ public:
         bool new_insertion = false;
         if (!sp) {
             ++m_cache->count;
+            m_cache->num_bytes += compute_num_bytes_per_object<T>();
             new_insertion = true;
             t_cache.identifier_to_key.emplace(identifier, key);
             /* Must explicitly call the constructor of T to give exclusive access to the factory. */
@@ -100,6 +116,7 @@ public:
                         const auto& key = t_cache.identifier_to_key.at(identifier);
                         t_cache.data.erase(key);
                         t_cache.identifier_to_key.erase(identifier);
+                        cache->num_bytes -= compute_num_bytes_per_object<T>();
                     }
                     /* After cache removal, we can call the objects destructor
                        and recursively call the deleter of children if their ref count goes to 0 */
@@ -109,6 +126,12 @@ public:
         }
         return GetOrCreateResult<T>{sp, new_insertion};
     }
+
+    /// @brief Returns the number of bytes of all live objects.
+    std::size_t get_num_bytes() const {
+        std::lock_guard<std::mutex> hold(m_cache->mutex);
+        return m_cache->num_bytes;
+    }
 };
 
 }
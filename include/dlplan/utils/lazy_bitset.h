@@ -0,0 +1,217 @@
+#ifndef DLPLAN_INCLUDE_DLPLAN_UTILS_LAZY_BITSET_H
+#define DLPLAN_INCLUDE_DLPLAN_UTILS_LAZY_BITSET_H
+
+#include "dynamic_bitset.h"
+
+#include <cstddef>
+
+
+namespace dlplan {
+
+/// @brief A bitset that represents complements and the empty and full set
+///        without materializing bits.
+///
+/// The represented set is the set of bits (or its complement if complemented).
+/// A symbolic bitset has no bits allocated, i.e., it represents the empty
+/// set or, if complemented, the full set. Binary operations and predicates
+/// work on all forms and bits are only allocated when single bits are set.
+template<typename Block = unsigned int>
+class LazyBitset {
+private:
+    std::size_t m_num_bits;
+    // Empty iff symbolic, otherwise it has m_num_bits bits.
+    DynamicBitset<Block> m_bits;
+    bool m_complemented;
+
+    void allocate() {
+        if (is_symbolic()) {
+            m_bits = DynamicBitset<Block>(m_num_bits);
+        }
+    }
+
+    void assign_symbolic(bool complemented) {
+        m_bits = DynamicBitset<Block>(0);
+        m_complemented = complemented;
+    }
+
+    /// @brief Intersects with other or with the complement of other.
+    void intersect(const LazyBitset& other, bool other_complemented) {
+        if (other.is_symbolic()) {
+            if (!other_complemented) assign_symbolic(false);
+            return;
+        }
+        if (is_symbolic()) {
+            if (m_complemented) {
+                m_bits = other.m_bits;
+                m_complemented = other_complemented;
+            }
+            return;
+        }
+        if (!m_complemented && !other_complemented) {
+            m_bits &= other.m_bits;
+        } else if (!m_complemented && other_complemented) {
+            m_bits -= other.m_bits;
+        } else if (m_complemented && !other_complemented) {
+            // ~A & B = B - A
+            m_bits.subtract_from(other.m_bits);
+            m_complemented = false;
+        } else {
+            // ~A & ~B = ~(A | B)
+            m_bits |= other.m_bits;
+        }
+    }
+
+public:
+    explicit LazyBitset(std::size_t num_bits)
+        : m_num_bits(num_bits), m_bits(0), m_complemented(false) { }
+
+    std::size_t size() const {
+        return m_num_bits;
+    }
+
+    /// @brief Returns true iff no bits are allocated.
+    bool is_symbolic() const {
+        return m_bits.size() == 0 && m_num_bits != 0;
+    }
+
+    /// @brief Returns true iff the set is represented by its complement.
+    bool is_complemented() const {
+        return m_complemented;
+    }
+
+    /// @brief Allocates the bits and removes the complement.
+    void materialize() {
+        allocate();
+        if (m_complemented) {
+            ~m_bits;
+            m_complemented = false;
+        }
+    }
+
+    /// @brief Returns the number of bytes of the allocated bits.
+    std::size_t get_num_bytes() const {
+        return m_bits.get_num_bytes();
+    }
+
+    int count() const {
+        const int num_bits = is_symbolic() ? 0 : m_bits.count();
+        return m_complemented ? m_num_bits - num_bits : num_bits;
+    }
+
+    bool none() const {
+        if (is_symbolic()) return !m_complemented;
+        return m_complemented ? m_bits.all() : m_bits.none();
+    }
+
+    bool all() const {
+        if (is_symbolic()) return m_complemented;
+        return m_complemented ? m_bits.none() : m_bits.all();
+    }
+
+    void set() {
+        assign_symbolic(true);
+    }
+
+    void reset() {
+        assign_symbolic(false);
+    }
+
+    void set(std::size_t pos) {
+        if (is_symbolic() && m_complemented) return;
+        allocate();
+        if (m_complemented) m_bits.reset(pos);
+        else m_bits.set(pos);
+    }
+
+    void reset(std::size_t pos) {
+        if (is_symbolic() && !m_complemented) return;
+        allocate();
+        if (m_complemented) m_bits.set(pos);
+        else m_bits.reset(pos);
+    }
+
+    bool test(std::size_t pos) const {
+        if (is_symbolic()) return m_complemented;
+        return m_bits.test(pos) != m_complemented;
+    }
+
+    /// @brief Calls f with each position in the set in ascending order.
+    template<typename F>
+    void for_each(F f) const {
+        if (is_symbolic()) {
+            if (m_complemented) {
+                for (std::size_t pos = 0; pos < m_num_bits; ++pos) f(pos);
+            }
+        } else if (m_complemented) {
+            m_bits.for_each_unset(f);
+        } else {
+            m_bits.for_each_set(f);
+        }
+    }
+
+    bool operator==(const LazyBitset& other) const {
+        if (this == &other) return true;
+        if (m_num_bits != other.m_num_bits) return false;
+        if (is_symbolic()) return m_complemented ? other.all() : other.none();
+        if (other.is_symbolic()) return other.m_complemented ? all() : none();
+        if (m_complemented == other.m_complemented) return m_bits == other.m_bits;
+        return m_bits.is_complement_of(other.m_bits);
+    }
+
+    bool operator!=(const LazyBitset& other) const {
+        return !(*this == other);
+    }
+
+    LazyBitset& operator&=(const LazyBitset& other) {
+        intersect(other, other.m_complemented);
+        return *this;
+    }
+
+    LazyBitset& operator|=(const LazyBitset& other) {
+        // A | A = A, and the complement below would otherwise also flip other.
+        if (this == &other) return *this;
+        // A | B = ~(~A & ~B)
+        m_complemented = !m_complemented;
+        intersect(other, !other.m_complemented);
+        m_complemented = !m_complemented;
+        return *this;
+    }
+
+    LazyBitset& operator-=(const LazyBitset& other) {
+        intersect(other, !other.m_complemented);
+        return *this;
+    }
+
+    LazyBitset& operator~() {
+        m_complemented = !m_complemented;
+        return *this;
+    }
+
+    bool intersects(const LazyBitset& other) const {
+        if (is_symbolic()) return m_complemented && !other.none();
+        if (other.is_symbolic()) return other.m_complemented && !none();
+        if (!m_complemented && !other.m_complemented) return m_bits.intersects(other.m_bits);
+        if (!m_complemented) return !m_bits.is_subset_of(other.m_bits);
+        if (!other.m_complemented) return !other.m_bits.is_subset_of(m_bits);
+        return !m_bits.is_union_full(other.m_bits);
+    }
+
+    bool is_subset_of(const LazyBitset& other) const {
+        if (is_symbolic()) return !m_complemented || other.all();
+        if (other.is_symbolic()) return other.m_complemented || none();
+        if (!m_complemented && !other.m_complemented) return m_bits.is_subset_of(other.m_bits);
+        if (!m_complemented) return !m_bits.intersects(other.m_bits);
+        if (!other.m_complemented) return m_bits.is_union_full(other.m_bits);
+        return other.m_bits.is_subset_of(m_bits);
+    }
+
+    /// @brief Returns the hash of the represented set independent of its form.
+    std::size_t hash() const {
+        if (is_symbolic()) return DynamicBitset<Block>::hash_uniform(m_num_bits, m_complemented);
+        return m_bits.hash(m_complemented);
+    }
+};
+
+}
+
+#endif
@@ -1,4 +1,4 @@
-/// @brief This module is work in progress and is not ready to be used.
+/// Provides functionality for partitioning states by color refinement.
 
 #ifndef DLPLAN_INCLUDE_DLPLAN_WEISFEILER_LEHMAN_H_
 #define DLPLAN_INCLUDE_DLPLAN_WEISFEILER_LEHMAN_H_
@@ -9,22 +9,51 @@
 
 
 namespace dlplan::weisfeiler_lehman {
-class Color;
-
 using CompressedColor = int;
 using CompressedColors = std::vector<CompressedColor>;
-using Colors = std::vector<Color>;
 
 
+/// @brief Implements 1-dimensional Weisfeiler-Lehman color refinement
+///        over the graphs of states.
+///
+/// The graph of a state has one vertex per object and one vertex per
+/// true atom, including static atoms. Each atom vertex is connected to
+/// the vertices of its objects with edges labeled by the argument position.
+/// Object vertices of constants are initially colored by their constant
+/// such that concepts over constants can distinguish them, the remaining
+/// object vertices are uncolored, and atom vertices are colored by their
+/// predicate.
+///
+/// The graphs of all states are refined together until the partition of
+/// the vertices is stable. Colors are compressed to consecutive integers
+/// by sorting the signatures, i.e., the color of a vertex together with
+/// the sorted multiset of labeled colors of its neighbors. States that
+/// receive different colors are not isomorphic.
 class WeisfeilerLehman {
+private:
+    int m_num_threads;
+
 public:
     WeisfeilerLehman();
+    /**
+     * Signatures of different states are computed on num_threads threads.
+     */
+    explicit WeisfeilerLehman(int num_threads);
     WeisfeilerLehman(const WeisfeilerLehman& other);
     WeisfeilerLehman& operator=(const WeisfeilerLehman& other);
     WeisfeilerLehman(WeisfeilerLehman&& other);
     WeisfeilerLehman& operator=(WeisfeilerLehman&& other);
     ~WeisfeilerLehman();
 
+    /**
+     * Returns the colors of the states in the given order.
+     */
+    CompressedColors compute_colors(
+        const core::States& states) const;
+
+    /**
+     * Returns the colors of the states in the order of StateSpace::get_state_vector.
+     */
     CompressedColors compute_colors_for_state_space(
         const state_space::StateSpace& state_space) const;
 };
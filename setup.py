@@ -55,6 +55,8 @@ class CMakeBuild(build_ext):
             f"-DCMAKE_BUILD_TYPE={cfg}",  # not used on MSVC, but no harm
             f"-DCMAKE_PREFIX_PATH={str(temp_directory)}/dependencies/installs"
         ]
+        if os.environ.get("DLPLAN_ENABLE_PROFILING"):
+            cmake_args += ["-DENABLE_PROFILING:bool=true"]
         build_args = []
         build_args += ["--target", ext.name]
 
@@ -76,7 +78,7 @@ setup(
     url="https://github.com/rleap-project/dlplan",
     description="A library for using description logics features in planning",
     long_description="",
-    install_requires=["state_space_generator==0.1.9", "cmake>=3.21"],
+    install_requires=["state_space_generator==0.1.9", "cmake>=3.21", "numpy"],
     packages=find_packages(where="api/python/src"),
     package_dir={"": "api/python/src"},
     package_data={
@@ -0,0 +1,313 @@
+#include "../../include/dlplan/core.h"
+
+#include "../utils/parallel.h"
+
+#include <algorithm>
+#include <charconv>
+#include <stdexcept>
+#include <string_view>
+#include <variant>
+
+
+namespace dlplan::core {
+
+/// @brief Parses descriptions by recursive descent and memoises the elements
+///        of all subterms by their text.
+///
+/// Only well-formed descriptions are accepted. Everything else is rejected
+/// such that the caller can fall back to the Boost.Spirit parser, which
+/// reports human readable errors.
+class MemoizingParser {
+private:
+    using Node = std::variant<
+        std::shared_ptr<const Boolean>,
+        std::shared_ptr<const Numerical>,
+        std::shared_ptr<const Concept>,
+        std::shared_ptr<const Role>>;
+
+    /// @brief Signals that the description is not accepted.
+    struct Rejected { };
+
+    SyntacticElementFactory& m_factory;
+    std::shared_ptr<VocabularyInfo> m_vocabulary_info;
+    std::unordered_map<std::string, Node> m_memo;
+
+    std::string_view m_description;
+    // Position of the matching closing parenthesis of each opening parenthesis.
+    std::vector<size_t> m_closing;
+
+    static bool is_space(char c) {
+        return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+    }
+
+    std::string_view trim(size_t begin, size_t end) const {
+        while (begin < end && is_space(m_description[begin])) ++begin;
+        while (end > begin && is_space(m_description[end - 1])) --end;
+        return m_description.substr(begin, end - begin);
+    }
+
+    void match_parentheses() {
+        m_closing.assign(m_description.size(), 0);
+        std::vector<size_t> opening;
+        for (size_t i = 0; i < m_description.size(); ++i) {
+            if (m_description[i] == '(') {
+                opening.push_back(i);
+            } else if (m_description[i] == ')') {
+                if (opening.empty()) throw Rejected();
+                m_closing[opening.back()] = i;
+                opening.pop_back();
+            }
+        }
+        if (!opening.empty()) throw Rejected();
+    }
+
+    size_t offset_of(std::string_view term) const {
+        return term.data() - m_description.data();
+    }
+
+    /// @brief Splits the arguments at commas outside of nested parentheses.
+    std::vector<std::string_view> split_arguments(size_t begin, size_t end) const {
+        std::vector<std::string_view> arguments;
+        size_t start = begin;
+        for (size_t i = begin; i < end; ++i) {
+            if (m_description[i] == '(') {
+                i = m_closing[i];
+            } else if (m_description[i] == ',') {
+                arguments.push_back(trim(start, i));
+                start = i + 1;
+            }
+        }
+        arguments.push_back(trim(start, end));
+        return arguments;
+    }
+
+    template<typename T>
+    std::shared_ptr<const T> parse_argument(std::string_view argument) {
+        auto node = parse_term(argument);
+        auto* element = std::get_if<std::shared_ptr<const T>>(&node);
+        if (!element) throw Rejected();
+        return *element;
+    }
+
+    std::shared_ptr<const Concept> parse_concept(std::string_view argument) { return parse_argument<Concept>(argument); }
+    std::shared_ptr<const Role> parse_role(std::string_view argument) { return parse_argument<Role>(argument); }
+
+    const Predicate& parse_predicate(std::string_view argument) const {
+        const auto& mapping = m_vocabulary_info->get_predicates_mapping();
+        auto it = mapping.find(std::string(argument));
+        if (it == mapping.end()) throw Rejected();
+        return m_vocabulary_info->get_predicates()[it->second];
+    }
+
+    const Constant& parse_constant(std::string_view argument) const {
+        const auto& mapping = m_vocabulary_info->get_constants_mapping();
+        auto it = mapping.find(std::string(argument));
+        if (it == mapping.end()) throw Rejected();
+        return m_vocabulary_info->get_constants()[it->second];
+    }
+
+    static int parse_integer(std::string_view argument) {
+        int value = 0;
+        auto result = std::from_chars(argument.data(), argument.data() + argument.size(), value);
+        if (result.ec != std::errc() || result.ptr != argument.data() + argument.size()) throw Rejected();
+        return value;
+    }
+
+    Node make_element(std::string_view keyword, const std::vector<std::string_view>& args) {
+        const auto arity = [&](size_t num_args) { if (args.size() != num_args) throw Rejected(); };
+        if (keyword == "b_empty") {
+            arity(1);
+            auto node = parse_term(args[0]);
+            if (auto* concept_ = std::get_if<std::shared_ptr<const Concept>>(&node)) return m_factory.make_empty_boolean(*concept_);
+            if (auto* role = std::get_if<std::shared_ptr<const Role>>(&node)) return m_factory.make_empty_boolean(*role);
+        } else if (keyword == "b_inclusion") {
+            arity(2);
+            auto left = parse_term(args[0]);
+            auto right = parse_term(args[1]);
+            auto* concept_left = std::get_if<std::shared_ptr<const Concept>>(&left);
+            auto* concept_right = std::get_if<std::shared_ptr<const Concept>>(&right);
+            if (concept_left && concept_right) return m_factory.make_inclusion_boolean(*concept_left, *concept_right);
+            auto* role_left = std::get_if<std::shared_ptr<const Role>>(&left);
+            auto* role_right = std::get_if<std::shared_ptr<const Role>>(&right);
+            if (role_left && role_right) return m_factory.make_inclusion_boolean(*role_left, *role_right);
+        } else if (keyword == "b_nullary") {
+            arity(1);
+            return m_factory.make_nullary_boolean(parse_predicate(args[0]));
+        } else if (keyword == "c_all") {
+            arity(2);
+            return m_factory.make_all_concept(parse_role(args[0]), parse_concept(args[1]));
+        } else if (keyword == "c_and") {
+            arity(2);
+            return m_factory.make_and_concept(parse_concept(args[0]), parse_concept(args[1]));
+        } else if (keyword == "c_diff") {
+            arity(2);
+            return m_factory.make_diff_concept(parse_concept(args[0]), parse_concept(args[1]));
+        } else if (keyword == "c_equal") {
+            arity(2);
+            return m_factory.make_equal_concept(parse_role(args[0]), parse_role(args[1]));
+        } else if (keyword == "c_not") {
+            arity(1);
+            return m_factory.make_not_concept(parse_concept(args[0]));
+        } else if (keyword == "c_one_of") {
+            arity(1);
+            return m_factory.make_one_of_concept(parse_constant(args[0]));
+        } else if (keyword == "c_or") {
+            arity(2);
+            return m_factory.make_or_concept(parse_concept(args[0]), parse_concept(args[1]));
+        } else if (keyword == "c_primitive") {
+            arity(2);
+            return m_factory.make_primitive_concept(parse_predicate(args[0]), parse_integer(args[1]));
+        } else if (keyword == "c_projection") {
+            arity(2);
+            return m_factory.make_projection_concept(parse_role(args[0]), parse_integer(args[1]));
+        } else if (keyword == "c_some") {
+            arity(2);
+            return m_factory.make_some_concept(parse_role(args[0]), parse_concept(args[1]));
+        } else if (keyword == "c_subset") {
+            arity(2);
+            return m_factory.make_subset_concept(parse_role(args[0]), parse_role(args[1]));
+        } else if (keyword == "n_concept_distance") {
+            arity(3);
+            return m_factory.make_concept_distance_numerical(parse_concept(args[0]), parse_role(args[1]), parse_concept(args[2]));
+        } else if (keyword == "n_count") {
+            arity(1);
+            auto node = parse_term(args[0]);
+            if (auto* concept_ = std::get_if<std::shared_ptr<const Concept>>(&node)) return m_factory.make_count_numerical(*concept_);
+            if (auto* role = std::get_if<std::shared_ptr<const Role>>(&node)) return m_factory.make_count_numerical(*role);
+        } else if (keyword == "n_role_distance") {
+            arity(3);
+            return m_factory.make_role_distance_numerical(parse_role(args[0]), parse_role(args[1]), parse_role(args[2]));
+        } else if (keyword == "n_sum_concept_distance") {
+            arity(3);
+            return m_factory.make_sum_concept_distance_numerical(parse_concept(args[0]), parse_role(args[1]), parse_concept(args[2]));
+        } else if (keyword == "n_sum_role_distance") {
+            arity(3);
+            return m_factory.make_sum_role_distance_numerical(parse_role(args[0]), parse_role(args[1]), parse_role(args[2]));
+        } else if (keyword == "r_and") {
+            arity(2);
+            return m_factory.make_and_role(parse_role(args[0]), parse_role(args[1]));
+        } else if (keyword == "r_compose") {
+            arity(2);
+            return m_factory.make_compose_role(parse_role(args[0]), parse_role(args[1]));
+        } else if (keyword == "r_diff") {
+            arity(2);
+            return m_factory.make_diff_role(parse_role(args[0]), parse_role(args[1]));
+        } else if (keyword == "r_identity") {
+            arity(1);
+            return m_factory.make_identity_role(parse_concept(args[0]));
+        } else if (keyword == "r_inverse") {
+            arity(1);
+            return m_factory.make_inverse_role(parse_role(args[0]));
+        } else if (keyword == "r_not") {
+            arity(1);
+            return m_factory.make_not_role(parse_role(args[0]));
+        } else if (keyword == "r_or") {
+            arity(2);
+            return m_factory.make_or_role(parse_role(args[0]), parse_role(args[1]));
+        } else if (keyword == "r_primitive") {
+            arity(3);
+            return m_factory.make_primitive_role(parse_predicate(args[0]), parse_integer(args[1]), parse_integer(args[2]));
+        } else if (keyword == "r_restrict") {
+            arity(2);
+            return m_factory.make_restrict_role(parse_role(args[0]), parse_concept(args[1]));
+        } else if (keyword == "r_til_c") {
+            arity(2);
+            return m_factory.make_til_c_role(parse_role(args[0]), parse_concept(args[1]));
+        } else if (keyword == "r_transitive_closure") {
+            arity(1);
+            return m_factory.make_transitive_closure(parse_role(args[0]));
+        } else if (keyword == "r_transitive_reflexive_closure") {
+            arity(1);
+            return m_factory.make_transitive_reflexive_closure(parse_role(args[0]));
+        }
+        throw Rejected();
+    }
+
+    Node parse_term(std::string_view term) {
+        std::string key(term);
+        auto cached = m_memo.find(key);
+        if (cached != m_memo.end()) {
+            return cached->second;
+        }
+        Node node;
+        const size_t begin = offset_of(term);
+        const size_t end = begin + term.size();
+        const size_t open = term.find('(');
+        if (open == std::string_view::npos) {
+            if (term == "c_bot") node = m_factory.make_bot_concept();
+            else if (term == "c_top") node = m_factory.make_top_concept();
+            else if (term == "r_top") node = m_factory.make_top_role();
+            else throw Rejected();
+        } else {
+            if (m_closing[begin + open] != end - 1) throw Rejected();
+            node = make_element(trim(begin, begin + open), split_arguments(begin + open + 1, end - 1));
+        }
+        m_memo.emplace(std::move(key), node);
+        return node;
+    }
+
+    template<typename T>
+    static void add(ElementCollection& elements, const std::shared_ptr<const T>& element) {
+        if constexpr (std::is_same_v<T, Boolean>) std::get<0>(elements).push_back(element);
+        else if constexpr (std::is_same_v<T, Numerical>) std::get<1>(elements).push_back(element);
+        else if constexpr (std::is_same_v<T, Concept>) std::get<2>(elements).push_back(element);
+        else std::get<3>(elements).push_back(element);
+    }
+
+public:
+    explicit MemoizingParser(SyntacticElementFactory& factory)
+        : m_factory(factory), m_vocabulary_info(factory.get_vocabulary_info()) { }
+
+    /// @brief Parses the description and appends the element to the elements.
+    void parse(const std::string& description, ElementCollection& elements) {
+        try {
+            m_description = description;
+            match_parentheses();
+            auto node = parse_term(trim(0, m_description.size()));
+            std::visit([&](const auto& element) { add(elements, element); }, node);
+            return;
+        } catch (const Rejected&) { }
+        auto first = trim(0, description.size()).substr(0, 2);
+        if (first == "b_") add(elements, m_factory.parse_boolean(description));
+        else if (first == "n_") add(elements, m_factory.parse_numerical(description));
+        else if (first == "c_") add(elements, m_factory.parse_concept(description));
+        else if (first == "r_") add(elements, m_factory.parse_role(description));
+        else throw std::runtime_error("SyntacticElementFactory::parse_elements - unknown type of element " + description + ".");
+    }
+};
+
+
+ElementCollection SyntacticElementFactory::parse_elements(const std::vector<std::string>& descriptions, int num_threads) {
+    const int num_descriptions = descriptions.size();
+    num_threads = std::max(1, std::min(num_threads, num_descriptions));
+    ElementCollection result;
+    if (num_threads == 1) {
+        MemoizingParser parser(*this);
+        for (const auto& description : descriptions) {
+            parser.parse(description, result);
+        }
+        return result;
+    }
+    // Each thread parses a block into its own factory. The blocks are
+    // merged through the binary format, which does not parse again.
+    std::vector<std::string> blocks(num_threads);
+    utils::parallel_for(num_descriptions, num_threads, [&](int t, int begin, int end) {
+        SyntacticElementFactory factory(get_vocabulary_info());
+        MemoizingParser parser(factory);
+        ElementCollection elements;
+        for (int i = begin; i < end; ++i) {
+            parser.parse(descriptions[i], elements);
+        }
+        blocks[t] = factory.serialize(elements);
+    });
+    for (const auto& block : blocks) {
+        auto elements = deserialize(block);
+        std::get<0>(result).insert(std::get<0>(result).end(), std::get<0>(elements).begin(), std::get<0>(elements).end());
+        std::get<1>(result).insert(std::get<1>(result).end(), std::get<1>(elements).begin(), std::get<1>(elements).end());
+        std::get<2>(result).insert(std::get<2>(result).end(), std::get<2>(elements).begin(), std::get<2>(elements).end());
+        std::get<3>(result).insert(std::get<3>(result).end(), std::get<3>(elements).begin(), std::get<3>(elements).end());
+    }
+    return result;
+}
+
+}
@@ -2,7 +2,7 @@
 
 #include "../utils/logging.h"
 #include "../../include/dlplan/utils/hash.h"
-#include "../../include/dlplan/utils/dynamic_bitset.h"
+#include "../../include/dlplan/utils/lazy_bitset.h"
 
 #include <boost/archive/text_oarchive.hpp>
 #include <boost/archive/text_iarchive.hpp>
@@ -13,7 +13,7 @@
 namespace dlplan::core {
 // we assign index undefined since we do not care
 ConceptDenotation::ConceptDenotation(int num_objects)
-    : Base<ConceptDenotation>(std::numeric_limits<int>::max()), m_num_objects(num_objects), m_data(DynamicBitset<unsigned>(num_objects)) { }
+    : Base<ConceptDenotation>(std::numeric_limits<int>::max()), m_num_objects(num_objects), m_data(LazyBitset<unsigned>(num_objects)) { }
 
 ConceptDenotation::ConceptDenotation(const ConceptDenotation& other) = default;
 
@@ -98,6 +98,22 @@ bool ConceptDenotation::is_subset_of(const ConceptDenotation& other) const {
     return m_data.is_subset_of(other.m_data);
 }
 
+bool ConceptDenotation::is_symbolic() const {
+    return m_data.is_symbolic();
+}
+
+bool ConceptDenotation::is_complemented() const {
+    return m_data.is_complemented();
+}
+
+void ConceptDenotation::materialize() {
+    m_data.materialize();
+}
+
+std::size_t ConceptDenotation::get_num_bytes() const {
+    return m_data.get_num_bytes();
+}
+
 ObjectIndices ConceptDenotation::to_vector() const {
     // In the case of bitset, the to_sorted_vector has best runtime complexity.
     return to_sorted_vector();
@@ -27,10 +27,10 @@ namespace std {
         return denotation.hash();
     }
     size_t hash<dlplan::core::ConceptDenotations>::operator()(const dlplan::core::ConceptDenotations& denotations) const {
-        return dlplan::hash_vector(denotations);
+        return denotations.hash();
     }
     size_t hash<dlplan::core::RoleDenotations>::operator()(const dlplan::core::RoleDenotations& denotations) const {
-        return dlplan::hash_vector(denotations);
+        return denotations.hash();
     }
     size_t hash<dlplan::core::DenotationsCacheKey>::operator()(const dlplan::core::DenotationsCacheKey& key) const {
         return key.hash();
@@ -66,6 +66,10 @@ std::shared_ptr<VocabularyInfo> SyntacticElementFactory::get_vocabulary_info() c
     return m_pImpl->get_vocabulary_info();
 }
 
+std::size_t SyntacticElementFactory::get_num_bytes() const {
+    return m_pImpl->get_num_bytes();
+}
+
 std::shared_ptr<const Concept> SyntacticElementFactory::parse_concept(
     const std::string &description, const std::string& filename) {
     return m_pImpl->parse_concept(*this, description, filename);
@@ -0,0 +1,415 @@
+#include "../../include/dlplan/core/cost_model.h"
+
+#include "../../include/dlplan/core.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <functional>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+
+
+namespace dlplan::core {
+
+static const std::array<std::string, NUM_ELEMENT_KINDS> ELEMENT_KIND_NAMES = {
+    "b_empty_concept",
+    "b_empty_role",
+    "b_inclusion_concept",
+    "b_inclusion_role",
+    "b_nullary",
+    "c_all",
+    "c_and",
+    "c_bot",
+    "c_diff",
+    "c_equal",
+    "c_not",
+    "c_one_of",
+    "c_or",
+    "c_primitive",
+    "c_projection",
+    "c_some",
+    "c_subset",
+    "c_top",
+    "n_concept_distance",
+    "n_count_concept",
+    "n_count_role",
+    "n_role_distance",
+    "n_sum_concept_distance",
+    "n_sum_role_distance",
+    "r_and",
+    "r_compose",
+    "r_diff",
+    "r_identity",
+    "r_inverse",
+    "r_not",
+    "r_or",
+    "r_primitive",
+    "r_restrict",
+    "r_til_c",
+    "r_top",
+    "r_transitive_closure",
+    "r_transitive_reflexive_closure",
+};
+
+/// @brief The asymptotic complexity of each operator in the number of objects.
+static const std::array<int, NUM_ELEMENT_KINDS> ELEMENT_KIND_DEGREES = {
+    1, 2, 1, 2, 1,
+    2, 1, 0, 1, 2, 1, 1, 1, 1, 2, 2, 2, 0,
+    3, 1, 2, 3, 3, 3,
+    2, 2, 2, 1, 2, 2, 2, 1, 2, 2, 0, 3, 3,
+};
+
+/// @brief The number of objects at which the default model yields the
+///        scores 1, 100, 10^4, and 10^6 for the respective degrees.
+static const int DEFAULT_REFERENCE_NUM_OBJECTS = 100;
+
+
+const std::string& get_element_kind_name(ElementKind kind) {
+    return ELEMENT_KIND_NAMES[static_cast<int>(kind)];
+}
+
+
+double OperatorCost::compute_cost(int num_objects, double denotation_density) const {
+    const double scale = std::pow(static_cast<double>(num_objects), degree);
+    return constant + linear * scale + density * scale * denotation_density;
+}
+
+
+CostModel::CostModel()
+    : m_reference_num_objects(DEFAULT_REFERENCE_NUM_OBJECTS), m_reference_density(0) {
+    for (int kind = 0; kind < NUM_ELEMENT_KINDS; ++kind) {
+        m_operator_costs[kind] = OperatorCost{ELEMENT_KIND_DEGREES[kind], 0, 1, 0};
+    }
+}
+
+CostModel::CostModel(const std::array<OperatorCost, NUM_ELEMENT_KINDS>& operator_costs, int reference_num_objects, double reference_density)
+    : m_operator_costs(operator_costs), m_reference_num_objects(reference_num_objects), m_reference_density(reference_density) { }
+
+double CostModel::compute_cost(ElementKind kind, int num_objects, double denotation_density) const {
+    return get_operator_cost(kind).compute_cost(num_objects, denotation_density);
+}
+
+int CostModel::compute_score(ElementKind kind) const {
+    const double cost = compute_cost(kind, m_reference_num_objects, m_reference_density);
+    return static_cast<int>(std::clamp(std::llround(cost), 1LL, static_cast<long long>(std::numeric_limits<int>::max() / 1024)));
+}
+
+const OperatorCost& CostModel::get_operator_cost(ElementKind kind) const {
+    return m_operator_costs[static_cast<int>(kind)];
+}
+
+int CostModel::get_reference_num_objects() const {
+    return m_reference_num_objects;
+}
+
+double CostModel::get_reference_density() const {
+    return m_reference_density;
+}
+
+std::string CostModel::str() const {
+    std::stringstream out;
+    out.precision(17);
+    out << "reference " << m_reference_num_objects << " " << m_reference_density << "\n";
+    for (int kind = 0; kind < NUM_ELEMENT_KINDS; ++kind) {
+        const auto& cost = m_operator_costs[kind];
+        out << ELEMENT_KIND_NAMES[kind] << " "
+            << cost.degree << " " << cost.constant << " " << cost.linear << " " << cost.density << "\n";
+    }
+    return out.str();
+}
+
+CostModel CostModel::parse(const std::string& description) {
+    std::stringstream in(description);
+    std::string keyword;
+    int reference_num_objects;
+    double reference_density;
+    if (!(in >> keyword >> reference_num_objects >> reference_density) || keyword != "reference") {
+        throw std::runtime_error("CostModel::parse - expected reference in first line.");
+    }
+    // Operators that are not listed keep their default cost.
+    auto operator_costs = CostModel().m_operator_costs;
+    std::string name;
+    OperatorCost cost;
+    while (in >> name) {
+        if (!(in >> cost.degree >> cost.constant >> cost.linear >> cost.density)) {
+            throw std::runtime_error("CostModel::parse - incomplete cost for " + name + ".");
+        }
+        auto it = std::find(ELEMENT_KIND_NAMES.begin(), ELEMENT_KIND_NAMES.end(), name);
+        if (it == ELEMENT_KIND_NAMES.end()) {
+            throw std::runtime_error("CostModel::parse - unknown element kind " + name + ".");
+        }
+        operator_costs[it - ELEMENT_KIND_NAMES.begin()] = cost;
+    }
+    return CostModel(operator_costs, reference_num_objects, reference_density);
+}
+
+
+static CostModel& get_mutable_cost_model() {
+    static CostModel cost_model;
+    return cost_model;
+}
+
+const CostModel& get_cost_model() {
+    return get_mutable_cost_model();
+}
+
+void set_cost_model(const CostModel& cost_model) {
+    get_mutable_cost_model() = cost_model;
+}
+
+
+/// @brief Encapsulates the element of a kind and its children.
+struct CalibrationTask {
+    ElementKind kind;
+    // Evaluates the element with caches.
+    std::function<void(const State&, DenotationsCaches&)> evaluate;
+    // Children are evaluated before the measurement such that only the operator is timed.
+    std::vector<std::shared_ptr<const Concept>> concepts;
+    std::vector<std::shared_ptr<const Role>> roles;
+};
+
+/// @brief Adds the task of evaluating the element whose children are the given concepts and roles.
+template<typename E>
+static void add_task(
+    std::vector<CalibrationTask>& tasks,
+    SyntacticElementFactory& factory,
+    ElementKind kind,
+    std::shared_ptr<const E> element,
+    const std::vector<std::string>& concepts,
+    const std::vector<std::string>& roles) {
+    CalibrationTask task{kind, [element](const State& state, DenotationsCaches& caches) { element->evaluate(state, caches); }, {}, {}};
+    for (const auto& child : concepts) task.concepts.push_back(factory.parse_concept(child));
+    for (const auto& child : roles) task.roles.push_back(factory.parse_role(child));
+    tasks.push_back(std::move(task));
+}
+
+/// @brief Returns the mean density of the denotations of the children.
+static double compute_density(const CalibrationTask& task, const State& state) {
+    const double num_objects = std::max<size_t>(1, state.get_instance_info()->get_objects().size());
+    double sum = 0;
+    for (const auto& concept_ : task.concepts) {
+        sum += concept_->evaluate(state).size() / num_objects;
+    }
+    for (const auto& role : task.roles) {
+        sum += role->evaluate(state).size() / (num_objects * num_objects);
+    }
+    const int num_children = task.concepts.size() + task.roles.size();
+    return (num_children > 0) ? sum / num_children : 0;
+}
+
+/// @brief Returns the coefficients that minimize the squared error of
+///        sum_i x[i] * w[i] = y over all samples subject to w >= 0.
+///        Since there are only three coefficients, we solve the normal
+///        equations for each subset of coefficients that is allowed to
+///        be positive and keep the best feasible solution.
+static std::array<double, 3> fit_nonnegative_least_squares(const std::vector<std::array<double, 3>>& xs, const std::vector<double>& ys) {
+    std::array<double, 3> best{0, 0, 0};
+    double best_error = std::numeric_limits<double>::infinity();
+    for (int subset = 1; subset < 8; ++subset) {
+        std::vector<int> active;
+        for (int i = 0; i < 3; ++i) {
+            if (subset & (1 << i)) active.push_back(i);
+        }
+        const int k = active.size();
+        // Augmented normal equations [X^T X | X^T y]
+        std::vector<std::vector<double>> system(k, std::vector<double>(k + 1, 0));
+        for (size_t s = 0; s < xs.size(); ++s) {
+            for (int i = 0; i < k; ++i) {
+                for (int j = 0; j < k; ++j) {
+                    system[i][j] += xs[s][active[i]] * xs[s][active[j]];
+                }
+                system[i][k] += xs[s][active[i]] * ys[s];
+            }
+        }
+        bool is_singular = false;
+        for (int col = 0; col < k && !is_singular; ++col) {
+            int pivot = col;
+            for (int row = col + 1; row < k; ++row) {
+                if (std::abs(system[row][col]) > std::abs(system[pivot][col])) pivot = row;
+            }
+            if (std::abs(system[pivot][col]) < 1e-12 * (1 + std::abs(system[col][col]))) {
+                is_singular = true;
+                break;
+            }
+            std::swap(system[col], system[pivot]);
+            for (int row = 0; row < k; ++row) {
+                if (row == col) continue;
+                const double factor = system[row][col] / system[col][col];
+                for (int j = col; j <= k; ++j) {
+                    system[row][j] -= factor * system[col][j];
+                }
+            }
+        }
+        if (is_singular) {
+            continue;
+        }
+        std::array<double, 3> weights{0, 0, 0};
+        bool is_feasible = true;
+        for (int i = 0; i < k; ++i) {
+            weights[active[i]] = system[i][k] / system[i][i];
+            is_feasible &= (weights[active[i]] >= 0);
+        }
+        if (!is_feasible) {
+            continue;
+        }
+        double error = 0;
+        for (size_t s = 0; s < xs.size(); ++s) {
+            double residual = ys[s];
+            for (int i = 0; i < 3; ++i) {
+                residual -= weights[i] * xs[s][i];
+            }
+            error += residual * residual;
+        }
+        if (error < best_error) {
+            best_error = error;
+            best = weights;
+        }
+    }
+    return best;
+}
+
+static double compute_median(std::vector<double> values) {
+    if (values.empty()) {
+        return 0;
+    }
+    auto middle = values.begin() + values.size() / 2;
+    std::nth_element(values.begin(), middle, values.end());
+    return *middle;
+}
+
+CostModel calibrate_cost_model(const States& states, int num_repetitions) {
+    if (states.empty()) {
+        throw std::runtime_error("calibrate_cost_model - states must not be empty.");
+    }
+    if (num_repetitions < 1) {
+        throw std::runtime_error("calibrate_cost_model - num_repetitions must be positive.");
+    }
+    auto vocabulary_info = states.front().get_instance_info()->get_vocabulary_info();
+    for (const auto& state : states) {
+        if (state.get_instance_info()->get_vocabulary_info() != vocabulary_info) {
+            throw std::runtime_error("calibrate_cost_model - states must share the vocabulary.");
+        }
+    }
+    // Primitives over the predicates of largest arity up to 2 are the
+    // children, falling back to top if the vocabulary has no such predicates.
+    const Predicate* unary = nullptr;
+    const Predicate* binary = nullptr;
+    const Predicate* nullary = nullptr;
+    for (const auto& predicate : vocabulary_info->get_predicates()) {
+        if (predicate.get_arity() == 0 && !nullary) nullary = &predicate;
+        if (predicate.get_arity() >= 1 && (!unary || (unary->get_arity() != 1 && predicate.get_arity() == 1))) unary = &predicate;
+        if (predicate.get_arity() >= 2 && (!binary || (binary->get_arity() != 2 && predicate.get_arity() == 2))) binary = &predicate;
+    }
+    const std::string c = unary ? "c_primitive(" + unary->get_name() + ",0)" : "c_top";
+    const std::string r = binary ? "r_primitive(" + binary->get_name() + ",0,1)" : "r_top";
+    const std::string d = "c_projection(" + r + ",1)";
+    const std::string s = "r_inverse(" + r + ")";
+
+    SyntacticElementFactory factory(vocabulary_info);
+    std::vector<CalibrationTask> tasks;
+    add_task(tasks, factory, ElementKind::EMPTY_BOOLEAN_CONCEPT, factory.parse_boolean("b_empty(" + c + ")"), {c}, {});
+    add_task(tasks, factory, ElementKind::EMPTY_BOOLEAN_ROLE, factory.parse_boolean("b_empty(" + r + ")"), {}, {r});
+    add_task(tasks, factory, ElementKind::INCLUSION_BOOLEAN_CONCEPT, factory.parse_boolean("b_inclusion(" + c + "," + d + ")"), {c, d}, {});
+    add_task(tasks, factory, ElementKind::INCLUSION_BOOLEAN_ROLE, factory.parse_boolean("b_inclusion(" + r + "," + s + ")"), {}, {r, s});
+    if (nullary) {
+        add_task(tasks, factory, ElementKind::NULLARY_BOOLEAN, factory.parse_boolean("b_nullary(" + nullary->get_name() + ")"), {}, {});
+    }
+    add_task(tasks, factory, ElementKind::ALL_CONCEPT, factory.parse_concept("c_all(" + r + "," + c + ")"), {c}, {r});
+    add_task(tasks, factory, ElementKind::AND_CONCEPT, factory.parse_concept("c_and(" + c + "," + d + ")"), {c, d}, {});
+    add_task(tasks, factory, ElementKind::BOT_CONCEPT, factory.parse_concept("c_bot"), {}, {});
+    add_task(tasks, factory, ElementKind::DIFF_CONCEPT, factory.parse_concept("c_diff(" + c + "," + d + ")"), {c, d}, {});
+    add_task(tasks, factory, ElementKind::EQUAL_CONCEPT, factory.parse_concept("c_equal(" + r + "," + s + ")"), {}, {r, s});
+    add_task(tasks, factory, ElementKind::NOT_CONCEPT, factory.parse_concept("c_not(" + c + ")"), {c}, {});
+    if (!vocabulary_info->get_constants().empty()) {
+        add_task(tasks, factory, ElementKind::ONE_OF_CONCEPT, factory.parse_concept("c_one_of(" + vocabulary_info->get_constants().front().get_name() + ")"), {}, {});
+    }
+    add_task(tasks, factory, ElementKind::OR_CONCEPT, factory.parse_concept("c_or(" + c + "," + d + ")"), {c, d}, {});
+    if (unary) {
+        // The density of a primitive is the density of its own denotation.
+        add_task(tasks, factory, ElementKind::PRIMITIVE_CONCEPT, factory.parse_concept(c), {c}, {});
+    }
+    add_task(tasks, factory, ElementKind::PROJECTION_CONCEPT, factory.parse_concept("c_projection(" + r + ",0)"), {}, {r});
+    add_task(tasks, factory, ElementKind::SOME_CONCEPT, factory.parse_concept("c_some(" + r + "," + c + ")"), {c}, {r});
+    add_task(tasks, factory, ElementKind::SUBSET_CONCEPT, factory.parse_concept("c_subset(" + r + "," + s + ")"), {}, {r, s});
+    add_task(tasks, factory, ElementKind::TOP_CONCEPT, factory.parse_concept("c_top"), {}, {});
+    add_task(tasks, factory, ElementKind::CONCEPT_DISTANCE_NUMERICAL, factory.parse_numerical("n_concept_distance(" + c + "," + r + "," + d + ")"), {c, d}, {r});
+    add_task(tasks, factory, ElementKind::COUNT_NUMERICAL_CONCEPT, factory.parse_numerical("n_count(" + c + ")"), {c}, {});
+    add_task(tasks, factory, ElementKind::COUNT_NUMERICAL_ROLE, factory.parse_numerical("n_count(" + r + ")"), {}, {r});
+    add_task(tasks, factory, ElementKind::ROLE_DISTANCE_NUMERICAL, factory.parse_numerical("n_role_distance(" + r + "," + r + "," + s + ")"), {}, {r, s});
+    add_task(tasks, factory, ElementKind::SUM_CONCEPT_DISTANCE_NUMERICAL, factory.parse_numerical("n_sum_concept_distance(" + c + "," + r + "," + d + ")"), {c, d}, {r});
+    add_task(tasks, factory, ElementKind::SUM_ROLE_DISTANCE_NUMERICAL, factory.parse_numerical("n_sum_role_distance(" + r + "," + r + "," + s + ")"), {}, {r, s});
+    add_task(tasks, factory, ElementKind::AND_ROLE, factory.parse_role("r_and(" + r + "," + s + ")"), {}, {r, s});
+    add_task(tasks, factory, ElementKind::COMPOSE_ROLE, factory.parse_role("r_compose(" + r + "," + s + ")"), {}, {r, s});
+    add_task(tasks, factory, ElementKind::DIFF_ROLE, factory.parse_role("r_diff(" + r + "," + s + ")"), {}, {r, s});
+    add_task(tasks, factory, ElementKind::IDENTITY_ROLE, factory.parse_role("r_identity(" + c + ")"), {c}, {});
+    add_task(tasks, factory, ElementKind::INVERSE_ROLE, factory.parse_role(s), {}, {r});
+    add_task(tasks, factory, ElementKind::NOT_ROLE, factory.parse_role("r_not(" + r + ")"), {}, {r});
+    add_task(tasks, factory, ElementKind::OR_ROLE, factory.parse_role("r_or(" + r + "," + s + ")"), {}, {r, s});
+    if (binary) {
+        add_task(tasks, factory, ElementKind::PRIMITIVE_ROLE, factory.parse_role(r), {}, {r});
+    }
+    add_task(tasks, factory, ElementKind::RESTRICT_ROLE, factory.parse_role("r_restrict(" + r + "," + c + ")"), {c}, {r});
+    add_task(tasks, factory, ElementKind::TIL_C_ROLE, factory.parse_role("r_til_c(" + r + "," + c + ")"), {c}, {r});
+    add_task(tasks, factory, ElementKind::TOP_ROLE, factory.parse_role("r_top"), {}, {});
+    add_task(tasks, factory, ElementKind::TRANSITIVE_CLOSURE_ROLE, factory.parse_role("r_transitive_closure(" + r + ")"), {}, {r});
+    add_task(tasks, factory, ElementKind::TRANSITIVE_REFLEXIVE_CLOSURE_ROLE, factory.parse_role("r_transitive_reflexive_closure(" + r + ")"), {}, {r});
+
+    CostModel default_cost_model;
+    std::array<OperatorCost, NUM_ELEMENT_KINDS> operator_costs;
+    std::array<bool, NUM_ELEMENT_KINDS> is_calibrated{};
+    std::vector<double> densities;
+    for (const auto& task : tasks) {
+        const int degree = default_cost_model.get_operator_cost(task.kind).degree;
+        std::vector<std::array<double, 3>> xs;
+        std::vector<double> ys;
+        for (const auto& state : states) {
+            const int num_objects = state.get_instance_info()->get_objects().size();
+            const double density = compute_density(task, state);
+            // Primitives are evaluated from scratch because they are their own child.
+            const bool is_leaf = task.kind == ElementKind::PRIMITIVE_CONCEPT || task.kind == ElementKind::PRIMITIVE_ROLE;
+            double min_ns = std::numeric_limits<double>::infinity();
+            for (int repetition = 0; repetition < num_repetitions; ++repetition) {
+                DenotationsCaches caches;
+                if (!is_leaf) {
+                    for (const auto& concept_ : task.concepts) concept_->evaluate(state, caches);
+                    for (const auto& role : task.roles) role->evaluate(state, caches);
+                }
+                auto start = std::chrono::steady_clock::now();
+                task.evaluate(state, caches);
+                auto end = std::chrono::steady_clock::now();
+                min_ns = std::min<double>(min_ns, std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count());
+            }
+            const double scale = std::pow(static_cast<double>(num_objects), degree);
+            xs.push_back({1, scale, scale * density});
+            ys.push_back(min_ns);
+            if (!task.concepts.empty() || !task.roles.empty()) {
+                densities.push_back(density);
+            }
+        }
+        auto weights = fit_nonnegative_least_squares(xs, ys);
+        operator_costs[static_cast<int>(task.kind)] = OperatorCost{degree, weights[0], weights[1], weights[2]};
+        is_calibrated[static_cast<int>(task.kind)] = true;
+    }
+    std::vector<double> nums_objects;
+    for (const auto& state : states) {
+        nums_objects.push_back(state.get_instance_info()->get_objects().size());
+    }
+    const int reference_num_objects = compute_median(nums_objects);
+    const double reference_density = compute_median(densities);
+    // Operators that cannot be constructed over the vocabulary scan
+    // the atoms of a state like primitives, and we assume a constant
+    // cost equal to that of a primitive at the reference.
+    const ElementKind fallback = is_calibrated[static_cast<int>(ElementKind::PRIMITIVE_CONCEPT)]
+        ? ElementKind::PRIMITIVE_CONCEPT : ElementKind::PROJECTION_CONCEPT;
+    const double fallback_cost = operator_costs[static_cast<int>(fallback)].compute_cost(reference_num_objects, reference_density);
+    for (int kind = 0; kind < NUM_ELEMENT_KINDS; ++kind) {
+        if (!is_calibrated[kind]) {
+            operator_costs[kind] = OperatorCost{ELEMENT_KIND_DEGREES[kind], fallback_cost, 0, 0};
+        }
+    }
+    return CostModel(operator_costs, reference_num_objects, reference_density);
+}
+
+}
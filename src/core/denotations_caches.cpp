@@ -7,12 +7,50 @@ namespace dlplan::core {
 
 DenotationsCaches::DenotationsCaches() = default;
 
+DenotationsCaches::DenotationsCaches(int num_shards) : data(num_shards) { }
+
 DenotationsCaches::~DenotationsCaches() = default;
 
 DenotationsCaches::DenotationsCaches(DenotationsCaches&& other) = default;
 
 DenotationsCaches& DenotationsCaches::operator=(DenotationsCaches&& other) = default;
 
+std::size_t DenotationsCaches::get_num_bytes() const {
+    return data.get_num_bytes();
+}
+
+void DenotationsCaches::set_memory_limit(std::size_t num_bytes) {
+    data.set_memory_limit(num_bytes);
+}
+
+std::size_t DenotationsCaches::get_memory_limit() const {
+    return data.get_memory_limit();
+}
+
+int DenotationsCaches::get_num_shards() const {
+    return data.get_num_shards();
+}
+
+std::size_t DenotationsCaches::get_num_hits() const {
+    return data.get_statistics().num_hits;
+}
+
+std::size_t DenotationsCaches::get_num_misses() const {
+    return data.get_statistics().num_misses;
+}
+
+std::size_t DenotationsCaches::get_num_evictions() const {
+    return data.get_statistics().num_evictions;
+}
+
+double DenotationsCaches::get_hit_rate() const {
+    return data.get_statistics().get_hit_rate();
+}
+
+void DenotationsCaches::reset_statistics() {
+    data.reset_statistics();
+}
+
 bool DenotationsCacheKey::operator==(const DenotationsCacheKey& other) const {
     return (element == other.element) &&
            (instance == other.instance) &&
@@ -24,3 +62,42 @@ size_t DenotationsCacheKey::hash() const {
 }
 
 }
+
+
+namespace dlplan {
+    static std::size_t compute_num_bitset_bytes(std::size_t num_bits) {
+        const std::size_t bits_per_block = 8 * sizeof(unsigned);
+        return (num_bits + bits_per_block - 1) / bits_per_block * sizeof(unsigned);
+    }
+
+    std::size_t SharedObjectSize<core::ConceptDenotation>::operator()(const core::ConceptDenotation& denotation) const {
+        return sizeof(core::ConceptDenotation) + denotation.get_num_bytes();
+    }
+
+    std::size_t SharedObjectSize<core::RoleDenotation>::operator()(const core::RoleDenotation& denotation) const {
+        return sizeof(core::RoleDenotation) + denotation.get_num_bytes();
+    }
+
+    // Lists only own the ids because the denotations are cached separately.
+    std::size_t SharedObjectSize<core::ConceptDenotations>::operator()(const core::ConceptDenotations& denotations) const {
+        return sizeof(core::ConceptDenotations) + denotations.get_num_bytes();
+    }
+
+    std::size_t SharedObjectSize<core::RoleDenotations>::operator()(const core::RoleDenotations& denotations) const {
+        return sizeof(core::RoleDenotations) + denotations.get_num_bytes();
+    }
+
+    std::size_t SharedObjectSize<core::BooleanDenotations>::operator()(const core::BooleanDenotations& denotations) const {
+        return sizeof(core::BooleanDenotations) + compute_num_bitset_bytes(denotations.capacity());
+    }
+
+    std::size_t SharedObjectSize<core::NumericalDenotations>::operator()(const core::NumericalDenotations& denotations) const {
+        return sizeof(core::NumericalDenotations) + denotations.capacity() * sizeof(int);
+    }
+
+    // Static denotations are needed by every state and batch results refer to
+    // their denotations by ids.
+    bool SharedObjectPinned<core::DenotationsCacheKey>::operator()(const core::DenotationsCacheKey& key) const {
+        return key.state == -1;
+    }
+}
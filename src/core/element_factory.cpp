@@ -321,6 +321,10 @@ std::shared_ptr<VocabularyInfo> SyntacticElementFactoryImpl::get_vocabulary_info
     return m_vocabulary_info;
 }
 
+std::size_t SyntacticElementFactoryImpl::get_num_bytes() const {
+    return m_cache.get_num_bytes();
+}
+
 }
 
 namespace dlplan {
@@ -154,6 +154,7 @@ public:
      * Getters.
      */
     std::shared_ptr<VocabularyInfo> get_vocabulary_info() const;
+    std::size_t get_num_bytes() const;
 };
 
 }
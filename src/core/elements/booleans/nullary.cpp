@@ -68,8 +68,13 @@ void NullaryBoolean::str_impl(std::stringstream& out) const {
     out << "b_nullary" << "(" << m_predicate.get_name() << ")";
 }
 
+void NullaryBoolean::serialize_impl(ElementSerializer& out) const {
+    out.write_kind(ElementKind::NULLARY_BOOLEAN);
+    out.write_predicate(m_predicate);
+}
+
 int NullaryBoolean::compute_evaluate_time_score_impl() const {
-    return SCORE_LINEAR;
+    return get_cost_model().compute_score(ElementKind::NULLARY_BOOLEAN);
 }
 
 }
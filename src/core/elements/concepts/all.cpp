@@ -22,7 +22,7 @@ ConceptDenotation AllConcept::evaluate_impl(const State& state, DenotationsCache
 }
 
 ConceptDenotations AllConcept::evaluate_impl(const States& states, DenotationsCaches& caches) const {
-    ConceptDenotations denotations;
+    ConceptDenotations denotations(caches.data.get_pool<ConceptDenotation>());
     denotations.reserve(states.size());
     auto role_denotations = m_role->evaluate(states, caches);
     auto concept_denotations = m_concept->evaluate(states, caches);
@@ -32,7 +32,7 @@ ConceptDenotations AllConcept::evaluate_impl(const States& states, DenotationsCa
             *(*role_denotations)[i],
             *(*concept_denotations)[i],
             denotation);
-        denotations.push_back(caches.data.insert_unique<ConceptDenotation>(std::move(denotation)));
+        denotations.push_back(caches.data.insert_unique_id<ConceptDenotation>(std::move(denotation)));
     }
     return denotations;
 }
@@ -75,8 +75,14 @@ void AllConcept::str_impl(std::stringstream& out) const {
     out << ")";
 }
 
+void AllConcept::serialize_impl(ElementSerializer& out) const {
+    out.write_kind(ElementKind::ALL_CONCEPT);
+    out.write_element(*m_role);
+    out.write_element(*m_concept);
+}
+
 int AllConcept::compute_evaluate_time_score_impl() const {
-    return m_role->compute_evaluate_time_score() + m_concept->compute_evaluate_time_score() + SCORE_QUADRATIC;
+    return m_role->compute_evaluate_time_score() + m_concept->compute_evaluate_time_score() + get_cost_model().compute_score(ElementKind::ALL_CONCEPT);
 }
 
 }
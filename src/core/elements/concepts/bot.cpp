@@ -7,11 +7,11 @@ ConceptDenotation BotConcept::evaluate_impl(const State& state, DenotationsCache
 }
 
 ConceptDenotations BotConcept::evaluate_impl(const States& states, DenotationsCaches& caches) const {
-    ConceptDenotations denotations;
+    ConceptDenotations denotations(caches.data.get_pool<ConceptDenotation>());
     denotations.reserve(states.size());
     for (size_t i = 0; i < states.size(); ++i) {
         ConceptDenotation denotation(states[i].get_instance_info()->get_objects().size());
-        denotations.push_back(caches.data.insert_unique(std::move(denotation)));
+        denotations.push_back(caches.data.insert_unique_id(std::move(denotation)));
     }
     return denotations;
 }
@@ -43,8 +43,12 @@ void BotConcept::str_impl(std::stringstream& out) const {
     out << "c_bot";
 }
 
+void BotConcept::serialize_impl(ElementSerializer& out) const {
+    out.write_kind(ElementKind::BOT_CONCEPT);
+}
+
 int BotConcept::compute_evaluate_time_score_impl() const {
-    return SCORE_CONSTANT;
+    return get_cost_model().compute_score(ElementKind::BOT_CONCEPT);
 }
 
 }
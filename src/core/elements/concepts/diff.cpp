@@ -17,7 +17,7 @@ ConceptDenotation DiffConcept::evaluate_impl(const State& state, DenotationsCach
 }
 
 ConceptDenotations DiffConcept::evaluate_impl(const States& states, DenotationsCaches& caches) const {
-    ConceptDenotations denotations;
+    ConceptDenotations denotations(caches.data.get_pool<ConceptDenotation>());
     denotations.reserve(states.size());
     auto concept_left_denotations = m_concept_left->evaluate(states, caches);
     auto concept_right_denotations = m_concept_right->evaluate(states, caches);
@@ -27,7 +27,7 @@ ConceptDenotations DiffConcept::evaluate_impl(const States& states, DenotationsC
             *(*concept_left_denotations)[i],
             *(*concept_right_denotations)[i],
             denotation);
-        denotations.push_back(caches.data.insert_unique(std::move(denotation)));
+        denotations.push_back(caches.data.insert_unique_id(std::move(denotation)));
     }
     return denotations;
 }
@@ -70,8 +70,14 @@ void DiffConcept::str_impl(std::stringstream& out) const {
     out << ")";
 }
 
+void DiffConcept::serialize_impl(ElementSerializer& out) const {
+    out.write_kind(ElementKind::DIFF_CONCEPT);
+    out.write_element(*m_concept_left);
+    out.write_element(*m_concept_right);
+}
+
 int DiffConcept::compute_evaluate_time_score_impl() const {
-    return m_concept_left->compute_evaluate_time_score() + m_concept_right->compute_evaluate_time_score() + SCORE_LINEAR;
+    return m_concept_left->compute_evaluate_time_score() + m_concept_right->compute_evaluate_time_score() + get_cost_model().compute_score(ElementKind::DIFF_CONCEPT);
 }
 
 }
@@ -23,7 +23,7 @@ ConceptDenotation EqualConcept::evaluate_impl(const State& state, DenotationsCac
 }
 
 ConceptDenotations EqualConcept::evaluate_impl(const States& states, DenotationsCaches& caches) const {
-    ConceptDenotations denotations;
+    ConceptDenotations denotations(caches.data.get_pool<ConceptDenotation>());
     denotations.reserve(states.size());
     auto role_left_denotations = m_role_left->evaluate(states, caches);
     auto role_right_denotations = m_role_right->evaluate(states, caches);
@@ -34,7 +34,7 @@ ConceptDenotations EqualConcept::evaluate_impl(const States& states, Denotations
             *(*role_right_denotations)[i],
             denotation);
         // register denotation and append it to denotations.
-        denotations.push_back(caches.data.insert_unique(std::move(denotation)));
+        denotations.push_back(caches.data.insert_unique_id(std::move(denotation)));
     }
     return denotations;
 }
@@ -78,8 +78,14 @@ void EqualConcept::str_impl(std::stringstream& out) const {
     out << ")";
 }
 
+void EqualConcept::serialize_impl(ElementSerializer& out) const {
+    out.write_kind(ElementKind::EQUAL_CONCEPT);
+    out.write_element(*m_role_left);
+    out.write_element(*m_role_right);
+}
+
 int EqualConcept::compute_evaluate_time_score_impl() const {
-    return m_role_left->compute_evaluate_time_score() + m_role_right->compute_evaluate_time_score() + SCORE_QUADRATIC;
+    return m_role_left->compute_evaluate_time_score() + m_role_right->compute_evaluate_time_score() + get_cost_model().compute_score(ElementKind::EQUAL_CONCEPT);
 }
 
 }
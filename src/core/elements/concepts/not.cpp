@@ -17,7 +17,7 @@ ConceptDenotation NotConcept::evaluate_impl(const State& state, DenotationsCache
 }
 
 ConceptDenotations NotConcept::evaluate_impl(const States& states, DenotationsCaches& caches) const {
-    ConceptDenotations denotations;
+    ConceptDenotations denotations(caches.data.get_pool<ConceptDenotation>());
     denotations.reserve(states.size());
     // get denotations of children
     auto concept_denotations = m_concept->evaluate(states, caches);
@@ -26,7 +26,7 @@ ConceptDenotations NotConcept::evaluate_impl(const States& states, DenotationsCa
         compute_result(
             *(*concept_denotations)[i],
             denotation);
-        denotations.push_back(caches.data.insert_unique(std::move(denotation)));
+        denotations.push_back(caches.data.insert_unique_id(std::move(denotation)));
     }
     return denotations;
 }
@@ -65,8 +65,13 @@ void NotConcept::str_impl(std::stringstream& out) const {
     out << ")";
 }
 
+void NotConcept::serialize_impl(ElementSerializer& out) const {
+    out.write_kind(ElementKind::NOT_CONCEPT);
+    out.write_element(*m_concept);
+}
+
 int NotConcept::compute_evaluate_time_score_impl() const {
-    return m_concept->compute_evaluate_time_score() + SCORE_LINEAR;
+    return m_concept->compute_evaluate_time_score() + get_cost_model().compute_score(ElementKind::NOT_CONCEPT);
 }
 
 }
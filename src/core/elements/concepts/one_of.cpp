@@ -25,14 +25,14 @@ ConceptDenotation OneOfConcept::evaluate_impl(const State& state, DenotationsCac
 }
 
 ConceptDenotations OneOfConcept::evaluate_impl(const States& states, DenotationsCaches& caches) const {
-    ConceptDenotations denotations;
+    ConceptDenotations denotations(caches.data.get_pool<ConceptDenotation>());
     denotations.reserve(states.size());
     for (size_t i = 0; i < states.size(); ++i) {
         ConceptDenotation denotation(states[i].get_instance_info()->get_objects().size());
         compute_result(
             states[i],
             denotation);
-        denotations.push_back(caches.data.insert_unique(std::move(denotation)));
+        denotations.push_back(caches.data.insert_unique_id(std::move(denotation)));
     }
     return denotations;
 }
@@ -67,8 +67,13 @@ void OneOfConcept::str_impl(std::stringstream& out) const {
     out << "c_one_of" << "(" << m_constant.get_name() << ")";
 }
 
+void OneOfConcept::serialize_impl(ElementSerializer& out) const {
+    out.write_kind(ElementKind::ONE_OF_CONCEPT);
+    out.write_constant(m_constant);
+}
+
 int OneOfConcept::compute_evaluate_time_score_impl() const {
-    return SCORE_LINEAR;
+    return get_cost_model().compute_score(ElementKind::ONE_OF_CONCEPT);
 }
 
 }
@@ -31,14 +31,14 @@ ConceptDenotation PrimitiveConcept::evaluate_impl(const State& state, Denotation
 }
 
 ConceptDenotations PrimitiveConcept::evaluate_impl(const States& states, DenotationsCaches& caches) const {
-    ConceptDenotations denotations;
+    ConceptDenotations denotations(caches.data.get_pool<ConceptDenotation>());
     denotations.reserve(states.size());
     for (size_t i = 0; i < states.size(); ++i) {
         ConceptDenotation denotation(states[i].get_instance_info()->get_objects().size());
         compute_result(
             states[i],
             denotation);
-        denotations.push_back(caches.data.insert_unique(std::move(denotation)));
+        denotations.push_back(caches.data.insert_unique_id(std::move(denotation)));
     }
     return denotations;
 }
@@ -78,8 +78,14 @@ void PrimitiveConcept::str_impl(std::stringstream& out) const {
     out << "c_primitive" << "(" << m_predicate.get_name() << "," << std::to_string(m_pos) << ")";
 }
 
+void PrimitiveConcept::serialize_impl(ElementSerializer& out) const {
+    out.write_kind(ElementKind::PRIMITIVE_CONCEPT);
+    out.write_predicate(m_predicate);
+    out.write_integer(m_pos);
+}
+
 int PrimitiveConcept::compute_evaluate_time_score_impl() const {
-    return SCORE_LINEAR;
+    return get_cost_model().compute_score(ElementKind::PRIMITIVE_CONCEPT);
 }
 
 }
@@ -18,7 +18,7 @@ ConceptDenotation ProjectionConcept::evaluate_impl(const State& state, Denotatio
 }
 
 ConceptDenotations ProjectionConcept::evaluate_impl(const States& states, DenotationsCaches& caches) const {
-    ConceptDenotations denotations;
+    ConceptDenotations denotations(caches.data.get_pool<ConceptDenotation>());
     denotations.reserve(states.size());
     auto role_denotations = m_role->evaluate(states, caches);
     for (size_t i = 0; i < states.size(); ++i) {
@@ -26,7 +26,7 @@ ConceptDenotations ProjectionConcept::evaluate_impl(const States& states, Denota
         compute_result(
             *(*role_denotations)[i],
             denotation);
-        denotations.push_back(caches.data.insert_unique(std::move(denotation)));
+        denotations.push_back(caches.data.insert_unique_id(std::move(denotation)));
     }
     return denotations;
 }
@@ -70,8 +70,14 @@ void ProjectionConcept::str_impl(std::stringstream& out) const {
     out << "," << std::to_string(m_pos) << ")";
 }
 
+void ProjectionConcept::serialize_impl(ElementSerializer& out) const {
+    out.write_kind(ElementKind::PROJECTION_CONCEPT);
+    out.write_element(*m_role);
+    out.write_integer(m_pos);
+}
+
 int ProjectionConcept::compute_evaluate_time_score_impl() const {
-    return m_role->compute_evaluate_time_score() + SCORE_QUADRATIC;
+    return m_role->compute_evaluate_time_score() + get_cost_model().compute_score(ElementKind::PROJECTION_CONCEPT);
 }
 
 }
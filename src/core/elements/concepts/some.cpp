@@ -21,7 +21,7 @@ ConceptDenotation SomeConcept::evaluate_impl(const State& state, DenotationsCach
 }
 
 ConceptDenotations SomeConcept::evaluate_impl(const States& states, DenotationsCaches& caches) const {
-    ConceptDenotations denotations;
+    ConceptDenotations denotations(caches.data.get_pool<ConceptDenotation>());
     denotations.reserve(states.size());
     auto role_denotations = m_role->evaluate(states, caches);
     auto concept_denotations = m_concept->evaluate(states, caches);
@@ -31,7 +31,7 @@ ConceptDenotations SomeConcept::evaluate_impl(const States& states, DenotationsC
             *(*role_denotations)[i],
             *(*concept_denotations)[i],
             denotation);
-        denotations.push_back(caches.data.insert_unique(std::move(denotation)));
+        denotations.push_back(caches.data.insert_unique_id(std::move(denotation)));
     }
     return denotations;
 }
@@ -74,8 +74,14 @@ void SomeConcept::str_impl(std::stringstream& out) const {
     out << ")";
 }
 
+void SomeConcept::serialize_impl(ElementSerializer& out) const {
+    out.write_kind(ElementKind::SOME_CONCEPT);
+    out.write_element(*m_role);
+    out.write_element(*m_concept);
+}
+
 int SomeConcept::compute_evaluate_time_score_impl() const {
-    return m_role->compute_evaluate_time_score() + m_concept->compute_evaluate_time_score() + SCORE_QUADRATIC;
+    return m_role->compute_evaluate_time_score() + m_concept->compute_evaluate_time_score() + get_cost_model().compute_score(ElementKind::SOME_CONCEPT);
 }
 
 }
@@ -20,7 +20,7 @@ ConceptDenotation SubsetConcept::evaluate_impl(const State& state, DenotationsCa
 }
 
 ConceptDenotations SubsetConcept::evaluate_impl(const States& states, DenotationsCaches& caches) const {
-    ConceptDenotations denotations;
+    ConceptDenotations denotations(caches.data.get_pool<ConceptDenotation>());
     denotations.reserve(states.size());
     auto role_left_denotations = m_role_left->evaluate(states, caches);
     auto role_right_denotations = m_role_right->evaluate(states, caches);
@@ -31,7 +31,7 @@ ConceptDenotations SubsetConcept::evaluate_impl(const States& states, Denotation
             *(*role_right_denotations)[i],
             denotation);
         // register denotation and append it to denotations.
-        denotations.push_back(caches.data.insert_unique(std::move(denotation)));
+        denotations.push_back(caches.data.insert_unique_id(std::move(denotation)));
     }
     return denotations;
 }
@@ -74,8 +74,14 @@ void SubsetConcept::str_impl(std::stringstream& out) const {
     out << ")";
 }
 
+void SubsetConcept::serialize_impl(ElementSerializer& out) const {
+    out.write_kind(ElementKind::SUBSET_CONCEPT);
+    out.write_element(*m_role_left);
+    out.write_element(*m_role_right);
+}
+
 int SubsetConcept::compute_evaluate_time_score_impl() const {
-    return m_role_left->compute_evaluate_time_score() + m_role_right->compute_evaluate_time_score() + SCORE_QUADRATIC;
+    return m_role_left->compute_evaluate_time_score() + m_role_right->compute_evaluate_time_score() + get_cost_model().compute_score(ElementKind::SUBSET_CONCEPT);
 }
 
 }
@@ -9,12 +9,12 @@ ConceptDenotation TopConcept::evaluate_impl(const State& state, DenotationsCache
 }
 
 ConceptDenotations TopConcept::evaluate_impl(const States& states, DenotationsCaches& caches) const {
-    ConceptDenotations denotations;
+    ConceptDenotations denotations(caches.data.get_pool<ConceptDenotation>());
     denotations.reserve(states.size());
     for (size_t i = 0; i < states.size(); ++i) {
         ConceptDenotation denotation(states[i].get_instance_info()->get_objects().size());
         denotation.set();
-        denotations.push_back(caches.data.insert_unique(std::move(denotation)));
+        denotations.push_back(caches.data.insert_unique_id(std::move(denotation)));
     }
     return denotations;
 }
@@ -49,8 +49,12 @@ void TopConcept::str_impl(std::stringstream& out) const {
     out << "c_top";
 }
 
+void TopConcept::serialize_impl(ElementSerializer& out) const {
+    out.write_kind(ElementKind::TOP_CONCEPT);
+}
+
 int TopConcept::compute_evaluate_time_score_impl() const {
-    return SCORE_CONSTANT;
+    return get_cost_model().compute_score(ElementKind::TOP_CONCEPT);
 }
 
 }
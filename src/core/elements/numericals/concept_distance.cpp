@@ -108,8 +108,15 @@ void ConceptDistanceNumerical::str_impl(std::stringstream& out) const {
     out << ")";
 }
 
+void ConceptDistanceNumerical::serialize_impl(ElementSerializer& out) const {
+    out.write_kind(ElementKind::CONCEPT_DISTANCE_NUMERICAL);
+    out.write_element(*m_concept_from);
+    out.write_element(*m_role);
+    out.write_element(*m_concept_to);
+}
+
 int ConceptDistanceNumerical::compute_evaluate_time_score_impl() const {
-    return m_concept_from->compute_evaluate_time_score() + m_role->compute_evaluate_time_score() + m_concept_to->compute_evaluate_time_score() + SCORE_QUBIC;
+    return m_concept_from->compute_evaluate_time_score() + m_role->compute_evaluate_time_score() + m_concept_to->compute_evaluate_time_score() + get_cost_model().compute_score(ElementKind::CONCEPT_DISTANCE_NUMERICAL);
 }
 
 }
@@ -108,8 +108,15 @@ void RoleDistanceNumerical::str_impl(std::stringstream& out) const {
     out << ")";
 }
 
+void RoleDistanceNumerical::serialize_impl(ElementSerializer& out) const {
+    out.write_kind(ElementKind::ROLE_DISTANCE_NUMERICAL);
+    out.write_element(*m_role_from);
+    out.write_element(*m_role);
+    out.write_element(*m_role_to);
+}
+
 int RoleDistanceNumerical::compute_evaluate_time_score_impl() const {
-    return m_role_from->compute_evaluate_time_score() + m_role->compute_evaluate_time_score() + m_role_to->compute_evaluate_time_score() + SCORE_QUBIC;
+    return m_role_from->compute_evaluate_time_score() + m_role->compute_evaluate_time_score() + m_role_to->compute_evaluate_time_score() + get_cost_model().compute_score(ElementKind::ROLE_DISTANCE_NUMERICAL);
 }
 
 }
@@ -105,8 +105,15 @@ void SumConceptDistanceNumerical::str_impl(std::stringstream& out) const {
     out << ")";
 }
 
+void SumConceptDistanceNumerical::serialize_impl(ElementSerializer& out) const {
+    out.write_kind(ElementKind::SUM_CONCEPT_DISTANCE_NUMERICAL);
+    out.write_element(*m_concept_from);
+    out.write_element(*m_role);
+    out.write_element(*m_concept_to);
+}
+
 int SumConceptDistanceNumerical::compute_evaluate_time_score_impl() const {
-    return m_concept_from->compute_evaluate_time_score() + m_role->compute_evaluate_time_score() + m_concept_to->compute_evaluate_time_score() + SCORE_QUBIC;
+    return m_concept_from->compute_evaluate_time_score() + m_role->compute_evaluate_time_score() + m_concept_to->compute_evaluate_time_score() + get_cost_model().compute_score(ElementKind::SUM_CONCEPT_DISTANCE_NUMERICAL);
 }
 
 }
@@ -18,7 +18,7 @@ RoleDenotation AndRole::evaluate_impl(const State& state, DenotationsCaches& cac
 }
 
 RoleDenotations AndRole::evaluate_impl(const States& states, DenotationsCaches& caches) const {
-    RoleDenotations denotations;
+    RoleDenotations denotations(caches.data.get_pool<RoleDenotation>());
     denotations.reserve(states.size());
     auto role_left_denotations = m_role_left->evaluate(states, caches);
     auto role_right_denotations = m_role_right->evaluate(states, caches);
@@ -28,7 +28,7 @@ RoleDenotations AndRole::evaluate_impl(const States& states, DenotationsCaches&
             *(*role_left_denotations)[i],
             *(*role_right_denotations)[i],
             denotation);
-        denotations.push_back(caches.data.insert_unique(std::move(denotation)));
+        denotations.push_back(caches.data.insert_unique_id(std::move(denotation)));
     }
     return denotations;
 }
@@ -73,8 +73,14 @@ void AndRole::str_impl(std::stringstream& out) const {
     out << ")";
 }
 
+void AndRole::serialize_impl(ElementSerializer& out) const {
+    out.write_kind(ElementKind::AND_ROLE);
+    out.write_element(*m_role_left);
+    out.write_element(*m_role_right);
+}
+
 int AndRole::compute_evaluate_time_score_impl() const {
-    return m_role_left->compute_evaluate_time_score() + m_role_right->compute_evaluate_time_score() + SCORE_QUADRATIC;
+    return m_role_left->compute_evaluate_time_score() + m_role_right->compute_evaluate_time_score() + get_cost_model().compute_score(ElementKind::AND_ROLE);
 }
 
 }
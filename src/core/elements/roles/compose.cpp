@@ -3,16 +3,8 @@
 
 namespace dlplan::core {
 void ComposeRole::compute_result(const RoleDenotation& left_denot, const RoleDenotation& right_denot, RoleDenotation& result) const {
-    // Compute sparse representation.
-    PairsOfObjectIndices left_pairs = left_denot.to_vector();
-    PairsOfObjectIndices right_pairs = right_denot.to_vector();
-    for (const auto& left_pair : left_pairs) {  // source
-        for (const auto& right_pair : right_pairs) {  // target
-            if (left_pair.second == right_pair.first) {
-                result.insert(std::make_pair(left_pair.first, right_pair.second));
-            }
-        }
-    }
+    // Join the sorted pairs and insert in bulk to support both forms.
+    result.insert_all(utils::compute_composition(left_denot.to_sorted_vector(), right_denot.to_sorted_vector(), result.get_num_objects()));
 }
 
 RoleDenotation ComposeRole::evaluate_impl(const State& state, DenotationsCaches& caches) const {
@@ -25,7 +17,7 @@ RoleDenotation ComposeRole::evaluate_impl(const State& state, DenotationsCaches&
 }
 
 RoleDenotations ComposeRole::evaluate_impl(const States& states, DenotationsCaches& caches) const {
-    RoleDenotations denotations;
+    RoleDenotations denotations(caches.data.get_pool<RoleDenotation>());
     denotations.reserve(states.size());
     auto role_left_denotations = m_role_left->evaluate(states, caches);
     auto role_right_denotations = m_role_right->evaluate(states, caches);
@@ -35,7 +27,7 @@ RoleDenotations ComposeRole::evaluate_impl(const States& states, DenotationsCach
             *(*role_left_denotations)[i],
             *(*role_right_denotations)[i],
             denotation);
-        denotations.push_back(caches.data.insert_unique(std::move(denotation)));
+        denotations.push_back(caches.data.insert_unique_id(std::move(denotation)));
     }
     return denotations;
 }
@@ -78,8 +70,14 @@ void ComposeRole::str_impl(std::stringstream& out) const {
     out << ")";
 }
 
+void ComposeRole::serialize_impl(ElementSerializer& out) const {
+    out.write_kind(ElementKind::COMPOSE_ROLE);
+    out.write_element(*m_role_left);
+    out.write_element(*m_role_right);
+}
+
 int ComposeRole::compute_evaluate_time_score_impl() const {
-    return m_role_left->compute_evaluate_time_score() + m_role_right->compute_evaluate_time_score() + SCORE_QUADRATIC;
+    return m_role_left->compute_evaluate_time_score() + m_role_right->compute_evaluate_time_score() + get_cost_model().compute_score(ElementKind::COMPOSE_ROLE);
 }
 
 }
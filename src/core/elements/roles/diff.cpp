@@ -17,7 +17,7 @@ RoleDenotation DiffRole::evaluate_impl(const State& state, DenotationsCaches& ca
 }
 
 RoleDenotations DiffRole::evaluate_impl(const States& states, DenotationsCaches& caches) const {
-    RoleDenotations denotations;
+    RoleDenotations denotations(caches.data.get_pool<RoleDenotation>());
     denotations.reserve(states.size());
     auto role_left_denotations = m_role_left->evaluate(states, caches);
     auto role_right_denotations = m_role_right->evaluate(states, caches);
@@ -27,7 +27,7 @@ RoleDenotations DiffRole::evaluate_impl(const States& states, DenotationsCaches&
             *(*role_left_denotations)[i],
             *(*role_right_denotations)[i],
             denotation);
-        denotations.push_back(caches.data.insert_unique(std::move(denotation)));
+        denotations.push_back(caches.data.insert_unique_id(std::move(denotation)));
     }
     return denotations;
 }
@@ -70,8 +70,14 @@ void DiffRole::str_impl(std::stringstream& out) const {
     out << ")";
 }
 
+void DiffRole::serialize_impl(ElementSerializer& out) const {
+    out.write_kind(ElementKind::DIFF_ROLE);
+    out.write_element(*m_role_left);
+    out.write_element(*m_role_right);
+}
+
 int DiffRole::compute_evaluate_time_score_impl() const {
-    return m_role_left->compute_evaluate_time_score() + m_role_right->compute_evaluate_time_score() + SCORE_QUADRATIC;
+    return m_role_left->compute_evaluate_time_score() + m_role_right->compute_evaluate_time_score() + get_cost_model().compute_score(ElementKind::DIFF_ROLE);
 }
 
 }
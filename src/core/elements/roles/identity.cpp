@@ -17,7 +17,7 @@ RoleDenotation IdentityRole::evaluate_impl(const State& state, DenotationsCaches
 }
 
 RoleDenotations IdentityRole::evaluate_impl(const States& states, DenotationsCaches& caches) const {
-    RoleDenotations denotations;
+    RoleDenotations denotations(caches.data.get_pool<RoleDenotation>());
     denotations.reserve(states.size());
     auto concept_denotations = m_concept->evaluate(states, caches);
     for (size_t i = 0; i < states.size(); ++i) {
@@ -25,7 +25,7 @@ RoleDenotations IdentityRole::evaluate_impl(const States& states, DenotationsCac
         compute_result(
             *(*concept_denotations)[i],
             denotation);
-        denotations.push_back(caches.data.insert_unique(std::move(denotation)));
+        denotations.push_back(caches.data.insert_unique_id(std::move(denotation)));
     }
     return denotations;
 }
@@ -64,8 +64,13 @@ void IdentityRole::str_impl(std::stringstream& out) const {
     out << ")";
 }
 
+void IdentityRole::serialize_impl(ElementSerializer& out) const {
+    out.write_kind(ElementKind::IDENTITY_ROLE);
+    out.write_element(*m_concept);
+}
+
 int IdentityRole::compute_evaluate_time_score_impl() const {
-    return m_concept->compute_evaluate_time_score() + SCORE_LINEAR;
+    return m_concept->compute_evaluate_time_score() + get_cost_model().compute_score(ElementKind::IDENTITY_ROLE);
 }
 
 }
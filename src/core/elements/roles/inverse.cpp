@@ -3,9 +3,11 @@
 
 namespace dlplan::core {
 void InverseRole::compute_result(const RoleDenotation& denot, RoleDenotation& result) const {
+    PairsOfObjectIndices pairs;
     for (const auto& pair : denot.to_vector()) {
-        result.insert(std::make_pair(pair.second, pair.first));
+        pairs.emplace_back(pair.second, pair.first);
     }
+    result.insert_all(pairs);
 }
 
 RoleDenotation InverseRole::evaluate_impl(const State& state, DenotationsCaches& caches) const {
@@ -17,7 +19,7 @@ RoleDenotation InverseRole::evaluate_impl(const State& state, DenotationsCaches&
 }
 
 RoleDenotations InverseRole::evaluate_impl(const States& states, DenotationsCaches& caches) const {
-    RoleDenotations denotations;
+    RoleDenotations denotations(caches.data.get_pool<RoleDenotation>());
     denotations.reserve(states.size());
     auto role_denotations = m_role->evaluate(states, caches);
     for (size_t i = 0; i < states.size(); ++i) {
@@ -25,7 +27,7 @@ RoleDenotations InverseRole::evaluate_impl(const States& states, DenotationsCach
         compute_result(
             *(*role_denotations)[i],
             denotation);
-        denotations.push_back(caches.data.insert_unique(std::move(denotation)));
+        denotations.push_back(caches.data.insert_unique_id(std::move(denotation)));
     }
     return denotations;
 }
@@ -64,8 +66,13 @@ void InverseRole::str_impl(std::stringstream& out) const {
     out << ")";
 }
 
+void InverseRole::serialize_impl(ElementSerializer& out) const {
+    out.write_kind(ElementKind::INVERSE_ROLE);
+    out.write_element(*m_role);
+}
+
 int InverseRole::compute_evaluate_time_score_impl() const {
-    return m_role->compute_evaluate_time_score() + SCORE_QUADRATIC;
+    return m_role->compute_evaluate_time_score() + get_cost_model().compute_score(ElementKind::INVERSE_ROLE);
 }
 
 }
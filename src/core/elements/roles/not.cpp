@@ -16,7 +16,7 @@ RoleDenotation NotRole::evaluate_impl(const State& state, DenotationsCaches& cac
 }
 
 RoleDenotations NotRole::evaluate_impl(const States& states, DenotationsCaches& caches) const {
-    RoleDenotations denotations;
+    RoleDenotations denotations(caches.data.get_pool<RoleDenotation>());
     denotations.reserve(states.size());
     auto role_denotations = m_role->evaluate(states, caches);
     for (size_t i = 0; i < states.size(); ++i) {
@@ -24,7 +24,7 @@ RoleDenotations NotRole::evaluate_impl(const States& states, DenotationsCaches&
         compute_result(
             *(*role_denotations)[i],
             denotation);
-        denotations.push_back(caches.data.insert_unique(std::move(denotation)));
+        denotations.push_back(caches.data.insert_unique_id(std::move(denotation)));
     }
     return denotations;
 }
@@ -63,8 +63,13 @@ void NotRole::str_impl(std::stringstream& out) const {
     out << ")";
 }
 
+void NotRole::serialize_impl(ElementSerializer& out) const {
+    out.write_kind(ElementKind::NOT_ROLE);
+    out.write_element(*m_role);
+}
+
 int NotRole::compute_evaluate_time_score_impl() const {
-    return m_role->compute_evaluate_time_score() + SCORE_QUADRATIC;
+    return m_role->compute_evaluate_time_score() + get_cost_model().compute_score(ElementKind::NOT_ROLE);
 }
 
 }
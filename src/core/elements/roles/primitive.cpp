@@ -10,21 +10,23 @@ namespace dlplan::core {
 void PrimitiveRole::compute_result(const State& state, RoleDenotation& result) const {
     const auto& instance_info = *state.get_instance_info();
     const auto& atoms = instance_info.get_atoms();
+    PairsOfObjectIndices pairs;
     for (int atom_idx : state.get_atom_indices()) {
         const auto& atom = atoms[atom_idx];
         if (atom.get_predicate_index() == m_predicate.get_index()) {
             assert(dlplan::utils::in_bounds(m_pos_1, atom.get_object_indices()));
             assert(dlplan::utils::in_bounds(m_pos_2, atom.get_object_indices()));
-            result.insert(std::make_pair(atom.get_object_indices()[m_pos_1], atom.get_object_indices()[m_pos_2]));
+            pairs.emplace_back(atom.get_object_indices()[m_pos_1], atom.get_object_indices()[m_pos_2]);
         }
     }
     for (const auto& atom : state.get_instance_info()->get_static_atoms()) {
         if (atom.get_predicate_index() == m_predicate.get_index()) {
             assert(dlplan::utils::in_bounds(m_pos_1, atom.get_object_indices()));
             assert(dlplan::utils::in_bounds(m_pos_2, atom.get_object_indices()));
-            result.insert(std::make_pair(atom.get_object_indices()[m_pos_1], atom.get_object_indices()[m_pos_2]));
+            pairs.emplace_back(atom.get_object_indices()[m_pos_1], atom.get_object_indices()[m_pos_2]);
         }
     }
+    result.insert_all(pairs);
 }
 
 RoleDenotation PrimitiveRole::evaluate_impl(const State& state, DenotationsCaches&) const {
@@ -36,14 +38,14 @@ RoleDenotation PrimitiveRole::evaluate_impl(const State& state, DenotationsCache
 }
 
 RoleDenotations PrimitiveRole::evaluate_impl(const States& states, DenotationsCaches& caches) const {
-    RoleDenotations denotations;
+    RoleDenotations denotations(caches.data.get_pool<RoleDenotation>());
     denotations.reserve(states.size());
     for (size_t i = 0; i < states.size(); ++i) {
         RoleDenotation denotation(states[i].get_instance_info()->get_objects().size());
         compute_result(
             states[i],
             denotation);
-        denotations.push_back(caches.data.insert_unique(std::move(denotation)));
+        denotations.push_back(caches.data.insert_unique_id(std::move(denotation)));
     }
     return denotations;
 }
@@ -85,8 +87,15 @@ void PrimitiveRole::str_impl(std::stringstream& out) const {
     out << "r_primitive" << "(" << m_predicate.get_name() << "," << std::to_string(m_pos_1) << "," << std::to_string(m_pos_2) << ")";
 }
 
+void PrimitiveRole::serialize_impl(ElementSerializer& out) const {
+    out.write_kind(ElementKind::PRIMITIVE_ROLE);
+    out.write_predicate(m_predicate);
+    out.write_integer(m_pos_1);
+    out.write_integer(m_pos_2);
+}
+
 int PrimitiveRole::compute_evaluate_time_score_impl() const {
-    return SCORE_LINEAR;
+    return get_cost_model().compute_score(ElementKind::PRIMITIVE_ROLE);
 }
 
 const Predicate& PrimitiveRole::get_predicate() const {
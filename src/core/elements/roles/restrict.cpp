@@ -3,12 +3,14 @@
 
 namespace dlplan::core {
 void RestrictRole::compute_result(const RoleDenotation& role_denot, const ConceptDenotation& concept_denot, RoleDenotation& result) const {
-    result = role_denot;
+    PairsOfObjectIndices pairs;
     for (const auto& pair : role_denot.to_vector()) {
-        if (!concept_denot.contains(pair.second)) {
-            result.erase(pair);
+        if (concept_denot.contains(pair.second)) {
+            pairs.push_back(pair);
         }
     }
+    result = RoleDenotation(role_denot.get_num_objects());
+    result.insert_all(pairs);
 }
 
 RoleDenotation RestrictRole::evaluate_impl(const State& state, DenotationsCaches& caches) const {
@@ -21,7 +23,7 @@ RoleDenotation RestrictRole::evaluate_impl(const State& state, DenotationsCaches
 }
 
 RoleDenotations RestrictRole::evaluate_impl(const States& states, DenotationsCaches& caches) const {
-    RoleDenotations denotations;
+    RoleDenotations denotations(caches.data.get_pool<RoleDenotation>());
     denotations.reserve(states.size());
     auto role_denotations = m_role->evaluate(states, caches);
     auto concept_denotations = m_concept->evaluate(states, caches);
@@ -31,7 +33,7 @@ RoleDenotations RestrictRole::evaluate_impl(const States& states, DenotationsCac
             *(*role_denotations)[i],
             *(*concept_denotations)[i],
             denotation);
-        denotations.push_back(caches.data.insert_unique(std::move(denotation)));
+        denotations.push_back(caches.data.insert_unique_id(std::move(denotation)));
     }
     return denotations;
 }
@@ -76,8 +78,14 @@ void RestrictRole::str_impl(std::stringstream& out) const {
     out << ")";
 }
 
+void RestrictRole::serialize_impl(ElementSerializer& out) const {
+    out.write_kind(ElementKind::RESTRICT_ROLE);
+    out.write_element(*m_role);
+    out.write_element(*m_concept);
+}
+
 int RestrictRole::compute_evaluate_time_score_impl() const {
-    return m_role->compute_evaluate_time_score() + m_concept->compute_evaluate_time_score() + SCORE_QUADRATIC;
+    return m_role->compute_evaluate_time_score() + m_concept->compute_evaluate_time_score() + get_cost_model().compute_score(ElementKind::RESTRICT_ROLE);
 }
 
 }
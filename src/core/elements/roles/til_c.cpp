@@ -17,11 +17,12 @@ namespace dlplan::core
             inv_edges[to].insert(from);
         }
 
+        PairsOfObjectIndices pairs;
         while(current.size() > 0) {
             for(auto& to : current) {
                 for(auto& from : inv_edges[to]) {
                     if(! visited.contains(from)) {
-                        result.insert(std::make_pair(from, to));
+                        pairs.emplace_back(from, to);
                         next.insert(from);
                     }
                 }
@@ -30,6 +31,7 @@ namespace dlplan::core
             current = next;
             next.clear();
         }
+        result.insert_all(pairs);
     }
 
     RoleDenotation TilCRole::evaluate_impl(const State &state, DenotationsCaches &caches) const
@@ -44,7 +46,7 @@ namespace dlplan::core
 
     RoleDenotations TilCRole::evaluate_impl(const States &states, DenotationsCaches &caches) const
     {
-        RoleDenotations denotations;
+        RoleDenotations denotations(caches.data.get_pool<RoleDenotation>());
         denotations.reserve(states.size());
         auto role_denotations = m_role->evaluate(states, caches);
         auto concept_denotations = m_concept->evaluate(states, caches);
@@ -55,7 +57,7 @@ namespace dlplan::core
                 *(*role_denotations)[i],
                 *(*concept_denotations)[i],
                 denotation);
-            denotations.push_back(caches.data.insert_unique(std::move(denotation)));
+            denotations.push_back(caches.data.insert_unique_id(std::move(denotation)));
         }
         return denotations;
     }
@@ -103,9 +105,16 @@ namespace dlplan::core
         out << ")";
     }
 
+    void TilCRole::serialize_impl(ElementSerializer &out) const
+    {
+        out.write_kind(ElementKind::TIL_C_ROLE);
+        out.write_element(*m_role);
+        out.write_element(*m_concept);
+    }
+
     int TilCRole::compute_evaluate_time_score_impl() const
     {
-        return m_role->compute_evaluate_time_score() + m_concept->compute_evaluate_time_score() + SCORE_QUADRATIC;
+        return m_role->compute_evaluate_time_score() + m_concept->compute_evaluate_time_score() + get_cost_model().compute_score(ElementKind::TIL_C_ROLE);
     }
 
 }
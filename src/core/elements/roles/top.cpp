@@ -9,12 +9,12 @@ RoleDenotation TopRole::evaluate_impl(const State& state, DenotationsCaches&) co
 }
 
 RoleDenotations TopRole::evaluate_impl(const States& states, DenotationsCaches& caches) const {
-    RoleDenotations denotations;
+    RoleDenotations denotations(caches.data.get_pool<RoleDenotation>());
     denotations.reserve(states.size());
     for (size_t i = 0; i < states.size(); ++i) {
         RoleDenotation denotation(states[i].get_instance_info()->get_objects().size());
         denotation.set();
-        denotations.push_back(caches.data.insert_unique(std::move(denotation)));
+        denotations.push_back(caches.data.insert_unique_id(std::move(denotation)));
     }
     return denotations;
 }
@@ -49,8 +49,12 @@ void TopRole::str_impl(std::stringstream& out) const {
     out << "r_top";
 }
 
+void TopRole::serialize_impl(ElementSerializer& out) const {
+    out.write_kind(ElementKind::TOP_ROLE);
+}
+
 int TopRole::compute_evaluate_time_score_impl() const {
-    return SCORE_CONSTANT;
+    return get_cost_model().compute_score(ElementKind::TOP_ROLE);
 }
 
 }
@@ -7,16 +7,10 @@ void TransitiveClosureRole::compute_result(const RoleDenotation& denot, RoleDeno
     result = denot;
     bool changed = false;
     do {
-        RoleDenotation tmp_result = result;
-        PairsOfObjectIndices pairs = tmp_result.to_vector();
-        for (const auto& pair_1 : pairs) {
-            for (const auto& pair_2 : pairs) {
-                if (pair_1.second == pair_2.first) {
-                    result.insert(std::make_pair(pair_1.first, pair_2.second));
-                }
-            }
-        }
-        changed = (result.size() != tmp_result.size());
+        int old_size = result.size();
+        PairsOfObjectIndices pairs = result.to_sorted_vector();
+        result.insert_all(utils::compute_composition(pairs, pairs, result.get_num_objects()));
+        changed = (result.size() != old_size);
     } while (changed);
 }
 
@@ -29,7 +23,7 @@ RoleDenotation TransitiveClosureRole::evaluate_impl(const State& state, Denotati
 }
 
 RoleDenotations TransitiveClosureRole::evaluate_impl(const States& states, DenotationsCaches& caches) const {
-    RoleDenotations denotations;
+    RoleDenotations denotations(caches.data.get_pool<RoleDenotation>());
     denotations.reserve(states.size());
     auto role_denotations = m_role->evaluate(states, caches);
     for (size_t i = 0; i < states.size(); ++i) {
@@ -37,7 +31,7 @@ RoleDenotations TransitiveClosureRole::evaluate_impl(const States& states, Denot
         compute_result(
             *(*role_denotations)[i],
             denotation);
-        denotations.push_back(caches.data.insert_unique(std::move(denotation)));
+        denotations.push_back(caches.data.insert_unique_id(std::move(denotation)));
     }
     return denotations;
 }
@@ -76,8 +70,13 @@ void TransitiveClosureRole::str_impl(std::stringstream& out) const {
     out << ")";
 }
 
+void TransitiveClosureRole::serialize_impl(ElementSerializer& out) const {
+    out.write_kind(ElementKind::TRANSITIVE_CLOSURE_ROLE);
+    out.write_element(*m_role);
+}
+
 int TransitiveClosureRole::compute_evaluate_time_score_impl() const {
-    return m_role->compute_evaluate_time_score() + SCORE_QUBIC;
+    return m_role->compute_evaluate_time_score() + get_cost_model().compute_score(ElementKind::TRANSITIVE_CLOSURE_ROLE);
 }
 
 }
@@ -6,16 +6,10 @@ void TransitiveReflexiveClosureRole::compute_result(const RoleDenotation& denot,
     result = denot;
     bool changed = false;
     do {
-        RoleDenotation tmp_result = result;
-        PairsOfObjectIndices pairs = tmp_result.to_vector();
-        for (const auto& pair_1 : pairs) {
-            for (const auto& pair_2 : pairs) {
-                if (pair_1.second == pair_2.first) {
-                    result.insert(std::make_pair(pair_1.first, pair_2.second));
-                }
-            }
-        }
-        changed = (result.size() != tmp_result.size());
+        int old_size = result.size();
+        PairsOfObjectIndices pairs = result.to_sorted_vector();
+        result.insert_all(utils::compute_composition(pairs, pairs, result.get_num_objects()));
+        changed = (result.size() != old_size);
     } while (changed);
     // add reflexive part
     for (int i = 0; i < num_objects; ++i) {
@@ -33,7 +27,7 @@ RoleDenotation TransitiveReflexiveClosureRole::evaluate_impl(const State& state,
 }
 
 RoleDenotations TransitiveReflexiveClosureRole::evaluate_impl(const States& states, DenotationsCaches& caches) const {
-    RoleDenotations denotations;
+    RoleDenotations denotations(caches.data.get_pool<RoleDenotation>());
     denotations.reserve(states.size());
     auto role_denotations = m_role->evaluate(states, caches);
     for (size_t i = 0; i < states.size(); ++i) {
@@ -42,7 +36,7 @@ RoleDenotations TransitiveReflexiveClosureRole::evaluate_impl(const States& stat
             *(*role_denotations)[i],
             states[i].get_instance_info()->get_objects().size(),
             denotation);
-        denotations.push_back(caches.data.insert_unique(std::move(denotation)));
+        denotations.push_back(caches.data.insert_unique_id(std::move(denotation)));
     }
     return denotations;
 }
@@ -83,8 +77,13 @@ void TransitiveReflexiveClosureRole::str_impl(std::stringstream& out) const {
     out << ")";
 }
 
+void TransitiveReflexiveClosureRole::serialize_impl(ElementSerializer& out) const {
+    out.write_kind(ElementKind::TRANSITIVE_REFLEXIVE_CLOSURE_ROLE);
+    out.write_element(*m_role);
+}
+
 int TransitiveReflexiveClosureRole::compute_evaluate_time_score_impl() const {
-    return m_role->compute_evaluate_time_score() + SCORE_QUBIC;
+    return m_role->compute_evaluate_time_score() + get_cost_model().compute_score(ElementKind::TRANSITIVE_REFLEXIVE_CLOSURE_ROLE);
 }
 
 }
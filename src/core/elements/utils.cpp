@@ -1,5 +1,6 @@
 #include "../../../include/dlplan/core/elements/utils.h"
 
+#include <algorithm>
 #include <deque>
 #include <iostream>
 
@@ -132,4 +133,37 @@ PairwiseDistances compute_floyd_warshall(const RoleDenotation& edges) {
     return dist;
 }
 
+
+PairsOfObjectIndices compute_composition(const PairsOfObjectIndices& left_pairs, const PairsOfObjectIndices& right_pairs, int num_objects) {
+    PairsOfObjectIndices result;
+    const auto compare_first = [](const PairOfObjectIndices& left, const PairOfObjectIndices& right) {
+        return left.first < right.first;
+    };
+    // The targets of each source are collected once, i.e., as the union of the
+    // rows of its successors, such that the memory is bounded by the result.
+    std::vector<bool> is_target(num_objects, false);
+    std::vector<ObjectIndex> targets;
+    for (auto row_begin = left_pairs.begin(); row_begin != left_pairs.end();) {
+        const ObjectIndex source = row_begin->first;
+        auto row_end = std::find_if(row_begin, left_pairs.end(), [source](const PairOfObjectIndices& pair) { return pair.first != source; });
+        for (auto it = row_begin; it != row_end; ++it) {
+            auto [begin, end] = std::equal_range(right_pairs.begin(), right_pairs.end(), std::make_pair(it->second, 0), compare_first);
+            for (auto jt = begin; jt != end; ++jt) {
+                if (!is_target[jt->second]) {
+                    is_target[jt->second] = true;
+                    targets.push_back(jt->second);
+                }
+            }
+        }
+        std::sort(targets.begin(), targets.end());
+        for (const ObjectIndex target : targets) {
+            result.emplace_back(source, target);
+            is_target[target] = false;
+        }
+        targets.clear();
+        row_begin = row_end;
+    }
+    return result;
+}
+
 }
@@ -0,0 +1,69 @@
+#include "../../include/dlplan/core.h"
+
+#include "../utils/parallel.h"
+
+#include <stdexcept>
+
+
+namespace dlplan::core {
+
+// Number of states that share a cache. Batched evaluation caches the
+// denotations of all subelements for all states of a block.
+static const int BLOCK_SIZE = 64;
+
+void evaluate_features(
+    const std::vector<std::shared_ptr<const Boolean>>& booleans,
+    const std::vector<std::shared_ptr<const Numerical>>& numericals,
+    const States& states,
+    std::span<int32_t> values,
+    int num_threads) {
+    const int num_booleans = booleans.size();
+    const int num_features = num_booleans + numericals.size();
+    const int num_states = states.size();
+    if (values.size() != static_cast<size_t>(num_states) * num_features) {
+        throw std::runtime_error("evaluate_features - expected " + std::to_string(static_cast<size_t>(num_states) * num_features) + " values but got " + std::to_string(values.size()) + ".");
+    }
+    for (const auto& boolean : booleans) {
+        if (!boolean) {
+            throw std::runtime_error("evaluate_features - boolean is nullptr.");
+        }
+    }
+    for (const auto& numerical : numericals) {
+        if (!numerical) {
+            throw std::runtime_error("evaluate_features - numerical is nullptr.");
+        }
+    }
+    const int num_blocks = (num_states + BLOCK_SIZE - 1) / BLOCK_SIZE;
+    utils::parallel_for(num_blocks, num_threads, [&](int, int begin, int end) {
+        for (int block = begin; block < end; ++block) {
+            const int first = block * BLOCK_SIZE;
+            const int last = std::min(num_states, first + BLOCK_SIZE);
+            const States block_states(states.begin() + first, states.begin() + last);
+            DenotationsCaches caches;
+            for (int j = 0; j < num_features; ++j) {
+                auto write_column = [&](const auto& denotations) {
+                    for (int i = first; i < last; ++i) {
+                        values[static_cast<size_t>(i) * num_features + j] = denotations[i - first];
+                    }
+                };
+                if (j < num_booleans) {
+                    write_column(*booleans[j]->evaluate(block_states, caches));
+                } else {
+                    write_column(*numericals[j - num_booleans]->evaluate(block_states, caches));
+                }
+            }
+        }
+    });
+}
+
+std::vector<int32_t> evaluate_features(
+    const std::vector<std::shared_ptr<const Boolean>>& booleans,
+    const std::vector<std::shared_ptr<const Numerical>>& numericals,
+    const States& states,
+    int num_threads) {
+    std::vector<int32_t> values(states.size() * (booleans.size() + numericals.size()));
+    evaluate_features(booleans, numericals, states, values, num_threads);
+    return values;
+}
+
+}
@@ -81,8 +81,12 @@ const Atom& InstanceInfo::add_atom(const Predicate& predicate, const std::vector
     std::string name = compute_atom_name(predicate, objects);
     std::vector<int> object_idxs;
     std::for_each(objects.begin(), objects.end(), [&](const auto& object){ object_idxs.push_back(object.get_index()); });
+    return insert_atom(predicate.get_index(), object_idxs, name, is_static);
+}
+
+const Atom& InstanceInfo::insert_atom(PredicateIndex predicate_idx, const ObjectIndices& object_idxs, const std::string& name, bool is_static) {
     if (is_static) {
-        Atom atom = Atom(m_static_atoms.size(), name, predicate.get_index(), object_idxs, is_static);
+        Atom atom = Atom(m_static_atoms.size(), name, predicate_idx, object_idxs, is_static);
         auto result = m_static_atom_name_to_index.emplace(atom.get_name(), m_static_atoms.size());
         bool newly_inserted = result.second;
         if (!newly_inserted) {
@@ -91,7 +95,7 @@ const Atom& InstanceInfo::add_atom(const Predicate& predicate, const std::vector
         m_static_atoms.push_back(std::move(atom));
         return m_static_atoms.back();
     } else {
-        Atom atom = Atom(m_atoms.size(), name, predicate.get_index(), object_idxs, is_static);
+        Atom atom = Atom(m_atoms.size(), name, predicate_idx, object_idxs, is_static);
         auto result = m_atom_name_to_index.emplace(atom.get_name(), m_atoms.size());
         bool newly_inserted = result.second;
         if (!newly_inserted) {
@@ -131,6 +135,14 @@ const Object& InstanceInfo::add_object(const std::string& object_name) {
     return m_objects.back();
 }
 
+const Atom& InstanceInfo::add_atom_with_name(PredicateIndex predicate_idx, const ObjectIndices& object_idxs, const std::string& name) {
+    return insert_atom(predicate_idx, object_idxs, name, false);
+}
+
+const Atom& InstanceInfo::add_static_atom_with_name(PredicateIndex predicate_idx, const ObjectIndices& object_idxs, const std::string& name) {
+    return insert_atom(predicate_idx, object_idxs, name, true);
+}
+
 const Atom& InstanceInfo::add_atom(const Predicate& predicate, const std::vector<Object>& objects) {
     return add_atom(predicate, objects, false);
 }
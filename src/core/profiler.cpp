@@ -0,0 +1,186 @@
+#include "../../include/dlplan/core/profiler.h"
+
+#include "../../include/dlplan/core.h"
+
+#include <algorithm>
+#include <iomanip>
+#include <mutex>
+#include <unordered_map>
+
+
+namespace dlplan::core {
+
+/// @brief Stores the profiles of a single thread. The mutex is only
+///        contended while a report is taken or the profiles are reset.
+struct ThreadProfiles {
+    std::mutex mutex;
+    std::unordered_map<int, ElementProfile> profiles;
+};
+
+/// @brief Stores the profiles of all threads that ever evaluated an element.
+///        Profiles of finished threads remain until they are reset.
+struct ProfilesRegistry {
+    std::mutex mutex;
+    std::vector<std::shared_ptr<ThreadProfiles>> thread_profiles;
+};
+
+static ProfilesRegistry& get_registry() {
+    static ProfilesRegistry registry;
+    return registry;
+}
+
+static ThreadProfiles& get_thread_profiles() {
+    thread_local std::shared_ptr<ThreadProfiles> thread_profiles = [] {
+        auto result = std::make_shared<ThreadProfiles>();
+        auto& registry = get_registry();
+        std::lock_guard<std::mutex> hold(registry.mutex);
+        registry.thread_profiles.push_back(result);
+        return result;
+    }();
+    return *thread_profiles;
+}
+
+/// @brief The time spent in children of each open scope in the current thread.
+thread_local std::vector<uint64_t> children_ns_stack;
+
+
+void ElementProfileScope::start() {
+    children_ns_stack.push_back(0);
+    m_start = std::chrono::steady_clock::now();
+}
+
+ElementProfileScope::~ElementProfileScope() {
+    const uint64_t inclusive_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - m_start).count();
+    const uint64_t children_ns = children_ns_stack.back();
+    children_ns_stack.pop_back();
+    if (!children_ns_stack.empty()) {
+        children_ns_stack.back() += inclusive_ns;
+    }
+    auto& thread_profiles = get_thread_profiles();
+    std::lock_guard<std::mutex> hold(thread_profiles.mutex);
+    auto result = thread_profiles.profiles.try_emplace(m_element_index);
+    auto& profile = result.first->second;
+    if (result.second) {
+        profile = ElementProfile{m_element_index, m_describe(m_element), 0, 0, 0, 0, 0, 0};
+    }
+    ++profile.num_calls;
+    if (m_is_cache_hit) {
+        ++profile.num_cache_hits;
+    } else {
+        ++profile.num_cache_misses;
+    }
+    profile.inclusive_ns += inclusive_ns;
+    profile.exclusive_ns += inclusive_ns - std::min(inclusive_ns, children_ns);
+    profile.allocated_bytes += m_allocated_bytes;
+}
+
+
+bool is_profiling_enabled() {
+#ifdef DLPLAN_ENABLE_PROFILING
+    return true;
+#else
+    return false;
+#endif
+}
+
+ElementProfiles get_element_profiles() {
+    std::unordered_map<int, ElementProfile> merged;
+    auto& registry = get_registry();
+    std::lock_guard<std::mutex> hold(registry.mutex);
+    for (const auto& thread_profiles : registry.thread_profiles) {
+        std::lock_guard<std::mutex> hold_thread(thread_profiles->mutex);
+        for (const auto& [element_index, profile] : thread_profiles->profiles) {
+            auto result = merged.try_emplace(element_index, profile);
+            if (result.second) {
+                continue;
+            }
+            auto& total = result.first->second;
+            total.num_calls += profile.num_calls;
+            total.num_cache_hits += profile.num_cache_hits;
+            total.num_cache_misses += profile.num_cache_misses;
+            total.inclusive_ns += profile.inclusive_ns;
+            total.exclusive_ns += profile.exclusive_ns;
+            total.allocated_bytes += profile.allocated_bytes;
+        }
+    }
+    ElementProfiles profiles;
+    profiles.reserve(merged.size());
+    for (auto& [element_index, profile] : merged) {
+        profiles.push_back(std::move(profile));
+    }
+    std::sort(profiles.begin(), profiles.end(), [](const ElementProfile& l, const ElementProfile& r) {
+        if (l.exclusive_ns != r.exclusive_ns) {
+            return l.exclusive_ns > r.exclusive_ns;
+        }
+        return l.element_index < r.element_index;
+    });
+    return profiles;
+}
+
+void reset_element_profiles() {
+    auto& registry = get_registry();
+    std::lock_guard<std::mutex> hold(registry.mutex);
+    for (const auto& thread_profiles : registry.thread_profiles) {
+        std::lock_guard<std::mutex> hold_thread(thread_profiles->mutex);
+        thread_profiles->profiles.clear();
+    }
+}
+
+std::string to_string(const ElementProfiles& profiles) {
+    std::stringstream out;
+    out << std::setw(8) << "index"
+        << std::setw(12) << "calls"
+        << std::setw(12) << "hits"
+        << std::setw(12) << "misses"
+        << std::setw(16) << "exclusive_ns"
+        << std::setw(16) << "inclusive_ns"
+        << std::setw(14) << "bytes"
+        << "  element" << std::endl;
+    for (const auto& profile : profiles) {
+        out << std::setw(8) << profile.element_index
+            << std::setw(12) << profile.num_calls
+            << std::setw(12) << profile.num_cache_hits
+            << std::setw(12) << profile.num_cache_misses
+            << std::setw(16) << profile.exclusive_ns
+            << std::setw(16) << profile.inclusive_ns
+            << std::setw(14) << profile.allocated_bytes
+            << "  " << profile.element_description << std::endl;
+    }
+    return out.str();
+}
+
+
+uint64_t compute_allocated_bytes(const ConceptDenotation& denotation) {
+    return SharedObjectSize<ConceptDenotation>()(denotation);
+}
+
+uint64_t compute_allocated_bytes(const RoleDenotation& denotation) {
+    return SharedObjectSize<RoleDenotation>()(denotation);
+}
+
+uint64_t compute_allocated_bytes(const ConceptDenotations& denotations) {
+    uint64_t result = denotations.get_num_bytes();
+    for (std::size_t i = 0; i < denotations.size(); ++i) {
+        result += compute_allocated_bytes(*denotations[i]);
+    }
+    return result;
+}
+
+uint64_t compute_allocated_bytes(const RoleDenotations& denotations) {
+    uint64_t result = denotations.get_num_bytes();
+    for (std::size_t i = 0; i < denotations.size(); ++i) {
+        result += compute_allocated_bytes(*denotations[i]);
+    }
+    return result;
+}
+
+uint64_t compute_allocated_bytes(const BooleanDenotations& denotations) {
+    return SharedObjectSize<BooleanDenotations>()(denotations);
+}
+
+uint64_t compute_allocated_bytes(const NumericalDenotations& denotations) {
+    return SharedObjectSize<NumericalDenotations>()(denotations);
+}
+
+}
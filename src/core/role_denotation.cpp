@@ -2,15 +2,56 @@
 
 #include "../utils/logging.h"
 #include "../../include/dlplan/utils/hash.h"
-#include "../../include/dlplan/utils/dynamic_bitset.h"
+#include "../../include/dlplan/utils/lazy_bitset.h"
 
+#include <algorithm>
+#include <iterator>
 #include <sstream>
 
 
 namespace dlplan::core {
+// Sparse keys are 32 bit, i.e., 32 bits per pair compared to 1 bit per pair in the
+// dense form, such that both forms use equal memory at a density of 1/32. Sorting and
+// merging keys is slower than setting and combining bits, at a density of 1/32 by 11-16x
+// in BM_RoleDenotationForm. Hence, we switch at a density of 1/128, where the sparse form
+// uses a quarter of the memory at equal time for 256 objects and 3.4x the time for 1024.
+static double sparse_density = 1.0 / 128;
+
+// Keys of pairs must fit into 32 bit.
+static const int max_num_objects_sparse = 65535;
+
+/// @brief Returns the key of the pair, computed in unsigned arithmetic
+///        since the product overflows int for more than 46340 objects.
+static uint32_t compute_key(const PairOfObjectIndices& value, int num_objects) {
+    return static_cast<uint32_t>(value.first) * static_cast<uint32_t>(num_objects) + static_cast<uint32_t>(value.second);
+}
+
+/// @brief Returns the number of pairs of objects, i.e., the number of bits of the dense form.
+static std::size_t compute_num_pairs(int num_objects) {
+    return static_cast<std::size_t>(num_objects) * num_objects;
+}
+
+/// @brief Returns the hash of the dense form of the sorted keys.
+static std::size_t compute_sparse_hash(const std::vector<uint32_t>& keys, std::size_t num_bits) {
+    const std::size_t bits_per_block = std::numeric_limits<unsigned>::digits;
+    const std::size_t num_blocks = (num_bits + bits_per_block - 1) / bits_per_block;
+    std::size_t aggregated_hash = 0;
+    auto it = keys.begin();
+    for (std::size_t i = 0; i < num_blocks; ++i) {
+        unsigned block = 0;
+        for (; it != keys.end() && *it / bits_per_block == i; ++it) {
+            block |= 1u << (*it % bits_per_block);
+        }
+        hash_combine(aggregated_hash, std::hash<unsigned>()(block));
+    }
+    return aggregated_hash;
+}
+
 // we assign index undefined since we do not care
 RoleDenotation::RoleDenotation(int num_objects)
-    : Base<RoleDenotation>(std::numeric_limits<int>::max()), m_num_objects(num_objects), m_data(DynamicBitset<unsigned>(num_objects * num_objects)) { }
+    : Base<RoleDenotation>(std::numeric_limits<int>::max()), m_num_objects(num_objects), m_sparse(false), m_data(LazyBitset<unsigned>(compute_num_pairs(num_objects))) {
+    m_sparse = get_max_num_sparse_pairs() > 0;
+}
 
 RoleDenotation::RoleDenotation(const RoleDenotation& other) = default;
 
@@ -22,9 +63,57 @@ RoleDenotation& RoleDenotation::operator=(RoleDenotation&& other) = default;
 
 RoleDenotation::~RoleDenotation() = default;
 
+std::size_t RoleDenotation::get_max_num_sparse_pairs() const {
+    if (m_num_objects > max_num_objects_sparse) {
+        return 0;
+    }
+    return static_cast<std::size_t>(sparse_density * compute_num_pairs(m_num_objects));
+}
+
+void RoleDenotation::to_dense() {
+    if (!m_sparse) {
+        return;
+    }
+    m_data = LazyBitset<unsigned>(compute_num_pairs(m_num_objects));
+    for (uint32_t key : m_pairs) {
+        m_data.set(key);
+    }
+    m_pairs = std::vector<uint32_t>();
+    m_sparse = false;
+}
+
+void RoleDenotation::try_to_sparse() {
+    // Switch back at half of the maximum size to avoid switching back and forth.
+    const std::size_t max_num_sparse_pairs = get_max_num_sparse_pairs();
+    if (m_sparse || max_num_sparse_pairs == 0 || m_data.count() > static_cast<int>(max_num_sparse_pairs / 2)) {
+        return;
+    }
+    std::vector<uint32_t> pairs;
+    pairs.reserve(m_data.count());
+    m_data.for_each([&pairs](std::size_t pos){ pairs.push_back(pos); });
+    m_pairs = std::move(pairs);
+    m_data = LazyBitset<unsigned>(compute_num_pairs(m_num_objects));
+    m_sparse = true;
+}
+
+bool RoleDenotation::contains_key(uint32_t key) const {
+    if (m_sparse) {
+        return std::binary_search(m_pairs.begin(), m_pairs.end(), key);
+    }
+    return m_data.test(key);
+}
+
 bool RoleDenotation::are_equal_impl(const RoleDenotation& other) const {
     if (this != &other) {
-        return this->m_data == other.m_data;
+        if (m_sparse && other.m_sparse) {
+            return m_pairs == other.m_pairs;
+        } else if (!m_sparse && !other.m_sparse) {
+            return m_data == other.m_data;
+        }
+        const auto& sparse = m_sparse ? *this : other;
+        const auto& dense = m_sparse ? other : *this;
+        return static_cast<int>(sparse.m_pairs.size()) == dense.m_data.count()
+            && std::all_of(sparse.m_pairs.begin(), sparse.m_pairs.end(), [&dense](uint32_t key){ return dense.m_data.test(key); });
     }
     return true;
 }
@@ -37,78 +126,235 @@ void RoleDenotation::str_impl(std::stringstream& out) const {
 }
 
 std::size_t RoleDenotation::hash_impl() const {
+    if (m_sparse) {
+        return compute_sparse_hash(m_pairs, compute_num_pairs(m_num_objects));
+    }
     return m_data.hash();
 }
 
 RoleDenotation& RoleDenotation::operator&=(const RoleDenotation& other) {
-    m_data &= other.m_data;
+    if (m_sparse) {
+        if (other.m_sparse) {
+            std::vector<uint32_t> pairs;
+            std::set_intersection(m_pairs.begin(), m_pairs.end(), other.m_pairs.begin(), other.m_pairs.end(), std::back_inserter(pairs));
+            m_pairs = std::move(pairs);
+        } else {
+            std::erase_if(m_pairs, [&other](uint32_t key){ return !other.m_data.test(key); });
+        }
+    } else if (other.m_sparse) {
+        // The result is a subset of the sparse operand.
+        std::vector<uint32_t> pairs;
+        std::copy_if(other.m_pairs.begin(), other.m_pairs.end(), std::back_inserter(pairs), [this](uint32_t key){ return m_data.test(key); });
+        m_pairs = std::move(pairs);
+        m_data = LazyBitset<unsigned>(compute_num_pairs(m_num_objects));
+        m_sparse = true;
+    } else {
+        m_data &= other.m_data;
+        try_to_sparse();
+    }
     return *this;
 }
 
 RoleDenotation& RoleDenotation::operator|=(const RoleDenotation& other) {
-    m_data |= other.m_data;
+    if (m_sparse && other.m_sparse) {
+        std::vector<uint32_t> pairs;
+        std::set_union(m_pairs.begin(), m_pairs.end(), other.m_pairs.begin(), other.m_pairs.end(), std::back_inserter(pairs));
+        m_pairs = std::move(pairs);
+        if (m_pairs.size() > get_max_num_sparse_pairs()) {
+            to_dense();
+        }
+    } else if (other.m_sparse) {
+        for (uint32_t key : other.m_pairs) {
+            m_data.set(key);
+        }
+    } else {
+        to_dense();
+        m_data |= other.m_data;
+    }
     return *this;
 }
 
 RoleDenotation& RoleDenotation::operator-=(const RoleDenotation& other) {
-    m_data -= other.m_data;
+    if (m_sparse) {
+        if (other.m_sparse) {
+            std::vector<uint32_t> pairs;
+            std::set_difference(m_pairs.begin(), m_pairs.end(), other.m_pairs.begin(), other.m_pairs.end(), std::back_inserter(pairs));
+            m_pairs = std::move(pairs);
+        } else {
+            std::erase_if(m_pairs, [&other](uint32_t key){ return other.m_data.test(key); });
+        }
+    } else {
+        if (other.m_sparse) {
+            for (uint32_t key : other.m_pairs) {
+                m_data.reset(key);
+            }
+        } else {
+            m_data -= other.m_data;
+        }
+        try_to_sparse();
+    }
     return *this;
 }
 
 RoleDenotation& RoleDenotation::operator~() {
+    to_dense();
     ~m_data;
     return *this;
 }
 
 void RoleDenotation::set() {
+    m_pairs = std::vector<uint32_t>();
+    m_data = LazyBitset<unsigned>(compute_num_pairs(m_num_objects));
     m_data.set();
+    m_sparse = false;
 }
 
 bool RoleDenotation::contains(const PairOfObjectIndices& value) const {
-    return m_data.test(value.first * m_num_objects + value.second);
+    return contains_key(compute_key(value, m_num_objects));
 }
 
 void RoleDenotation::insert(const PairOfObjectIndices& value) {
-    return m_data.set(value.first * m_num_objects + value.second);
+    const uint32_t key = compute_key(value, m_num_objects);
+    if (m_sparse) {
+        // Pairs are often inserted in ascending order.
+        if (m_pairs.empty() || m_pairs.back() < key) {
+            m_pairs.push_back(key);
+        } else {
+            auto it = std::lower_bound(m_pairs.begin(), m_pairs.end(), key);
+            if (*it == key) {
+                return;
+            }
+            m_pairs.insert(it, key);
+        }
+        if (m_pairs.size() > get_max_num_sparse_pairs()) {
+            to_dense();
+        }
+    } else {
+        m_data.set(key);
+    }
 }
 
 void RoleDenotation::erase(const PairOfObjectIndices& value) {
-    return m_data.reset(value.first * m_num_objects + value.second);
+    const uint32_t key = compute_key(value, m_num_objects);
+    if (m_sparse) {
+        auto it = std::lower_bound(m_pairs.begin(), m_pairs.end(), key);
+        if (it != m_pairs.end() && *it == key) {
+            m_pairs.erase(it);
+        }
+    } else {
+        m_data.reset(key);
+    }
+}
+
+void RoleDenotation::insert_all(const PairsOfObjectIndices& values) {
+    if (m_sparse) {
+        std::vector<uint32_t> keys;
+        keys.reserve(values.size());
+        for (const auto& value : values) {
+            keys.push_back(compute_key(value, m_num_objects));
+        }
+        std::sort(keys.begin(), keys.end());
+        keys.erase(std::unique(keys.begin(), keys.end()), keys.end());
+        std::vector<uint32_t> pairs;
+        pairs.reserve(m_pairs.size() + keys.size());
+        std::set_union(m_pairs.begin(), m_pairs.end(), keys.begin(), keys.end(), std::back_inserter(pairs));
+        m_pairs = std::move(pairs);
+        if (m_pairs.size() > get_max_num_sparse_pairs()) {
+            to_dense();
+        }
+    } else {
+        for (const auto& value : values) {
+            m_data.set(compute_key(value, m_num_objects));
+        }
+    }
 }
 
 int RoleDenotation::size() const {
+    if (m_sparse) {
+        return m_pairs.size();
+    }
     return m_data.count();
 }
 
 bool RoleDenotation::empty() const {
+    if (m_sparse) {
+        return m_pairs.empty();
+    }
     return m_data.none();
 }
 
 bool RoleDenotation::intersects(const RoleDenotation& other) const {
+    if (m_sparse && other.m_sparse) {
+        auto it_1 = m_pairs.begin();
+        auto it_2 = other.m_pairs.begin();
+        while (it_1 != m_pairs.end() && it_2 != other.m_pairs.end()) {
+            if (*it_1 < *it_2) ++it_1;
+            else if (*it_2 < *it_1) ++it_2;
+            else return true;
+        }
+        return false;
+    } else if (m_sparse) {
+        return std::any_of(m_pairs.begin(), m_pairs.end(), [&other](uint32_t key){ return other.m_data.test(key); });
+    } else if (other.m_sparse) {
+        return std::any_of(other.m_pairs.begin(), other.m_pairs.end(), [this](uint32_t key){ return m_data.test(key); });
+    }
     return m_data.intersects(other.m_data);
 }
 
 bool RoleDenotation::is_subset_of(const RoleDenotation& other) const {
+    if (m_sparse) {
+        if (other.m_sparse) {
+            return std::includes(other.m_pairs.begin(), other.m_pairs.end(), m_pairs.begin(), m_pairs.end());
+        }
+        return std::all_of(m_pairs.begin(), m_pairs.end(), [&other](uint32_t key){ return other.m_data.test(key); });
+    } else if (other.m_sparse) {
+        if (m_data.count() > static_cast<int>(other.m_pairs.size())) {
+            return false;
+        }
+        bool result = true;
+        m_data.for_each([&](std::size_t pos){ result = result && other.contains_key(pos); });
+        return result;
+    }
     return m_data.is_subset_of(other.m_data);
 }
 
+bool RoleDenotation::is_sparse() const {
+    return m_sparse;
+}
+
+bool RoleDenotation::is_symbolic() const {
+    return !m_sparse && m_data.is_symbolic();
+}
+
+bool RoleDenotation::is_complemented() const {
+    return !m_sparse && m_data.is_complemented();
+}
+
+void RoleDenotation::materialize() {
+    to_dense();
+    m_data.materialize();
+}
+
+std::size_t RoleDenotation::get_num_bytes() const {
+    return m_pairs.capacity() * sizeof(uint32_t) + m_data.get_num_bytes();
+}
+
 PairsOfObjectIndices RoleDenotation::to_vector() const {
-    // In the case of bitset, the to_sorted_vector has best runtime complexity.
+    // Both forms enumerate the pairs in ascending order.
     return to_sorted_vector();
 }
 
 PairsOfObjectIndices RoleDenotation::to_sorted_vector() const {
     PairsOfObjectIndices result;
-    result.reserve(m_num_objects * m_num_objects);
-    for (ObjectIndex i = 0; i < m_num_objects; ++i) {
-        int offset = m_num_objects * i;
-        for (ObjectIndex j = 0; j < m_num_objects; ++j) {
-            if (m_data.test(offset + j)) {
-                result.emplace_back(i, j);
-            }
+    if (m_sparse) {
+        result.reserve(m_pairs.size());
+        for (uint32_t key : m_pairs) {
+            result.emplace_back(key / m_num_objects, key % m_num_objects);
         }
+    } else {
+        result.reserve(m_data.count());
+        m_data.for_each([this, &result](std::size_t pos){ result.emplace_back(pos / m_num_objects, pos % m_num_objects); });
     }
-    result.shrink_to_fit();
     return result;
 }
 
@@ -116,4 +362,12 @@ int RoleDenotation::get_num_objects() const {
     return m_num_objects;
 }
 
+double RoleDenotation::get_sparse_density() {
+    return sparse_density;
+}
+
+void RoleDenotation::set_sparse_density(double density) {
+    sparse_density = density;
+}
+
 }
@@ -0,0 +1,410 @@
+#include "../../include/dlplan/core/serialization.h"
+
+#include "../../include/dlplan/core.h"
+
+#include <algorithm>
+#include <numeric>
+#include <variant>
+
+
+namespace dlplan::core {
+static const char ELEMENT_SERIALIZATION_MAGIC[4] = {'D', 'L', 'P', 'E'};
+
+static void write_varint(std::string& out, uint64_t value) {
+    while (value >= 0x80) {
+        out.push_back(static_cast<char>((value & 0x7f) | 0x80));
+        value >>= 7;
+    }
+    out.push_back(static_cast<char>(value));
+}
+
+static void write_string(std::string& out, const std::string& value) {
+    write_varint(out, value.size());
+    out.append(value);
+}
+
+
+template<typename E>
+uint32_t ElementSerializer::write_node(const E& element) {
+    auto result = m_node_ids.find(&element);
+    if (result != m_node_ids.end()) {
+        return result->second;
+    }
+    m_records.emplace_back();
+    element.serialize_impl(*this);
+    uint32_t node_id = m_nodes.size();
+    m_nodes.push_back(NodeRecord{element.get_index(), std::move(m_records.back())});
+    m_records.pop_back();
+    m_node_ids.emplace(&element, node_id);
+    return node_id;
+}
+
+void ElementSerializer::write_kind(ElementKind kind) {
+    m_records.back().push_back(Field{false, static_cast<uint64_t>(kind)});
+}
+
+void ElementSerializer::write_element(const Concept& concept_) {
+    uint32_t node_id = write_node(concept_);
+    m_records.back().push_back(Field{true, node_id});
+}
+
+void ElementSerializer::write_element(const Role& role) {
+    uint32_t node_id = write_node(role);
+    m_records.back().push_back(Field{true, node_id});
+}
+
+void ElementSerializer::write_predicate(const Predicate& predicate) {
+    auto result = m_predicate_ids.emplace(predicate.get_name(), m_predicates.size());
+    if (result.second) {
+        m_predicates.push_back(predicate);
+    }
+    m_records.back().push_back(Field{false, result.first->second});
+}
+
+void ElementSerializer::write_constant(const Constant& constant) {
+    auto result = m_constant_ids.emplace(constant.get_name(), m_constants.size());
+    if (result.second) {
+        m_constants.push_back(constant.get_name());
+    }
+    m_records.back().push_back(Field{false, result.first->second});
+}
+
+void ElementSerializer::write_integer(int value) {
+    // zigzag encoding keeps small negative values short
+    uint32_t unsigned_value = static_cast<uint32_t>(value);
+    m_records.back().push_back(Field{false, (unsigned_value << 1) ^ static_cast<uint32_t>(value >> 31)});
+}
+
+void ElementSerializer::add_root(const Boolean& boolean) {
+    m_roots[0].push_back(write_node(boolean));
+}
+
+void ElementSerializer::add_root(const Numerical& numerical) {
+    m_roots[1].push_back(write_node(numerical));
+}
+
+void ElementSerializer::add_root(const Concept& concept_) {
+    m_roots[2].push_back(write_node(concept_));
+}
+
+void ElementSerializer::add_root(const Role& role) {
+    m_roots[3].push_back(write_node(role));
+}
+
+std::string ElementSerializer::get_data() const {
+    std::vector<uint32_t> order(m_nodes.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [&](uint32_t l, uint32_t r) {
+        return m_nodes[l].element_index < m_nodes[r].element_index;
+    });
+    std::vector<uint32_t> node_ids(m_nodes.size());
+    for (uint32_t i = 0; i < order.size(); ++i) {
+        node_ids[order[i]] = i;
+    }
+
+    std::string out;
+    out.append(ELEMENT_SERIALIZATION_MAGIC, sizeof(ELEMENT_SERIALIZATION_MAGIC));
+    for (int i = 0; i < 4; ++i) {
+        out.push_back(static_cast<char>((ELEMENT_SERIALIZATION_VERSION >> (8 * i)) & 0xff));
+    }
+    write_varint(out, m_predicates.size());
+    for (const auto& predicate : m_predicates) {
+        write_string(out, predicate.get_name());
+        write_varint(out, predicate.get_arity());
+        out.push_back(static_cast<char>(predicate.is_static()));
+    }
+    write_varint(out, m_constants.size());
+    for (const auto& constant : m_constants) {
+        write_string(out, constant);
+    }
+    write_varint(out, m_nodes.size());
+    for (uint32_t node_id : order) {
+        for (const auto& field : m_nodes[node_id].fields) {
+            write_varint(out, field.is_node ? node_ids[field.value] : field.value);
+        }
+    }
+    for (const auto& roots : m_roots) {
+        write_varint(out, roots.size());
+        for (uint32_t node_id : roots) {
+            write_varint(out, node_ids[node_id]);
+        }
+    }
+    return out;
+}
+
+
+/// @brief Reads the binary format and creates the elements in a factory.
+class ElementDeserializer {
+private:
+    using Node = std::variant<
+        std::shared_ptr<const Boolean>,
+        std::shared_ptr<const Numerical>,
+        std::shared_ptr<const Concept>,
+        std::shared_ptr<const Role>>;
+
+    const std::string& m_data;
+    size_t m_pos;
+    std::vector<const Predicate*> m_predicates;
+    std::vector<const Constant*> m_constants;
+    std::vector<Node> m_nodes;
+
+    [[noreturn]] static void fail(const std::string& message) {
+        throw std::runtime_error("SyntacticElementFactory::deserialize - " + message);
+    }
+
+    uint8_t read_byte() {
+        if (m_pos >= m_data.size()) {
+            fail("unexpected end of data.");
+        }
+        return static_cast<uint8_t>(m_data[m_pos++]);
+    }
+
+    uint64_t read_varint() {
+        uint64_t result = 0;
+        for (int shift = 0; shift < 64; shift += 7) {
+            uint8_t byte = read_byte();
+            result |= static_cast<uint64_t>(byte & 0x7f) << shift;
+            if (!(byte & 0x80)) {
+                return result;
+            }
+        }
+        fail("malformed varint.");
+    }
+
+    uint64_t read_index(size_t size, const std::string& what) {
+        uint64_t index = read_varint();
+        if (index >= size) {
+            fail("reference to non-existing " + what + ".");
+        }
+        return index;
+    }
+
+    std::string read_string() {
+        uint64_t size = read_varint();
+        if (size > m_data.size() - m_pos) {
+            fail("unexpected end of data.");
+        }
+        std::string result = m_data.substr(m_pos, size);
+        m_pos += size;
+        return result;
+    }
+
+    int read_integer() {
+        uint32_t value = static_cast<uint32_t>(read_varint());
+        return static_cast<int>((value >> 1) ^ (~(value & 1) + 1));
+    }
+
+    template<typename T>
+    std::shared_ptr<const T> read_element(const std::string& what) {
+        const auto& node = m_nodes[read_index(m_nodes.size(), "element")];
+        const auto* element = std::get_if<std::shared_ptr<const T>>(&node);
+        if (!element) {
+            fail("element is not a " + what + ".");
+        }
+        return *element;
+    }
+
+    std::shared_ptr<const Concept> read_concept() { return read_element<Concept>("concept"); }
+    std::shared_ptr<const Role> read_role() { return read_element<Role>("role"); }
+    const Predicate& read_predicate() { return *m_predicates[read_index(m_predicates.size(), "predicate")]; }
+    const Constant& read_constant() { return *m_constants[read_index(m_constants.size(), "constant")]; }
+
+    void read_header(const VocabularyInfo& vocabulary_info) {
+        if (m_data.size() < 8 || m_data.compare(0, 4, ELEMENT_SERIALIZATION_MAGIC, 4) != 0) {
+            fail("data is not in the binary element format.");
+        }
+        m_pos = 4;
+        uint32_t version = 0;
+        for (int i = 0; i < 4; ++i) {
+            version |= static_cast<uint32_t>(read_byte()) << (8 * i);
+        }
+        if (version != ELEMENT_SERIALIZATION_VERSION) {
+            fail("unsupported version " + std::to_string(version) + ", expected " + std::to_string(ELEMENT_SERIALIZATION_VERSION) + ".");
+        }
+        uint64_t num_predicates = read_varint();
+        for (uint64_t i = 0; i < num_predicates; ++i) {
+            std::string name = read_string();
+            int arity = static_cast<int>(read_varint());
+            read_byte();  // is_static is determined by the vocabulary of the factory
+            const Predicate& predicate = vocabulary_info.get_predicate(name);
+            if (predicate.get_arity() != arity) {
+                fail("predicate " + name + " has arity " + std::to_string(predicate.get_arity()) + " instead of " + std::to_string(arity) + ".");
+            }
+            m_predicates.push_back(&predicate);
+        }
+        uint64_t num_constants = read_varint();
+        for (uint64_t i = 0; i < num_constants; ++i) {
+            m_constants.push_back(&vocabulary_info.get_constant(read_string()));
+        }
+    }
+
+    Node read_node(SyntacticElementFactory& factory) {
+        uint64_t kind = read_varint();
+        if (kind >= static_cast<uint64_t>(NUM_ELEMENT_KINDS)) {
+            fail("unknown element kind " + std::to_string(kind) + ".");
+        }
+        switch (static_cast<ElementKind>(kind)) {
+            case ElementKind::EMPTY_BOOLEAN_CONCEPT: return factory.make_empty_boolean(read_concept());
+            case ElementKind::EMPTY_BOOLEAN_ROLE: return factory.make_empty_boolean(read_role());
+            case ElementKind::INCLUSION_BOOLEAN_CONCEPT: {
+                auto left = read_concept();
+                return factory.make_inclusion_boolean(left, read_concept());
+            }
+            case ElementKind::INCLUSION_BOOLEAN_ROLE: {
+                auto left = read_role();
+                return factory.make_inclusion_boolean(left, read_role());
+            }
+            case ElementKind::NULLARY_BOOLEAN: return factory.make_nullary_boolean(read_predicate());
+            case ElementKind::ALL_CONCEPT: {
+                auto role = read_role();
+                return factory.make_all_concept(role, read_concept());
+            }
+            case ElementKind::AND_CONCEPT: {
+                auto left = read_concept();
+                return factory.make_and_concept(left, read_concept());
+            }
+            case ElementKind::BOT_CONCEPT: return factory.make_bot_concept();
+            case ElementKind::DIFF_CONCEPT: {
+                auto left = read_concept();
+                return factory.make_diff_concept(left, read_concept());
+            }
+            case ElementKind::EQUAL_CONCEPT: {
+                auto left = read_role();
+                return factory.make_equal_concept(left, read_role());
+            }
+            case ElementKind::NOT_CONCEPT: return factory.make_not_concept(read_concept());
+            case ElementKind::ONE_OF_CONCEPT: return factory.make_one_of_concept(read_constant());
+            case ElementKind::OR_CONCEPT: {
+                auto left = read_concept();
+                return factory.make_or_concept(left, read_concept());
+            }
+            case ElementKind::PRIMITIVE_CONCEPT: {
+                const auto& predicate = read_predicate();
+                return factory.make_primitive_concept(predicate, read_integer());
+            }
+            case ElementKind::PROJECTION_CONCEPT: {
+                auto role = read_role();
+                return factory.make_projection_concept(role, read_integer());
+            }
+            case ElementKind::SOME_CONCEPT: {
+                auto role = read_role();
+                return factory.make_some_concept(role, read_concept());
+            }
+            case ElementKind::SUBSET_CONCEPT: {
+                auto left = read_role();
+                return factory.make_subset_concept(left, read_role());
+            }
+            case ElementKind::TOP_CONCEPT: return factory.make_top_concept();
+            case ElementKind::CONCEPT_DISTANCE_NUMERICAL: {
+                auto from = read_concept();
+                auto role = read_role();
+                return factory.make_concept_distance_numerical(from, role, read_concept());
+            }
+            case ElementKind::COUNT_NUMERICAL_CONCEPT: return factory.make_count_numerical(read_concept());
+            case ElementKind::COUNT_NUMERICAL_ROLE: return factory.make_count_numerical(read_role());
+            case ElementKind::ROLE_DISTANCE_NUMERICAL: {
+                auto from = read_role();
+                auto role = read_role();
+                return factory.make_role_distance_numerical(from, role, read_role());
+            }
+            case ElementKind::SUM_CONCEPT_DISTANCE_NUMERICAL: {
+                auto from = read_concept();
+                auto role = read_role();
+                return factory.make_sum_concept_distance_numerical(from, role, read_concept());
+            }
+            case ElementKind::SUM_ROLE_DISTANCE_NUMERICAL: {
+                auto from = read_role();
+                auto role = read_role();
+                return factory.make_sum_role_distance_numerical(from, role, read_role());
+            }
+            case ElementKind::AND_ROLE: {
+                auto left = read_role();
+                return factory.make_and_role(left, read_role());
+            }
+            case ElementKind::COMPOSE_ROLE: {
+                auto left = read_role();
+                return factory.make_compose_role(left, read_role());
+            }
+            case ElementKind::DIFF_ROLE: {
+                auto left = read_role();
+                return factory.make_diff_role(left, read_role());
+            }
+            case ElementKind::IDENTITY_ROLE: return factory.make_identity_role(read_concept());
+            case ElementKind::INVERSE_ROLE: return factory.make_inverse_role(read_role());
+            case ElementKind::NOT_ROLE: return factory.make_not_role(read_role());
+            case ElementKind::OR_ROLE: {
+                auto left = read_role();
+                return factory.make_or_role(left, read_role());
+            }
+            case ElementKind::PRIMITIVE_ROLE: {
+                const auto& predicate = read_predicate();
+                int pos_1 = read_integer();
+                return factory.make_primitive_role(predicate, pos_1, read_integer());
+            }
+            case ElementKind::RESTRICT_ROLE: {
+                auto role = read_role();
+                return factory.make_restrict_role(role, read_concept());
+            }
+            case ElementKind::TIL_C_ROLE: {
+                auto role = read_role();
+                return factory.make_til_c_role(role, read_concept());
+            }
+            case ElementKind::TOP_ROLE: return factory.make_top_role();
+            case ElementKind::TRANSITIVE_CLOSURE_ROLE: return factory.make_transitive_closure(read_role());
+            case ElementKind::TRANSITIVE_REFLEXIVE_CLOSURE_ROLE: return factory.make_transitive_reflexive_closure(read_role());
+        }
+        fail("unknown element kind " + std::to_string(kind) + ".");
+    }
+
+    template<typename T>
+    void read_roots(std::vector<std::shared_ptr<const T>>& roots, const std::string& what) {
+        uint64_t num_roots = read_varint();
+        for (uint64_t i = 0; i < num_roots; ++i) {
+            roots.push_back(read_element<T>(what));
+        }
+    }
+
+public:
+    explicit ElementDeserializer(const std::string& data) : m_data(data), m_pos(0) { }
+
+    ElementCollection read(SyntacticElementFactory& factory) {
+        read_header(*factory.get_vocabulary_info());
+        uint64_t num_nodes = read_varint();
+        for (uint64_t i = 0; i < num_nodes; ++i) {
+            m_nodes.push_back(read_node(factory));
+        }
+        ElementCollection result;
+        read_roots(std::get<0>(result), "boolean");
+        read_roots(std::get<1>(result), "numerical");
+        read_roots(std::get<2>(result), "concept");
+        read_roots(std::get<3>(result), "role");
+        if (m_pos != m_data.size()) {
+            fail("unexpected data after the roots.");
+        }
+        return result;
+    }
+};
+
+
+std::string SyntacticElementFactory::serialize(const ElementCollection& elements) const {
+    ElementSerializer serializer;
+    for (const auto& boolean : std::get<0>(elements)) {
+        serializer.add_root(*boolean);
+    }
+    for (const auto& numerical : std::get<1>(elements)) {
+        serializer.add_root(*numerical);
+    }
+    for (const auto& concept_ : std::get<2>(elements)) {
+        serializer.add_root(*concept_);
+    }
+    for (const auto& role : std::get<3>(elements)) {
+        serializer.add_root(*role);
+    }
+    return serializer.get_data();
+}
+
+ElementCollection SyntacticElementFactory::deserialize(const std::string& data) {
+    return ElementDeserializer(data).read(*this);
+}
+
+}
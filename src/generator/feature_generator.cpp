@@ -7,6 +7,7 @@
 #include <algorithm>
 #include <iostream>
 #include <csignal>
+#include <limits>
 
 
 namespace dlplan::generator {
@@ -46,7 +47,8 @@ FeatureGeneratorImpl::FeatureGeneratorImpl()
       r_til_c(std::make_shared<rules::TilCRole>()),
       r_compose(std::make_shared<rules::ComposeRole>()),
       r_transitive_closure(std::make_shared<rules::TransitiveClosureRole>()),
-      r_transitive_reflexive_closure(std::make_shared<rules::TransitiveReflexiveClosureRole>()) {
+      r_transitive_reflexive_closure(std::make_shared<rules::TransitiveReflexiveClosureRole>()),
+      m_memory_limit(std::numeric_limits<std::size_t>::max()) {
     m_primitive_rules.emplace_back(b_nullary);
     m_primitive_rules.emplace_back(c_one_of);
     m_primitive_rules.emplace_back(c_top);
@@ -103,10 +105,12 @@ GeneratedFeatures FeatureGeneratorImpl::generate(
     int count_numerical_complexity_limit,
     int distance_numerical_complexity_limit,
     int time_limit,
-    int feature_limit)
+    int feature_limit,
+    std::shared_ptr<const utils::CancellationToken> cancellation_token)
 {
-    // Allow termination with ctrl+c
-    auto pre_sigint_handler = std::signal(SIGINT, exit_sigint_handler);
+    // Allow termination with ctrl+c unless the caller handles cancellation.
+    // The handler is process-wide and must not be swapped by concurrent generator runs.
+    auto pre_sigint_handler = (cancellation_token) ? SIG_ERR : std::signal(SIGINT, exit_sigint_handler);
 
     // Initialize statistics in each rule.
     for (auto& r : m_primitive_rules) r->initialize();
@@ -114,10 +118,10 @@ GeneratedFeatures FeatureGeneratorImpl::generate(
     for (auto& r : m_role_inductive_rules) r->initialize();
     for (auto& r : m_boolean_inductive_rules) r->initialize();
     for (auto& r : m_numerical_inductive_rules) r->initialize();
-    // Initialize memory to store intermediate results.
-    GeneratorData data(factory, std::max({concept_complexity_limit, role_complexity_limit, boolean_complexity_limit, count_numerical_complexity_limit, distance_numerical_complexity_limit}), time_limit, feature_limit);
     // Initialize cache.
     core::DenotationsCaches caches;
+    // Initialize memory to store intermediate results.
+    GeneratorData data(factory, caches, std::max({concept_complexity_limit, role_complexity_limit, boolean_complexity_limit, count_numerical_complexity_limit, distance_numerical_complexity_limit}), time_limit, feature_limit, m_memory_limit, std::move(cancellation_token));
     generate_base(states, data, caches);
 
     try
@@ -132,7 +136,9 @@ GeneratedFeatures FeatureGeneratorImpl::generate(
     }
 
     // Restore previous sigint handler
-    std::signal(SIGINT, pre_sigint_handler);
+    if (pre_sigint_handler != SIG_ERR) {
+        std::signal(SIGINT, pre_sigint_handler);
+    }
 
     return data.m_generated_features;
 }
@@ -147,6 +153,7 @@ void FeatureGeneratorImpl::generate_base(
         rule->generate(states, 1, data, caches);
     }
     utils::g_log << "Complexity " << 1 << ":" << std::endl;
+    data.print_memory_statistics();
     print_statistics();
     utils::g_log << "Finished generating base features." << std::endl;
 }
@@ -163,6 +170,7 @@ void FeatureGeneratorImpl::generate_inductively(
     utils::g_log << "Started generating composite features. " << std::endl;
     int max_complexity = std::max({concept_complexity_limit, role_complexity_limit, boolean_complexity_limit, count_numerical_complexity_limit, distance_numerical_complexity_limit});
     for (int target_complexity = 2; target_complexity <= max_complexity; ++target_complexity) {  // every composition adds at least one complexity
+        if (data.reached_memory_limit()) break;
         const auto num_features = data.get_num_features();
         if (target_complexity <= concept_complexity_limit) {
             if (data.reached_resource_limit()) break;
@@ -195,6 +203,7 @@ void FeatureGeneratorImpl::generate_inductively(
         }
         utils::g_log << "Complexity " << target_complexity << ":" << std::endl;
         data.print_statistics();
+        data.print_memory_statistics();
         print_statistics();
 
         if (num_features == data.get_num_features()) {
@@ -202,6 +211,9 @@ void FeatureGeneratorImpl::generate_inductively(
             break;
         }
     }
+    if (data.reached_memory_limit()) {
+        utils::g_log << "Feature generation stopped at memory limit of " << m_memory_limit << " bytes." << std::endl;
+    }
     utils::g_log << "Finished generating composite features." << std::endl;
 }
 
@@ -213,6 +225,10 @@ void FeatureGeneratorImpl::print_statistics() const {
     for (auto& r : m_numerical_inductive_rules) r->print_statistics();
 }
 
+void FeatureGeneratorImpl::set_memory_limit(std::size_t num_bytes) {
+    m_memory_limit = num_bytes;
+}
+
 void FeatureGeneratorImpl::set_generate_empty_boolean(bool enable) {
     b_empty->set_enabled(enable);
 }
@@ -97,6 +97,8 @@ private:
     Rule_Ptr r_transitive_closure;
     Rule_Ptr r_transitive_reflexive_closure;
 
+    std::size_t m_memory_limit;
+
 private:
     /**
      * Generates all Elements with complexity 1.
@@ -144,7 +146,10 @@ public:
         int count_numerical_complexity_limit,
         int distance_numerical_complexity_limit,
         int time_limit,
-        int feature_limit);
+        int feature_limit,
+        std::shared_ptr<const utils::CancellationToken> cancellation_token);
+
+    void set_memory_limit(std::size_t num_bytes);
 
     /**
      * Set element generation on or off
@@ -36,9 +36,14 @@ GeneratedFeatures FeatureGenerator::generate(
     int count_numerical_complexity_limit,
     int distance_numerical_complexity_limit,
     int time_limit,
-    int feature_limit)
+    int feature_limit,
+    std::shared_ptr<const utils::CancellationToken> cancellation_token)
 {
-    return m_pImpl->generate(factory, states, concept_complexity_limit, role_complexity_limit, boolean_complexity_limit, count_numerical_complexity_limit, distance_numerical_complexity_limit, time_limit, feature_limit);
+    return m_pImpl->generate(factory, states, concept_complexity_limit, role_complexity_limit, boolean_complexity_limit, count_numerical_complexity_limit, distance_numerical_complexity_limit, time_limit, feature_limit, cancellation_token);
+}
+
+void FeatureGenerator::set_memory_limit(std::size_t num_bytes) {
+    m_pImpl->set_memory_limit(num_bytes);
 }
 
 void FeatureGenerator::set_generate_empty_boolean(bool enable) {
@@ -205,7 +210,8 @@ GeneratedFeatures generate_features(
     bool generate_til_c_role,
     bool generate_top_role,
     bool generate_transitive_closure_role,
-    bool generate_transitive_reflexive_closure_role) {
+    bool generate_transitive_reflexive_closure_role,
+    std::shared_ptr<const utils::CancellationToken> cancellation_token) {
     FeatureGeneratorImpl generator = FeatureGeneratorImpl();
     generator.set_generate_empty_boolean(generate_empty_boolean);
     generator.set_generate_inclusion_boolean(generate_inclusion_boolean);
@@ -244,7 +250,8 @@ GeneratedFeatures generate_features(
         count_numerical_complexity_limit,
         distance_numerical_complexity_limit,
         time_limit,
-        feature_limit);
+        feature_limit,
+        cancellation_token);
 }
 
 }
@@ -6,6 +6,7 @@
 #include "../../include/dlplan/generator.h"
 
 #include <iostream>
+#include <limits>
 #include <numeric>
 #include <vector>
 
@@ -28,13 +29,22 @@ struct GeneratorData {
     int m_complexity;
     int m_time_limit;
     int m_feature_limit;
+    std::size_t m_memory_limit;
     utils::CountdownTimer m_timer;
+    std::shared_ptr<const utils::CancellationToken> m_cancellation_token;
+
+    // memory accounting
+    const core::DenotationsCaches& m_caches;
+    std::size_t m_num_bytes_after_previous_layer;
 
     GeneratorData(
       core::SyntacticElementFactory& factory,
+      const core::DenotationsCaches& caches,
       int complexity,
       int time_limit,
-      int feature_limit)
+      int feature_limit,
+      std::size_t memory_limit,
+      std::shared_ptr<const utils::CancellationToken> cancellation_token)
       : m_factory(factory),
         m_booleans_by_iteration(std::vector<std::vector<std::shared_ptr<const core::Boolean>>>(complexity + 1)),
         m_numericals_by_iteration(std::vector<std::vector<std::shared_ptr<const core::Numerical>>>(complexity + 1)),
@@ -43,12 +53,57 @@ struct GeneratorData {
         m_complexity(complexity),
         m_time_limit(time_limit),
         m_feature_limit(feature_limit),
-        m_timer(time_limit) { }
+        m_memory_limit(memory_limit),
+        m_timer(time_limit),
+        m_cancellation_token(std::move(cancellation_token)),
+        m_caches(caches),
+        m_num_bytes_after_previous_layer(0) { }
 
     int get_num_features() {
       return std::get<0>(m_generated_features).size() + std::get<1>(m_generated_features).size() + std::get<2>(m_generated_features).size() + std::get<3>(m_generated_features).size();
     }
 
+    /// @brief Returns the number of bytes of the hash tables and
+    ///        element lists, excluding the elements and denotations.
+    std::size_t compute_num_generator_bytes() const {
+        auto hash_table_bytes = [](const auto& hash_table) {
+            // nodes with next pointer, shared_ptr and cached hash value, and buckets
+            return hash_table.size() * (2 * sizeof(void*) + sizeof(typename std::decay_t<decltype(hash_table)>::value_type))
+                + hash_table.bucket_count() * sizeof(void*);
+        };
+        auto list_bytes = [](const auto& lists) {
+            return std::accumulate(lists.begin(), lists.end(), sizeof(lists) + lists.capacity() * sizeof(lists.front()), [](std::size_t current_sum, const auto& e){
+                return current_sum + e.capacity() * sizeof(typename std::decay_t<decltype(e)>::value_type);
+            });
+        };
+        return hash_table_bytes(m_boolean_hash_table) + hash_table_bytes(m_numerical_hash_table)
+            + hash_table_bytes(m_concept_hash_table) + hash_table_bytes(m_role_hash_table)
+            + list_bytes(m_booleans_by_iteration) + list_bytes(m_numericals_by_iteration)
+            + list_bytes(m_concepts_by_iteration) + list_bytes(m_roles_by_iteration)
+            + std::get<0>(m_generated_features).capacity() * sizeof(std::shared_ptr<const core::Boolean>)
+            + std::get<1>(m_generated_features).capacity() * sizeof(std::shared_ptr<const core::Numerical>)
+            + std::get<2>(m_generated_features).capacity() * sizeof(std::shared_ptr<const core::Concept>)
+            + std::get<3>(m_generated_features).capacity() * sizeof(std::shared_ptr<const core::Role>);
+    }
+
+    /// @brief Returns the number of bytes of the denotations, elements, and generator.
+    std::size_t compute_num_bytes() const {
+        return m_caches.get_num_bytes() + m_factory.get_num_bytes() + compute_num_generator_bytes();
+    }
+
+    /// @brief Prints the memory in total and of the layer since the previous call.
+    void print_memory_statistics() {
+        const std::size_t num_denotation_bytes = m_caches.get_num_bytes();
+        const std::size_t num_element_bytes = m_factory.get_num_bytes();
+        const std::size_t num_generator_bytes = compute_num_generator_bytes();
+        const std::size_t num_bytes = num_denotation_bytes + num_element_bytes + num_generator_bytes;
+        std::cout << "Memory of denotations: " << num_denotation_bytes << " bytes" << std::endl
+                  << "Memory of elements: " << num_element_bytes << " bytes" << std::endl
+                  << "Memory of generator: " << num_generator_bytes << " bytes" << std::endl
+                  << "Memory of layer: " << static_cast<long long>(num_bytes) - static_cast<long long>(m_num_bytes_after_previous_layer) << " bytes" << std::endl;
+        m_num_bytes_after_previous_layer = num_bytes;
+    }
+
     void print_statistics() const {
         std::cout << "Total concept elements: " << std::accumulate(m_concepts_by_iteration.begin(), m_concepts_by_iteration.end(), 0, [&](int current_sum, const auto& e){ return current_sum + e.size(); }) << std::endl
                   << "Total role elements: " << std::accumulate(m_roles_by_iteration.begin(), m_roles_by_iteration.end(), 0, [&](int current_sum, const auto& e){ return current_sum + e.size(); }) << std::endl
@@ -57,8 +112,16 @@ struct GeneratorData {
     }
 
     bool reached_resource_limit() {
+      // Cancellation is observed at the same rule and layer boundaries as the resource limits.
+      utils::throw_if_cancelled(m_cancellation_token, "FeatureGenerator::generate");
       return (get_num_features() >= m_feature_limit || m_timer.is_expired());
     }
+
+    /// @brief Is only checked between complexity layers such that generation
+    ///        stops with the layers completed so far.
+    bool reached_memory_limit() const {
+      return m_memory_limit != std::numeric_limits<std::size_t>::max() && compute_num_bytes() >= m_memory_limit;
+    }
 };
 
 }
@@ -15,17 +15,18 @@ namespace dlplan::novelty {
 TupleGraph::TupleGraph(
     std::shared_ptr<const NoveltyBase> novelty_base,
     std::shared_ptr<const state_space::StateSpace> state_space,
-    StateIndex root_state_index)
+    StateIndex root_state_index,
+    std::shared_ptr<const utils::CancellationToken> cancellation_token)
     : m_novelty_base(novelty_base),
       m_state_space(state_space),
       m_root_state_index(root_state_index) {
     if (!m_novelty_base) {
         throw std::runtime_error("TupleGraph::TupleGraph - novelty_base is nullptr.");
     }
-    if (!m_novelty_base) {
+    if (!m_state_space) {
         throw std::runtime_error("TupleGraph::TupleGraph - state_space is nullptr.");
     }
-    TupleGraphBuilderResult result = TupleGraphBuilder(novelty_base, state_space, root_state_index).get_result();
+    TupleGraphBuilderResult result = TupleGraphBuilder(novelty_base, state_space, root_state_index, std::move(cancellation_token)).get_result();
     m_nodes = std::move(result.nodes);
     m_node_indices_by_distance = std::move(result.node_indices_by_distance);
     m_state_indices_by_distance = std::move(result.state_indices_by_distance);
@@ -155,7 +156,7 @@ std::string TupleGraph::to_dot(int verbosity_level) const {
                     }
                 }
                 if (verbosity_level >= 1) {
-                    result << m_state_space->get_states().at(state_index).str();
+                    result << m_state_space->get_state(state_index).str();
                 } else {
                     result << state_index;
                 }
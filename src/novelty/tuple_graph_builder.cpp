@@ -73,22 +73,18 @@ StateIndices TupleGraphBuilder::compute_state_layer(
     StateIndicesSet& visited_state_indices)
 {
     std::unordered_set<StateIndex> layer_set;
-    const auto& successors = m_state_space->get_forward_successor_state_indices();
+    const auto& successors = m_state_space->get_forward_successors();
 
     for (const auto source_index : current_layer)
     {
         assert(visited_state_indices.count(source_index));
-        const auto it = successors.find(source_index);
 
-        if (it != successors.end())
+        for (const auto target_index : successors.get_targets(source_index))
         {
-            for (const auto target_index : it->second)
+            if (!visited_state_indices.count(target_index))
             {
-                if (!visited_state_indices.count(target_index))
-                {
-                    visited_state_indices.insert(target_index);
-                    layer_set.insert(target_index);
-                }
+                visited_state_indices.insert(target_index);
+                layer_set.insert(target_index);
             }
         }
     }
@@ -103,7 +99,7 @@ TupleIndicesSet TupleGraphBuilder::compute_novel_tuple_indices_layer(const State
     {
         const TupleIndices state_novel_tuples = m_novelty_table.compute_novel_tuple_indices(
             {},
-            m_state_space->get_states().at(state_index).get_atom_indices());
+            m_state_space->get_state(state_index).get_atom_indices());
         novel_tuples_set.insert(state_novel_tuples.begin(), state_novel_tuples.end());
         m_state_index_to_novel_tuple_indices.emplace(state_index, state_novel_tuples);
 
@@ -120,24 +116,19 @@ TupleIndicesSet TupleGraphBuilder::compute_novel_tuple_indices_layer(const State
 std::unordered_map<TupleIndex, StateIndicesSet>
 TupleGraphBuilder::extend_states(TupleIndex cur_node_index) const {
     std::unordered_map<TupleIndex, StateIndicesSet> extended;
-    const auto& successors = m_state_space->get_forward_successor_state_indices();
+    const auto& successors = m_state_space->get_forward_successors();
 
     for (const auto source_index : m_nodes[cur_node_index].get_state_indices())
     {
-        const auto it = successors.find(source_index);
-
-        if (it != successors.end())
+        for (const auto target_index : successors.get_targets(source_index))
         {
-            for (const auto target_index : it->second)
-            {
-                const auto it = m_state_index_to_novel_tuple_indices.find(target_index);
+            const auto it = m_state_index_to_novel_tuple_indices.find(target_index);
 
-                if (it != m_state_index_to_novel_tuple_indices.end())
+            if (it != m_state_index_to_novel_tuple_indices.end())
+            {
+                for (const auto target_tuple_index : it->second)
                 {
-                    for (const auto target_tuple_index : it->second)
-                    {
-                        extended[target_tuple_index].insert(source_index);
-                    }
+                    extended[target_tuple_index].insert(source_index);
                 }
             }
         }
@@ -247,14 +238,14 @@ void TupleGraphBuilder::build_width_equal_0_tuple_graph()
     m_node_indices_by_distance.push_back({initial_node_index});
     m_nodes.push_back({TupleNode(initial_node_index, initial_node_index, {m_root_state_index})});
     m_state_indices_by_distance.push_back({m_root_state_index});
-    const auto& it = m_state_space->get_forward_successor_state_indices().find(m_root_state_index);
+    const auto targets = m_state_space->get_forward_successors().get_targets(m_root_state_index);
 
-    if (it != m_state_space->get_forward_successor_state_indices().end())
+    if (!targets.empty())
     {
         TupleNodeIndices curr_tuple_layer;
         StateIndices curr_state_layer;
 
-        for (const auto& target_index : it->second)
+        for (const auto& target_index : targets)
         {
             TupleNodeIndex node_index = m_nodes.size();
             curr_tuple_layer.push_back(node_index);
@@ -280,13 +271,14 @@ void TupleGraphBuilder::build_width_greater_0_tuple_graph()
     TupleNode tuple_node = TupleNode(node_index, tuple_index, StateIndicesSet{m_root_state_index});
     m_nodes.push_back(tuple_node);
     m_node_indices_by_distance.push_back(TupleNodeIndices{node_index});
-    TupleIndices tuple_indices = m_novelty_table.compute_novel_tuple_indices(m_state_space->get_states().at(m_root_state_index).get_atom_indices());
+    TupleIndices tuple_indices = m_novelty_table.compute_novel_tuple_indices(m_state_space->get_state(m_root_state_index).get_atom_indices());
     m_novelty_table.insert_tuple_indices(tuple_indices, false);
     visited_state_indices.insert(m_root_state_index);
 
     // 2. Iterate distances > 0
     for (int distance = 1; ; ++distance)
     {
+        utils::throw_if_cancelled(m_cancellation_token, "TupleGraph::TupleGraph");
         StateIndices curr_state_layer = compute_state_layer(m_state_indices_by_distance[distance-1], visited_state_indices);
         auto novel_tuple_indices = compute_novel_tuple_indices_layer(curr_state_layer);
 
@@ -309,10 +301,12 @@ void TupleGraphBuilder::build_width_greater_0_tuple_graph()
 TupleGraphBuilder::TupleGraphBuilder(
     std::shared_ptr<const NoveltyBase> novelty_base,
     std::shared_ptr<const state_space::StateSpace> state_space,
-    StateIndex root_state)
+    StateIndex root_state,
+    std::shared_ptr<const utils::CancellationToken> cancellation_token)
     : m_novelty_base(novelty_base),
       m_state_space(state_space),
       m_root_state_index(root_state),
+      m_cancellation_token(std::move(cancellation_token)),
       m_novelty_table(novelty_base)
 {
     if (!m_novelty_base)
@@ -320,7 +314,7 @@ TupleGraphBuilder::TupleGraphBuilder(
         throw std::runtime_error("TupleGraphBuilder::TupleGraphBuilder - novelty_base is nullptr.");
     }
 
-    if (!m_novelty_base)
+    if (!m_state_space)
     {
         throw std::runtime_error("TupleGraphBuilder::TupleGraphBuilder - state_space is nullptr.");
     }
@@ -22,6 +22,7 @@ private:
     std::shared_ptr<const NoveltyBase> m_novelty_base;
     std::shared_ptr<const state_space::StateSpace> m_state_space;
     state_space::StateIndex m_root_state_index;
+    std::shared_ptr<const utils::CancellationToken> m_cancellation_token;
     // output
     TupleNodes m_nodes;
     std::vector<TupleNodeIndices> m_node_indices_by_distance;
@@ -67,7 +68,8 @@ public:
     TupleGraphBuilder(
         std::shared_ptr<const NoveltyBase> novelty_base,
         std::shared_ptr<const state_space::StateSpace> state_space,
-        StateIndex root_state);
+        StateIndex root_state,
+        std::shared_ptr<const utils::CancellationToken> cancellation_token);
 
     TupleGraphBuilderResult get_result();
 };
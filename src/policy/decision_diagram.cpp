@@ -0,0 +1,231 @@
+#include "../../include/dlplan/policy.h"
+
+#include "feature_predicates.h"
+
+#include <algorithm>
+#include <limits>
+#include <map>
+#include <stdexcept>
+#include <tuple>
+#include <unordered_map>
+
+
+namespace dlplan::policy {
+
+/// @brief Constructs the reduced diagram bottom-up by recursively splitting
+///        the ordered list of candidate rules on the next required predicate.
+///
+/// A candidate rule is alive if all of its predicates tested so far were true.
+/// Since rules are tried in order, the first alive rule whose predicates were
+/// all tested determines the result and all later candidates can be dropped.
+class DecisionDiagramBuilder {
+private:
+    using Node = std::tuple<int, int, int>;
+
+    // sorted predicates per rule
+    const std::vector<std::vector<int>>& m_rule_predicates;
+    std::vector<Node>& m_nodes;
+    std::map<Node, int> m_unique_table;
+    std::map<std::pair<int, std::vector<int>>, int> m_computed_table;
+
+    int make_node(int predicate, int high, int low) {
+        if (high == low) {
+            return high;
+        }
+        auto result = m_unique_table.emplace(Node(predicate, high, low), m_nodes.size());
+        if (result.second) {
+            m_nodes.emplace_back(predicate, high, low);
+        }
+        return result.first->second;
+    }
+
+public:
+    DecisionDiagramBuilder(const std::vector<std::vector<int>>& rule_predicates, std::vector<Node>& nodes)
+        : m_rule_predicates(rule_predicates), m_nodes(nodes) {
+        // Terminal 0 represents no rule and terminal i+1 represents rule i.
+        m_nodes.emplace_back(-1, -1, -1);
+        for (size_t i = 0; i < rule_predicates.size(); ++i) {
+            m_nodes.emplace_back(-1, i, -1);
+        }
+    }
+
+    int build(int level, std::vector<int> candidates) {
+        // Drop candidates after the first rule whose predicates were all tested.
+        for (size_t i = 0; i < candidates.size(); ++i) {
+            const auto& predicates = m_rule_predicates[candidates[i]];
+            if (predicates.empty() || predicates.back() < level) {
+                if (i == 0) {
+                    return candidates[0] + 1;
+                }
+                candidates.resize(i + 1);
+                break;
+            }
+        }
+        if (candidates.empty()) {
+            return 0;
+        }
+        // Skip predicates that no candidate requires.
+        int predicate = std::numeric_limits<int>::max();
+        for (const int rule : candidates) {
+            const auto& predicates = m_rule_predicates[rule];
+            auto it = std::lower_bound(predicates.begin(), predicates.end(), level);
+            if (it != predicates.end()) {
+                predicate = std::min(predicate, *it);
+            }
+        }
+        auto key = std::make_pair(predicate, candidates);
+        auto it = m_computed_table.find(key);
+        if (it != m_computed_table.end()) {
+            return it->second;
+        }
+        std::vector<int> low_candidates;
+        for (const int rule : candidates) {
+            const auto& predicates = m_rule_predicates[rule];
+            if (!std::binary_search(predicates.begin(), predicates.end(), predicate)) {
+                low_candidates.push_back(rule);
+            }
+        }
+        int high = build(predicate + 1, candidates);
+        int low = build(predicate + 1, std::move(low_candidates));
+        int node = make_node(predicate, high, low);
+        m_computed_table.emplace(std::move(key), node);
+        return node;
+    }
+};
+
+
+PolicyDecisionDiagram::PolicyDecisionDiagram(std::shared_ptr<const Policy> policy)
+    : m_policy(policy), m_root(0) {
+    if (!m_policy) {
+        throw std::runtime_error("PolicyDecisionDiagram::PolicyDecisionDiagram - policy is nullptr.");
+    }
+    m_rules = std::vector<std::shared_ptr<const Rule>>(m_policy->get_rules().begin(), m_policy->get_rules().end());
+
+    // Collect distinct predicates and order them cheapest first
+    // where conditions precede effects of equal score.
+    struct Predicate {
+        int score;
+        bool is_effect;
+        int position;
+        std::shared_ptr<const BaseCondition> condition;
+        std::shared_ptr<const BaseEffect> effect;
+    };
+    std::vector<Predicate> predicates;
+    std::unordered_map<const void*, int> predicate_to_position;
+    for (const auto& rule : m_rules) {
+        for (const auto& condition : rule->get_conditions()) {
+            if (predicate_to_position.emplace(condition.get(), predicates.size()).second) {
+                predicates.push_back(Predicate{condition->compute_evaluate_time_score(), false, static_cast<int>(predicates.size()), condition, nullptr});
+            }
+        }
+        for (const auto& effect : rule->get_effects()) {
+            if (predicate_to_position.emplace(effect.get(), predicates.size()).second) {
+                predicates.push_back(Predicate{effect->compute_evaluate_time_score(), true, static_cast<int>(predicates.size()), nullptr, effect});
+            }
+        }
+    }
+    std::sort(predicates.begin(), predicates.end(), [](const Predicate& l, const Predicate& r) {
+        return std::tie(l.score, l.is_effect, l.position) < std::tie(r.score, r.is_effect, r.position);
+    });
+    std::vector<int> position_to_predicate(predicates.size());
+    std::unordered_map<const void*, int> element_to_feature_index;
+    for (size_t i = 0; i < predicates.size(); ++i) {
+        const auto& predicate = predicates[i];
+        position_to_predicate[predicate.position] = i;
+        if (predicate.is_effect) {
+            CompileEffect compile_effect(m_feature_evaluators, element_to_feature_index);
+            predicate.effect->accept(compile_effect);
+            m_predicate_feature_indices.push_back(compile_effect.feature_index);
+            m_condition_predicates.push_back(nullptr);
+            m_effect_predicates.push_back(std::move(compile_effect.predicate));
+        } else {
+            CompileCondition compile_condition(m_feature_evaluators, element_to_feature_index);
+            predicate.condition->accept(compile_condition);
+            m_predicate_feature_indices.push_back(compile_condition.feature_index);
+            m_condition_predicates.push_back(std::move(compile_condition.predicate));
+            m_effect_predicates.push_back(nullptr);
+        }
+    }
+
+    std::vector<std::vector<int>> rule_predicates;
+    for (const auto& rule : m_rules) {
+        std::vector<int> indices;
+        for (const auto& condition : rule->get_conditions()) {
+            indices.push_back(position_to_predicate[predicate_to_position.at(condition.get())]);
+        }
+        for (const auto& effect : rule->get_effects()) {
+            indices.push_back(position_to_predicate[predicate_to_position.at(effect.get())]);
+        }
+        std::sort(indices.begin(), indices.end());
+        rule_predicates.push_back(std::move(indices));
+    }
+    std::vector<std::tuple<int, int, int>> nodes;
+    DecisionDiagramBuilder builder(rule_predicates, nodes);
+    std::vector<int> candidates(m_rules.size());
+    for (size_t i = 0; i < m_rules.size(); ++i) {
+        candidates[i] = i;
+    }
+    m_root = builder.build(0, std::move(candidates));
+    for (const auto& [predicate, high, low] : nodes) {
+        m_nodes.push_back(Node{predicate, high, low});
+    }
+}
+
+PolicyDecisionDiagram::PolicyDecisionDiagram(const PolicyDecisionDiagram& other) = default;
+
+PolicyDecisionDiagram& PolicyDecisionDiagram::operator=(const PolicyDecisionDiagram& other) = default;
+
+PolicyDecisionDiagram::PolicyDecisionDiagram(PolicyDecisionDiagram&& other) = default;
+
+PolicyDecisionDiagram& PolicyDecisionDiagram::operator=(PolicyDecisionDiagram&& other) = default;
+
+PolicyDecisionDiagram::~PolicyDecisionDiagram() = default;
+
+std::shared_ptr<const Rule> PolicyDecisionDiagram::evaluate(const core::State& source_state, const core::State& target_state, core::DenotationsCaches* caches) const {
+    // Feature values are computed on demand and at most once per state.
+    const int num_features = m_feature_evaluators.size();
+    std::vector<int> source_values(num_features);
+    std::vector<int> target_values(num_features);
+    std::vector<bool> has_source_value(num_features, false);
+    std::vector<bool> has_target_value(num_features, false);
+    auto get_value = [&](int feature_index, const core::State& state, std::vector<int>& values, std::vector<bool>& has_value) {
+        if (!has_value[feature_index]) {
+            values[feature_index] = m_feature_evaluators[feature_index](state, caches);
+            has_value[feature_index] = true;
+        }
+        return values[feature_index];
+    };
+    const Node* node = &m_nodes[m_root];
+    while (node->predicate != -1) {
+        int predicate = node->predicate;
+        int feature_index = m_predicate_feature_indices[predicate];
+        int source_value = get_value(feature_index, source_state, source_values, has_source_value);
+        bool value = (m_condition_predicates[predicate])
+            ? m_condition_predicates[predicate](source_value)
+            : m_effect_predicates[predicate](source_value, get_value(feature_index, target_state, target_values, has_target_value));
+        node = &m_nodes[value ? node->high : node->low];
+    }
+    return (node->high == -1) ? nullptr : m_rules[node->high];
+}
+
+std::shared_ptr<const Rule> PolicyDecisionDiagram::evaluate(const core::State& source_state, const core::State& target_state) const {
+    return evaluate(source_state, target_state, nullptr);
+}
+
+std::shared_ptr<const Rule> PolicyDecisionDiagram::evaluate(const core::State& source_state, const core::State& target_state, core::DenotationsCaches& caches) const {
+    return evaluate(source_state, target_state, &caches);
+}
+
+int PolicyDecisionDiagram::get_num_nodes() const {
+    return m_nodes.size();
+}
+
+int PolicyDecisionDiagram::get_num_predicates() const {
+    return m_predicate_feature_indices.size();
+}
+
+std::shared_ptr<const Policy> PolicyDecisionDiagram::get_policy() const {
+    return m_policy;
+}
+
+}
@@ -0,0 +1,185 @@
+#ifndef DLPLAN_SRC_POLICY_FEATURE_PREDICATES_H_
+#define DLPLAN_SRC_POLICY_FEATURE_PREDICATES_H_
+
+#include "../../include/dlplan/policy.h"
+#include "../../include/dlplan/policy/condition.h"
+#include "../../include/dlplan/policy/effect.h"
+
+#include <functional>
+#include <unordered_map>
+#include <vector>
+
+
+namespace dlplan::policy {
+
+/// @brief Evaluates a feature to an int, i.e., booleans as 0/1 and concepts by their size.
+///        Uses the caches if they are not nullptr.
+using FeatureEvaluator = std::function<int(const core::State&, core::DenotationsCaches*)>;
+using ConditionPredicate = std::function<bool(int)>;
+using EffectPredicate = std::function<bool(int, int)>;
+
+
+/// @brief Numbers the features that occur in conditions and effects.
+struct FeatureCompiler {
+    std::vector<FeatureEvaluator>& feature_evaluators;
+    std::unordered_map<const void*, int>& element_to_feature_index;
+    int feature_index;
+
+    FeatureCompiler(std::vector<FeatureEvaluator>& feature_evaluators_, std::unordered_map<const void*, int>& element_to_feature_index_)
+        : feature_evaluators(feature_evaluators_), element_to_feature_index(element_to_feature_index_), feature_index(-1) { }
+
+    template<typename Element, typename Evaluator>
+    void add_feature(const std::shared_ptr<const Element>& element, Evaluator&& evaluator) {
+        auto result = element_to_feature_index.emplace(element.get(), feature_evaluators.size());
+        if (result.second) {
+            feature_evaluators.push_back(std::forward<Evaluator>(evaluator));
+        }
+        feature_index = result.first->second;
+    }
+
+    void add_boolean(const std::shared_ptr<const NamedBoolean>& boolean) {
+        auto element = boolean->get_element();
+        add_feature(element, [element](const core::State& state, core::DenotationsCaches* caches) -> int {
+            return caches ? element->evaluate(state, *caches) : element->evaluate(state);
+        });
+    }
+
+    void add_numerical(const std::shared_ptr<const NamedNumerical>& numerical) {
+        auto element = numerical->get_element();
+        add_feature(element, [element](const core::State& state, core::DenotationsCaches* caches) -> int {
+            return caches ? element->evaluate(state, *caches) : element->evaluate(state);
+        });
+    }
+
+    void add_concept(const std::shared_ptr<const NamedConcept>& concept_) {
+        auto element = concept_->get_element();
+        add_feature(element, [element](const core::State& state, core::DenotationsCaches* caches) -> int {
+            return caches ? element->evaluate(state, *caches)->size() : element->evaluate(state).size();
+        });
+    }
+};
+
+
+/// @brief Compiles a condition into a predicate over the source value of a feature.
+struct CompileCondition : public FeatureCompiler, public BaseConditionVisitor {
+    ConditionPredicate predicate;
+
+    using FeatureCompiler::FeatureCompiler;
+
+    void visit(const std::shared_ptr<const PositiveBooleanCondition>& condition) override {
+        add_boolean(condition->get_named_element());
+        predicate = [](int source) { return source != 0; };
+    }
+
+    void visit(const std::shared_ptr<const NegativeBooleanCondition>& condition) override {
+        add_boolean(condition->get_named_element());
+        predicate = [](int source) { return source == 0; };
+    }
+
+    void visit(const std::shared_ptr<const GreaterNumericalCondition>& condition) override {
+        add_numerical(condition->get_named_element());
+        predicate = [](int source) { return source > 0; };
+    }
+
+    void visit(const std::shared_ptr<const EqualNumericalCondition>& condition) override {
+        add_numerical(condition->get_named_element());
+        predicate = [](int source) { return source == 0; };
+    }
+
+    void visit(const std::shared_ptr<const GreaterConceptCondition>& condition) override {
+        add_concept(condition->get_named_element());
+        predicate = [](int source) { return source > 0; };
+    }
+
+    void visit(const std::shared_ptr<const EqualConceptCondition>& condition) override {
+        add_concept(condition->get_named_element());
+        predicate = [](int source) { return source == 0; };
+    }
+};
+
+
+/// @brief Compiles an effect into a predicate over the source and target value of a feature.
+struct CompileEffect : public FeatureCompiler, public BaseEffectVisitor {
+    EffectPredicate predicate;
+
+    using FeatureCompiler::FeatureCompiler;
+
+    void visit(const std::shared_ptr<const PositiveBooleanEffect>& effect) override {
+        add_boolean(effect->get_named_element());
+        predicate = [](int, int target) { return target != 0; };
+    }
+
+    void visit(const std::shared_ptr<const NegativeBooleanEffect>& effect) override {
+        add_boolean(effect->get_named_element());
+        predicate = [](int, int target) { return target == 0; };
+    }
+
+    void visit(const std::shared_ptr<const UnchangedBooleanEffect>& effect) override {
+        add_boolean(effect->get_named_element());
+        predicate = [](int source, int target) { return source == target; };
+    }
+
+    void visit(const std::shared_ptr<const IncrementNumericalEffect>& effect) override {
+        add_numerical(effect->get_named_element());
+        predicate = [](int source, int target) { return source < target; };
+    }
+
+    void visit(const std::shared_ptr<const IncrementOrUnchangedNumericalEffect>& effect) override {
+        add_numerical(effect->get_named_element());
+        predicate = [](int source, int target) { return source <= target; };
+    }
+
+    void visit(const std::shared_ptr<const DecrementNumericalEffect>& effect) override {
+        add_numerical(effect->get_named_element());
+        predicate = [](int source, int target) { return source > target; };
+    }
+
+    void visit(const std::shared_ptr<const DecrementOrUnchangedNumericalEffect>& effect) override {
+        add_numerical(effect->get_named_element());
+        predicate = [](int source, int target) { return source >= target; };
+    }
+
+    void visit(const std::shared_ptr<const UnchangedNumericalEffect>& effect) override {
+        add_numerical(effect->get_named_element());
+        predicate = [](int source, int target) { return source == target; };
+    }
+
+    void visit(const std::shared_ptr<const GreaterNumericalEffect>& effect) override {
+        add_numerical(effect->get_named_element());
+        predicate = [](int, int target) { return target > 0; };
+    }
+
+    void visit(const std::shared_ptr<const EqualNumericalEffect>& effect) override {
+        add_numerical(effect->get_named_element());
+        predicate = [](int, int target) { return target == 0; };
+    }
+
+    void visit(const std::shared_ptr<const IncrementConceptEffect>& effect) override {
+        add_concept(effect->get_named_element());
+        predicate = [](int source, int target) { return source < target; };
+    }
+
+    void visit(const std::shared_ptr<const DecrementConceptEffect>& effect) override {
+        add_concept(effect->get_named_element());
+        predicate = [](int source, int target) { return source > target; };
+    }
+
+    void visit(const std::shared_ptr<const UnchangedConceptEffect>& effect) override {
+        add_concept(effect->get_named_element());
+        predicate = [](int source, int target) { return source == target; };
+    }
+
+    void visit(const std::shared_ptr<const GreaterConceptEffect>& effect) override {
+        add_concept(effect->get_named_element());
+        predicate = [](int, int target) { return target > 0; };
+    }
+
+    void visit(const std::shared_ptr<const EqualConceptEffect>& effect) override {
+        add_concept(effect->get_named_element());
+        predicate = [](int, int target) { return target == 0; };
+    }
+};
+
+}
+
+#endif
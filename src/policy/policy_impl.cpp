@@ -5,8 +5,12 @@
 #include "../../include/dlplan/policy/condition.h"
 #include "../../include/dlplan/policy/effect.h"
 
+#include "feature_predicates.h"
+
 #include <algorithm>
+#include <exception>
 #include <sstream>
+#include <thread>
 
 
 namespace dlplan::policy {
@@ -128,6 +132,49 @@ Policy::Policy(int identifier, const Rules& rules)
             effect->accept(effect_visitor);
         }
     }
+    // Number the distinct conditions and effects.
+    std::unordered_map<const BaseCondition*, int> condition_to_index;
+    std::unordered_map<const BaseEffect*, int> effect_to_index;
+    for (const auto& rule : m_rules) {
+        for (const auto& condition : rule->get_conditions()) {
+            if (condition_to_index.emplace(condition.get(), m_condition_vector.size()).second) {
+                m_condition_vector.push_back(condition);
+            }
+        }
+        for (const auto& effect : rule->get_effects()) {
+            if (effect_to_index.emplace(effect.get(), m_effect_vector.size()).second) {
+                m_effect_vector.push_back(effect);
+            }
+        }
+    }
+    // Evaluate cheap conditions first such that expensive conditions of rules that cannot match are skipped.
+    std::stable_sort(m_condition_vector.begin(), m_condition_vector.end(), [](const auto& l, const auto& r) {
+        return l->compute_evaluate_time_score() < r->compute_evaluate_time_score();
+    });
+    for (size_t i = 0; i < m_condition_vector.size(); ++i) {
+        condition_to_index[m_condition_vector[i].get()] = i;
+    }
+    m_condition_rule_indices.resize(m_condition_vector.size());
+    for (const auto& rule : m_rules) {
+        for (const auto& condition : rule->get_conditions()) {
+            m_condition_rule_indices[condition_to_index.at(condition.get())].push_back(m_rule_vector.size());
+        }
+        std::vector<int> effect_indices;
+        for (const auto& effect : rule->get_effects()) {
+            effect_indices.push_back(effect_to_index.at(effect.get()));
+        }
+        m_rule_to_index.emplace(rule.get(), m_rule_vector.size());
+        m_rule_vector.push_back(rule);
+        m_rule_effect_indices.push_back(std::move(effect_indices));
+    }
+    // Compile effects for the batched evaluation.
+    std::unordered_map<const void*, int> element_to_feature_index;
+    for (const auto& effect : m_effect_vector) {
+        CompileEffect compile_effect(m_feature_evaluators, element_to_feature_index);
+        effect->accept(compile_effect);
+        m_effect_feature_indices.push_back(compile_effect.feature_index);
+        m_effect_predicates.push_back(std::move(compile_effect.predicate));
+    }
 }
 
 Policy::Policy(const Policy& other) = default;
@@ -156,45 +203,202 @@ size_t Policy::hash_impl() const {
         hash_set(m_rules));
 }
 
-std::shared_ptr<const Rule> Policy::evaluate(const core::State& source_state, const core::State& target_state) const {
-    for (const auto& r : m_rules) {
-        if (r->evaluate_conditions(source_state) && r->evaluate_effects(source_state, target_state)) {
-            return r;
+std::vector<int> Policy::compute_matching_rule_indices(const core::State& source_state, core::DenotationsCaches* caches) const {
+    std::vector<char> is_candidate(m_rule_vector.size(), true);
+    int num_candidates = m_rule_vector.size();
+    for (size_t i = 0; i < m_condition_vector.size() && num_candidates > 0; ++i) {
+        const auto& rule_indices = m_condition_rule_indices[i];
+        if (std::none_of(rule_indices.begin(), rule_indices.end(), [&](int rule_index) { return is_candidate[rule_index]; })) {
+            continue;
+        }
+        const auto& condition = m_condition_vector[i];
+        if (!(caches ? condition->evaluate(source_state, *caches) : condition->evaluate(source_state))) {
+            for (const int rule_index : rule_indices) {
+                if (is_candidate[rule_index]) {
+                    is_candidate[rule_index] = false;
+                    --num_candidates;
+                }
+            }
         }
     }
-    return nullptr;
+    std::vector<int> result;
+    for (size_t i = 0; i < m_rule_vector.size(); ++i) {
+        if (is_candidate[i]) {
+            result.push_back(i);
+        }
+    }
+    return result;
 }
 
-std::shared_ptr<const Rule> Policy::evaluate(const core::State& source_state, const core::State& target_state, core::DenotationsCaches& caches) const {
-    for (const auto& r : m_rules) {
-        if (r->evaluate_conditions(source_state, caches) && r->evaluate_effects(source_state, target_state, caches)) {
-            return r;
+std::shared_ptr<const Rule> Policy::find_rule(const core::State& source_state, const core::State& target_state, const std::vector<int>& rule_indices, core::DenotationsCaches* caches) const {
+    // UNKNOWN=-1, FALSE=0, TRUE=1
+    std::vector<int8_t> effect_values(m_effect_vector.size(), -1);
+    for (const int rule_index : rule_indices) {
+        bool satisfied = true;
+        for (const int effect_index : m_rule_effect_indices[rule_index]) {
+            auto& value = effect_values[effect_index];
+            if (value == -1) {
+                const auto& effect = m_effect_vector[effect_index];
+                value = caches ? effect->evaluate(source_state, target_state, *caches) : effect->evaluate(source_state, target_state);
+            }
+            if (!value) {
+                satisfied = false;
+                break;
+            }
+        }
+        if (satisfied) {
+            return m_rule_vector[rule_index];
         }
     }
     return nullptr;
 }
 
+std::vector<std::pair<int, std::shared_ptr<const Rule>>> Policy::compute_compatible_successors(const core::State& source_state, std::span<const core::State> target_states, core::DenotationsCaches* caches, int num_threads) const {
+    std::vector<std::pair<int, std::shared_ptr<const Rule>>> result;
+    auto rule_indices = compute_matching_rule_indices(source_state, caches);
+    if (rule_indices.empty()) {
+        return result;
+    }
+    // Collect the features of the effects of the matching rules.
+    std::vector<int> feature_to_column(m_feature_evaluators.size(), -1);
+    std::vector<int> feature_indices;
+    for (const int rule_index : rule_indices) {
+        for (const int effect_index : m_rule_effect_indices[rule_index]) {
+            int feature_index = m_effect_feature_indices[effect_index];
+            if (feature_to_column[feature_index] == -1) {
+                feature_to_column[feature_index] = feature_indices.size();
+                feature_indices.push_back(feature_index);
+            }
+        }
+    }
+    const int num_features = feature_indices.size();
+    const int num_targets = target_states.size();
+    std::vector<int> source_values(num_features);
+    for (int j = 0; j < num_features; ++j) {
+        source_values[j] = m_feature_evaluators[feature_indices[j]](source_state, caches);
+    }
+    // Evaluate the features of the successors as a row-major matrix.
+    std::vector<int> target_values(static_cast<size_t>(num_targets) * num_features);
+    auto evaluate_targets = [&](int begin, int end, core::DenotationsCaches* local_caches) {
+        for (int i = begin; i < end; ++i) {
+            for (int j = 0; j < num_features; ++j) {
+                target_values[static_cast<size_t>(i) * num_features + j] = m_feature_evaluators[feature_indices[j]](target_states[i], local_caches);
+            }
+        }
+    };
+    num_threads = std::max(1, std::min(num_threads, num_targets));
+    if (num_threads == 1) {
+        evaluate_targets(0, num_targets, caches);
+    } else {
+        // Caches with a single shard would serialize the threads, hence, each thread uses its own.
+        const bool share_caches = caches && caches->get_num_shards() > 1;
+        std::vector<std::exception_ptr> exceptions(num_threads);
+        // Threads join on destruction such that a failure to spawn a thread does not leave started threads running.
+        std::vector<std::jthread> threads;
+        threads.reserve(num_threads);
+        for (int t = 0; t < num_threads; ++t) {
+            threads.emplace_back([&, t]() {
+                try {
+                    core::DenotationsCaches local_caches;
+                    evaluate_targets(
+                        static_cast<long>(num_targets) * t / num_threads,
+                        static_cast<long>(num_targets) * (t + 1) / num_threads,
+                        share_caches ? caches : (caches ? &local_caches : nullptr));
+                } catch (...) {
+                    exceptions[t] = std::current_exception();
+                }
+            });
+        }
+        // Joins the threads.
+        threads.clear();
+        for (const auto& exception : exceptions) {
+            if (exception) {
+                std::rethrow_exception(exception);
+            }
+        }
+    }
+    // Find the first rule with satisfied effects for each successor.
+    // UNKNOWN=-1, FALSE=0, TRUE=1
+    std::vector<int8_t> effect_values(m_effect_vector.size());
+    for (int i = 0; i < num_targets; ++i) {
+        std::fill(effect_values.begin(), effect_values.end(), -1);
+        const int* values = target_values.data() + static_cast<size_t>(i) * num_features;
+        for (const int rule_index : rule_indices) {
+            bool satisfied = true;
+            for (const int effect_index : m_rule_effect_indices[rule_index]) {
+                auto& value = effect_values[effect_index];
+                if (value == -1) {
+                    int column = feature_to_column[m_effect_feature_indices[effect_index]];
+                    value = m_effect_predicates[effect_index](source_values[column], values[column]);
+                }
+                if (!value) {
+                    satisfied = false;
+                    break;
+                }
+            }
+            if (satisfied) {
+                result.emplace_back(i, m_rule_vector[rule_index]);
+                break;
+            }
+        }
+    }
+    return result;
+}
+
+std::vector<std::pair<int, std::shared_ptr<const Rule>>> Policy::evaluate_successors(const core::State& source_state, std::span<const core::State> target_states, int num_threads) const {
+    return compute_compatible_successors(source_state, target_states, nullptr, num_threads);
+}
+
+std::vector<std::pair<int, std::shared_ptr<const Rule>>> Policy::evaluate_successors(const core::State& source_state, std::span<const core::State> target_states, core::DenotationsCaches& caches, int num_threads) const {
+    return compute_compatible_successors(source_state, target_states, &caches, num_threads);
+}
+
+std::shared_ptr<const Rule> Policy::evaluate(const core::State& source_state, const core::State& target_state) const {
+    auto rule_indices = compute_matching_rule_indices(source_state, nullptr);
+    return find_rule(source_state, target_state, rule_indices, nullptr);
+}
+
+std::shared_ptr<const Rule> Policy::evaluate(const core::State& source_state, const core::State& target_state, core::DenotationsCaches& caches) const {
+    auto rule_indices = compute_matching_rule_indices(source_state, &caches);
+    return find_rule(source_state, target_state, rule_indices, &caches);
+}
+
 std::vector<std::shared_ptr<const Rule>> Policy::evaluate_conditions(const core::State& source_state) const {
     std::vector<std::shared_ptr<const Rule>> result;
-    for (const auto& r : m_rules) {
-        if (r->evaluate_conditions(source_state)) {
-            result.push_back(r);
-        }
+    for (const int rule_index : compute_matching_rule_indices(source_state, nullptr)) {
+        result.push_back(m_rule_vector[rule_index]);
     }
     return result;
 }
 
 std::vector<std::shared_ptr<const Rule>> Policy::evaluate_conditions(const core::State& source_state, core::DenotationsCaches& caches) const {
     std::vector<std::shared_ptr<const Rule>> result;
-    for (const auto& r : m_rules) {
-        if (r->evaluate_conditions(source_state, caches)) {
-            result.push_back(r);
-        }
+    for (const int rule_index : compute_matching_rule_indices(source_state, &caches)) {
+        result.push_back(m_rule_vector[rule_index]);
     }
     return result;
 }
 
+/// @brief Maps rules to their indices and returns false if some rule is not part of the policy.
+static bool compute_rule_indices(
+    const std::unordered_map<const Rule*, int>& rule_to_index,
+    const std::vector<std::shared_ptr<const Rule>>& rules,
+    std::vector<int>& rule_indices) {
+    for (const auto& rule : rules) {
+        auto it = rule_to_index.find(rule.get());
+        if (it == rule_to_index.end()) {
+            return false;
+        }
+        rule_indices.push_back(it->second);
+    }
+    return true;
+}
+
 std::shared_ptr<const Rule> Policy::evaluate_effects(const core::State& source_state, const core::State& target_state, const std::vector<std::shared_ptr<const Rule>>& rules) const {
+    std::vector<int> rule_indices;
+    if (compute_rule_indices(m_rule_to_index, rules, rule_indices)) {
+        return find_rule(source_state, target_state, rule_indices, nullptr);
+    }
     for (const auto& r : rules) {
         if (r->evaluate_effects(source_state, target_state)) {
             return r;
@@ -204,6 +408,10 @@ std::shared_ptr<const Rule> Policy::evaluate_effects(const core::State& source_s
 }
 
 std::shared_ptr<const Rule> Policy::evaluate_effects(const core::State& source_state, const core::State& target_state, const std::vector<std::shared_ptr<const Rule>>& rules, core::DenotationsCaches& caches) const {
+    std::vector<int> rule_indices;
+    if (compute_rule_indices(m_rule_to_index, rules, rule_indices)) {
+        return find_rule(source_state, target_state, rule_indices, &caches);
+    }
     for (const auto& r : rules) {
         if (r->evaluate_effects(source_state, target_state, caches)) {
             return r;
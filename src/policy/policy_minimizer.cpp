@@ -1,36 +1,23 @@
 #include "../../include/dlplan/policy.h"
 
+#include "feature_predicates.h"
+
+#include "../utils/parallel.h"
+
 #include "../../include/dlplan/policy/condition.h"
 #include "../../include/dlplan/policy/effect.h"
+#include "../../include/dlplan/utils/dynamic_bitset.h"
 #include "../../include/dlplan/utils/hash.h"
 
 #include <algorithm>
+#include <atomic>
+#include <set>
+#include <tuple>
+#include <unordered_set>
 
 
 namespace dlplan::policy {
 
-template<typename T, typename C>
-static bool is_subset_eq(const std::set<T, C> &l, const std::set<T, C>& r)
-{
-    for (const auto& e : l) {
-        if (!r.count(e)) {
-            return false;
-        }
-    }
-    return true;
-}
-
-template<typename T, typename C>
-bool is_supset_eq(const std::set<T, C> &l, const std::set<T, C>& r)
-{
-    for (const auto& e : r) {
-        if (!l.count(e)) {
-            return false;
-        }
-    }
-    return true;
-}
-
 template<typename T, typename C>
 std::set<T, C> set_difference(const std::set<T, C>& l, const std::set<T, C>& r) {
     std::set<T, C> result = l;
@@ -45,341 +32,430 @@ std::set<T, C> set_difference(const std::set<T, C>& l, const std::set<T, C>& r)
 
 
 namespace dlplan::policy {
-static Rules compute_dominated_rules(
-    const Rules& rules) {
-    Rules dominated_rules;
-    for (const auto& rule_1 : rules) {
-        for (const auto& rule_2 : rules) {
-            if (rule_1 == rule_2) {
-                // Note: there cannot be identical rules in a policy, hence this equality check suffices to not remove all identical rules.
-                continue;
+
+/// @brief A rule encoded as set of numbered literals, i.e., conditions and effects.
+using RuleBitset = DynamicBitset<uint64_t>;
+
+struct RuleBitsetHash {
+    std::size_t operator()(const RuleBitset& rule) const {
+        return rule.hash();
+    }
+};
+
+/// @brief Numbers the conditions and effects of rules such that conditions precede effects.
+class Literals {
+private:
+    std::vector<std::shared_ptr<const BaseCondition>> m_conditions;
+    std::vector<std::shared_ptr<const BaseEffect>> m_effects;
+    std::unordered_map<std::shared_ptr<const BaseCondition>, int> m_condition_to_index;
+    std::unordered_map<std::shared_ptr<const BaseEffect>, int> m_effect_to_index;
+
+public:
+    explicit Literals(const Rules& rules) {
+        for (const auto& rule : rules) {
+            for (const auto& condition : rule->get_conditions()) {
+                if (m_condition_to_index.emplace(condition, m_conditions.size()).second) {
+                    m_conditions.push_back(condition);
+                }
             }
-            if (is_subset_eq(rule_1->get_conditions(), rule_2->get_conditions()) && is_subset_eq(rule_1->get_effects(), rule_2->get_effects())) {
-                dominated_rules.insert(rule_2);
+        }
+        for (const auto& rule : rules) {
+            for (const auto& effect : rule->get_effects()) {
+                if (m_effect_to_index.emplace(effect, m_conditions.size() + m_effects.size()).second) {
+                    m_effects.push_back(effect);
+                }
             }
         }
     }
-    return dominated_rules;
-}
 
+    /// @brief Returns the index of the condition or -1 if no rule contains it.
+    int get_index(const std::shared_ptr<const BaseCondition>& condition) const {
+        auto it = m_condition_to_index.find(condition);
+        return (it == m_condition_to_index.end()) ? -1 : it->second;
+    }
 
-/**
- * Returns true iff policy classifies true_state_pairs as true and false_state_pairs as false.
- */
-static bool check_policy_matches_classification(
-    const Policy& policy,
-    const StatePairs& true_state_pairs,
-    const StatePairs& false_state_pairs) {
-    return std::all_of(true_state_pairs.begin(), true_state_pairs.end(), [&policy](const StatePair& state_pair){ return policy.evaluate(state_pair.first, state_pair.second); }) &&
-           std::all_of(false_state_pairs.begin(), false_state_pairs.end(), [&policy](const StatePair& state_pair){ return !policy.evaluate(state_pair.first, state_pair.second); });
-}
+    /// @brief Returns the index of the effect or -1 if no rule contains it.
+    int get_index(const std::shared_ptr<const BaseEffect>& effect) const {
+        auto it = m_effect_to_index.find(effect);
+        return (it == m_effect_to_index.end()) ? -1 : it->second;
+    }
 
+    RuleBitset encode(const Rule& rule) const {
+        RuleBitset result(size());
+        for (const auto& condition : rule.get_conditions()) {
+            result.set(m_condition_to_index.at(condition));
+        }
+        for (const auto& effect : rule.get_effects()) {
+            result.set(m_effect_to_index.at(effect));
+        }
+        return result;
+    }
 
-PolicyMinimizer::PolicyMinimizer() { }
+    std::shared_ptr<const Rule> decode(const RuleBitset& rule, PolicyFactory& builder) const {
+        Conditions conditions;
+        for (size_t i = 0; i < m_conditions.size(); ++i) {
+            if (rule.test(i)) {
+                conditions.insert(m_conditions[i]);
+            }
+        }
+        Effects effects;
+        for (size_t i = 0; i < m_effects.size(); ++i) {
+            if (rule.test(m_conditions.size() + i)) {
+                effects.insert(m_effects[i]);
+            }
+        }
+        return builder.make_rule(conditions, effects);
+    }
 
-PolicyMinimizer::PolicyMinimizer(const PolicyMinimizer& other) = default;
+    int size() const {
+        return m_conditions.size() + m_effects.size();
+    }
+};
 
-PolicyMinimizer& PolicyMinimizer::operator=(const PolicyMinimizer& other) = default;
+/// @brief A merge removes the base literal from a rule R if for each partner
+///        literal p there is a rule R' with p in R' and R' - {p} subset R - {base}.
+struct MergeOperator {
+    int base;
+    std::vector<int> partners;
+};
 
-PolicyMinimizer::PolicyMinimizer(PolicyMinimizer&& other) = default;
+/// @brief Closes a set of rules under merges.
+///
+/// Rules are expanded in rounds where each round checks the rules added in
+/// the previous round against all known rules, either as the base of a merge
+/// or as partner that enables a merge of an older base.
+class RuleClosure {
+private:
+    const std::vector<MergeOperator>& m_merges;
+    int m_num_literals;
 
-PolicyMinimizer& PolicyMinimizer::operator=(PolicyMinimizer&& other) = default;
+    std::vector<RuleBitset> m_rules;
+    std::unordered_set<RuleBitset, RuleBitsetHash> m_rule_set;
+    // maps literal to rules containing it
+    std::vector<std::vector<int>> m_literal_to_rules;
 
-PolicyMinimizer::~PolicyMinimizer() { }
+    bool has_partner(const RuleBitset& remainder, int partner) const {
+        RuleBitset signature = remainder;
+        signature.set(partner);
+        if (m_rule_set.count(signature)) {
+            return true;
+        }
+        return std::any_of(
+            m_literal_to_rules[partner].begin(), m_literal_to_rules[partner].end(),
+            [&](int rule){ return m_rules[rule].is_subset_of(signature); });
+    }
 
-static void insert_rules_to_mapping(
-    const std::shared_ptr<const Rule>& rule,
-    std::unordered_map<std::shared_ptr<const BaseCondition>, std::vector<std::shared_ptr<const Rule>>>& c2r,
-    std::unordered_map<std::shared_ptr<const BaseEffect>, std::vector<std::shared_ptr<const Rule>>>& e2r) {
-    for (const auto& condition : rule->get_conditions()) {
-        c2r[condition].push_back(rule);
+    void try_merge(const RuleBitset& rule, const MergeOperator& merge, std::vector<RuleBitset>& result) const {
+        RuleBitset remainder = rule;
+        remainder.reset(merge.base);
+        if (m_rule_set.count(remainder)) {
+            return;
+        }
+        for (const int partner : merge.partners) {
+            if (!has_partner(remainder, partner)) {
+                return;
+            }
+        }
+        result.push_back(std::move(remainder));
     }
-    for (const auto& effect : rule->get_effects()) {
-        e2r[effect].push_back(rule);
+
+    void expand(int index, std::vector<RuleBitset>& result) const {
+        const auto& rule = m_rules[index];
+        for (const auto& merge : m_merges) {
+            if (rule.test(merge.base)) {
+                try_merge(rule, merge, result);
+            }
+            for (const int partner : merge.partners) {
+                if (!rule.test(partner)) {
+                    continue;
+                }
+                // Find bases B with rule - {partner} subset B - {base}.
+                RuleBitset pattern = rule;
+                pattern.reset(partner);
+                pattern.set(merge.base);
+                for (const int base : m_literal_to_rules[merge.base]) {
+                    if (pattern.is_subset_of(m_rules[base])) {
+                        try_merge(m_rules[base], merge, result);
+                    }
+                }
+            }
+        }
     }
-}
 
-static bool try_merge_boolean_condition(
-    const Booleans& booleans,
-    PolicyFactory& builder,
-    Rules& rules,
-    Rules& rules_result,
-    std::unordered_map<std::shared_ptr<const BaseCondition>, std::vector<std::shared_ptr<const Rule>>>& c2r,
-    std::unordered_map<std::shared_ptr<const BaseEffect>, std::vector<std::shared_ptr<const Rule>>>& e2r) {
-    for (const auto& boolean : booleans) {
-        const auto c_pos = builder.make_pos_condition(boolean);
-        const auto c_neg = builder.make_neg_condition(boolean);
-        for (const auto& rule1 : c2r[c_pos]) {
-            for (const auto& rule2 : c2r[c_neg]) {
-                // check mergeable
-                if (!is_subset_eq(rule1->get_effects(), rule2->get_effects())) continue;
-                if (!is_subset_eq(set_difference(rule1->get_conditions(), {c_pos}), set_difference(rule2->get_conditions(), {c_neg}))) continue;
-                // merge
-                std::shared_ptr<const Rule> result_rule = builder.make_rule(
-                    set_difference(rule2->get_conditions(), {c_neg}),
-                    Effects(rule2->get_effects()));
-                // was merged before
-                if (rules.count(result_rule)) continue;
-                // compute result
-                rules.insert(result_rule);
-
-                rules_result.erase(rule2);
-                rules_result.insert(result_rule);
-                insert_rules_to_mapping(result_rule, c2r, e2r);
-                /*
-                std::cout << "try_merge_boolean_condition" << std::endl;
-                std::cout << "rule1: " << rule1->str() << std::endl;
-                std::cout << "rule2: " << rule2->str() << std::endl;
-                std::cout << "rule_result: " << result_rule->str() << std::endl;
-                */
-                return true;
+public:
+    RuleClosure(const std::vector<MergeOperator>& merges, int num_literals)
+        : m_merges(merges), m_num_literals(num_literals), m_literal_to_rules(num_literals) { }
+
+    bool add(RuleBitset rule) {
+        if (!m_rule_set.insert(rule).second) {
+            return false;
+        }
+        for (int literal = 0; literal < m_num_literals; ++literal) {
+            if (rule.test(literal)) {
+                m_literal_to_rules[literal].push_back(m_rules.size());
             }
         }
+        m_rules.push_back(std::move(rule));
+        return true;
     }
-    return false;
-}
 
-static bool try_merge_numerical_condition(
-    const Numericals& numericals,
-    PolicyFactory& builder,
-    Rules& rules,
-    Rules& rules_result,
-    std::unordered_map<std::shared_ptr<const BaseCondition>, std::vector<std::shared_ptr<const Rule>>>& c2r,
-    std::unordered_map<std::shared_ptr<const BaseEffect>, std::vector<std::shared_ptr<const Rule>>>& e2r) {
-    for (const auto& numerical : numericals) {
-        const auto c_gt = builder.make_gt_condition(numerical);
-        const auto c_eq = builder.make_eq_condition(numerical);
-        for (const auto& rule1 : c2r[c_gt]) {
-            for (const auto& rule2 : c2r[c_eq]) {
-                // check mergeable
-                if (!is_subset_eq(rule1->get_effects(), rule2->get_effects())) continue;
-                if (!is_subset_eq(set_difference(rule1->get_conditions(), {c_gt}), set_difference(rule2->get_conditions(), {c_eq}))) continue;
-                // merge
-                std::shared_ptr<const Rule> result_rule = builder.make_rule(
-                    set_difference(rule2->get_conditions(), {c_eq}),
-                    Effects(rule2->get_effects()));
-                // was merged before
-                if (rules.count(result_rule)) continue;
-                // compute result
-                rules.insert(result_rule);
-                rules_result.erase(rule2);
-                rules_result.insert(result_rule);
-                insert_rules_to_mapping(result_rule, c2r, e2r);
-                /*
-                std::cout << "try_merge_numerical_condition" << std::endl;
-                std::cout << "rule1: " << rule1->str() << std::endl;
-                std::cout << "rule2: " << rule2->str() << std::endl;
-                std::cout << "rule_result: " << result_rule->str() << std::endl;
-                */
-                return true;
+    void close(int num_threads, const std::shared_ptr<const utils::CancellationToken>& cancellation_token) {
+        for (int begin = 0, end = m_rules.size(); begin < end; begin = end, end = m_rules.size()) {
+            utils::throw_if_cancelled(cancellation_token, "PolicyMinimizer::minimize");
+            std::vector<std::vector<RuleBitset>> results(std::max(1, num_threads));
+            utils::parallel_for(end - begin, num_threads, [&](int t, int first, int last) {
+                for (int i = first; i < last; ++i) {
+                    expand(begin + i, results[t]);
+                }
+            });
+            for (auto& result : results) {
+                for (auto& rule : result) {
+                    add(std::move(rule));
+                }
             }
         }
     }
-    return false;
-}
 
-static bool try_merge_boolean_effect(
-    const Booleans& booleans,
-    PolicyFactory& builder,
-    Rules& rules,
-    Rules& rules_result,
-    std::unordered_map<std::shared_ptr<const BaseCondition>, std::vector<std::shared_ptr<const Rule>>>& c2r,
-    std::unordered_map<std::shared_ptr<const BaseEffect>, std::vector<std::shared_ptr<const Rule>>>& e2r) {
-    for (const auto& boolean : booleans) {
-        const auto e_pos = builder.make_pos_effect(boolean);
-        const auto e_neg = builder.make_neg_effect(boolean);
-        const auto e_bot = builder.make_bot_effect(boolean);
-        for (const auto& rule1 : e2r[e_pos]) {
-            for (const auto& rule2 : e2r[e_neg]) {
-                // check mergeable
-                if (!is_subset_eq(rule1->get_conditions(), rule2->get_conditions())) continue;
-                if (!is_subset_eq(set_difference(rule1->get_effects(), {e_pos}), set_difference(rule2->get_effects(), {e_neg}))) continue;
-                // merge
-                std::shared_ptr<const Rule> result_rule = builder.make_rule(
-                    Conditions(rule2->get_conditions()),
-                    set_difference(rule2->get_effects(), {e_neg}));
-                // was merged before
-                if (rules.count(result_rule)) continue;
-                // compute result
-                rules.insert(result_rule);
-
-                rules_result.erase(rule2);
-                rules_result.insert(result_rule);
-                insert_rules_to_mapping(result_rule, c2r, e2r);
-                /*
-                std::cout << "try_merge_boolean_effect" << std::endl;
-                std::cout << "rule1: " << rule1->str() << std::endl;
-                std::cout << "rule2: " << rule2->str() << std::endl;
-                std::cout << "rule_result: " << result_rule->str() << std::endl;
-                */
-                return true;
+    /// @brief Returns the rules that do not contain all literals of another rule.
+    std::vector<RuleBitset> compute_undominated_rules() const {
+        std::vector<int> counts(m_rules.size());
+        std::vector<int> order(m_rules.size());
+        for (size_t i = 0; i < m_rules.size(); ++i) {
+            counts[i] = m_rules[i].count();
+            order[i] = i;
+        }
+        // A dominating rule has fewer literals, hence, it is processed first.
+        std::stable_sort(order.begin(), order.end(), [&](int l, int r){ return counts[l] < counts[r]; });
+        std::vector<RuleBitset> result;
+        for (const int index : order) {
+            const auto& rule = m_rules[index];
+            if (std::none_of(result.begin(), result.end(), [&](const RuleBitset& other){ return other.is_subset_of(rule); })) {
+                result.push_back(rule);
             }
         }
-        for (const auto& rule1 : e2r[e_pos]) {
-            for (const auto& rule2 : e2r[e_bot]) {
-                // check mergeable
-                if (!is_subset_eq(rule1->get_conditions(), rule2->get_conditions())) continue;
-                if (!is_subset_eq(set_difference(rule1->get_effects(), {e_pos}), set_difference(rule2->get_effects(), {e_bot}))) continue;
-                // merge
-                std::shared_ptr<const Rule> result_rule = builder.make_rule(
-                    Conditions(rule2->get_conditions()),
-                    set_difference(rule2->get_effects(), {e_bot}));
-                // was merged before
-                if (rules.count(result_rule)) continue;
-                // compute result
-                rules.insert(result_rule);
-
-                rules_result.erase(rule2);
-                rules_result.insert(result_rule);
-                insert_rules_to_mapping(result_rule, c2r, e2r);
-                /*
-                std::cout << "try_merge_boolean_effect" << std::endl;
-                std::cout << "rule1: " << rule1->str() << std::endl;
-                std::cout << "rule2: " << rule2->str() << std::endl;
-                std::cout << "rule_result: " << result_rule->str() << std::endl;
-                */
-                return true;
+        return result;
+    }
+};
+
+
+/// @brief Stores for each condition and effect of a policy the true and false
+///        state pairs that satisfy it.
+///
+/// Features are evaluated once per distinct state of the pairs into one column
+/// of values per feature, such that checking a rule made up of these conditions
+/// and effects requires no evaluation of features.
+class ClassificationTable {
+private:
+    using PairBitset = DynamicBitset<uint64_t>;
+
+    int m_num_true_pairs;
+    int m_num_false_pairs;
+    std::unordered_map<const void*, std::pair<PairBitset, PairBitset>> m_literal_to_pairs;
+
+public:
+    ClassificationTable(
+        const Policy& policy,
+        const StatePairs& true_state_pairs,
+        const StatePairs& false_state_pairs,
+        int num_threads)
+        : m_num_true_pairs(true_state_pairs.size()),
+          m_num_false_pairs(false_state_pairs.size()) {
+        // Number the distinct states of the pairs.
+        std::vector<core::State> states;
+        std::unordered_map<core::State, int> state_to_index;
+        std::vector<int> sources;
+        std::vector<int> targets;
+        auto add_state = [&](const core::State& state) {
+            auto result = state_to_index.emplace(state, states.size());
+            if (result.second) {
+                states.push_back(state);
+            }
+            return result.first->second;
+        };
+        for (const auto* state_pairs : {&true_state_pairs, &false_state_pairs}) {
+            for (const auto& state_pair : *state_pairs) {
+                sources.push_back(add_state(state_pair.first));
+                targets.push_back(add_state(state_pair.second));
             }
         }
-        for (const auto& rule1 : e2r[e_neg]) {
-            for (const auto& rule2 : e2r[e_bot]) {
-                // check mergeable
-                if (!is_subset_eq(rule1->get_conditions(), rule2->get_conditions())) continue;
-                if (!is_subset_eq(set_difference(rule1->get_effects(), {e_neg}), set_difference(rule2->get_effects(), {e_bot}))) continue;
-                // merge
-                std::shared_ptr<const Rule> result_rule = builder.make_rule(
-                    Conditions(rule2->get_conditions()),
-                    set_difference(rule2->get_effects(), {e_bot}));
-                // was merged before
-                if (rules.count(result_rule)) continue;
-                // compute result
-                rules.insert(result_rule);
-
-                rules_result.erase(rule2);
-                rules_result.insert(result_rule);
-                insert_rules_to_mapping(result_rule, c2r, e2r);
-                /*
-                std::cout << "try_merge_boolean_effect" << std::endl;
-                std::cout << "rule1: " << rule1->str() << std::endl;
-                std::cout << "rule2: " << rule2->str() << std::endl;
-                std::cout << "rule_result: " << result_rule->str() << std::endl;
-                */
-                return true;
+        // The caches identify states by their index.
+        std::set<std::pair<const core::InstanceInfo*, int>> cache_keys;
+        bool use_caches = std::all_of(states.begin(), states.end(), [&](const core::State& state) {
+            return cache_keys.emplace(state.get_instance_info().get(), state.get_index()).second;
+        });
+
+        // Compile conditions and effects into predicates over features.
+        std::vector<FeatureEvaluator> feature_evaluators;
+        std::unordered_map<const void*, int> element_to_feature_index;
+        std::vector<std::tuple<const void*, int, ConditionPredicate, EffectPredicate>> literals;
+        std::unordered_set<const void*> compiled;
+        for (const auto& rule : policy.get_rules()) {
+            for (const auto& condition : rule->get_conditions()) {
+                if (compiled.insert(condition.get()).second) {
+                    CompileCondition compile_condition(feature_evaluators, element_to_feature_index);
+                    condition->accept(compile_condition);
+                    literals.emplace_back(condition.get(), compile_condition.feature_index, std::move(compile_condition.predicate), nullptr);
+                }
+            }
+            for (const auto& effect : rule->get_effects()) {
+                if (compiled.insert(effect.get()).second) {
+                    CompileEffect compile_effect(feature_evaluators, element_to_feature_index);
+                    effect->accept(compile_effect);
+                    literals.emplace_back(effect.get(), compile_effect.feature_index, nullptr, std::move(compile_effect.predicate));
+                }
             }
         }
-    }
-    return false;
-}
 
-static bool try_merge_numerical_effect(
-    const Numericals& numericals,
-    PolicyFactory& builder,
-    Rules& rules,
-    Rules& rules_result,
-    std::unordered_map<std::shared_ptr<const BaseCondition>, std::vector<std::shared_ptr<const Rule>>>& c2r,
-    std::unordered_map<std::shared_ptr<const BaseEffect>, std::vector<std::shared_ptr<const Rule>>>& e2r) {
-    for (const auto& numerical : numericals) {
-        const auto e_inc = builder.make_inc_effect(numerical);
-        const auto e_dec = builder.make_dec_effect(numerical);
-        const auto e_bot = builder.make_bot_effect(numerical);
-        for (const auto& rule1 : e2r[e_inc]) {
-            for (const auto& rule2 : e2r[e_dec]) {
-                // check mergeable
-                if (!is_supset_eq(rule1->get_conditions(), rule2->get_conditions())) continue;
-                if (!is_supset_eq(set_difference(rule1->get_effects(), {e_inc}), set_difference(rule2->get_effects(), {e_dec}))) continue;
-                for (const auto& rule3 : e2r[e_bot]) {
-                    // check mergeable
-                    if (!is_supset_eq(rule1->get_conditions(), rule3->get_conditions())) continue;
-                    if (!is_supset_eq(set_difference(rule1->get_effects(), {e_inc}), set_difference(rule3->get_effects(), {e_bot}))) continue;
-                    // merge
-                    std::shared_ptr<const Rule> result_rule = builder.make_rule(
-                        Conditions(rule1->get_conditions()),
-                        set_difference(rule1->get_effects(), {e_inc}));
-                    // was merged before
-                    if (rules.count(result_rule)) continue;
-                    // compute result
-                    rules.insert(result_rule);
-                    rules_result.erase(rule1);
-                    rules_result.insert(result_rule);
-                    insert_rules_to_mapping(result_rule, c2r, e2r);
-                    /*
-                    std::cout << "try_merge_numerical_effect" << std::endl;
-                    std::cout << "rule1: " << rule1->str() << std::endl;
-                    std::cout << "rule2: " << rule2->str() << std::endl;
-                    std::cout << "rule3: " << rule3->str() << std::endl;
-                    std::cout << "rule_result: " << result_rule->str() << std::endl;
-                    */
-                    return true;
+        // Evaluate the features as column-major matrix.
+        const int num_states = states.size();
+        const int num_features = feature_evaluators.size();
+        std::vector<int> values(static_cast<size_t>(num_features) * num_states);
+        utils::parallel_for(num_states, num_threads, [&](int, int begin, int end) {
+            core::DenotationsCaches caches;
+            for (int i = begin; i < end; ++i) {
+                for (int j = 0; j < num_features; ++j) {
+                    values[static_cast<size_t>(j) * num_states + i] = feature_evaluators[j](states[i], use_caches ? &caches : nullptr);
                 }
             }
+        });
+
+        for (const auto& [literal, feature_index, condition_predicate, effect_predicate] : literals) {
+            const int* column = values.data() + static_cast<size_t>(feature_index) * num_states;
+            PairBitset true_pairs(m_num_true_pairs);
+            PairBitset false_pairs(m_num_false_pairs);
+            for (int i = 0; i < m_num_true_pairs + m_num_false_pairs; ++i) {
+                bool value = (condition_predicate)
+                    ? condition_predicate(column[sources[i]])
+                    : effect_predicate(column[sources[i]], column[targets[i]]);
+                if (!value) {
+                    continue;
+                }
+                if (i < m_num_true_pairs) {
+                    true_pairs.set(i);
+                } else {
+                    false_pairs.set(i - m_num_true_pairs);
+                }
+            }
+            m_literal_to_pairs.emplace(literal, std::make_pair(std::move(true_pairs), std::move(false_pairs)));
         }
     }
-    return false;
-}
 
-std::shared_ptr<const Policy> PolicyMinimizer::minimize(const std::shared_ptr<const Policy>& policy, PolicyFactory& builder) const {
+    /**
+     * Returns true iff the rule classifies true_state_pairs as true and false_state_pairs as false.
+     */
+    bool check_rule_matches_classification(const Conditions& conditions, const Effects& effects) const {
+        PairBitset true_pairs(m_num_true_pairs);
+        PairBitset false_pairs(m_num_false_pairs);
+        true_pairs.set();
+        false_pairs.set();
+        auto intersect = [&](const void* literal) {
+            const auto& pairs = m_literal_to_pairs.at(literal);
+            true_pairs &= pairs.first;
+            false_pairs &= pairs.second;
+        };
+        for (const auto& condition : conditions) {
+            intersect(condition.get());
+        }
+        for (const auto& effect : effects) {
+            intersect(effect.get());
+        }
+        PairBitset all_true_pairs(m_num_true_pairs);
+        all_true_pairs.set();
+        return true_pairs == all_true_pairs && false_pairs.none();
+    }
+};
+
+
+PolicyMinimizer::PolicyMinimizer() : m_num_threads(1) { }
+
+PolicyMinimizer::PolicyMinimizer(int num_threads) : m_num_threads(std::max(1, num_threads)) { }
+
+PolicyMinimizer::PolicyMinimizer(const PolicyMinimizer& other) = default;
+
+PolicyMinimizer& PolicyMinimizer::operator=(const PolicyMinimizer& other) = default;
+
+PolicyMinimizer::PolicyMinimizer(PolicyMinimizer&& other) = default;
+
+PolicyMinimizer& PolicyMinimizer::operator=(PolicyMinimizer&& other) = default;
+
+PolicyMinimizer::~PolicyMinimizer() { }
+
+std::shared_ptr<const Policy> PolicyMinimizer::minimize(const std::shared_ptr<const Policy>& policy, PolicyFactory& builder, std::shared_ptr<const utils::CancellationToken> cancellation_token) const {
     // successively add simpler rules that are made up of existing rules
     auto tmp_policy = builder.make_policy(Rules(policy->get_rules()));
-    Rules rules = tmp_policy->get_rules();
-    Rules rules_result = rules;
-    Booleans booleans = tmp_policy->get_booleans();
-    Numericals numericals = tmp_policy->get_numericals();
-    std::unordered_map<std::shared_ptr<const BaseCondition>, std::vector<std::shared_ptr<const Rule>>> c2r;
-    std::unordered_map<std::shared_ptr<const BaseEffect>, std::vector<std::shared_ptr<const Rule>>> e2r;
-    for (const auto& rule : rules) {
-        insert_rules_to_mapping(rule, c2r, e2r);
+    Literals literals(tmp_policy->get_rules());
+    std::vector<MergeOperator> merges;
+    auto add_merge = [&merges](int base, std::vector<int> partners) {
+        if (base != -1 && std::find(partners.begin(), partners.end(), -1) == partners.end()) {
+            merges.push_back(MergeOperator{base, std::move(partners)});
+        }
+    };
+    for (const auto& boolean : tmp_policy->get_booleans()) {
+        add_merge(literals.get_index(builder.make_neg_condition(boolean)), {literals.get_index(builder.make_pos_condition(boolean))});
+        add_merge(literals.get_index(builder.make_neg_effect(boolean)), {literals.get_index(builder.make_pos_effect(boolean))});
+        add_merge(literals.get_index(builder.make_bot_effect(boolean)), {literals.get_index(builder.make_pos_effect(boolean))});
+        add_merge(literals.get_index(builder.make_bot_effect(boolean)), {literals.get_index(builder.make_neg_effect(boolean))});
     }
-    do {
-        if (try_merge_boolean_condition(booleans, builder, rules, rules_result, c2r, e2r)) continue;
-        if (try_merge_numerical_condition(numericals, builder, rules, rules_result, c2r, e2r)) continue;
-        if (try_merge_boolean_effect(booleans, builder, rules, rules_result, c2r, e2r)) continue;
-        if (try_merge_numerical_effect(numericals, builder, rules, rules_result, c2r, e2r)) continue;
-        break;
-    } while(true);
-    return builder.make_policy(set_difference(rules_result, compute_dominated_rules(rules_result)));
+    for (const auto& numerical : tmp_policy->get_numericals()) {
+        add_merge(literals.get_index(builder.make_eq_condition(numerical)), {literals.get_index(builder.make_gt_condition(numerical))});
+        add_merge(literals.get_index(builder.make_inc_effect(numerical)), {literals.get_index(builder.make_dec_effect(numerical)), literals.get_index(builder.make_bot_effect(numerical))});
+    }
+    RuleClosure closure(merges, literals.size());
+    for (const auto& rule : tmp_policy->get_rules()) {
+        closure.add(literals.encode(*rule));
+    }
+    closure.close(m_num_threads, cancellation_token);
+    Rules rules;
+    for (const auto& rule : closure.compute_undominated_rules()) {
+        rules.insert(literals.decode(rule, builder));
+    }
+    return builder.make_policy(rules);
 }
 
-std::shared_ptr<const Policy> PolicyMinimizer::minimize(const std::shared_ptr<const Policy>& policy, const StatePairs& true_state_pairs, const StatePairs& false_state_pairs, PolicyFactory& builder) const {
+std::shared_ptr<const Policy> PolicyMinimizer::minimize(const std::shared_ptr<const Policy>& policy, const StatePairs& true_state_pairs, const StatePairs& false_state_pairs, PolicyFactory& builder, std::shared_ptr<const utils::CancellationToken> cancellation_token) const {
+    // Candidates only remove conditions and effects of the given policy.
+    ClassificationTable table(*policy, true_state_pairs, false_state_pairs, m_num_threads);
     auto current_policy = policy;
     bool minimization_success;
     do {
+        utils::throw_if_cancelled(cancellation_token, "PolicyMinimizer::minimize");
         minimization_success = false;
+        // Candidates in the order in which they are tried.
+        std::vector<std::pair<Conditions, Effects>> candidates;
         for (const auto& rule : current_policy->get_rules()) {
             for (const auto& condition : rule->get_conditions()) {
-                Rules rules;
-                rules.insert(
-                    builder.make_rule(
-                        set_difference(rule->get_conditions(), {condition}),
-                        Effects(rule->get_effects())));
-                auto tmp_policy = builder.make_policy(std::move(rules));
-                if (check_policy_matches_classification(*tmp_policy, true_state_pairs, false_state_pairs)) {
-                    minimization_success = true;
-                    current_policy = tmp_policy;
-                    break;
-                }
-            }
-            if (minimization_success) {
-                break;
+                candidates.emplace_back(
+                    set_difference(rule->get_conditions(), {condition}),
+                    Effects(rule->get_effects()));
             }
             for (const auto& effect : rule->get_effects()) {
-                Rules rules;
-                rules.insert(
-                    builder.make_rule(
-                        Conditions(rule->get_conditions()),
-                        set_difference(rule->get_effects(), {effect})));
-                auto tmp_policy = builder.make_policy(std::move(rules));
-                if (check_policy_matches_classification(*tmp_policy, true_state_pairs, false_state_pairs)) {
-                    minimization_success = true;
-                    current_policy = tmp_policy;
+                candidates.emplace_back(
+                    Conditions(rule->get_conditions()),
+                    set_difference(rule->get_effects(), {effect}));
+            }
+        }
+        // Find the first successful candidate where threads skip candidates
+        // that come after a successful candidate found so far.
+        const int num_candidates = candidates.size();
+        std::atomic<int> first_success(num_candidates);
+        utils::parallel_for(num_candidates, m_num_threads, [&](int, int begin, int end) {
+            for (int i = begin; i < end && i < first_success.load(); ++i) {
+                if (table.check_rule_matches_classification(candidates[i].first, candidates[i].second)) {
+                    int current = first_success.load();
+                    while (i < current && !first_success.compare_exchange_weak(current, i)) { }
                     break;
                 }
             }
-            if (minimization_success) {
-                break;
-            }
+        });
+        if (first_success < num_candidates) {
+            const auto& candidate = candidates[first_success];
+            Rules rules;
+            rules.insert(builder.make_rule(candidate.first, candidate.second));
+            current_policy = builder.make_policy(rules);
+            minimization_success = true;
         }
     } while (minimization_success);
     return current_policy;
 }
 
-}
\ No newline at end of file
+}
@@ -0,0 +1,233 @@
+#include "../../include/dlplan/policy.h"
+
+#include "feature_predicates.h"
+
+#include "../utils/parallel.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+
+using namespace dlplan::state_space;
+
+namespace dlplan::policy {
+
+/// @brief Computes the strongly connected components of a graph over
+///        nodes 0,...,n-1 with an iterative version of Tarjan's algorithm.
+static std::vector<std::vector<int>> compute_strongly_connected_components(const std::vector<std::vector<int>>& successors) {
+    const int num_nodes = successors.size();
+    std::vector<std::vector<int>> components;
+    std::vector<int> index(num_nodes, UNDEFINED);
+    std::vector<int> lowlink(num_nodes, 0);
+    std::vector<bool> on_stack(num_nodes, false);
+    std::vector<int> stack;
+    // pairs of node and position of the next successor
+    std::vector<std::pair<int, int>> call_stack;
+    int next_index = 0;
+    for (int root = 0; root < num_nodes; ++root) {
+        if (index[root] != UNDEFINED) {
+            continue;
+        }
+        auto visit = [&](int node) {
+            index[node] = lowlink[node] = next_index++;
+            stack.push_back(node);
+            on_stack[node] = true;
+            call_stack.emplace_back(node, 0);
+        };
+        visit(root);
+        while (!call_stack.empty()) {
+            auto& [node, position] = call_stack.back();
+            if (position < static_cast<int>(successors[node].size())) {
+                int successor = successors[node][position++];
+                if (index[successor] == UNDEFINED) {
+                    visit(successor);
+                } else if (on_stack[successor]) {
+                    lowlink[node] = std::min(lowlink[node], index[successor]);
+                }
+                continue;
+            }
+            int finished = node;
+            call_stack.pop_back();
+            if (lowlink[finished] == index[finished]) {
+                std::vector<int> component;
+                int member;
+                do {
+                    member = stack.back();
+                    stack.pop_back();
+                    on_stack[member] = false;
+                    component.push_back(member);
+                } while (member != finished);
+                components.push_back(std::move(component));
+            }
+            if (!call_stack.empty()) {
+                int parent = call_stack.back().first;
+                lowlink[parent] = std::min(lowlink[parent], lowlink[finished]);
+            }
+        }
+    }
+    return components;
+}
+
+
+bool PolicyVerificationResult::is_sound() const {
+    return unsolved_state_indices.empty() && unsafe_state_indices.empty() && cycles.empty();
+}
+
+
+PolicyVerifier::PolicyVerifier() : m_num_threads(1) { }
+
+PolicyVerifier::PolicyVerifier(int num_threads) : m_num_threads(std::max(1, num_threads)) { }
+
+PolicyVerifier::PolicyVerifier(const PolicyVerifier& other) = default;
+
+PolicyVerifier& PolicyVerifier::operator=(const PolicyVerifier& other) = default;
+
+PolicyVerifier::PolicyVerifier(PolicyVerifier&& other) = default;
+
+PolicyVerifier& PolicyVerifier::operator=(PolicyVerifier&& other) = default;
+
+PolicyVerifier::~PolicyVerifier() = default;
+
+PolicyVerificationResult PolicyVerifier::verify(
+    const std::shared_ptr<const Policy>& policy,
+    const std::shared_ptr<const StateSpace>& state_space) const {
+    if (!policy) {
+        throw std::runtime_error("PolicyVerifier::verify - policy is nullptr.");
+    }
+    if (!state_space) {
+        throw std::runtime_error("PolicyVerifier::verify - state_space is nullptr.");
+    }
+    const int num_state_indices = state_space->get_num_state_indices();
+    const auto& states = state_space->get_state_vector();
+    DenseDistances goal_distances = state_space->compute_dense_goal_distances(m_num_threads);
+    StateIndices alive_state_indices;
+    std::vector<int> state_index_to_alive_position(num_state_indices, UNDEFINED);
+    for (const auto& state : states) {
+        if (!state_space->is_goal(state.get_index()) && goal_distances[state.get_index()] != UNDEFINED) {
+            state_index_to_alive_position[state.get_index()] = alive_state_indices.size();
+            alive_state_indices.push_back(state.get_index());
+        }
+    }
+    const int num_alive_states = alive_state_indices.size();
+
+    // Compile conditions and effects into predicates over features.
+    std::vector<FeatureEvaluator> feature_evaluators;
+    std::unordered_map<const void*, int> element_to_feature_index;
+    std::vector<int> condition_feature_indices;
+    std::vector<ConditionPredicate> condition_predicates;
+    std::vector<int> effect_feature_indices;
+    std::vector<EffectPredicate> effect_predicates;
+    std::vector<std::vector<int>> rule_condition_indices;
+    std::vector<std::vector<int>> rule_effect_indices;
+    std::unordered_map<const void*, int> literal_to_index;
+    for (const auto& rule : policy->get_rules()) {
+        std::vector<int> condition_indices;
+        for (const auto& condition : rule->get_conditions()) {
+            auto result = literal_to_index.emplace(condition.get(), condition_predicates.size());
+            if (result.second) {
+                CompileCondition compile_condition(feature_evaluators, element_to_feature_index);
+                condition->accept(compile_condition);
+                condition_feature_indices.push_back(compile_condition.feature_index);
+                condition_predicates.push_back(std::move(compile_condition.predicate));
+            }
+            condition_indices.push_back(result.first->second);
+        }
+        std::vector<int> effect_indices;
+        for (const auto& effect : rule->get_effects()) {
+            auto result = literal_to_index.emplace(effect.get(), effect_predicates.size());
+            if (result.second) {
+                CompileEffect compile_effect(feature_evaluators, element_to_feature_index);
+                effect->accept(compile_effect);
+                effect_feature_indices.push_back(compile_effect.feature_index);
+                effect_predicates.push_back(std::move(compile_effect.predicate));
+            }
+            effect_indices.push_back(result.first->second);
+        }
+        rule_condition_indices.push_back(std::move(condition_indices));
+        rule_effect_indices.push_back(std::move(effect_indices));
+    }
+
+    // Evaluate the features as column-major table over state indices.
+    const int num_features = feature_evaluators.size();
+    std::vector<int> values(static_cast<size_t>(num_features) * num_state_indices);
+    utils::parallel_for(states.size(), m_num_threads, [&](int, int begin, int end) {
+        core::DenotationsCaches caches;
+        for (int i = begin; i < end; ++i) {
+            const auto& state = states[i];
+            for (int j = 0; j < num_features; ++j) {
+                values[static_cast<size_t>(j) * num_state_indices + state.get_index()] = feature_evaluators[j](state, &caches);
+            }
+        }
+    });
+    auto get_value = [&](int feature_index, StateIndex state) {
+        return values[static_cast<size_t>(feature_index) * num_state_indices + state];
+    };
+
+    // Compute the compatible transitions of alive states.
+    const auto& forward_successors = state_space->get_forward_successors();
+    std::vector<StateIndices> compatible_successors(num_alive_states);
+    utils::parallel_for(num_alive_states, m_num_threads, [&](int, int begin, int end) {
+        std::vector<int> matching_rules;
+        for (int i = begin; i < end; ++i) {
+            StateIndex source = alive_state_indices[i];
+            matching_rules.clear();
+            for (size_t rule = 0; rule < rule_condition_indices.size(); ++rule) {
+                if (std::all_of(rule_condition_indices[rule].begin(), rule_condition_indices[rule].end(), [&](int condition) {
+                        return condition_predicates[condition](get_value(condition_feature_indices[condition], source));
+                    })) {
+                    matching_rules.push_back(rule);
+                }
+            }
+            if (matching_rules.empty()) {
+                continue;
+            }
+            for (StateIndex target : forward_successors.get_targets(source)) {
+                if (std::any_of(matching_rules.begin(), matching_rules.end(), [&](int rule) {
+                        return std::all_of(rule_effect_indices[rule].begin(), rule_effect_indices[rule].end(), [&](int effect) {
+                            int feature_index = effect_feature_indices[effect];
+                            return effect_predicates[effect](get_value(feature_index, source), get_value(feature_index, target));
+                        });
+                    })) {
+                    compatible_successors[i].push_back(target);
+                }
+            }
+        }
+    });
+
+    PolicyVerificationResult result{num_alive_states, 0, {}, {}, {}};
+    std::vector<std::vector<int>> policy_graph(num_alive_states);
+    for (int i = 0; i < num_alive_states; ++i) {
+        const StateIndex source = alive_state_indices[i];
+        result.num_compatible_transitions += compatible_successors[i].size();
+        if (compatible_successors[i].empty()) {
+            result.unsolved_state_indices.push_back(source);
+        }
+        bool is_unsafe = false;
+        for (StateIndex target : compatible_successors[i]) {
+            if (state_index_to_alive_position[target] != UNDEFINED) {
+                policy_graph[i].push_back(state_index_to_alive_position[target]);
+            } else if (!state_space->is_goal(target)) {
+                is_unsafe = true;
+            }
+        }
+        if (is_unsafe) {
+            result.unsafe_state_indices.push_back(source);
+        }
+    }
+    for (const auto& component : compute_strongly_connected_components(policy_graph)) {
+        const int node = component.front();
+        if (component.size() == 1 && std::find(policy_graph[node].begin(), policy_graph[node].end(), node) == policy_graph[node].end()) {
+            continue;
+        }
+        StateIndices cycle;
+        for (const int member : component) {
+            cycle.push_back(alive_state_indices[member]);
+        }
+        std::sort(cycle.begin(), cycle.end());
+        result.cycles.push_back(std::move(cycle));
+    }
+    std::sort(result.cycles.begin(), result.cycles.end());
+    return result;
+}
+
+}
@@ -0,0 +1,342 @@
+#include "binary.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+
+using namespace dlplan::core;
+
+/*
+ Layout of the binary format. All integers are int32_t in host byte order.
+ Strings are stored as length followed by the characters.
+
+   magic "DLPLANSS", version, byte order mark
+   predicates: count, (name, arity, is_static)*
+   constants: count, name*
+   objects: count, name*
+   dynamic atoms: count, (predicate index, name, arity, object index*)*
+   static atoms: count, (predicate index, name, arity, object index*)*
+   states: count, state index*, offsets[count+1], atom index*
+   initial state index
+   goal states: count, state index*
+   transitions: number of state indices n, offsets[n+1], target state index*
+*/
+
+namespace dlplan::state_space::binary {
+
+static const char MAGIC[8] = {'D', 'L', 'P', 'L', 'A', 'N', 'S', 'S'};
+static const int32_t BYTE_ORDER_MARK = 0x01020304;
+
+
+/// @brief Buffers the binary representation and writes it at once.
+class BinaryWriter {
+private:
+    std::vector<char> m_buffer;
+
+public:
+    void write_bytes(const void* data, size_t num_bytes) {
+        const char* bytes = static_cast<const char*>(data);
+        m_buffer.insert(m_buffer.end(), bytes, bytes + num_bytes);
+    }
+
+    void write_int(int32_t value) {
+        write_bytes(&value, sizeof(value));
+    }
+
+    void write_ints(const std::vector<int>& values) {
+        static_assert(sizeof(int) == sizeof(int32_t));
+        write_bytes(values.data(), values.size() * sizeof(int32_t));
+    }
+
+    void write_string(const std::string& value) {
+        write_int(value.size());
+        write_bytes(value.data(), value.size());
+    }
+
+    void flush(const std::string& filename) const {
+        std::ofstream outfile(filename, std::ios::binary | std::ios::trunc);
+        if (!outfile) {
+            throw std::runtime_error("binary::write - unable to open file " + filename);
+        }
+        outfile.write(m_buffer.data(), m_buffer.size());
+        if (!outfile) {
+            throw std::runtime_error("binary::write - unable to write file " + filename);
+        }
+    }
+};
+
+
+/// @brief Reads sequentially from a memory mapped file.
+class MappedFileReader {
+private:
+    const char* m_data;
+    size_t m_size;
+    size_t m_position;
+
+public:
+    explicit MappedFileReader(const std::string& filename) : m_data(nullptr), m_size(0), m_position(0) {
+        int fd = open(filename.c_str(), O_RDONLY);
+        if (fd == -1) {
+            throw std::runtime_error("binary::read - unable to open file " + filename);
+        }
+        struct stat file_stat;
+        if (fstat(fd, &file_stat) == -1) {
+            close(fd);
+            throw std::runtime_error("binary::read - unable to stat file " + filename);
+        }
+        m_size = file_stat.st_size;
+        if (m_size > 0) {
+            void* data = mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (data == MAP_FAILED) {
+                close(fd);
+                throw std::runtime_error("binary::read - unable to map file " + filename);
+            }
+            madvise(data, m_size, MADV_SEQUENTIAL);
+            m_data = static_cast<const char*>(data);
+        }
+        close(fd);
+    }
+    MappedFileReader(const MappedFileReader& other) = delete;
+    MappedFileReader& operator=(const MappedFileReader& other) = delete;
+    ~MappedFileReader() {
+        if (m_data) {
+            munmap(const_cast<char*>(m_data), m_size);
+        }
+    }
+
+    const char* read_bytes(size_t num_bytes) {
+        if (num_bytes > m_size - m_position) {
+            throw std::runtime_error("binary::read - unexpected end of file.");
+        }
+        const char* bytes = m_data + m_position;
+        m_position += num_bytes;
+        return bytes;
+    }
+
+    int read_int() {
+        int32_t value;
+        std::memcpy(&value, read_bytes(sizeof(value)), sizeof(value));
+        return value;
+    }
+
+    /// @brief Reads a count of elements that each occupy at least
+    ///        min_num_bytes bytes of the remaining file.
+    int read_count(size_t min_num_bytes = 0) {
+        int count = read_int();
+        if (count < 0) {
+            throw std::runtime_error("binary::read - negative count.");
+        }
+        if (min_num_bytes > 0 && static_cast<size_t>(count) > (m_size - m_position) / min_num_bytes) {
+            throw std::runtime_error("binary::read - count exceeds the file size.");
+        }
+        return count;
+    }
+
+    std::vector<int> read_ints(int count) {
+        if (count < 0) {
+            throw std::runtime_error("binary::read - negative count.");
+        }
+        // Check the size first such that corrupt counts do not allocate.
+        const char* bytes = read_bytes(static_cast<size_t>(count) * sizeof(int32_t));
+        std::vector<int> values(count);
+        std::memcpy(values.data(), bytes, count * sizeof(int32_t));
+        return values;
+    }
+
+    std::string read_string() {
+        int length = read_count();
+        return std::string(read_bytes(length), length);
+    }
+
+    bool at_end() const {
+        return m_position == m_size;
+    }
+};
+
+
+static void write_atoms(BinaryWriter& writer, const std::vector<Atom>& atoms) {
+    writer.write_int(atoms.size());
+    for (const auto& atom : atoms) {
+        writer.write_int(atom.get_predicate_index());
+        writer.write_string(atom.get_name());
+        writer.write_int(atom.get_object_indices().size());
+        writer.write_ints(atom.get_object_indices());
+    }
+}
+
+void write(const StateSpace& state_space, const std::string& filename) {
+    const auto& instance_info = *state_space.get_instance_info();
+    const auto& vocabulary_info = *instance_info.get_vocabulary_info();
+    BinaryWriter writer;
+    writer.write_bytes(MAGIC, sizeof(MAGIC));
+    writer.write_int(VERSION);
+    writer.write_int(BYTE_ORDER_MARK);
+    // vocabulary
+    writer.write_int(vocabulary_info.get_predicates().size());
+    for (const auto& predicate : vocabulary_info.get_predicates()) {
+        writer.write_string(predicate.get_name());
+        writer.write_int(predicate.get_arity());
+        writer.write_int(predicate.is_static());
+    }
+    writer.write_int(vocabulary_info.get_constants().size());
+    for (const auto& constant : vocabulary_info.get_constants()) {
+        writer.write_string(constant.get_name());
+    }
+    // instance
+    writer.write_int(instance_info.get_objects().size());
+    for (const auto& object : instance_info.get_objects()) {
+        writer.write_string(object.get_name());
+    }
+    write_atoms(writer, instance_info.get_atoms());
+    write_atoms(writer, instance_info.get_static_atoms());
+    // states in CSR form
+    const auto& states = state_space.get_state_vector();
+    writer.write_int(states.size());
+    std::vector<int> offsets;
+    offsets.reserve(states.size() + 1);
+    offsets.push_back(0);
+    for (const auto& state : states) {
+        writer.write_int(state.get_index());
+        offsets.push_back(offsets.back() + state.get_atom_indices().size());
+    }
+    writer.write_ints(offsets);
+    for (const auto& state : states) {
+        writer.write_ints(state.get_atom_indices());
+    }
+    writer.write_int(state_space.get_initial_state_index());
+    StateIndices goal_state_indices(state_space.get_goal_state_indices().begin(), state_space.get_goal_state_indices().end());
+    std::sort(goal_state_indices.begin(), goal_state_indices.end());
+    writer.write_int(goal_state_indices.size());
+    writer.write_ints(goal_state_indices);
+    // transitions in CSR form
+    const auto& successors = state_space.get_forward_successors();
+    writer.write_int(successors.get_num_state_indices());
+    writer.write_ints(successors.get_offsets());
+    writer.write_ints(successors.get_targets());
+    writer.flush(filename);
+}
+
+
+static void read_atoms(MappedFileReader& reader, InstanceInfo& instance_info, const std::vector<PredicateIndex>& predicate_mapping, bool is_static) {
+    const int num_objects = instance_info.get_objects().size();
+    int num_atoms = reader.read_count();
+    for (int i = 0; i < num_atoms; ++i) {
+        int predicate_index = reader.read_int();
+        if (predicate_index < 0 || predicate_index >= static_cast<int>(predicate_mapping.size())) {
+            throw std::runtime_error("binary::read - predicate index out of bounds.");
+        }
+        // Names are stored such that they are not built again for each atom.
+        std::string name = reader.read_string();
+        auto object_indices = reader.read_ints(reader.read_count());
+        const auto& predicate = instance_info.get_vocabulary_info()->get_predicates()[predicate_mapping[predicate_index]];
+        if (predicate.get_arity() != static_cast<int>(object_indices.size())) {
+            throw std::runtime_error("binary::read - arity mismatch of atom " + name);
+        }
+        for (int object_index : object_indices) {
+            if (object_index < 0 || object_index >= num_objects) {
+                throw std::runtime_error("binary::read - object index out of bounds.");
+            }
+        }
+        const auto& atom = (is_static)
+            ? instance_info.add_static_atom_with_name(predicate.get_index(), object_indices, name)
+            : instance_info.add_atom_with_name(predicate.get_index(), object_indices, name);
+        if (atom.get_index() != i) {
+            throw std::runtime_error("binary::read - duplicate atom " + atom.get_name());
+        }
+    }
+}
+
+std::shared_ptr<StateSpace> read(const std::string& filename, std::shared_ptr<VocabularyInfo> vocabulary_info, InstanceIndex index) {
+    MappedFileReader reader(filename);
+    if (std::memcmp(reader.read_bytes(sizeof(MAGIC)), MAGIC, sizeof(MAGIC))) {
+        throw std::runtime_error("binary::read - file " + filename + " is not a binary state space.");
+    }
+    int version = reader.read_int();
+    if (version != VERSION) {
+        throw std::runtime_error("binary::read - unsupported version " + std::to_string(version) + " (expected " + std::to_string(VERSION) + ").");
+    }
+    if (reader.read_int() != BYTE_ORDER_MARK) {
+        throw std::runtime_error("binary::read - file was written with a different byte order.");
+    }
+    // vocabulary, predicates are matched by name if a vocabulary is given.
+    auto new_vocabulary_info = std::make_shared<VocabularyInfo>();
+    std::vector<PredicateIndex> predicate_mapping;
+    int num_predicates = reader.read_count();
+    for (int i = 0; i < num_predicates; ++i) {
+        std::string name = reader.read_string();
+        int arity = reader.read_int();
+        bool is_static = reader.read_int();
+        const auto& predicate = (vocabulary_info)
+            ? vocabulary_info->get_predicate(name)
+            : new_vocabulary_info->add_predicate(name, arity, is_static);
+        if (predicate.get_arity() != arity) {
+            throw std::runtime_error("binary::read - arity mismatch of predicate " + name);
+        }
+        predicate_mapping.push_back(predicate.get_index());
+    }
+    int num_constants = reader.read_count();
+    for (int i = 0; i < num_constants; ++i) {
+        std::string name = reader.read_string();
+        if (!vocabulary_info) {
+            new_vocabulary_info->add_constant(name);
+        }
+    }
+    if (!vocabulary_info) {
+        vocabulary_info = new_vocabulary_info;
+    }
+    // instance
+    auto instance_info = std::make_shared<InstanceInfo>(index, vocabulary_info);
+    int num_objects = reader.read_count();
+    for (int i = 0; i < num_objects; ++i) {
+        instance_info->add_object(reader.read_string());
+    }
+    read_atoms(reader, *instance_info, predicate_mapping, false);
+    read_atoms(reader, *instance_info, predicate_mapping, true);
+    // states
+    const int num_atoms = instance_info->get_atoms().size();
+    // Each state has an index and an offset, which also keeps num_states + 1 in range.
+    int num_states = reader.read_count(2 * sizeof(int32_t));
+    auto state_indices = reader.read_ints(num_states);
+    auto state_offsets = reader.read_ints(num_states + 1);
+    if (state_offsets.front() != 0 || !std::is_sorted(state_offsets.begin(), state_offsets.end())) {
+        throw std::runtime_error("binary::read - invalid state offsets.");
+    }
+    const char* atom_indices_data = reader.read_bytes(state_offsets.back() * sizeof(int32_t));
+    States states;
+    states.reserve(num_states);
+    for (int i = 0; i < num_states; ++i) {
+        AtomIndices atom_indices(state_offsets[i + 1] - state_offsets[i]);
+        std::memcpy(atom_indices.data(), atom_indices_data + state_offsets[i] * sizeof(int32_t), atom_indices.size() * sizeof(int32_t));
+        for (int atom_index : atom_indices) {
+            if (atom_index < 0 || atom_index >= num_atoms) {
+                throw std::runtime_error("binary::read - atom index out of bounds.");
+            }
+        }
+        states.emplace_back(state_indices[i], instance_info, std::move(atom_indices));
+    }
+    StateIndex initial_state_index = reader.read_int();
+    auto goal_state_indices = reader.read_ints(reader.read_count());
+    // transitions
+    int num_state_indices = reader.read_count(sizeof(int32_t));
+    auto offsets = reader.read_ints(num_state_indices + 1);
+    auto targets = reader.read_ints(offsets.back());
+    if (!reader.at_end()) {
+        throw std::runtime_error("binary::read - unexpected trailing data.");
+    }
+    return std::make_shared<StateSpace>(
+        std::move(instance_info),
+        std::move(states),
+        initial_state_index,
+        CompressedAdjacencyList(std::move(offsets), std::move(targets)),
+        StateIndicesSet(goal_state_indices.begin(), goal_state_indices.end()));
+}
+
+}
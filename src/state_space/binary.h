@@ -0,0 +1,21 @@
+#ifndef DLPLAN_SRC_STATE_SPACE_BINARY_H_
+#define DLPLAN_SRC_STATE_SPACE_BINARY_H_
+
+#include "../../include/dlplan/state_space.h"
+
+#include <string>
+
+
+namespace dlplan::state_space::binary {
+
+/// @brief Version of the binary state space format.
+///        Increment on every incompatible change of the layout.
+const int VERSION = 2;
+
+extern void write(const StateSpace& state_space, const std::string& filename);
+
+extern std::shared_ptr<StateSpace> read(const std::string& filename, std::shared_ptr<core::VocabularyInfo> vocabulary_info=nullptr, core::InstanceIndex index=-1);
+
+}
+
+#endif
@@ -0,0 +1,184 @@
+#include "breadth_first_search.h"
+
+#include <atomic>
+#include <barrier>
+#include <cstdint>
+#include <thread>
+
+
+namespace dlplan::state_space::breadth_first_search {
+
+/// @brief Switch to bottom-up if the frontier has more than 1/ALPHA
+///        of the edges of the unvisited states.
+static const int ALPHA = 14;
+/// @brief Switch back to top-down if the frontier has less than 1/BETA
+///        of all states.
+static const int BETA = 24;
+
+
+/// @brief A fixed-size bitset that supports concurrent insertion.
+class AtomicBitset {
+private:
+    std::vector<std::atomic<uint64_t>> m_blocks;
+
+public:
+    explicit AtomicBitset(int size) : m_blocks((size + 63) / 64) {
+        for (auto& block : m_blocks) {
+            block.store(0, std::memory_order_relaxed);
+        }
+    }
+
+    bool test(int index) const {
+        return m_blocks[index / 64].load(std::memory_order_relaxed) & (uint64_t(1) << (index % 64));
+    }
+
+    /// @brief Sets the bit and returns true iff it was not set before.
+    bool test_and_set(int index) {
+        uint64_t mask = uint64_t(1) << (index % 64);
+        auto& block = m_blocks[index / 64];
+        if (block.load(std::memory_order_relaxed) & mask) {
+            return false;
+        }
+        return !(block.fetch_or(mask, std::memory_order_relaxed) & mask);
+    }
+};
+
+
+static long compute_num_edges(const CompressedAdjacencyList& successors, const StateIndices& state_indices) {
+    const auto& offsets = successors.get_offsets();
+    long num_edges = 0;
+    for (StateIndex state : state_indices) {
+        num_edges += offsets[state + 1] - offsets[state];
+    }
+    return num_edges;
+}
+
+
+DenseDistances compute_distances(
+    const CompressedAdjacencyList& successors,
+    const CompressedAdjacencyList& predecessors,
+    const std::vector<bool>& is_goal,
+    const StateIndices& source_state_indices,
+    bool stop_if_goal,
+    int num_threads) {
+    const int num_state_indices = successors.get_num_state_indices();
+    num_threads = std::max(num_threads, 1);
+    DenseDistances distances(num_state_indices, UNDEFINED);
+    AtomicBitset visited(num_state_indices);
+
+    StateIndices frontier;
+    for (StateIndex state : source_state_indices) {
+        if (visited.test_and_set(state)) {
+            distances[state] = 0;
+            frontier.push_back(state);
+        }
+    }
+    // Membership of the frontier, only maintained in bottom-up levels.
+    std::vector<char> in_frontier(num_state_indices, false);
+    std::vector<StateIndices> next_frontiers(num_threads);
+    long num_frontier_edges = compute_num_edges(successors, frontier);
+    long num_unvisited_edges = successors.get_num_edges() - num_frontier_edges;
+    bool bottom_up = false;
+    bool done = frontier.empty();
+    Distance level = 0;
+
+    auto expand = [&](StateIndex source) {
+        return !(stop_if_goal && is_goal[source]);
+    };
+
+    auto top_down_step = [&](int thread_index) {
+        auto& next_frontier = next_frontiers[thread_index];
+        size_t begin = frontier.size() * thread_index / num_threads;
+        size_t end = frontier.size() * (thread_index + 1) / num_threads;
+        for (size_t i = begin; i < end; ++i) {
+            StateIndex source = frontier[i];
+            if (!expand(source)) {
+                continue;
+            }
+            for (StateIndex target : successors.get_targets(source)) {
+                if (visited.test_and_set(target)) {
+                    distances[target] = level + 1;
+                    next_frontier.push_back(target);
+                }
+            }
+        }
+    };
+
+    auto bottom_up_step = [&](int thread_index) {
+        auto& next_frontier = next_frontiers[thread_index];
+        StateIndex begin = static_cast<long>(num_state_indices) * thread_index / num_threads;
+        StateIndex end = static_cast<long>(num_state_indices) * (thread_index + 1) / num_threads;
+        for (StateIndex target = begin; target < end; ++target) {
+            if (visited.test(target)) {
+                continue;
+            }
+            for (StateIndex source : predecessors.get_targets(target)) {
+                if (in_frontier[source] && expand(source)) {
+                    visited.test_and_set(target);
+                    distances[target] = level + 1;
+                    next_frontier.push_back(target);
+                    break;
+                }
+            }
+        }
+    };
+
+    // Runs on a single thread between levels while all others wait.
+    auto complete_level = [&]() noexcept {
+        if (bottom_up) {
+            for (StateIndex state : frontier) {
+                in_frontier[state] = false;
+            }
+        }
+        frontier.clear();
+        for (auto& next_frontier : next_frontiers) {
+            frontier.insert(frontier.end(), next_frontier.begin(), next_frontier.end());
+            next_frontier.clear();
+        }
+        ++level;
+        num_frontier_edges = compute_num_edges(successors, frontier);
+        num_unvisited_edges -= num_frontier_edges;
+        if (!bottom_up && num_frontier_edges > num_unvisited_edges / ALPHA) {
+            bottom_up = true;
+        } else if (bottom_up && static_cast<long>(frontier.size()) * BETA < num_state_indices) {
+            bottom_up = false;
+        }
+        if (bottom_up) {
+            for (StateIndex state : frontier) {
+                in_frontier[state] = true;
+            }
+        }
+        done = frontier.empty();
+    };
+
+    // The decision for the first level is made before spawning threads.
+    if (num_frontier_edges > num_unvisited_edges / ALPHA) {
+        bottom_up = true;
+        for (StateIndex state : frontier) {
+            in_frontier[state] = true;
+        }
+    }
+
+    std::barrier barrier(num_threads, complete_level);
+    auto worker = [&](int thread_index) {
+        while (!done) {
+            if (bottom_up) {
+                bottom_up_step(thread_index);
+            } else {
+                top_down_step(thread_index);
+            }
+            barrier.arrive_and_wait();
+        }
+    };
+    std::vector<std::thread> threads;
+    for (int thread_index = 1; thread_index < num_threads; ++thread_index) {
+        threads.emplace_back(worker, thread_index);
+    }
+    worker(0);
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    return distances;
+}
+
+}
@@ -0,0 +1,31 @@
+#ifndef DLPLAN_SRC_STATE_SPACE_BREADTH_FIRST_SEARCH_H_
+#define DLPLAN_SRC_STATE_SPACE_BREADTH_FIRST_SEARCH_H_
+
+#include "../../include/dlplan/state_space.h"
+
+
+namespace dlplan::state_space::breadth_first_search {
+
+/// @brief Computes distances from the given source states with a
+///        level-synchronous direction-optimizing breadth-first search
+///        (Beamer et al. 2012) that runs on num_threads threads.
+///
+/// Each level is either expanded top-down by claiming successors of the
+/// frontier in an atomic visited bitset or bottom-up by letting each
+/// unvisited state look for a predecessor in the frontier. The direction
+/// is chosen from the number of edges incident to the frontier and to
+/// unvisited states.
+/// @param successors the edges in search direction.
+/// @param predecessors the edges against search direction.
+/// @param is_goal dense goal membership, used if stop_if_goal is true.
+extern DenseDistances compute_distances(
+    const CompressedAdjacencyList& successors,
+    const CompressedAdjacencyList& predecessors,
+    const std::vector<bool>& is_goal,
+    const StateIndices& source_state_indices,
+    bool stop_if_goal,
+    int num_threads);
+
+}
+
+#endif
@@ -2,6 +2,7 @@
 
 #include "../utils/tokenizer.h"
 
+#include <algorithm>
 #include <iostream>
 #include <fstream>
 #include <regex>
@@ -116,8 +117,8 @@ static void parse_goal_atoms_file(const std::string& filename, InstanceInfo& ins
 }
 
 
-static std::pair<StateMapping, StateIndicesSet> parse_states_file(const std::string& filename, std::shared_ptr<InstanceInfo> instance_info, const std::vector<int>& new_atom_indices) {
-    StateMapping states;
+static std::pair<States, StateIndicesSet> parse_states_file(const std::string& filename, std::shared_ptr<InstanceInfo> instance_info, const std::vector<int>& new_atom_indices) {
+    States states;
     StateIndicesSet goal_state_indices;
     std::ifstream infile(filename);
     std::string line;
@@ -141,24 +142,36 @@ static std::pair<StateMapping, StateIndicesSet> parse_states_file(const std::str
                 atom_indices.push_back(new_atom_index);
             }
         }
-        auto result = states.emplace(state_index, core::State(state_index, instance_info, atom_indices));
-        if (!result.second) {
-            throw std::runtime_error("StateSpaceGenerator::parse_states_file - tried parsing duplicate states.");
-        }
+        states.emplace_back(state_index, instance_info, std::move(atom_indices));
     }
     return std::make_pair(std::move(states), std::move(goal_state_indices));
 }
 
 
-static AdjacencyList parse_transitions_file(const std::string& filename) {
+static CompressedAdjacencyList parse_transitions_file(const std::string& filename, int num_states) {
     std::ifstream infile(filename);
     int source_idx;
     int target_idx;
-    AdjacencyList adjacency_list;
+    std::vector<std::pair<StateIndex, StateIndex>> transitions;
     while (infile >> source_idx >> target_idx) {
-        adjacency_list[source_idx].insert(target_idx);
+        if (source_idx < 0 || source_idx >= num_states || target_idx < 0 || target_idx >= num_states) {
+            throw std::runtime_error("StateSpaceGenerator::parse_transitions_file - state index out of bounds.");
+        }
+        transitions.emplace_back(source_idx, target_idx);
+    }
+    std::sort(transitions.begin(), transitions.end());
+    transitions.erase(std::unique(transitions.begin(), transitions.end()), transitions.end());
+    std::vector<int> offsets(num_states + 1, 0);
+    StateIndices targets;
+    targets.reserve(transitions.size());
+    for (const auto& transition : transitions) {
+        ++offsets[transition.first + 1];
+        targets.push_back(transition.second);
+    }
+    for (int i = 0; i < num_states; ++i) {
+        offsets[i + 1] += offsets[i];
     }
-    return adjacency_list;
+    return CompressedAdjacencyList(std::move(offsets), std::move(targets));
 }
 
 static GeneratorExitCode parse_run_file(const std::string& filename) {
@@ -208,11 +221,11 @@ GeneratorResult read(std::shared_ptr<VocabularyInfo> vocabulary_info, int index)
     auto parse_states_result = parse_states_file("states.txt", instance_info, new_atom_indices);
     auto states = std::move(parse_states_result.first);
     auto goal_state_indices = std::move(parse_states_result.second);
-    auto adjacency_list = parse_transitions_file("transitions.txt");
+    auto forward_successors = parse_transitions_file("transitions.txt", states.size());
     int initial_state_index = 0;
     return GeneratorResult{
         exit_code,
-        std::make_shared<StateSpace>(std::move(instance_info), std::move(states), initial_state_index, std::move(adjacency_list), std::move(goal_state_indices))
+        std::make_shared<StateSpace>(std::move(instance_info), std::move(states), initial_state_index, std::move(forward_successors), std::move(goal_state_indices))
     };
 }
 
@@ -0,0 +1,273 @@
+#include "../../include/dlplan/state_space.h"
+
+#include "../../include/dlplan/utils/hash.h"
+
+#include <bit>
+#include <cstring>
+#include <stdexcept>
+
+
+using namespace dlplan::core;
+
+namespace dlplan::state_space {
+
+/// @brief Initial number of slots in the hash table, must be a power of two.
+static const size_t INITIAL_TABLE_SIZE = 16;
+
+/// @brief Finalizer of MurmurHash3 such that the low bits
+///        that index the hash table depend on all bits of a block.
+static uint64_t mix(uint64_t key) {
+    key ^= key >> 33;
+    key *= 0xff51afd7ed558ccdULL;
+    key ^= key >> 33;
+    key *= 0xc4ceb9fe1a85ec53ULL;
+    key ^= key >> 33;
+    return key;
+}
+
+static size_t hash_blocks(const uint64_t* blocks, int num_blocks) {
+    size_t seed = num_blocks;
+    for (int i = 0; i < num_blocks; ++i) {
+        hash_combine(seed, static_cast<size_t>(mix(blocks[i])));
+    }
+    return mix(seed);
+}
+
+
+/// @brief Stores the interned states of a StatePool at a stable address.
+class StatePoolImpl {
+public:
+    using Block = uint64_t;
+
+    std::shared_ptr<InstanceInfo> m_instance_info;
+    int m_num_atoms;
+    int m_num_blocks_per_state;
+    std::vector<Block> m_blocks;
+    std::vector<std::size_t> m_hashes;
+    // open addressing hash table over state indices
+    std::vector<StateIndex> m_table;
+    // scratch memory
+    std::vector<Block> m_buffer;
+
+    explicit StatePoolImpl(std::shared_ptr<InstanceInfo> instance_info)
+        : m_instance_info(instance_info),
+          m_table(INITIAL_TABLE_SIZE, UNDEFINED) {
+        if (!m_instance_info) {
+            throw std::runtime_error("StatePool::StatePool - instance_info is nullptr.");
+        }
+        m_num_atoms = m_instance_info->get_atoms().size();
+        m_num_blocks_per_state = (m_num_atoms + 63) / 64;
+        m_buffer.resize(m_num_blocks_per_state);
+    }
+
+    const Block* get_blocks(StateIndex index) const {
+        return m_blocks.data() + static_cast<size_t>(index) * m_num_blocks_per_state;
+    }
+
+    void resize_table(size_t size) {
+        m_table.assign(size, UNDEFINED);
+        size_t mask = size - 1;
+        for (StateIndex index = 0; index < this->size(); ++index) {
+            size_t slot = m_hashes[index] & mask;
+            while (m_table[slot] != UNDEFINED) {
+                slot = (slot + 1) & mask;
+            }
+            m_table[slot] = index;
+        }
+    }
+
+    std::pair<StateIndex, bool> insert(const AtomIndices& atom_indices) {
+        std::fill(m_buffer.begin(), m_buffer.end(), 0);
+        for (const auto atom_index : atom_indices) {
+            if (atom_index < 0 || atom_index >= m_num_atoms) {
+                throw std::runtime_error("StatePool::insert - atom index out of range.");
+            }
+            m_buffer[atom_index / 64] |= Block(1) << (atom_index % 64);
+        }
+        size_t hash = hash_blocks(m_buffer.data(), m_num_blocks_per_state);
+        size_t mask = m_table.size() - 1;
+        size_t slot = hash & mask;
+        for (; m_table[slot] != UNDEFINED; slot = (slot + 1) & mask) {
+            StateIndex index = m_table[slot];
+            if (m_hashes[index] == hash
+                && std::memcmp(get_blocks(index), m_buffer.data(), m_num_blocks_per_state * sizeof(Block)) == 0) {
+                return {index, false};
+            }
+        }
+        StateIndex index = size();
+        m_table[slot] = index;
+        m_hashes.push_back(hash);
+        m_blocks.insert(m_blocks.end(), m_buffer.begin(), m_buffer.end());
+        // keep load factor at most 1/2
+        if (2 * m_hashes.size() > m_table.size()) {
+            resize_table(2 * m_table.size());
+        }
+        return {index, true};
+    }
+
+    std::optional<StateIndex> find(const AtomIndices& atom_indices) const {
+        std::vector<Block> blocks(m_num_blocks_per_state, 0);
+        for (const auto atom_index : atom_indices) {
+            if (atom_index < 0 || atom_index >= m_num_atoms) {
+                return std::nullopt;
+            }
+            blocks[atom_index / 64] |= Block(1) << (atom_index % 64);
+        }
+        size_t hash = hash_blocks(blocks.data(), m_num_blocks_per_state);
+        size_t mask = m_table.size() - 1;
+        for (size_t slot = hash & mask; m_table[slot] != UNDEFINED; slot = (slot + 1) & mask) {
+            StateIndex index = m_table[slot];
+            if (m_hashes[index] == hash
+                && std::memcmp(get_blocks(index), blocks.data(), m_num_blocks_per_state * sizeof(Block)) == 0) {
+                return index;
+            }
+        }
+        return std::nullopt;
+    }
+
+    bool contains(StateIndex index, AtomIndex atom_index) const {
+        if (index < 0 || index >= size()) {
+            throw std::out_of_range("StatePool::contains - state index out of range.");
+        }
+        if (atom_index < 0 || atom_index >= m_num_atoms) {
+            return false;
+        }
+        return (get_blocks(index)[atom_index / 64] >> (atom_index % 64)) & 1;
+    }
+
+    std::size_t get_hash(StateIndex index) const {
+        if (index < 0 || index >= size()) {
+            throw std::out_of_range("StatePool::get_hash - state index out of range.");
+        }
+        return m_hashes[index];
+    }
+
+    AtomIndices get_atom_indices(StateIndex index) const {
+        if (index < 0 || index >= size()) {
+            throw std::out_of_range("StatePool::get_atom_indices - state index out of range.");
+        }
+        AtomIndices result;
+        const Block* blocks = get_blocks(index);
+        for (int i = 0; i < m_num_blocks_per_state; ++i) {
+            Block block = blocks[i];
+            while (block) {
+                result.push_back(i * 64 + std::countr_zero(block));
+                block &= block - 1;
+            }
+        }
+        return result;
+    }
+
+    State get_state(StateIndex index) const {
+        return State(index, m_instance_info, get_atom_indices(index));
+    }
+
+    int size() const {
+        return m_hashes.size();
+    }
+};
+
+
+StateHandle::StateHandle(const StatePoolImpl* pool, StateIndex index)
+    : m_pool(pool), m_index(index) { }
+
+bool StateHandle::operator==(const StateHandle& other) const {
+    return m_pool == other.m_pool && m_index == other.m_index;
+}
+
+bool StateHandle::operator!=(const StateHandle& other) const {
+    return !(*this == other);
+}
+
+std::size_t StateHandle::hash() const {
+    return m_pool->get_hash(m_index);
+}
+
+StateIndex StateHandle::get_index() const {
+    return m_index;
+}
+
+bool StateHandle::contains(AtomIndex atom_index) const {
+    return m_pool->contains(m_index, atom_index);
+}
+
+AtomIndices StateHandle::get_atom_indices() const {
+    return m_pool->get_atom_indices(m_index);
+}
+
+State StateHandle::to_state() const {
+    return m_pool->get_state(m_index);
+}
+
+
+StatePool::StatePool(std::shared_ptr<InstanceInfo> instance_info)
+    : m_impl(std::make_unique<StatePoolImpl>(instance_info)) { }
+
+StatePool::StatePool(StatePool&& other) = default;
+
+StatePool& StatePool::operator=(StatePool&& other) = default;
+
+StatePool::~StatePool() = default;
+
+std::pair<StateHandle, bool> StatePool::insert(const AtomIndices& atom_indices) {
+    auto [index, inserted] = m_impl->insert(atom_indices);
+    return {StateHandle(m_impl.get(), index), inserted};
+}
+
+std::optional<StateHandle> StatePool::find(const AtomIndices& atom_indices) const {
+    auto index = m_impl->find(atom_indices);
+    if (!index) {
+        return std::nullopt;
+    }
+    return StateHandle(m_impl.get(), *index);
+}
+
+bool StatePool::contains(StateIndex index, AtomIndex atom_index) const {
+    return m_impl->contains(index, atom_index);
+}
+
+std::size_t StatePool::get_hash(StateIndex index) const {
+    return m_impl->get_hash(index);
+}
+
+AtomIndices StatePool::get_atom_indices(StateIndex index) const {
+    return m_impl->get_atom_indices(index);
+}
+
+State StatePool::get_state(StateIndex index) const {
+    return m_impl->get_state(index);
+}
+
+StateHandle StatePool::get_handle(StateIndex index) const {
+    if (index < 0 || index >= size()) {
+        throw std::out_of_range("StatePool::get_handle - state index out of range.");
+    }
+    return StateHandle(m_impl.get(), index);
+}
+
+int StatePool::size() const {
+    return m_impl->size();
+}
+
+int StatePool::get_num_atoms() const {
+    return m_impl->m_num_atoms;
+}
+
+std::size_t StatePool::get_memory_usage() const {
+    return m_impl->m_blocks.capacity() * sizeof(StatePoolImpl::Block)
+        + m_impl->m_hashes.capacity() * sizeof(std::size_t)
+        + m_impl->m_table.capacity() * sizeof(StateIndex);
+}
+
+std::shared_ptr<InstanceInfo> StatePool::get_instance_info() const {
+    return m_impl->m_instance_info;
+}
+
+}
+
+
+namespace std {
+    size_t hash<dlplan::state_space::StateHandle>::operator()(const dlplan::state_space::StateHandle& handle) const {
+        return handle.hash();
+    }
+}
@@ -1,7 +1,10 @@
 #include "../../include/dlplan/state_space.h"
 
+#include "binary.h"
+#include "breadth_first_search.h"
 #include "generator.h"
 #include "reader.h"
+#include "successor_generator.h"
 #include "../utils/collections.h"
 
 #include <algorithm>
@@ -15,15 +18,121 @@ using namespace dlplan::core;
 
 namespace dlplan::state_space {
 
-static AdjacencyList compute_inverse_successor_state_indices(const AdjacencyList& successor_state_indices) {
-    AdjacencyList inverse_successor_state_indices(successor_state_indices.size());
-    for (const auto& pair : successor_state_indices) {
-        StateIndex source_state_index = pair.first;
-        for (auto target_state_index : pair.second) {
-            inverse_successor_state_indices[target_state_index].insert(source_state_index);
+CompressedAdjacencyList::CompressedAdjacencyList() : m_offsets({0}) { }
+
+CompressedAdjacencyList::CompressedAdjacencyList(int num_state_indices, const AdjacencyList& adjacency_list)
+    : m_offsets(num_state_indices + 1, 0) {
+    for (const auto& pair : adjacency_list) {
+        if (pair.first < 0 || pair.first >= num_state_indices) {
+            throw std::runtime_error("CompressedAdjacencyList::CompressedAdjacencyList - source state index out of bounds.");
+        }
+        m_offsets[pair.first + 1] = pair.second.size();
+    }
+    for (int i = 0; i < num_state_indices; ++i) {
+        m_offsets[i + 1] += m_offsets[i];
+    }
+    m_targets.resize(m_offsets.back());
+    for (const auto& pair : adjacency_list) {
+        auto first = m_targets.begin() + m_offsets[pair.first];
+        std::copy(pair.second.begin(), pair.second.end(), first);
+        std::sort(first, m_targets.begin() + m_offsets[pair.first + 1]);
+    }
+}
+
+CompressedAdjacencyList::CompressedAdjacencyList(std::vector<int>&& offsets, StateIndices&& targets)
+    : m_offsets(std::move(offsets)), m_targets(std::move(targets)) {
+    if (m_offsets.empty() || m_offsets.front() != 0 || m_offsets.back() != static_cast<int>(m_targets.size())
+        || !std::is_sorted(m_offsets.begin(), m_offsets.end())) {
+        throw std::runtime_error("CompressedAdjacencyList::CompressedAdjacencyList - invalid offsets.");
+    }
+    int num_state_indices = get_num_state_indices();
+    if (!std::all_of(m_targets.begin(), m_targets.end(),
+        [num_state_indices](StateIndex target){ return target >= 0 && target < num_state_indices; })) {
+        throw std::runtime_error("CompressedAdjacencyList::CompressedAdjacencyList - target state index out of bounds.");
+    }
+}
+
+CompressedAdjacencyList::CompressedAdjacencyList(const CompressedAdjacencyList& other) = default;
+
+CompressedAdjacencyList& CompressedAdjacencyList::operator=(const CompressedAdjacencyList& other) = default;
+
+CompressedAdjacencyList::CompressedAdjacencyList(CompressedAdjacencyList&& other) = default;
+
+CompressedAdjacencyList& CompressedAdjacencyList::operator=(CompressedAdjacencyList&& other) = default;
+
+CompressedAdjacencyList::~CompressedAdjacencyList() = default;
+
+CompressedAdjacencyList CompressedAdjacencyList::compute_inverse() const {
+    int num_state_indices = get_num_state_indices();
+    std::vector<int> offsets(num_state_indices + 1, 0);
+    for (StateIndex target : m_targets) {
+        ++offsets[target + 1];
+    }
+    for (int i = 0; i < num_state_indices; ++i) {
+        offsets[i + 1] += offsets[i];
+    }
+    // Iterating sources in ascending order keeps each row sorted.
+    StateIndices targets(m_targets.size());
+    std::vector<int> positions(offsets.begin(), offsets.end() - 1);
+    for (StateIndex source = 0; source < num_state_indices; ++source) {
+        for (int i = m_offsets[source]; i < m_offsets[source + 1]; ++i) {
+            targets[positions[m_targets[i]]++] = source;
+        }
+    }
+    return CompressedAdjacencyList(std::move(offsets), std::move(targets));
+}
+
+AdjacencyList CompressedAdjacencyList::to_adjacency_list() const {
+    AdjacencyList adjacency_list;
+    for (StateIndex source = 0; source < get_num_state_indices(); ++source) {
+        auto targets = get_targets(source);
+        if (!targets.empty()) {
+            adjacency_list.emplace(source, StateIndicesSet(targets.begin(), targets.end()));
+        }
+    }
+    return adjacency_list;
+}
+
+std::span<const StateIndex> CompressedAdjacencyList::get_targets(StateIndex source) const {
+    return std::span<const StateIndex>(m_targets.data() + m_offsets[source], m_offsets[source + 1] - m_offsets[source]);
+}
+
+int CompressedAdjacencyList::get_num_state_indices() const {
+    return static_cast<int>(m_offsets.size()) - 1;
+}
+
+int CompressedAdjacencyList::get_num_edges() const {
+    return m_targets.size();
+}
+
+const std::vector<int>& CompressedAdjacencyList::get_offsets() const {
+    return m_offsets;
+}
+
+const StateIndices& CompressedAdjacencyList::get_targets() const {
+    return m_targets;
+}
+
+
+static int compute_num_state_indices(const StateMapping& states) {
+    int num_state_indices = 0;
+    for (const auto& pair : states) {
+        num_state_indices = std::max(num_state_indices, pair.first + 1);
+    }
+    return num_state_indices;
+}
+
+static States to_sorted_states(StateMapping&& states) {
+    States result;
+    result.reserve(states.size());
+    for (auto& pair : states) {
+        if (pair.first != pair.second.get_index()) {
+            throw std::runtime_error("StateSpace::StateSpace - invalid mapping from index to state.");
         }
+        result.push_back(std::move(pair.second));
     }
-    return inverse_successor_state_indices;
+    std::sort(result.begin(), result.end(), [](const State& l, const State& r){ return l.get_index() < r.get_index(); });
+    return result;
 }
 
 StateSpace::StateSpace(
@@ -32,49 +141,78 @@ StateSpace::StateSpace(
     StateIndex initial_state_index,
     AdjacencyList&& forward_successor_state_indices,
     StateIndicesSet&& goal_state_indices)
+    : m_instance_info(std::move(instance_info)),
+      m_initial_state_index(initial_state_index),
+      m_forward_successors(compute_num_state_indices(states), forward_successor_state_indices),
+      m_goal_state_indices(std::move(goal_state_indices)) {
+    m_states = to_sorted_states(std::move(states));
+    initialize();
+}
+
+StateSpace::StateSpace(
+    std::shared_ptr<InstanceInfo>&& instance_info,
+    States&& states,
+    StateIndex initial_state_index,
+    CompressedAdjacencyList&& forward_successors,
+    StateIndicesSet&& goal_state_indices)
     : m_instance_info(std::move(instance_info)),
       m_states(std::move(states)),
       m_initial_state_index(initial_state_index),
-      m_forward_successor_state_indices(std::move(forward_successor_state_indices)),
+      m_forward_successors(std::move(forward_successors)),
       m_goal_state_indices(std::move(goal_state_indices)) {
+    initialize();
+}
+
+void StateSpace::initialize() {
     // assert states
     if (!std::all_of(m_states.begin(), m_states.end(),
-        [this](const auto& pair){ return pair.second.get_instance_info() == this->get_instance_info(); })) {
+        [this](const State& state){ return state.get_instance_info() == this->get_instance_info(); })) {
         throw std::runtime_error("StateSpace::StateSpace - not all states come from the given InstanceInfo.");
     }
-    if (!std::all_of(m_states.begin(), m_states.end(),
-        [](const auto& pair){ return pair.first == pair.second.get_index(); })) {
-        throw std::runtime_error("StateSpace::StateSpace - invalid mapping from index to state.");
+    for (size_t i = 1; i < m_states.size(); ++i) {
+        if (m_states[i - 1].get_index() >= m_states[i].get_index()) {
+            throw std::runtime_error("StateSpace::StateSpace - states must be unique and sorted by index.");
+        }
+    }
+    if (!m_states.empty() && m_states.front().get_index() < 0) {
+        throw std::runtime_error("StateSpace::StateSpace - negative state index.");
+    }
+    // fragments keep the range of state indices of the original state space
+    int num_state_indices = std::max(m_states.empty() ? 0 : m_states.back().get_index() + 1, m_forward_successors.get_num_state_indices());
+    m_state_index_to_position = StateIndices(num_state_indices, UNDEFINED);
+    for (size_t i = 0; i < m_states.size(); ++i) {
+        m_state_index_to_position[m_states[i].get_index()] = i;
     }
     // assert goals
     if (!std::all_of(m_goal_state_indices.begin(), m_goal_state_indices.end(),
         [this](StateIndex goal_state){
-            return m_states.count(goal_state);
+            return has_state(goal_state);
         })) {
         throw std::runtime_error("StateSpace::StateSpace - goal state index out of bounds.");
     }
+    m_is_goal = std::vector<bool>(num_state_indices, false);
+    for (StateIndex goal_state : m_goal_state_indices) {
+        m_is_goal[goal_state] = true;
+    }
     // assert initial state
-    if (!m_states.count(m_initial_state_index)) {
+    if (!has_state(m_initial_state_index)) {
         throw std::runtime_error("StateSpace::StateSpace - initial state index out of bounds." + std::to_string(m_initial_state_index));
     }
     // assert forward successors
-    if (!std::all_of(m_forward_successor_state_indices.begin(), m_forward_successor_state_indices.end(),
-        [this](const auto& pair) {
-            return m_states.count(pair.first);
-        })) {
-        throw std::runtime_error("StateSpace::StateSpace - source state index out of bounds.");
-    }
-    if (!std::all_of(m_forward_successor_state_indices.begin(), m_forward_successor_state_indices.end(),
-        [this](const auto& pair){
-            return std::all_of(pair.second.begin(), pair.second.end(),
-            [this](StateIndex successor){
-                return m_states.count(successor);
-            });
-        })) {
-        throw std::runtime_error("StateSpace::StateSpace - target state index out of bounds.");
+    if (m_forward_successors.get_num_state_indices() != num_state_indices) {
+        throw std::runtime_error("StateSpace::StateSpace - expected successors over " + std::to_string(num_state_indices) + " state indices.");
+    }
+    for (StateIndex source = 0; source < num_state_indices; ++source) {
+        auto targets = m_forward_successors.get_targets(source);
+        if (!targets.empty() && !has_state(source)) {
+            throw std::runtime_error("StateSpace::StateSpace - source state index out of bounds.");
+        }
+        if (!std::all_of(targets.begin(), targets.end(), [this](StateIndex target){ return has_state(target); })) {
+            throw std::runtime_error("StateSpace::StateSpace - target state index out of bounds.");
+        }
     }
     // compute backward successors
-    m_backward_successor_state_indices = compute_inverse_successor_state_indices(m_forward_successor_state_indices);
+    m_backward_successors = m_forward_successors.compute_inverse();
 }
 
 StateSpace::StateSpace(const StateSpace& other) = default;
@@ -83,38 +221,45 @@ StateSpace::StateSpace(
     const StateSpace& other,
     const StateIndicesSet& state_indices)
     : m_instance_info(other.m_instance_info) {
-    // set state_index_to_state
-    for (const auto& pair : other.m_states) {
-        StateIndex state_index = pair.first;
-        if (state_indices.count(state_index)) {
-            m_states.insert(pair);
+    // set states
+    for (const auto& state : other.m_states) {
+        if (state_indices.count(state.get_index())) {
+            m_states.push_back(state);
         }
     }
+    m_state_index_to_position = StateIndices(other.get_num_state_indices(), UNDEFINED);
+    for (size_t i = 0; i < m_states.size(); ++i) {
+        m_state_index_to_position[m_states[i].get_index()] = i;
+    }
     // set initial_state_index
-    if (!state_indices.count(other.m_initial_state_index)) {
+    if (!has_state(other.m_initial_state_index)) {
         m_initial_state_index = UNDEFINED;
     } else {
         m_initial_state_index = other.m_initial_state_index;
     }
     // set goal_state_indices
+    m_is_goal = std::vector<bool>(other.get_num_state_indices(), false);
     for (StateIndex goal_state : other.m_goal_state_indices) {
-        if (state_indices.count(goal_state)) {
+        if (has_state(goal_state)) {
             m_goal_state_indices.insert(goal_state);
+            m_is_goal[goal_state] = true;
         }
     }
-    // set forward_successor_state_indices
-    for (const auto& pair : other.m_forward_successor_state_indices) {
-        StateIndex source = pair.first;
-        if (state_indices.count(source)) {
-            const auto& successors = pair.second;
-            for (StateIndex successor : successors) {
-                if (state_indices.count(successor)) {
-                    m_forward_successor_state_indices[source].insert(successor);
+    // set forward_successors, keeping the range of state indices
+    std::vector<int> offsets(other.get_num_state_indices() + 1, 0);
+    StateIndices targets;
+    for (StateIndex source = 0; source < other.get_num_state_indices(); ++source) {
+        if (has_state(source)) {
+            for (StateIndex target : other.m_forward_successors.get_targets(source)) {
+                if (has_state(target)) {
+                    targets.push_back(target);
                 }
             }
         }
+        offsets[source + 1] = targets.size();
     }
-    m_backward_successor_state_indices = compute_inverse_successor_state_indices(m_forward_successor_state_indices);
+    m_forward_successors = CompressedAdjacencyList(std::move(offsets), std::move(targets));
+    m_backward_successors = m_forward_successors.compute_inverse();
 }
 
 StateSpace& StateSpace::operator=(const StateSpace& other) = default;
@@ -125,70 +270,100 @@ StateSpace& StateSpace::operator=(StateSpace&& other) = default;
 
 StateSpace::~StateSpace() = default;
 
-Distances StateSpace::compute_distances(const StateIndicesSet& state_indices, bool forward, bool stop_if_goal) const {
-    Distances distances;
-    std::deque<StateIndex> queue;
+DenseDistances StateSpace::compute_dense_distances(const StateIndices& state_indices, bool forward, bool stop_if_goal, int num_threads) const {
     for (StateIndex state : state_indices) {
-        queue.push_back(state);
-        distances[state] = 0;
+        if (!has_state(state)) {
+            throw std::runtime_error("StateSpace::compute_dense_distances - state index out of bounds: " + std::to_string(state));
+        }
     }
-    const auto& successor_states = (forward) ? m_forward_successor_state_indices : m_backward_successor_state_indices;
-    while (!queue.empty()) {
-        int source = queue.front();
-        queue.pop_front();
-        if (stop_if_goal && m_goal_state_indices.count(source)) {
+    const auto& successor_states = (forward) ? m_forward_successors : m_backward_successors;
+    if (num_threads > 1) {
+        const auto& predecessor_states = (forward) ? m_backward_successors : m_forward_successors;
+        return breadth_first_search::compute_distances(successor_states, predecessor_states, m_is_goal, state_indices, stop_if_goal, num_threads);
+    }
+    DenseDistances distances(get_num_state_indices(), UNDEFINED);
+    // The visited prefix of the vector serves as FIFO queue.
+    StateIndices queue;
+    queue.reserve(m_states.size());
+    for (StateIndex state : state_indices) {
+        if (distances[state] == UNDEFINED) {
+            distances[state] = 0;
+            queue.push_back(state);
+        }
+    }
+    for (size_t head = 0; head < queue.size(); ++head) {
+        StateIndex source = queue[head];
+        if (stop_if_goal && m_is_goal[source]) {
             continue;
         }
-        const auto& targets = successor_states.find(source);
-        if (targets != successor_states.end()) {
-            for (int target : targets->second) {
-                if (!distances.count(target)) {
-                    distances[target] = distances[source] + 1;
-                    queue.push_back(target);
-                }
+        Distance target_distance = distances[source] + 1;
+        for (StateIndex target : successor_states.get_targets(source)) {
+            if (distances[target] == UNDEFINED) {
+                distances[target] = target_distance;
+                queue.push_back(target);
             }
         }
     }
     return distances;
 }
 
+DenseDistances StateSpace::compute_dense_goal_distances(int num_threads) const {
+    return compute_dense_distances(StateIndices(m_goal_state_indices.begin(), m_goal_state_indices.end()), false, false, num_threads);
+}
+
+static Distances to_distances(const DenseDistances& dense_distances) {
+    Distances distances;
+    for (StateIndex state = 0; state < static_cast<int>(dense_distances.size()); ++state) {
+        if (dense_distances[state] != UNDEFINED) {
+            distances.emplace(state, dense_distances[state]);
+        }
+    }
+    return distances;
+}
+
+Distances StateSpace::compute_distances(const StateIndicesSet& state_indices, bool forward, bool stop_if_goal) const {
+    return to_distances(compute_dense_distances(StateIndices(state_indices.begin(), state_indices.end()), forward, stop_if_goal));
+}
+
 Distances StateSpace::compute_goal_distances() const {
-    return compute_distances(m_goal_state_indices, false, false);
+    return to_distances(compute_dense_goal_distances());
 }
 
 void StateSpace::for_each_state(std::function<void(const State& state)>&& function) const {
     for (const auto& state : m_states) {
-        function(state.second);
+        function(state);
     }
 }
 
 void StateSpace::for_each_forward_successor_state_index(std::function<void(StateIndex)>&& function, StateIndex source) const {
-    auto result = m_forward_successor_state_indices.find(source);
-    if (result != m_forward_successor_state_indices.end()) {
-        for (StateIndex successor : result->second) {
+    if (has_state(source)) {
+        for (StateIndex successor : m_forward_successors.get_targets(source)) {
             function(successor);
         }
     }
 }
 void StateSpace::for_each_backward_successor_state_index(std::function<void(StateIndex)>&& function, StateIndex source) const {
-    auto result = m_backward_successor_state_indices.find(source);
-    if (result != m_backward_successor_state_indices.end()) {
-        for (StateIndex successor : result->second) {
+    if (has_state(source)) {
+        for (StateIndex successor : m_backward_successors.get_targets(source)) {
             function(successor);
         }
     }
 }
 
 bool StateSpace::is_goal(StateIndex state) const {
-    return m_goal_state_indices.count(state);
+    return has_state(state) && m_is_goal[state];
+}
+
+bool StateSpace::has_state(StateIndex state) const {
+    return state >= 0 && state < get_num_state_indices() && m_state_index_to_position[state] != UNDEFINED;
 }
 
 std::string StateSpace::str() const {
     std::stringstream ss;
     ss << "Initial state index: " << m_initial_state_index << std::endl;
     ss << "States: " << std::to_string(m_states.size()) << std::endl;
-    for (const auto& pair : m_states) {
-        ss << "    " << std::to_string(pair.first) << ":" << pair.second.str() << std::endl;
+    for (const auto& state : m_states) {
+        ss << "    " << std::to_string(state.get_index()) << ":" << state.str() << std::endl;
     }
     ss << "Forward successors:" << std::endl;
     for_each_state(
@@ -223,15 +398,19 @@ std::string StateSpace::to_dot(int verbosity_level) const {
     /* 1. Precompute information for layout.
        Align nodes by their goal distance and then by their forward distance.
     */
-    auto goal_distances = compute_goal_distances();
+    auto goal_distances = compute_dense_goal_distances();
     std::vector<StateIndices> layers;
     std::deque<int> queue;
-    for (const auto& pair : goal_distances) {
-        if (pair.second >= static_cast<int>(layers.size())) {
-            layers.resize(pair.second + 1);
+    for (StateIndex state_index = 0; state_index < static_cast<int>(goal_distances.size()); ++state_index) {
+        Distance distance = goal_distances[state_index];
+        if (distance == UNDEFINED) {
+            continue;
+        }
+        if (distance >= static_cast<int>(layers.size())) {
+            layers.resize(distance + 1);
         }
-        layers[pair.second].push_back(pair.first);
-        queue.push_back(pair.first);
+        layers[distance].push_back(state_index);
+        queue.push_back(state_index);
     }
     std::reverse(layers.begin(), layers.end());
     std::unordered_map<int, int> state_index_to_layer_index;
@@ -244,17 +423,15 @@ std::string StateSpace::to_dot(int verbosity_level) const {
         int s_idx = queue.front();
         queue.pop_front();
         int layer_index = state_index_to_layer_index.at(s_idx);
-        if (m_forward_successor_state_indices.count(s_idx)) {
-            for (int s_prime_idx : m_forward_successor_state_indices.at(s_idx)) {
-                if (!state_index_to_layer_index.count(s_prime_idx)) {
-                    int new_layer_index = layer_index + 1;
-                    state_index_to_layer_index.emplace(s_prime_idx, new_layer_index);
-                    if (new_layer_index >= static_cast<int>(layers.size())) {
-                        layers.resize(new_layer_index + 1);
-                    }
-                    layers[new_layer_index].push_back(s_prime_idx);
-                    queue.push_back(s_prime_idx);
+        for (int s_prime_idx : m_forward_successors.get_targets(s_idx)) {
+            if (!state_index_to_layer_index.count(s_prime_idx)) {
+                int new_layer_index = layer_index + 1;
+                state_index_to_layer_index.emplace(s_prime_idx, new_layer_index);
+                if (new_layer_index >= static_cast<int>(layers.size())) {
+                    layers.resize(new_layer_index + 1);
                 }
+                layers[new_layer_index].push_back(s_prime_idx);
+                queue.push_back(s_prime_idx);
             }
         }
     }
@@ -267,12 +444,12 @@ std::string StateSpace::to_dot(int verbosity_level) const {
     for (const auto& layer : layers) {
         for (auto state_index : layer) {
             result << "s" << state_index << "[";
-            if (m_goal_state_indices.count(state_index)) {
+            if (m_is_goal[state_index]) {
                 result << "peripheries=2,";
             }
             result << "label=\"";
             if (verbosity_level >= 1) {
-                result << m_states.at(state_index).str();
+                result << get_state(state_index).str();
             } else {
                 result << state_index;
             }
@@ -303,10 +480,8 @@ std::string StateSpace::to_dot(int verbosity_level) const {
     for (const auto& layer : layers) {
         result << "{\n";
         for (auto source_index : layer) {
-            if (m_forward_successor_state_indices.count(source_index)) {
-                for (auto target_index : m_forward_successor_state_indices.at(source_index)) {
-                    result << "s" << source_index << "->" << "s" << target_index << "\n";
-                }
+            for (auto target_index : m_forward_successors.get_targets(source_index)) {
+                result << "s" << source_index << "->" << "s" << target_index << "\n";
             }
         }
         result << "}\n";
@@ -321,10 +496,27 @@ void StateSpace::set_initial_state_index(StateIndex state_index) {
 }
 
 void StateSpace::set_goal_state_indices(const StateIndicesSet& goal_states) {
+    if (!std::all_of(goal_states.begin(), goal_states.end(),
+        [this](StateIndex goal_state){
+            return has_state(goal_state);
+        })) {
+        throw std::runtime_error("StateSpace::set_goal_state_indices - goal state index out of bounds.");
+    }
     m_goal_state_indices = goal_states;
+    m_is_goal = std::vector<bool>(get_num_state_indices(), false);
+    for (StateIndex goal_state : m_goal_state_indices) {
+        m_is_goal[goal_state] = true;
+    }
 }
 
-const StateMapping& StateSpace::get_states() const {
+const State& StateSpace::get_state(StateIndex state) const {
+    if (!has_state(state)) {
+        throw std::out_of_range("StateSpace::get_state - state index out of bounds: " + std::to_string(state));
+    }
+    return m_states[m_state_index_to_position[state]];
+}
+
+const States& StateSpace::get_state_vector() const {
     return m_states;
 }
 
@@ -332,18 +524,38 @@ StateIndex StateSpace::get_initial_state_index() const {
     return m_initial_state_index;
 }
 
-const AdjacencyList& StateSpace::get_forward_successor_state_indices() const {
-    return m_forward_successor_state_indices;
+const CompressedAdjacencyList& StateSpace::get_forward_successors() const {
+    return m_forward_successors;
 }
 
-const AdjacencyList& StateSpace::get_backward_successor_state_indices() const {
-    return m_backward_successor_state_indices;
+const CompressedAdjacencyList& StateSpace::get_backward_successors() const {
+    return m_backward_successors;
 }
 
 const StateIndicesSet& StateSpace::get_goal_state_indices() const {
     return m_goal_state_indices;
 }
 
+int StateSpace::get_num_state_indices() const {
+    return m_state_index_to_position.size();
+}
+
+StateMapping StateSpace::get_states() const {
+    StateMapping states;
+    for (const auto& state : m_states) {
+        states.emplace(state.get_index(), state);
+    }
+    return states;
+}
+
+AdjacencyList StateSpace::get_forward_successor_state_indices() const {
+    return m_forward_successors.to_adjacency_list();
+}
+
+AdjacencyList StateSpace::get_backward_successor_state_indices() const {
+    return m_backward_successors.to_adjacency_list();
+}
+
 std::shared_ptr<InstanceInfo> StateSpace::get_instance_info() const {
     return m_instance_info;
 }
@@ -354,12 +566,47 @@ GeneratorResult generate_state_space(
     std::shared_ptr<core::VocabularyInfo> vocabulary_info,
     core::InstanceIndex index,
     int max_time,
-    int max_num_states) {
-
+    int max_num_states,
+    std::shared_ptr<const utils::CancellationToken> cancellation_token) {
+    // The generator runs in a separate process, hence, cancellation
+    // is only observed before and after running it.
+    utils::throw_if_cancelled(cancellation_token, "generate_state_space");
     generator::generate_state_space_files(domain_file, instance_file, max_time, max_num_states);
+    utils::throw_if_cancelled(cancellation_token, "generate_state_space");
     auto result = reader::read(vocabulary_info, index);
 
     return result;
 }
 
+GeneratorResult generate_grounded_state_space(
+    std::shared_ptr<core::InstanceInfo> instance_info,
+    const core::AtomIndices& initial_atom_indices,
+    const GroundActions& actions,
+    const core::AtomIndices& goal_atom_indices,
+    int max_time,
+    int max_num_states,
+    std::shared_ptr<const utils::CancellationToken> cancellation_token) {
+    return successor_generator::generate(
+        std::move(instance_info),
+        initial_atom_indices,
+        actions,
+        goal_atom_indices,
+        max_time,
+        max_num_states,
+        std::move(cancellation_token));
+}
+
+void write_binary_state_space(
+    const StateSpace& state_space,
+    const std::string& filename) {
+    binary::write(state_space, filename);
+}
+
+std::shared_ptr<StateSpace> read_binary_state_space(
+    const std::string& filename,
+    std::shared_ptr<core::VocabularyInfo> vocabulary_info,
+    core::InstanceIndex index) {
+    return binary::read(filename, vocabulary_info, index);
+}
+
 }
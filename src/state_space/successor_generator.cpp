@@ -0,0 +1,169 @@
+#include "successor_generator.h"
+
+#include "../utils/countdown_timer.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+
+using namespace dlplan::core;
+
+namespace dlplan::state_space::successor_generator {
+
+/// @brief Time budget is checked only every this many expansions.
+static const int TIMER_CHECK_INTERVAL = 64;
+
+static AtomIndices normalize(const AtomIndices& atom_indices, int num_atoms) {
+    AtomIndices result(atom_indices);
+    std::sort(result.begin(), result.end());
+    result.erase(std::unique(result.begin(), result.end()), result.end());
+    if (!result.empty() && (result.front() < 0 || result.back() >= num_atoms)) {
+        throw std::runtime_error("generate_grounded_state_space - atom index out of range.");
+    }
+    return result;
+}
+
+
+SuccessorGenerator::SuccessorGenerator(int num_atoms, const GroundActions& actions)
+    : m_actions_by_first_precondition(num_atoms),
+      m_in_state(num_atoms, false) {
+    for (const auto& action : actions) {
+        int action_index = m_preconditions.size();
+        m_preconditions.push_back(normalize(action.precondition, num_atoms));
+        m_add_effects.push_back(normalize(action.add_effect, num_atoms));
+        m_delete_effects.push_back(normalize(action.delete_effect, num_atoms));
+        const auto& precondition = m_preconditions.back();
+        if (precondition.empty()) {
+            m_unconditional_actions.push_back(action_index);
+        } else {
+            m_actions_by_first_precondition[precondition.front()].push_back(action_index);
+        }
+    }
+}
+
+bool SuccessorGenerator::is_applicable(int action) const {
+    const auto& precondition = m_preconditions[action];
+    // the first precondition atom holds by construction
+    for (size_t i = 1; i < precondition.size(); ++i) {
+        if (!m_in_state[precondition[i]]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void SuccessorGenerator::for_each_successor(
+    const AtomIndices& atom_indices,
+    const std::function<void(const AtomIndices&)>& function) {
+    for (const auto atom_index : atom_indices) {
+        m_in_state[atom_index] = true;
+    }
+    auto apply = [&](int action) {
+        m_remaining.clear();
+        std::set_difference(
+            atom_indices.begin(), atom_indices.end(),
+            m_delete_effects[action].begin(), m_delete_effects[action].end(),
+            std::back_inserter(m_remaining));
+        m_buffer.clear();
+        std::set_union(
+            m_remaining.begin(), m_remaining.end(),
+            m_add_effects[action].begin(), m_add_effects[action].end(),
+            std::back_inserter(m_buffer));
+        function(m_buffer);
+    };
+    for (const auto action : m_unconditional_actions) {
+        apply(action);
+    }
+    for (const auto atom_index : atom_indices) {
+        for (const auto action : m_actions_by_first_precondition[atom_index]) {
+            if (is_applicable(action)) {
+                apply(action);
+            }
+        }
+    }
+    for (const auto atom_index : atom_indices) {
+        m_in_state[atom_index] = false;
+    }
+}
+
+
+GeneratorResult generate(
+    std::shared_ptr<InstanceInfo> instance_info,
+    const AtomIndices& initial_atom_indices,
+    const GroundActions& actions,
+    const AtomIndices& goal_atom_indices,
+    int max_time,
+    int max_num_states,
+    std::shared_ptr<const utils::CancellationToken> cancellation_token) {
+    if (!instance_info) {
+        throw std::runtime_error("generate_grounded_state_space - instance_info is nullptr.");
+    }
+    utils::CountdownTimer timer(max_time);
+    int num_atoms = instance_info->get_atoms().size();
+    SuccessorGenerator successor_generator(num_atoms, actions);
+    AtomIndices goal = normalize(goal_atom_indices, num_atoms);
+
+    // States are indexed in the order of generation and,
+    // since the search is breadth-first, expanded in the same order.
+    StatePool state_pool(instance_info);
+    std::vector<int> offsets{0};
+    StateIndices targets;
+    StateIndices successors;
+    bool exceeded_limit = false;
+    auto intern = [&](const AtomIndices& atom_indices) {
+        auto [handle, inserted] = state_pool.insert(atom_indices);
+        if (inserted && state_pool.size() > max_num_states) {
+            exceeded_limit = true;
+        }
+        return handle.get_index();
+    };
+
+    intern(normalize(initial_atom_indices, num_atoms));
+    for (StateIndex source = 0; source < state_pool.size() && !exceeded_limit; ++source) {
+        if (source % TIMER_CHECK_INTERVAL == 0) {
+            utils::throw_if_cancelled(cancellation_token, "generate_grounded_state_space");
+            if (timer.is_expired()) {
+                exceeded_limit = true;
+                break;
+            }
+        }
+        successors.clear();
+        successor_generator.for_each_successor(
+            state_pool.get_atom_indices(source),
+            [&](const AtomIndices& atom_indices) {
+                successors.push_back(intern(atom_indices));
+            });
+        std::sort(successors.begin(), successors.end());
+        successors.erase(std::unique(successors.begin(), successors.end()), successors.end());
+        targets.insert(targets.end(), successors.begin(), successors.end());
+        offsets.push_back(targets.size());
+    }
+    if (exceeded_limit) {
+        return GeneratorResult{
+            GeneratorExitCode::INCOMPLETE,
+            nullptr
+        };
+    }
+
+    States states;
+    states.reserve(state_pool.size());
+    StateIndicesSet goal_state_indices;
+    for (StateIndex index = 0; index < state_pool.size(); ++index) {
+        if (std::all_of(goal.begin(), goal.end(), [&](AtomIndex atom_index){ return state_pool.contains(index, atom_index); })) {
+            goal_state_indices.insert(index);
+        }
+        states.push_back(state_pool.get_state(index));
+    }
+    StateIndex initial_state_index = 0;
+    return GeneratorResult{
+        GeneratorExitCode::COMPLETE,
+        std::make_shared<StateSpace>(
+            std::move(instance_info),
+            std::move(states),
+            initial_state_index,
+            CompressedAdjacencyList(std::move(offsets), std::move(targets)),
+            std::move(goal_state_indices))
+    };
+}
+
+}
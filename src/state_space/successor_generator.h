@@ -0,0 +1,52 @@
+#ifndef DLPLAN_SRC_STATE_SPACE_SUCCESSOR_GENERATOR_H_
+#define DLPLAN_SRC_STATE_SPACE_SUCCESSOR_GENERATOR_H_
+
+#include "../../include/dlplan/state_space.h"
+
+
+namespace dlplan::state_space::successor_generator {
+
+/// @brief Generates successor atom sets of a grounded STRIPS task.
+///
+/// Actions are indexed by their smallest precondition atom such that
+/// only actions whose first precondition holds are tested.
+class SuccessorGenerator {
+private:
+    std::vector<core::AtomIndices> m_preconditions;
+    std::vector<core::AtomIndices> m_add_effects;
+    std::vector<core::AtomIndices> m_delete_effects;
+    // actions with empty precondition
+    std::vector<int> m_unconditional_actions;
+    // maps atom index to actions whose smallest precondition atom it is
+    std::vector<std::vector<int>> m_actions_by_first_precondition;
+
+    // scratch memory
+    std::vector<bool> m_in_state;
+    core::AtomIndices m_remaining;
+    core::AtomIndices m_buffer;
+
+    bool is_applicable(int action) const;
+
+public:
+    SuccessorGenerator(int num_atoms, const GroundActions& actions);
+
+    /// @brief Calls function with the sorted atoms of each successor
+    ///        of the state given by sorted atoms.
+    void for_each_successor(
+        const core::AtomIndices& atom_indices,
+        const std::function<void(const core::AtomIndices&)>& function);
+};
+
+/// @brief Implements generate_grounded_state_space.
+extern GeneratorResult generate(
+    std::shared_ptr<core::InstanceInfo> instance_info,
+    const core::AtomIndices& initial_atom_indices,
+    const GroundActions& actions,
+    const core::AtomIndices& goal_atom_indices,
+    int max_time,
+    int max_num_states,
+    std::shared_ptr<const utils::CancellationToken> cancellation_token);
+
+}
+
+#endif
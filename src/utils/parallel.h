@@ -0,0 +1,49 @@
+#ifndef DLPLAN_SRC_UTILS_PARALLEL_H
+#define DLPLAN_SRC_UTILS_PARALLEL_H
+
+#include <algorithm>
+#include <exception>
+#include <thread>
+#include <vector>
+
+
+namespace dlplan::utils {
+
+/// @brief Calls function(t, begin, end) on num_threads threads that split
+///        [0, num_items) into consecutive chunks and rethrows the first
+///        exception thrown by a thread.
+template<typename Function>
+void parallel_for(int num_items, int num_threads, const Function& function) {
+    num_threads = std::max(1, std::min(num_threads, num_items));
+    if (num_threads == 1) {
+        function(0, 0, num_items);
+        return;
+    }
+    std::vector<std::exception_ptr> exceptions(num_threads);
+    // Threads join on destruction such that a failure to spawn a thread does not leave started threads running.
+    std::vector<std::jthread> threads;
+    threads.reserve(num_threads);
+    for (int t = 0; t < num_threads; ++t) {
+        threads.emplace_back([&, t]() {
+            try {
+                function(
+                    t,
+                    static_cast<long>(num_items) * t / num_threads,
+                    static_cast<long>(num_items) * (t + 1) / num_threads);
+            } catch (...) {
+                exceptions[t] = std::current_exception();
+            }
+        });
+    }
+    // Joins the threads.
+    threads.clear();
+    for (const auto& exception : exceptions) {
+        if (exception) {
+            std::rethrow_exception(exception);
+        }
+    }
+}
+
+}
+
+#endif
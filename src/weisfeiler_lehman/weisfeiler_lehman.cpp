@@ -0,0 +1,209 @@
+#include "../../include/dlplan/weisfeiler_lehman.h"
+
+#include "../utils/parallel.h"
+
+#include <algorithm>
+#include <unordered_set>
+
+
+namespace dlplan::weisfeiler_lehman {
+
+/// @brief Stores the graph of a state with vertices 0,...,n-1 for the objects
+///        followed by one vertex per atom.
+struct StateGraph {
+    int num_objects;
+    // 0 for objects that are no constants and -(1 + i) for the constant with index i
+    std::vector<int> object_colors;
+    std::vector<int> atom_predicates;
+    // CSR over atoms of the objects in argument order
+    std::vector<int> atom_offsets;
+    std::vector<int> atom_objects;
+    // CSR over objects of the pairs of argument position and atom
+    std::vector<int> object_offsets;
+    std::vector<std::pair<int, int>> object_incidences;
+
+    explicit StateGraph(const core::State& state)
+        : num_objects(state.get_instance_info()->get_objects().size()),
+          atom_offsets{0} {
+        const auto& instance_info = *state.get_instance_info();
+        const auto& constants = instance_info.get_vocabulary_info()->get_constants_mapping();
+        object_colors.reserve(num_objects);
+        for (const auto& object : instance_info.get_objects()) {
+            auto result = constants.find(object.get_name());
+            object_colors.push_back(result == constants.end() ? 0 : -(1 + result->second));
+        }
+        auto add_atom = [&](const core::Atom& atom) {
+            atom_predicates.push_back(atom.get_predicate_index());
+            atom_objects.insert(atom_objects.end(), atom.get_object_indices().begin(), atom.get_object_indices().end());
+            atom_offsets.push_back(atom_objects.size());
+        };
+        for (const auto atom_index : state.get_atom_indices()) {
+            add_atom(instance_info.get_atoms()[atom_index]);
+        }
+        for (const auto& atom : instance_info.get_static_atoms()) {
+            add_atom(atom);
+        }
+        object_offsets.assign(num_objects + 1, 0);
+        for (const int object : atom_objects) {
+            ++object_offsets[object + 1];
+        }
+        for (int object = 0; object < num_objects; ++object) {
+            object_offsets[object + 1] += object_offsets[object];
+        }
+        object_incidences.resize(atom_objects.size());
+        std::vector<int> next(object_offsets.begin(), object_offsets.end() - 1);
+        for (int atom = 0; atom < get_num_atoms(); ++atom) {
+            for (int position = 0; position < atom_offsets[atom + 1] - atom_offsets[atom]; ++position) {
+                int object = atom_objects[atom_offsets[atom] + position];
+                object_incidences[next[object]++] = {position, atom};
+            }
+        }
+    }
+
+    int get_num_atoms() const {
+        return atom_predicates.size();
+    }
+
+    int get_num_vertices() const {
+        return num_objects + get_num_atoms();
+    }
+
+    /// @brief Returns the length of the signature of the vertex.
+    int get_signature_size(int vertex) const {
+        if (vertex < num_objects) {
+            return 1 + 2 * (object_offsets[vertex + 1] - object_offsets[vertex]);
+        }
+        int atom = vertex - num_objects;
+        return 1 + atom_offsets[atom + 1] - atom_offsets[atom];
+    }
+};
+
+
+/// @brief Assigns to each slice [offsets[i], offsets[i+1]) of data the rank of
+///        its value among all distinct values in lexicographic order.
+/// @return the number of distinct values.
+static int compress(const std::vector<int>& data, const std::vector<size_t>& offsets, std::vector<int>& ranks) {
+    const int num_slices = offsets.size() - 1;
+    auto compare = [&](int l, int r) {
+        return std::lexicographical_compare(
+            data.begin() + offsets[l], data.begin() + offsets[l + 1],
+            data.begin() + offsets[r], data.begin() + offsets[r + 1]);
+    };
+    std::vector<int> order(num_slices);
+    for (int i = 0; i < num_slices; ++i) {
+        order[i] = i;
+    }
+    std::sort(order.begin(), order.end(), compare);
+    ranks.resize(num_slices);
+    int rank = -1;
+    for (int i = 0; i < num_slices; ++i) {
+        if (i == 0 || compare(order[i - 1], order[i])) {
+            ++rank;
+        }
+        ranks[order[i]] = rank;
+    }
+    return rank + 1;
+}
+
+
+WeisfeilerLehman::WeisfeilerLehman() : m_num_threads(1) { }
+
+WeisfeilerLehman::WeisfeilerLehman(int num_threads) : m_num_threads(std::max(1, num_threads)) { }
+
+WeisfeilerLehman::WeisfeilerLehman(const WeisfeilerLehman& other) = default;
+
+WeisfeilerLehman& WeisfeilerLehman::operator=(const WeisfeilerLehman& other) = default;
+
+WeisfeilerLehman::WeisfeilerLehman(WeisfeilerLehman&& other) = default;
+
+WeisfeilerLehman& WeisfeilerLehman::operator=(WeisfeilerLehman&& other) = default;
+
+WeisfeilerLehman::~WeisfeilerLehman() = default;
+
+CompressedColors WeisfeilerLehman::compute_colors(const core::States& states) const {
+    const int num_states = states.size();
+    std::vector<StateGraph> graphs;
+    graphs.reserve(num_states);
+    for (const auto& state : states) {
+        graphs.emplace_back(state);
+    }
+    // Vertices of all graphs are numbered consecutively and
+    // the signature of each vertex has a fixed size.
+    std::vector<int> vertex_offsets{0};
+    std::vector<size_t> signature_offsets{0};
+    for (const auto& graph : graphs) {
+        for (int vertex = 0; vertex < graph.get_num_vertices(); ++vertex) {
+            signature_offsets.push_back(signature_offsets.back() + graph.get_signature_size(vertex));
+        }
+        vertex_offsets.push_back(vertex_offsets.back() + graph.get_num_vertices());
+    }
+    std::vector<int> colors(vertex_offsets.back());
+    std::unordered_set<int> initial_colors;
+    for (int s = 0; s < num_states; ++s) {
+        const auto& graph = graphs[s];
+        std::copy(graph.object_colors.begin(), graph.object_colors.end(), colors.begin() + vertex_offsets[s]);
+        for (int atom = 0; atom < graph.get_num_atoms(); ++atom) {
+            colors[vertex_offsets[s] + graph.num_objects + atom] = 1 + graph.atom_predicates[atom];
+        }
+    }
+    initial_colors.insert(colors.begin(), colors.end());
+    int num_colors = initial_colors.size();
+
+    std::vector<int> signatures(signature_offsets.back());
+    std::vector<int> new_colors;
+    while (true) {
+        utils::parallel_for(num_states, m_num_threads, [&](int, int begin, int end) {
+            std::vector<std::pair<int, int>> neighbors;
+            for (int s = begin; s < end; ++s) {
+                const auto& graph = graphs[s];
+                const int* state_colors = colors.data() + vertex_offsets[s];
+                for (int vertex = 0; vertex < graph.get_num_vertices(); ++vertex) {
+                    int* signature = signatures.data() + signature_offsets[vertex_offsets[s] + vertex];
+                    *signature++ = state_colors[vertex];
+                    if (vertex < graph.num_objects) {
+                        neighbors.clear();
+                        for (int i = graph.object_offsets[vertex]; i < graph.object_offsets[vertex + 1]; ++i) {
+                            const auto& [position, atom] = graph.object_incidences[i];
+                            neighbors.emplace_back(position, state_colors[graph.num_objects + atom]);
+                        }
+                        std::sort(neighbors.begin(), neighbors.end());
+                        for (const auto& [position, color] : neighbors) {
+                            *signature++ = position;
+                            *signature++ = color;
+                        }
+                    } else {
+                        int atom = vertex - graph.num_objects;
+                        for (int i = graph.atom_offsets[atom]; i < graph.atom_offsets[atom + 1]; ++i) {
+                            *signature++ = state_colors[graph.atom_objects[i]];
+                        }
+                    }
+                }
+            }
+        });
+        // Refinement only splits color classes, hence, the partition is
+        // stable iff the number of colors did not increase.
+        int num_new_colors = compress(signatures, signature_offsets, new_colors);
+        colors.swap(new_colors);
+        if (num_new_colors == num_colors) {
+            break;
+        }
+        num_colors = num_new_colors;
+    }
+
+    // The color of a state is given by the sorted multiset of its vertex colors.
+    utils::parallel_for(num_states, m_num_threads, [&](int, int begin, int end) {
+        for (int s = begin; s < end; ++s) {
+            std::sort(colors.begin() + vertex_offsets[s], colors.begin() + vertex_offsets[s + 1]);
+        }
+    });
+    std::vector<size_t> state_offsets(vertex_offsets.begin(), vertex_offsets.end());
+    CompressedColors result;
+    compress(colors, state_offsets, result);
+    return result;
+}
+
+CompressedColors WeisfeilerLehman::compute_colors_for_state_space(const state_space::StateSpace& state_space) const {
+    return compute_colors(state_space.get_state_vector());
+}
+
+}
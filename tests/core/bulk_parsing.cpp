@@ -0,0 +1,66 @@
+#include <gtest/gtest.h>
+
+#include "../../include/dlplan/core.h"
+
+using namespace dlplan::core;
+
+namespace dlplan::tests::core
+{
+    static std::shared_ptr<VocabularyInfo> create_vocabulary() {
+        auto vocabulary = std::make_shared<VocabularyInfo>();
+        vocabulary->add_predicate("role", 2);
+        vocabulary->add_predicate("concept", 1);
+        vocabulary->add_predicate("nullary", 0);
+        vocabulary->add_constant("A");
+        return vocabulary;
+    }
+
+    static const std::vector<std::string> descriptions = {
+        "b_empty(c_primitive(concept,0))",
+        "n_count(r_primitive(role,0,1))",
+        "c_and(c_primitive(concept,0), c_some(r_primitive(role,0,1),c_top))",
+        "r_compose(r_primitive(role,0,1),r_inverse(r_primitive(role,0,1)))",
+        "b_inclusion(r_primitive(role,0,1),r_top)",
+        "b_nullary(nullary)",
+        "n_concept_distance(c_one_of(A),r_primitive(role,0,1),c_primitive(concept,0))",
+        "c_bot",
+        "r_restrict(r_transitive_closure(r_primitive(role,0,1)),c_not(c_primitive(concept,0)))",
+        "c_projection(r_primitive(role,0,1), 1)",
+        "n_sum_role_distance(r_primitive(role,0,1),r_top,r_identity(c_top))",
+    };
+
+    TEST(DLPTests, BulkParsing)
+    {
+        for (int num_threads : {1, 4}) {
+            auto vocabulary = create_vocabulary();
+            SyntacticElementFactory factory(vocabulary);
+            auto elements = factory.parse_elements(descriptions, num_threads);
+            ASSERT_EQ(std::get<0>(elements).size(), 3u);
+            ASSERT_EQ(std::get<1>(elements).size(), 3u);
+            ASSERT_EQ(std::get<2>(elements).size(), 3u);
+            ASSERT_EQ(std::get<3>(elements).size(), 2u);
+            // The elements are the same as the ones from parsing one by one.
+            EXPECT_EQ(std::get<0>(elements)[0], factory.parse_boolean(descriptions[0]));
+            EXPECT_EQ(std::get<0>(elements)[1], factory.parse_boolean(descriptions[4]));
+            EXPECT_EQ(std::get<0>(elements)[2], factory.parse_boolean(descriptions[5]));
+            EXPECT_EQ(std::get<1>(elements)[0], factory.parse_numerical(descriptions[1]));
+            EXPECT_EQ(std::get<1>(elements)[1], factory.parse_numerical(descriptions[6]));
+            EXPECT_EQ(std::get<1>(elements)[2], factory.parse_numerical(descriptions[10]));
+            EXPECT_EQ(std::get<2>(elements)[0], factory.parse_concept(descriptions[2]));
+            EXPECT_EQ(std::get<2>(elements)[1], factory.parse_concept(descriptions[7]));
+            EXPECT_EQ(std::get<2>(elements)[2], factory.parse_concept(descriptions[9]));
+            EXPECT_EQ(std::get<3>(elements)[0], factory.parse_role(descriptions[3]));
+            EXPECT_EQ(std::get<3>(elements)[1], factory.parse_role(descriptions[8]));
+        }
+    }
+
+    TEST(DLPTests, BulkParsingErrors)
+    {
+        SyntacticElementFactory factory(create_vocabulary());
+        // Descriptions are parsed as with parse_* after the fast path rejects them.
+        EXPECT_THROW(factory.parse_elements({"c_primitive(unknown,0)"}), std::runtime_error);
+        EXPECT_THROW(factory.parse_elements({"c_and(c_top)"}), std::runtime_error);
+        EXPECT_THROW(factory.parse_elements({"r_top", "x_unknown"}, 2), std::runtime_error);
+        EXPECT_EQ(std::get<2>(factory.parse_elements({" c_not(c_top  )"}))[0], factory.parse_concept("c_not(c_top)"));
+    }
+}
@@ -4,6 +4,8 @@
 
 #include "../../include/dlplan/core.h"
 
+#include <thread>
+
 using namespace dlplan::core;
 
 namespace dlplan::tests::core
@@ -28,10 +30,10 @@ namespace dlplan::tests::core
         EXPECT_EQ(concept_0->evaluate(state_1), create_concept_denotation(*instance, {"A"}));
         EXPECT_EQ(concept_0->evaluate(state_1), *concept_0->evaluate(state_1, caches));
         EXPECT_EQ(concept_0->evaluate(state_1, caches), concept_0->evaluate(state_1, caches));
-        EXPECT_EQ(
-            ConceptDenotations({concept_0->evaluate(state_0,caches), concept_0->evaluate(state_1,caches)}),
-            *concept_0->evaluate(States{state_0, state_1}, caches)
-        );
+        auto concept_denotations = concept_0->evaluate(States{state_0, state_1}, caches);
+        ASSERT_EQ(concept_denotations->size(), 2u);
+        EXPECT_EQ((*concept_denotations)[0], concept_0->evaluate(state_0,caches).get());
+        EXPECT_EQ((*concept_denotations)[1], concept_0->evaluate(state_1,caches).get());
 
         auto role_0 = factory.parse_role("r_primitive(role, 0, 1)");
         EXPECT_EQ(role_0->evaluate(state_0), create_role_denotation(*instance, {}));
@@ -40,10 +42,10 @@ namespace dlplan::tests::core
         EXPECT_EQ(role_0->evaluate(state_1), create_role_denotation(*instance, {{"A", "B"}}));
         EXPECT_EQ(role_0->evaluate(state_1), *role_0->evaluate(state_1, caches));
         EXPECT_EQ(role_0->evaluate(state_1, caches), role_0->evaluate(state_1, caches));
-        EXPECT_EQ(
-            RoleDenotations({role_0->evaluate(state_0,caches), role_0->evaluate(state_1,caches)}),
-            *role_0->evaluate(States{state_0, state_1}, caches)
-        );
+        auto role_denotations = role_0->evaluate(States{state_0, state_1}, caches);
+        ASSERT_EQ(role_denotations->size(), 2u);
+        EXPECT_EQ((*role_denotations)[0], role_0->evaluate(state_0,caches).get());
+        EXPECT_EQ((*role_denotations)[1], role_0->evaluate(state_1,caches).get());
 
         auto numerical_0 = factory.parse_numerical("n_count(c_primitive(role, 0))");
         EXPECT_EQ(numerical_0->evaluate(state_0), 0);
@@ -67,4 +69,186 @@ namespace dlplan::tests::core
         );
         EXPECT_EQ(boolean_0->evaluate(States{state_0, state_1}, caches), boolean_0->evaluate(States{state_0, state_1}, caches));
     }
+
+    TEST(DLPTests, CachingMemoryAccounting)
+    {
+        auto vocabulary = std::make_shared<VocabularyInfo>();
+        auto predicate_0 = vocabulary->add_predicate("role", 2);
+        auto instance = std::make_shared<InstanceInfo>(0, vocabulary);
+        auto atom_0 = instance->add_atom("role", {"A", "B"});
+
+        State state_0(0, instance, std::vector<Atom>{});
+        State state_1(1, instance, {atom_0});
+
+        SyntacticElementFactory factory(vocabulary);
+        DenotationsCaches caches;
+        const auto empty_factory_bytes = factory.get_num_bytes();
+        const auto empty_caches_bytes = caches.get_num_bytes();
+
+        {
+            auto concept_0 = factory.parse_concept("c_primitive(role, 0)");
+            auto role_0 = factory.parse_role("r_primitive(role, 0, 1)");
+            const auto factory_bytes = factory.get_num_bytes();
+            EXPECT_GT(factory_bytes, empty_factory_bytes);
+
+            concept_0->evaluate(state_0, caches);
+            const auto caches_bytes_0 = caches.get_num_bytes();
+            EXPECT_GT(caches_bytes_0, empty_caches_bytes);
+            // Cache hits do not allocate.
+            concept_0->evaluate(state_0, caches);
+            EXPECT_EQ(caches.get_num_bytes(), caches_bytes_0);
+
+            role_0->evaluate(States{state_0, state_1}, caches);
+            EXPECT_GT(caches.get_num_bytes(), caches_bytes_0);
+        }
+        // Released elements no longer count.
+        EXPECT_EQ(factory.get_num_bytes(), empty_factory_bytes);
+    }
+
+    TEST(DLPTests, CachingDenotationsView)
+    {
+        auto vocabulary = std::make_shared<VocabularyInfo>();
+        auto predicate_0 = vocabulary->add_predicate("role", 2);
+        auto instance = std::make_shared<InstanceInfo>(0, vocabulary);
+        auto atom_0 = instance->add_atom("role", {"A", "B"});
+
+        State state_0(0, instance, std::vector<Atom>{});
+        State state_1(1, instance, {atom_0});
+        State state_2(2, instance, {atom_0});
+
+        SyntacticElementFactory factory(vocabulary);
+        auto concept_0 = factory.parse_concept("c_primitive(role, 0)");
+        std::unique_ptr<DenotationsCaches> caches = std::make_unique<DenotationsCaches>();
+        auto view = caches->make_view(concept_0->evaluate(States{state_0, state_1, state_2}, *caches));
+        // Equal denotations share an id.
+        EXPECT_NE(view.get_ids().get_id(0), view.get_ids().get_id(1));
+        EXPECT_EQ(view.get_ids().get_id(1), view.get_ids().get_id(2));
+        // The view keeps the denotations alive after the caches are destroyed.
+        caches.reset();
+        ASSERT_EQ(view.size(), 3u);
+        EXPECT_EQ(view[0], create_concept_denotation(*instance, {}));
+        EXPECT_EQ(view[1], create_concept_denotation(*instance, {"A"}));
+        EXPECT_EQ(view[2], create_concept_denotation(*instance, {"A"}));
+    }
+
+    TEST(DLPTests, CachingMemoryLimit)
+    {
+        auto vocabulary = std::make_shared<VocabularyInfo>();
+        auto predicate_0 = vocabulary->add_predicate("role", 2);
+        auto instance = std::make_shared<InstanceInfo>(0, vocabulary);
+        auto atom_0 = instance->add_atom("role", {"A", "B"});
+        auto atom_1 = instance->add_atom("role", {"B", "C"});
+
+        std::vector<State> states;
+        for (int i = 0; i < 64; ++i) {
+            states.push_back(State(i, instance, (i % 2) ? std::vector<Atom>{atom_0} : std::vector<Atom>{atom_1}));
+        }
+
+        SyntacticElementFactory factory(vocabulary);
+        auto concept_0 = factory.parse_concept("c_primitive(role, 0)");
+        auto concept_1 = factory.parse_concept("c_not(c_primitive(role, 0))");
+        DenotationsCaches caches;
+        // Batch results are pinned and keep their denotations alive.
+        auto batch = concept_0->evaluate(States{states[0], states[1]}, caches);
+        const auto pinned_bytes = caches.get_num_bytes();
+
+        caches.set_memory_limit(pinned_bytes);
+        for (const auto& state : states) {
+            EXPECT_EQ(*concept_1->evaluate(state, caches), concept_1->evaluate(state));
+        }
+        EXPECT_GT(caches.get_num_evictions(), 0u);
+        EXPECT_EQ(caches.get_num_hits(), 0u);
+        EXPECT_EQ((*batch)[0]->to_sorted_vector(), concept_0->evaluate(states[0]).to_sorted_vector());
+        EXPECT_EQ((*batch)[1]->to_sorted_vector(), concept_0->evaluate(states[1]).to_sorted_vector());
+        // The batch result is still cached.
+        EXPECT_EQ(concept_0->evaluate(States{states[0], states[1]}, caches), batch);
+        EXPECT_EQ(caches.get_num_hits(), 1u);
+
+        // Without limit, repeated lookups hit.
+        caches.set_memory_limit(std::numeric_limits<std::size_t>::max());
+        caches.reset_statistics();
+        for (int i = 0; i < 2; ++i) {
+            for (const auto& state : states) {
+                concept_1->evaluate(state, caches);
+            }
+        }
+        EXPECT_EQ(caches.get_num_evictions(), 0u);
+        // Each state misses on the not and the primitive concept once.
+        EXPECT_EQ(caches.get_num_hits(), states.size());
+        EXPECT_DOUBLE_EQ(caches.get_hit_rate(), 1.0 / 3.0);
+        const auto unlimited_bytes = caches.get_num_bytes();
+        // Lowering the limit evicts immediately.
+        caches.set_memory_limit(pinned_bytes);
+        EXPECT_GT(caches.get_num_evictions(), 0u);
+        EXPECT_LT(caches.get_num_bytes(), unlimited_bytes);
+    }
+
+    TEST(DLPTests, CachingConcurrent)
+    {
+        auto vocabulary = std::make_shared<VocabularyInfo>();
+        auto predicate_0 = vocabulary->add_predicate("role", 2);
+        auto instance = std::make_shared<InstanceInfo>(0, vocabulary);
+        std::vector<Atom> atoms;
+        for (const auto& [a, b] : std::vector<std::pair<std::string, std::string>>{{"A", "B"}, {"B", "C"}, {"C", "D"}, {"D", "A"}}) {
+            atoms.push_back(instance->add_atom("role", {a, b}));
+        }
+        std::vector<State> states;
+        for (int i = 0; i < 256; ++i) {
+            std::vector<Atom> state_atoms;
+            for (int j = 0; j < 4; ++j) {
+                if (i & (1 << j)) state_atoms.push_back(atoms[j]);
+            }
+            states.push_back(State(i, instance, state_atoms));
+        }
+
+        SyntacticElementFactory factory(vocabulary);
+        auto concept_0 = factory.parse_concept("c_some(r_transitive_closure(r_primitive(role,0,1)),c_primitive(role,0))");
+        auto role_0 = factory.parse_role("r_compose(r_primitive(role,0,1),r_inverse(r_primitive(role,0,1)))");
+        const States batch_states(states.begin(), states.begin() + 16);
+
+        for (std::size_t memory_limit : {std::numeric_limits<std::size_t>::max(), std::size_t(0)}) {
+            DenotationsCaches caches(4);
+            EXPECT_EQ(caches.get_num_shards(), 4);
+            caches.set_memory_limit(memory_limit);
+            const int num_threads = 8;
+            std::vector<std::vector<std::shared_ptr<const ConceptDenotation>>> results(num_threads);
+            std::vector<std::shared_ptr<const ConceptDenotations>> batch_results(num_threads);
+            std::vector<std::thread> threads;
+            for (int t = 0; t < num_threads; ++t) {
+                threads.emplace_back([&, t]() {
+                    // All threads evaluate all states in a different order.
+                    for (int i = 0; i < static_cast<int>(states.size()); ++i) {
+                        const auto& state = states[(i + t * 32) % states.size()];
+                        role_0->evaluate(state, caches);
+                        results[t].push_back(concept_0->evaluate(state, caches));
+                    }
+                    batch_results[t] = concept_0->evaluate(batch_states, caches);
+                });
+            }
+            for (auto& thread : threads) {
+                thread.join();
+            }
+            for (int t = 0; t < num_threads; ++t) {
+                for (int i = 0; i < static_cast<int>(states.size()); ++i) {
+                    EXPECT_EQ(*results[t][i], concept_0->evaluate(states[(i + t * 32) % states.size()]));
+                }
+                // Batch results are deduplicated across threads.
+                ASSERT_EQ(batch_results[t]->size(), batch_states.size());
+                for (std::size_t i = 0; i < batch_states.size(); ++i) {
+                    EXPECT_EQ(*(*batch_results[t])[i], concept_0->evaluate(batch_states[i]));
+                    EXPECT_EQ((*batch_results[t])[i], (*batch_results[0])[i]);
+                }
+            }
+            if (memory_limit == 0) {
+                EXPECT_GT(caches.get_num_evictions(), 0u);
+            } else {
+                // Without eviction, threads share the denotations of each state.
+                EXPECT_GT(caches.get_num_hits(), 0u);
+                EXPECT_EQ(caches.get_num_evictions(), 0u);
+                for (int t = 1; t < num_threads; ++t) {
+                    EXPECT_EQ(results[t][0], results[0][(t * 32) % states.size()]);
+                }
+            }
+        }
+    }
 }
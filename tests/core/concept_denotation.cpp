@@ -2,6 +2,8 @@
 
 #include "../../include/dlplan/core.h"
 
+#include <set>
+
 using namespace dlplan::core;
 
 
@@ -15,4 +17,87 @@ TEST(DLPTests, ConceptDenotationComputeRepr) {
     EXPECT_EQ(denotation.str(), "ConceptDenotation(num_objects=4, object_indices=[0, 2])");
 }
 
+TEST(DLPTests, ConceptDenotationLazyForms) {
+    int num_objects = 35;
+    ConceptDenotation bot(num_objects);
+    ConceptDenotation top(num_objects);
+    top.set();
+    EXPECT_TRUE(bot.is_symbolic());
+    EXPECT_TRUE(top.is_symbolic());
+    EXPECT_EQ(top.get_num_bytes(), 0u);
+    EXPECT_EQ(top.size(), num_objects);
+    EXPECT_TRUE(bot.empty());
+
+    ConceptDenotation a(num_objects);
+    a.insert(0);
+    a.insert(33);
+    ConceptDenotation not_a = a;
+    ~not_a;
+    EXPECT_TRUE(not_a.is_complemented());
+    EXPECT_EQ(not_a.size(), num_objects - 2);
+    EXPECT_FALSE(not_a.contains(33));
+    EXPECT_TRUE(not_a.contains(34));
+
+    // Equal sets in different forms are equal and have equal hashes.
+    ConceptDenotation explicit_not_a = not_a;
+    explicit_not_a.materialize();
+    EXPECT_FALSE(explicit_not_a.is_complemented());
+    EXPECT_EQ(not_a, explicit_not_a);
+    EXPECT_EQ(not_a.hash(), explicit_not_a.hash());
+    ConceptDenotation explicit_top(num_objects);
+    for (int i = 0; i < num_objects; ++i) explicit_top.insert(i);
+    EXPECT_FALSE(explicit_top.is_symbolic());
+    EXPECT_EQ(top, explicit_top);
+    EXPECT_EQ(top.hash(), explicit_top.hash());
+    ConceptDenotation explicit_bot(num_objects);
+    explicit_bot.insert(1);
+    explicit_bot.erase(1);
+    EXPECT_EQ(bot, explicit_bot);
+    EXPECT_EQ(bot.hash(), explicit_bot.hash());
+
+    // Operations and predicates agree with the materialized forms.
+    ConceptDenotation b(num_objects);
+    b.insert(0);
+    b.insert(5);
+    std::vector<ConceptDenotation> forms = {bot, top, a, not_a, explicit_not_a, b};
+    for (const auto& left : forms) {
+        for (const auto& right : forms) {
+            ConceptDenotation explicit_left = left;
+            explicit_left.materialize();
+            ConceptDenotation explicit_right = right;
+            explicit_right.materialize();
+            std::set<ObjectIndex> left_set, right_set;
+            for (int i = 0; i < num_objects; ++i) {
+                if (explicit_left.contains(i)) left_set.insert(i);
+                if (explicit_right.contains(i)) right_set.insert(i);
+            }
+            ConceptDenotation intersection = left;
+            intersection &= right;
+            ConceptDenotation union_ = left;
+            union_ |= right;
+            ConceptDenotation difference = left;
+            difference -= right;
+            for (int i = 0; i < num_objects; ++i) {
+                EXPECT_EQ(intersection.contains(i), left_set.count(i) && right_set.count(i));
+                EXPECT_EQ(union_.contains(i), left_set.count(i) || right_set.count(i));
+                EXPECT_EQ(difference.contains(i), left_set.count(i) && !right_set.count(i));
+            }
+            EXPECT_EQ(left.intersects(right), explicit_left.intersects(explicit_right));
+            EXPECT_EQ(left.is_subset_of(right), explicit_left.is_subset_of(explicit_right));
+            EXPECT_EQ(left == right, left_set == right_set);
+        }
+    }
+
+    // Operations with itself as operand.
+    for (const auto& form : forms) {
+        ConceptDenotation self = form;
+        self |= self;
+        EXPECT_EQ(self, form);
+        self &= self;
+        EXPECT_EQ(self, form);
+        self -= self;
+        EXPECT_TRUE(self.empty());
+    }
+}
+
 }
@@ -0,0 +1,62 @@
+#include <gtest/gtest.h>
+
+#include "../../include/dlplan/core.h"
+
+using namespace dlplan::core;
+
+namespace dlplan::tests::core
+{
+    TEST(DLPTests, CostModelDefault)
+    {
+        auto vocabulary = std::make_shared<VocabularyInfo>();
+        vocabulary->add_predicate("role", 2);
+        vocabulary->add_predicate("concept", 1);
+        SyntacticElementFactory factory(vocabulary);
+        // The default model reflects the asymptotic complexity of the operators.
+        EXPECT_EQ(factory.parse_concept("c_top")->compute_evaluate_time_score(), 1);
+        EXPECT_EQ(factory.parse_concept("c_and(c_primitive(concept,0),c_primitive(concept,0))")->compute_evaluate_time_score(), 300);
+        EXPECT_EQ(factory.parse_numerical("n_count(r_primitive(role,0,1))")->compute_evaluate_time_score(), 10100);
+        EXPECT_EQ(factory.parse_role("r_transitive_closure(r_primitive(role,0,1))")->compute_evaluate_time_score(), 1000100);
+
+        CostModel cost_model;
+        auto parsed = CostModel::parse(cost_model.str());
+        EXPECT_EQ(parsed.str(), cost_model.str());
+        EXPECT_THROW(CostModel::parse("c_and 1 0 1 0"), std::runtime_error);
+        EXPECT_THROW(CostModel::parse("reference 10 0.5\nc_unknown 1 0 1 0"), std::runtime_error);
+    }
+
+    TEST(DLPTests, CostModelCalibration)
+    {
+        auto vocabulary = std::make_shared<VocabularyInfo>();
+        vocabulary->add_predicate("role", 2);
+        vocabulary->add_predicate("concept", 1);
+        States states;
+        for (int num_objects : {4, 8, 16}) {
+            auto instance = std::make_shared<InstanceInfo>(num_objects, vocabulary);
+            std::vector<Atom> atoms;
+            for (int i = 0; i < num_objects; ++i) {
+                atoms.push_back(instance->add_atom("concept", {std::to_string(i)}));
+                atoms.push_back(instance->add_atom("role", {std::to_string(i), std::to_string((i + 1) % num_objects)}));
+            }
+            states.emplace_back(0, instance, atoms);
+        }
+        auto cost_model = calibrate_cost_model(states, 3);
+        EXPECT_EQ(cost_model.get_reference_num_objects(), 8);
+        for (int kind = 0; kind < NUM_ELEMENT_KINDS; ++kind) {
+            const auto& cost = cost_model.get_operator_cost(static_cast<ElementKind>(kind));
+            EXPECT_GE(cost.constant, 0);
+            EXPECT_GE(cost.linear, 0);
+            EXPECT_GE(cost.density, 0);
+            EXPECT_GE(cost_model.compute_score(static_cast<ElementKind>(kind)), 1);
+        }
+        EXPECT_EQ(CostModel::parse(cost_model.str()).str(), cost_model.str());
+
+        SyntacticElementFactory factory(vocabulary);
+        auto concept_ = factory.parse_concept("c_primitive(concept,0)");
+        set_cost_model(cost_model);
+        EXPECT_EQ(concept_->compute_evaluate_time_score(), cost_model.compute_score(ElementKind::PRIMITIVE_CONCEPT));
+        set_cost_model(CostModel());
+        EXPECT_EQ(concept_->compute_evaluate_time_score(), 100);
+        EXPECT_THROW(calibrate_cost_model({}), std::runtime_error);
+    }
+}
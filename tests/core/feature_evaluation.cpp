@@ -0,0 +1,65 @@
+#include <gtest/gtest.h>
+
+#include "../../include/dlplan/core.h"
+
+#include <random>
+
+using namespace dlplan::core;
+
+namespace dlplan::tests::core
+{
+    TEST(DLPTests, FeatureEvaluation)
+    {
+        auto vocabulary = std::make_shared<VocabularyInfo>();
+        vocabulary->add_predicate("role", 2);
+        vocabulary->add_predicate("concept", 1);
+        auto instance = std::make_shared<InstanceInfo>(0, vocabulary);
+        std::vector<std::string> objects{"A", "B", "C", "D"};
+        std::vector<Atom> atoms;
+        for (const auto& object_1 : objects) {
+            atoms.push_back(instance->add_atom("concept", {object_1}));
+            for (const auto& object_2 : objects) {
+                atoms.push_back(instance->add_atom("role", {object_1, object_2}));
+            }
+        }
+        // Enough random states to cover several blocks and threads.
+        std::mt19937 generator(0);
+        States states;
+        for (int index = 0; index < 300; ++index) {
+            std::vector<Atom> state_atoms;
+            for (const auto& atom : atoms) {
+                if (generator() % 3 == 0) {
+                    state_atoms.push_back(atom);
+                }
+            }
+            states.emplace_back(index, instance, state_atoms);
+        }
+
+        SyntacticElementFactory factory(vocabulary);
+        std::vector<std::shared_ptr<const Boolean>> booleans{
+            factory.parse_boolean("b_empty(c_primitive(concept, 0))"),
+            factory.parse_boolean("b_inclusion(c_primitive(concept, 0),c_primitive(role, 0))")};
+        std::vector<std::shared_ptr<const Numerical>> numericals{
+            factory.parse_numerical("n_count(r_primitive(role, 0, 1))"),
+            factory.parse_numerical("n_concept_distance(c_primitive(concept, 0),r_primitive(role, 0, 1),c_not(c_primitive(concept, 0)))")};
+
+        std::vector<int32_t> expected;
+        for (const auto& state : states) {
+            for (const auto& boolean : booleans) {
+                expected.push_back(boolean->evaluate(state));
+            }
+            for (const auto& numerical : numericals) {
+                expected.push_back(numerical->evaluate(state));
+            }
+        }
+        EXPECT_EQ(evaluate_features(booleans, numericals, states), expected);
+        EXPECT_EQ(evaluate_features(booleans, numericals, states, 4), expected);
+        std::vector<int32_t> values(expected.size());
+        evaluate_features(booleans, numericals, states, values, 3);
+        EXPECT_EQ(values, expected);
+        EXPECT_TRUE(evaluate_features({}, {}, states).empty());
+        EXPECT_TRUE(evaluate_features(booleans, numericals, {}).empty());
+        values.pop_back();
+        EXPECT_THROW(evaluate_features(booleans, numericals, states, values), std::runtime_error);
+    }
+}
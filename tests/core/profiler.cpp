@@ -0,0 +1,65 @@
+#include <gtest/gtest.h>
+
+#include "../../include/dlplan/core.h"
+
+#include <algorithm>
+
+using namespace dlplan::core;
+
+namespace dlplan::tests::core
+{
+    TEST(DLPTests, ElementProfiler)
+    {
+        auto vocabulary = std::make_shared<VocabularyInfo>();
+        vocabulary->add_predicate("role", 2);
+        vocabulary->add_predicate("concept", 1);
+        auto instance = std::make_shared<InstanceInfo>(0, vocabulary);
+        auto a0 = instance->add_atom("role", {"A", "B"});
+        auto a1 = instance->add_atom("concept", {"A"});
+        State state(0, instance, {a0, a1});
+
+        SyntacticElementFactory factory(vocabulary);
+        auto concept_ = factory.parse_concept("c_primitive(concept, 0)");
+        auto numerical = factory.parse_numerical("n_count(c_and(c_primitive(concept, 0),c_projection(r_primitive(role, 0, 1),0)))");
+
+        reset_element_profiles();
+        DenotationsCaches caches;
+        EXPECT_EQ(numerical->evaluate(state, caches), 1);
+        EXPECT_EQ(numerical->evaluate(state, caches), 1);
+        auto profiles = get_element_profiles();
+        if (!is_profiling_enabled()) {
+            EXPECT_TRUE(profiles.empty());
+            return;
+        }
+        // n_count, c_and, c_primitive, c_projection, r_primitive
+        EXPECT_EQ(profiles.size(), 5);
+        EXPECT_TRUE(std::is_sorted(profiles.begin(), profiles.end(), [](const auto& l, const auto& r) {
+            return l.exclusive_ns > r.exclusive_ns;
+        }));
+        for (const auto& profile : profiles) {
+            EXPECT_EQ(profile.num_calls, profile.num_cache_hits + profile.num_cache_misses);
+            EXPECT_EQ(profile.num_cache_misses, 1);
+            EXPECT_LE(profile.exclusive_ns, profile.inclusive_ns);
+            EXPECT_GT(profile.allocated_bytes, 0);
+        }
+        auto it = std::find_if(profiles.begin(), profiles.end(), [&](const auto& profile) {
+            return profile.element_index == numerical->get_index();
+        });
+        ASSERT_NE(it, profiles.end());
+        EXPECT_EQ(it->element_description, numerical->str());
+        EXPECT_EQ(it->num_calls, 2);
+        EXPECT_EQ(it->num_cache_hits, 1);
+        // The primitive is evaluated once as child and found in the cache afterwards.
+        EXPECT_EQ(concept_->evaluate(state, caches)->size(), 1);
+        profiles = get_element_profiles();
+        it = std::find_if(profiles.begin(), profiles.end(), [&](const auto& profile) {
+            return profile.element_index == concept_->get_index();
+        });
+        ASSERT_NE(it, profiles.end());
+        EXPECT_EQ(it->num_calls, 2);
+        EXPECT_EQ(it->num_cache_hits, 1);
+
+        reset_element_profiles();
+        EXPECT_TRUE(get_element_profiles().empty());
+    }
+}
@@ -3,6 +3,7 @@
 #include "../utils/denotation.h"
 
 #include "../../include/dlplan/core.h"
+#include "../../include/dlplan/core/elements/utils.h"
 
 using namespace dlplan::core;
 
@@ -29,4 +30,17 @@ TEST(DLPTests, RoleCompose) {
     EXPECT_EQ(role1->evaluate(state_0), create_role_denotation(*instance, {{"A", "B"}, {"A", "C"}, {"B", "B"}, {"B", "C"}}));
 }
 
+TEST(DLPTests, RoleComposeWithoutRepetitions) {
+    // Each of the n^3 joined pairs of top with itself is found n times.
+    int num_objects = 20;
+    PairsOfObjectIndices top;
+    for (int i = 0; i < num_objects; ++i) {
+        for (int j = 0; j < num_objects; ++j) {
+            top.emplace_back(i, j);
+        }
+    }
+    EXPECT_EQ(dlplan::core::utils::compute_composition(top, top, num_objects), top);
+    EXPECT_EQ(dlplan::core::utils::compute_composition({{0, 1}, {0, 2}, {1, 3}}, {{1, 4}, {2, 4}, {2, 0}}, 5), PairsOfObjectIndices({{0, 0}, {0, 4}}));
+}
+
 }
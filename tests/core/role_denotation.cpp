@@ -2,6 +2,8 @@
 
 #include "../../include/dlplan/core.h"
 
+#include <set>
+
 using namespace dlplan::core;
 
 
@@ -15,4 +17,160 @@ TEST(DLPTests, RoleDenotationComputeRepr) {
     EXPECT_EQ(denotation.str(), "RoleDenotation(num_objects=4, pairs_of_object_indices=[<0,1>, <1,2>])");
 }
 
+TEST(DLPTests, RoleDenotationLazyForms) {
+    int num_objects = 6;
+    RoleDenotation top(num_objects);
+    top.set();
+    EXPECT_TRUE(top.is_symbolic());
+    EXPECT_EQ(top.get_num_bytes(), 0u);
+    EXPECT_EQ(top.size(), num_objects * num_objects);
+
+    RoleDenotation a(num_objects);
+    a.insert({1, 2});
+    a.insert({5, 5});
+    RoleDenotation not_a = a;
+    ~not_a;
+    EXPECT_TRUE(not_a.is_complemented());
+    EXPECT_EQ(not_a.size(), num_objects * num_objects - 2);
+    EXPECT_FALSE(not_a.contains({5, 5}));
+
+    // Intersecting with the complement never allocates the complement.
+    RoleDenotation difference = top;
+    difference &= not_a;
+    EXPECT_EQ(difference, not_a);
+    difference -= not_a;
+    EXPECT_TRUE(difference.empty());
+    EXPECT_TRUE(a.is_subset_of(top));
+    EXPECT_FALSE(a.intersects(not_a));
+    EXPECT_TRUE(not_a.intersects(top));
+
+    RoleDenotation explicit_not_a = not_a;
+    explicit_not_a.materialize();
+    EXPECT_EQ(not_a, explicit_not_a);
+    EXPECT_EQ(not_a.hash(), explicit_not_a.hash());
+    EXPECT_EQ(not_a.to_sorted_vector(), explicit_not_a.to_sorted_vector());
+}
+
+TEST(DLPTests, RoleDenotationSparseForms) {
+    const double sparse_density = RoleDenotation::get_sparse_density();
+    // At most 16 of the 64 pairs are sparse.
+    RoleDenotation::set_sparse_density(0.25);
+    int num_objects = 8;
+    RoleDenotation a(num_objects);
+    a.insert({7, 7});
+    a.insert({0, 1});
+    a.insert({2, 3});
+    EXPECT_TRUE(a.is_sparse());
+    EXPECT_EQ(a.size(), 3);
+    EXPECT_TRUE(a.contains({2, 3}));
+    EXPECT_FALSE(a.contains({3, 2}));
+    RoleDenotation dense_a = a;
+    dense_a.materialize();
+    EXPECT_FALSE(dense_a.is_sparse());
+    EXPECT_EQ(a, dense_a);
+    EXPECT_EQ(a.hash(), dense_a.hash());
+    EXPECT_EQ(a.to_sorted_vector(), dense_a.to_sorted_vector());
+
+    // Becomes dense when growing and sparse again when shrinking.
+    RoleDenotation b(num_objects);
+    PairsOfObjectIndices pairs;
+    for (int i = 0; i < num_objects; ++i) {
+        for (int j = 0; j < 3; ++j) {
+            pairs.emplace_back(i, j);
+        }
+    }
+    b.insert_all(pairs);
+    EXPECT_FALSE(b.is_sparse());
+    EXPECT_EQ(b.size(), 24);
+    RoleDenotation c = b;
+    c &= dense_a;
+    EXPECT_TRUE(c.is_sparse());
+    EXPECT_EQ(c.to_sorted_vector(), PairsOfObjectIndices({{0, 1}}));
+
+    RoleDenotation not_a = a;
+    ~not_a;
+    RoleDenotation top(num_objects);
+    top.set();
+    RoleDenotation bot(num_objects);
+    std::vector<RoleDenotation> forms = {a, dense_a, b, c, not_a, top, bot};
+    for (const auto& left : forms) {
+        for (const auto& right : forms) {
+            auto left_pairs = left.to_sorted_vector();
+            auto right_pairs = right.to_sorted_vector();
+            std::set<PairOfObjectIndices> left_set(left_pairs.begin(), left_pairs.end());
+            std::set<PairOfObjectIndices> right_set(right_pairs.begin(), right_pairs.end());
+            RoleDenotation intersection = left;
+            intersection &= right;
+            RoleDenotation union_ = left;
+            union_ |= right;
+            RoleDenotation difference = left;
+            difference -= right;
+            for (int i = 0; i < num_objects; ++i) {
+                for (int j = 0; j < num_objects; ++j) {
+                    PairOfObjectIndices pair(i, j);
+                    EXPECT_EQ(intersection.contains(pair), left_set.count(pair) && right_set.count(pair));
+                    EXPECT_EQ(union_.contains(pair), left_set.count(pair) || right_set.count(pair));
+                    EXPECT_EQ(difference.contains(pair), left_set.count(pair) && !right_set.count(pair));
+                }
+            }
+            EXPECT_EQ(left.intersects(right), !intersection.empty());
+            EXPECT_EQ(left.is_subset_of(right), difference.empty());
+            EXPECT_EQ(left == right, left_set == right_set);
+            if (left == right) {
+                EXPECT_EQ(left.hash(), right.hash());
+            }
+        }
+    }
+    RoleDenotation::set_sparse_density(sparse_density);
+}
+
+TEST(DLPTests, RoleDenotationKernelsOnSparseForms) {
+    auto vocabulary = std::make_shared<VocabularyInfo>();
+    vocabulary->add_predicate("conn", 2);
+    vocabulary->add_predicate("goal", 1);
+    auto instance = std::make_shared<InstanceInfo>(0, vocabulary);
+    std::vector<Atom> atoms = {
+        instance->add_atom("conn", {"A", "B"}),
+        instance->add_atom("conn", {"B", "C"}),
+        instance->add_atom("conn", {"C", "A"}),
+        instance->add_atom("conn", {"D", "E"}),
+        instance->add_atom("goal", {"C"}),
+    };
+    State state(0, instance, atoms);
+    SyntacticElementFactory factory(vocabulary);
+    const double sparse_density = RoleDenotation::get_sparse_density();
+    for (const auto& description : {
+        "r_compose(r_primitive(conn,0,1),r_inverse(r_primitive(conn,0,1)))",
+        "r_restrict(r_primitive(conn,0,1),c_primitive(goal,0))",
+        "r_til_c(r_primitive(conn,0,1),c_primitive(goal,0))",
+        "r_transitive_closure(r_primitive(conn,0,1))",
+        "r_transitive_reflexive_closure(r_primitive(conn,0,1))",
+        "r_diff(r_top,r_not(r_primitive(conn,0,1)))"}) {
+        auto role = factory.parse_role(description);
+        RoleDenotation::set_sparse_density(0);
+        auto dense = role->evaluate(state);
+        RoleDenotation::set_sparse_density(1);
+        auto sparse = role->evaluate(state);
+        EXPECT_FALSE(dense.is_sparse());
+        EXPECT_EQ(sparse, dense) << description;
+        EXPECT_EQ(sparse.to_sorted_vector(), dense.to_sorted_vector()) << description;
+    }
+    RoleDenotation::set_sparse_density(sparse_density);
+}
+
+TEST(DLPTests, RoleDenotationLargeNumberOfObjects) {
+    // Keys of pairs exceed the range of int for more than 46340 objects.
+    RoleDenotation denotation(60000);
+    EXPECT_TRUE(denotation.is_sparse());
+    denotation.insert({59999, 59998});
+    denotation.insert({1, 2});
+    denotation.insert_all({{50000, 0}, {59999, 59998}});
+    EXPECT_TRUE(denotation.contains({59999, 59998}));
+    EXPECT_TRUE(denotation.contains({50000, 0}));
+    EXPECT_FALSE(denotation.contains({59998, 59999}));
+    EXPECT_EQ(denotation.to_sorted_vector(), PairsOfObjectIndices({{1, 2}, {50000, 0}, {59999, 59998}}));
+    denotation.erase({59999, 59998});
+    EXPECT_EQ(denotation.size(), 2);
+}
+
 }
@@ -0,0 +1,132 @@
+#include <gtest/gtest.h>
+
+#include "../../include/dlplan/core.h"
+#include "../../include/dlplan/core/serialization.h"
+
+using namespace dlplan::core;
+
+namespace dlplan::tests::core
+{
+    static std::vector<std::string> to_strings(const ElementCollection& elements) {
+        std::vector<std::string> result;
+        for (const auto& boolean : std::get<0>(elements)) result.push_back(boolean->str());
+        for (const auto& numerical : std::get<1>(elements)) result.push_back(numerical->str());
+        for (const auto& concept_ : std::get<2>(elements)) result.push_back(concept_->str());
+        for (const auto& role : std::get<3>(elements)) result.push_back(role->str());
+        return result;
+    }
+
+    TEST(DLPTests, SerializationRoundTrip)
+    {
+        auto vocabulary = std::make_shared<VocabularyInfo>();
+        vocabulary->add_predicate("role", 2);
+        vocabulary->add_predicate("concept", 1);
+        vocabulary->add_predicate("nullary", 0, true);
+        vocabulary->add_constant("A");
+        SyntacticElementFactory factory(vocabulary);
+
+        // Covers every kind of element.
+        ElementCollection elements;
+        for (const auto& description : {
+            "b_empty(c_primitive(concept,0))",
+            "b_empty(r_primitive(role,0,1))",
+            "b_inclusion(c_primitive(concept,0),c_one_of(A))",
+            "b_inclusion(r_primitive(role,0,1),r_top)",
+            "b_nullary(nullary)"}) {
+            std::get<0>(elements).push_back(factory.parse_boolean(description));
+        }
+        for (const auto& description : {
+            "n_count(c_not(c_primitive(concept,0)))",
+            "n_count(r_inverse(r_primitive(role,0,1)))",
+            "n_concept_distance(c_primitive(concept,0),r_primitive(role,0,1),c_one_of(A))",
+            "n_role_distance(r_primitive(role,0,1),r_primitive(role,0,1),r_top)",
+            "n_sum_concept_distance(c_primitive(concept,0),r_primitive(role,0,1),c_top)",
+            "n_sum_role_distance(r_primitive(role,0,1),r_primitive(role,0,1),r_top)"}) {
+            std::get<1>(elements).push_back(factory.parse_numerical(description));
+        }
+        for (const auto& description : {
+            "c_all(r_primitive(role,0,1),c_primitive(concept,0))",
+            "c_and(c_primitive(concept,0),c_one_of(A))",
+            "c_bot",
+            "c_diff(c_primitive(concept,0),c_one_of(A))",
+            "c_equal(r_primitive(role,0,1),r_top)",
+            "c_or(c_primitive(concept,0),c_top)",
+            "c_projection(r_primitive(role,0,1),1)",
+            "c_some(r_primitive(role,0,1),c_top)",
+            "c_subset(r_primitive(role,0,1),r_top)"}) {
+            std::get<2>(elements).push_back(factory.parse_concept(description));
+        }
+        for (const auto& description : {
+            "r_and(r_primitive(role,0,1),r_top)",
+            "r_compose(r_primitive(role,0,1),r_primitive(role,1,0))",
+            "r_diff(r_primitive(role,0,1),r_top)",
+            "r_identity(c_primitive(concept,0))",
+            "r_not(r_primitive(role,0,1))",
+            "r_or(r_primitive(role,0,1),r_top)",
+            "r_restrict(r_primitive(role,0,1),c_primitive(concept,0))",
+            "r_til_c(r_primitive(role,0,1),c_primitive(concept,0))",
+            "r_transitive_closure(r_primitive(role,0,1))",
+            "r_transitive_reflexive_closure(r_primitive(role,0,1))"}) {
+            std::get<3>(elements).push_back(factory.parse_role(description));
+        }
+        auto data = factory.serialize(elements);
+
+        // The same factory returns the same elements.
+        auto same = factory.deserialize(data);
+        EXPECT_EQ(std::get<0>(same), std::get<0>(elements));
+        EXPECT_EQ(std::get<1>(same), std::get<1>(elements));
+        EXPECT_EQ(std::get<2>(same), std::get<2>(elements));
+        EXPECT_EQ(std::get<3>(same), std::get<3>(elements));
+
+        // A fresh factory resolves the vocabulary by name.
+        auto other_vocabulary = std::make_shared<VocabularyInfo>();
+        other_vocabulary->add_constant("A");
+        other_vocabulary->add_predicate("nullary", 0, true);
+        other_vocabulary->add_predicate("concept", 1);
+        other_vocabulary->add_predicate("role", 2);
+        SyntacticElementFactory other_factory(other_vocabulary);
+        auto loaded = other_factory.deserialize(data);
+        EXPECT_EQ(to_strings(loaded), to_strings(elements));
+        EXPECT_EQ(other_factory.serialize(loaded), data);
+    }
+
+    TEST(DLPTests, SerializationSharedSubterms)
+    {
+        auto vocabulary = std::make_shared<VocabularyInfo>();
+        vocabulary->add_predicate("role", 2);
+        SyntacticElementFactory factory(vocabulary);
+        std::string description = "r_primitive(role,0,1)";
+        ElementCollection elements;
+        for (int i = 0; i < 8; ++i) {
+            description = "r_compose(" + description + "," + description + ")";
+            std::get<3>(elements).push_back(factory.parse_role(description));
+        }
+        // The tree has 2^9 - 1 nodes but the DAG only 9.
+        auto data = factory.serialize(elements);
+        EXPECT_LT(data.size(), description.size() / 10);
+
+        SyntacticElementFactory other_factory(vocabulary);
+        EXPECT_EQ(to_strings(other_factory.deserialize(data)), to_strings(elements));
+    }
+
+    TEST(DLPTests, SerializationErrors)
+    {
+        auto vocabulary = std::make_shared<VocabularyInfo>();
+        vocabulary->add_predicate("role", 2);
+        SyntacticElementFactory factory(vocabulary);
+        ElementCollection elements;
+        std::get<3>(elements).push_back(factory.parse_role("r_inverse(r_primitive(role,0,1))"));
+        auto data = factory.serialize(elements);
+
+        EXPECT_THROW(factory.deserialize("c_top"), std::runtime_error);
+        auto other_version = data;
+        other_version[4] = static_cast<char>(ELEMENT_SERIALIZATION_VERSION + 1);
+        EXPECT_THROW(factory.deserialize(other_version), std::runtime_error);
+        EXPECT_THROW(factory.deserialize(data.substr(0, data.size() - 1)), std::runtime_error);
+
+        auto other_vocabulary = std::make_shared<VocabularyInfo>();
+        other_vocabulary->add_predicate("role", 3);
+        SyntacticElementFactory other_factory(other_vocabulary);
+        EXPECT_THROW(other_factory.deserialize(data), std::runtime_error);
+    }
+}
@@ -33,8 +33,7 @@ TEST(DLPTests, GeneratorDeliveryTest) {
     feature_generator.set_generate_til_c_role(false);
     feature_generator.set_generate_transitive_reflexive_closure_role(false);
     SyntacticElementFactory syntactic_element_factory(vocabulary_info);
-    States states;
-    std::for_each(state_space.get_states().begin(), state_space.get_states().end(), [&](const auto& pair){states.push_back(pair.second); });
+    States states = state_space.get_state_vector();
     const auto [generated_booleans, generated_numericals, generated_concepts, generated_roles] = feature_generator.generate(syntactic_element_factory, states, 9, 9, 9, 9, 15, 1000, 100000);
 
     DenotationsCaches caches;
@@ -0,0 +1,82 @@
+#include <gtest/gtest.h>
+
+#include "../../utils/domain.h"
+
+#include "../../../include/dlplan/core.h"
+#include "../../../include/dlplan/generator.h"
+
+#include <sstream>
+
+using namespace dlplan::core;
+using namespace dlplan::generator;
+
+
+namespace dlplan::tests::generator {
+
+static int count_features(const GeneratedFeatures& features) {
+    const auto& [booleans, numericals, concepts, roles] = features;
+    return booleans.size() + numericals.size() + concepts.size() + roles.size();
+}
+
+/// @brief Returns the descriptions of the features in generation order.
+static std::vector<std::string> to_strings(const GeneratedFeatures& features) {
+    const auto& [booleans, numericals, concepts, roles] = features;
+    std::vector<std::string> result;
+    for (const auto& boolean : booleans) result.push_back(boolean->str());
+    for (const auto& numerical : numericals) result.push_back(numerical->str());
+    for (const auto& concept_ : concepts) result.push_back(concept_->str());
+    for (const auto& role : roles) result.push_back(role->str());
+    return result;
+}
+
+/// @brief Returns the bytes after each complexity layer from the printed memory statistics.
+static std::vector<std::size_t> parse_num_bytes_by_layer(const std::string& output) {
+    std::vector<std::size_t> result;
+    std::istringstream stream(output);
+    std::string line;
+    while (std::getline(stream, line)) {
+        // The denotations are printed first for each layer.
+        if (line.rfind("Memory of denotations: ", 0) == 0) {
+            result.push_back(0);
+        }
+        for (const std::string prefix : {"Memory of denotations: ", "Memory of elements: ", "Memory of generator: "}) {
+            if (line.rfind(prefix, 0) == 0) {
+                result.back() += std::stoull(line.substr(prefix.size()));
+            }
+        }
+    }
+    return result;
+}
+
+TEST(DLPTests, GeneratorMemoryLimitTest) {
+    auto vocabulary_info = gripper::construct_vocabulary_info();
+    auto instance_info = gripper::construct_instance_info(vocabulary_info);
+    // States where the robot is in A or B and holds no package or p1.
+    States states;
+    states.emplace_back(0, instance_info, AtomIndices{0, 2, 4, 6});
+    states.emplace_back(1, instance_info, AtomIndices{0, 2, 4, 7});
+    states.emplace_back(2, instance_info, AtomIndices{2, 4, 6, 8});
+    states.emplace_back(3, instance_info, AtomIndices{2, 4, 7, 8});
+    states.emplace_back(4, instance_info, AtomIndices{1, 3, 5, 7});
+
+    SyntacticElementFactory unlimited_factory(vocabulary_info);
+    testing::internal::CaptureStdout();
+    auto unlimited = FeatureGenerator().generate(unlimited_factory, states, 5, 5, 5, 5, 5, 3600, 100000);
+    const auto num_bytes_by_layer = parse_num_bytes_by_layer(testing::internal::GetCapturedStdout());
+    ASSERT_GE(num_bytes_by_layer.size(), 4);
+    ASSERT_LT(num_bytes_by_layer[1], num_bytes_by_layer[2]);
+
+    // The limit lies between the second and the third layer, hence,
+    // generation stops after completing the third layer.
+    auto feature_generator = FeatureGenerator();
+    feature_generator.set_memory_limit(num_bytes_by_layer[1] + 1);
+    SyntacticElementFactory limited_factory(vocabulary_info);
+    GeneratedFeatures limited;
+    EXPECT_NO_THROW(limited = feature_generator.generate(limited_factory, states, 5, 5, 5, 5, 5, 3600, 100000));
+    SyntacticElementFactory truncated_factory(vocabulary_info);
+    auto truncated = FeatureGenerator().generate(truncated_factory, states, 3, 3, 3, 3, 3, 3600, 100000);
+    EXPECT_EQ(to_strings(limited), to_strings(truncated));
+    EXPECT_LT(count_features(limited), count_features(unlimited));
+}
+
+}
@@ -0,0 +1,334 @@
+#include <gtest/gtest.h>
+
+#include "../utils/domain.h"
+
+#include "../../include/dlplan/policy.h"
+
+#include <map>
+#include <random>
+
+using namespace std;
+using namespace dlplan::core;
+using namespace dlplan::policy;
+
+
+namespace dlplan::tests::policy {
+
+/// @brief Creates gripper states with the robot in A or B and each
+///        package in A, in B, or held where at most one package is held.
+static States create_gripper_states(std::shared_ptr<InstanceInfo> instance_info) {
+    States states;
+    for (int robot = 0; robot < 2; ++robot) {
+        for (int held = -1; held < 3; ++held) {
+            for (int locations = 0; locations < 8; ++locations) {
+                AtomIndices atom_indices{6 + robot};
+                bool valid = true;
+                for (int package = 0; package < 3; ++package) {
+                    int location = (locations >> package) & 1;
+                    if (package == held) {
+                        // enumerate the held package only once
+                        valid &= (location == 0);
+                        atom_indices.push_back(8 + package);
+                    } else {
+                        atom_indices.push_back(2 * package + location);
+                    }
+                }
+                if (valid) {
+                    states.emplace_back(states.size(), instance_info, atom_indices);
+                }
+            }
+        }
+    }
+    return states;
+}
+
+/// @brief Creates the state space over the gripper states with actions
+///        for moving the robot, picking with free hands, and dropping.
+static std::shared_ptr<const dlplan::state_space::StateSpace> create_gripper_state_space(std::shared_ptr<InstanceInfo> instance_info) {
+    auto states = create_gripper_states(instance_info);
+    std::map<AtomIndices, int> atoms_to_index;
+    for (const auto& state : states) {
+        atoms_to_index.emplace(state.get_atom_indices(), state.get_index());
+    }
+    dlplan::state_space::AdjacencyList adjacency_list;
+    dlplan::state_space::StateIndicesSet goal_state_indices;
+    for (const auto& state : states) {
+        const auto& atoms = state.get_atom_indices();
+        auto contains = [&](int atom) { return std::count(atoms.begin(), atoms.end(), atom) > 0; };
+        auto add_successor = [&](int removed_atom, int added_atom) {
+            AtomIndices successor_atoms(atoms);
+            std::replace(successor_atoms.begin(), successor_atoms.end(), removed_atom, added_atom);
+            std::sort(successor_atoms.begin(), successor_atoms.end());
+            adjacency_list[state.get_index()].insert(atoms_to_index.at(successor_atoms));
+        };
+        int room = contains(6) ? 0 : 1;
+        add_successor(6 + room, 7 - room);
+        for (int package = 0; package < 3; ++package) {
+            if (contains(8 + package)) {
+                add_successor(8 + package, 2 * package + room);
+            } else if (contains(2 * package + room) && !contains(8) && !contains(9) && !contains(10)) {
+                add_successor(2 * package + room, 8 + package);
+            }
+        }
+        if (contains(1) && contains(3) && contains(5)) {
+            goal_state_indices.insert(state.get_index());
+        }
+    }
+    int num_states = states.size();
+    int initial_state_index = atoms_to_index.at({0, 2, 4, 6});
+    return std::make_shared<dlplan::state_space::StateSpace>(
+        std::move(instance_info),
+        std::move(states),
+        initial_state_index,
+        dlplan::state_space::CompressedAdjacencyList(num_states, adjacency_list),
+        std::move(goal_state_indices));
+}
+
+/// @brief Evaluates rules in order independently of each other.
+static std::shared_ptr<const Rule> evaluate_naive(const Policy& policy, const State& source_state, const State& target_state) {
+    for (const auto& rule : policy.get_rules()) {
+        if (rule->evaluate_conditions(source_state) && rule->evaluate_effects(source_state, target_state)) {
+            return rule;
+        }
+    }
+    return nullptr;
+}
+
+static std::shared_ptr<const Policy> create_gripper_policy(PolicyFactory& policy_factory, std::shared_ptr<SyntacticElementFactory> element_factory) {
+    auto b0 = policy_factory.make_boolean("b0", element_factory->parse_boolean("b_empty(c_primitive(holding,0))"));
+    auto n0 = policy_factory.make_numerical("n0", element_factory->parse_numerical("n_count(c_some(r_primitive(at,0,1),c_primitive(at_roboter,0)))"));
+    auto n1 = policy_factory.make_numerical("n1", element_factory->parse_numerical("n_count(c_and(c_not(c_equal(r_primitive(at_g,0,1),r_primitive(at,0,1))),c_primitive(package,0)))"));
+    // pick up a package in the room of the robot
+    auto r1 = policy_factory.make_rule(
+        {policy_factory.make_pos_condition(b0), policy_factory.make_gt_condition(n0)},
+        {policy_factory.make_neg_effect(b0), policy_factory.make_dec_effect(n0), policy_factory.make_bot_effect(n1)});
+    // move to the other room while holding a package
+    auto r2 = policy_factory.make_rule(
+        {policy_factory.make_neg_condition(b0), policy_factory.make_gt_condition(n1)},
+        {policy_factory.make_bot_effect(b0), policy_factory.make_bot_effect(n1)});
+    // drop a package
+    auto r3 = policy_factory.make_rule(
+        {policy_factory.make_neg_condition(b0)},
+        {policy_factory.make_pos_effect(b0), policy_factory.make_dec_effect(n1)});
+    // move to the other room with free hands
+    auto r4 = policy_factory.make_rule(
+        {policy_factory.make_pos_condition(b0), policy_factory.make_eq_condition(n0), policy_factory.make_gt_condition(n1)},
+        {policy_factory.make_bot_effect(b0), policy_factory.make_inc_effect(n0)});
+    return policy_factory.make_policy({r1, r2, r3, r4});
+}
+
+TEST(DLPTests, PolicyEvaluateTest) {
+    auto vocabulary_info = gripper::construct_vocabulary_info();
+    auto instance_info = gripper::construct_instance_info(vocabulary_info);
+    auto element_factory = construct_syntactic_element_factory(vocabulary_info);
+    PolicyFactory policy_factory(element_factory);
+    auto policy = create_gripper_policy(policy_factory, element_factory);
+    auto states = create_gripper_states(instance_info);
+    EXPECT_EQ(states.size(), 40);
+
+    DenotationsCaches caches;
+    int num_matched_pairs = 0;
+    for (const auto& source_state : states) {
+        auto rules = policy->evaluate_conditions(source_state);
+        EXPECT_EQ(rules, policy->evaluate_conditions(source_state, caches));
+        for (const auto& rule : policy->get_rules()) {
+            bool expected = std::find(rules.begin(), rules.end(), rule) != rules.end();
+            EXPECT_EQ(rule->evaluate_conditions(source_state), expected);
+        }
+        for (const auto& target_state : states) {
+            auto expected = evaluate_naive(*policy, source_state, target_state);
+            EXPECT_EQ(policy->evaluate(source_state, target_state), expected);
+            EXPECT_EQ(policy->evaluate(source_state, target_state, caches), expected);
+            EXPECT_EQ(policy->evaluate_effects(source_state, target_state, rules), expected);
+            EXPECT_EQ(policy->evaluate_effects(source_state, target_state, rules, caches), expected);
+            if (expected) ++num_matched_pairs;
+        }
+    }
+    EXPECT_GT(num_matched_pairs, 0);
+}
+
+TEST(DLPTests, PolicyLazyConditionsTest) {
+    auto vocabulary_info = gripper::construct_vocabulary_info();
+    auto instance_info = gripper::construct_instance_info(vocabulary_info);
+    auto element_factory = construct_syntactic_element_factory(vocabulary_info);
+    PolicyFactory policy_factory(element_factory);
+    auto b0 = policy_factory.make_boolean("b0", element_factory->parse_boolean("b_empty(c_primitive(holding,0))"));
+    auto n1 = policy_factory.make_numerical("n1", element_factory->parse_numerical("n_count(c_and(c_not(c_equal(r_primitive(at_g,0,1),r_primitive(at,0,1))),c_primitive(package,0)))"));
+    ASSERT_LT(b0->compute_evaluate_time_score(), n1->compute_evaluate_time_score());
+    auto rule = policy_factory.make_rule(
+        {policy_factory.make_pos_condition(b0), policy_factory.make_gt_condition(n1)},
+        {policy_factory.make_neg_effect(b0)});
+    auto policy = policy_factory.make_policy({rule});
+    // The robot holds p1, hence, the cheap condition is false and the expensive one is skipped.
+    State state(0, instance_info, AtomIndices{2, 4, 6, 8});
+    DenotationsCaches caches;
+    EXPECT_TRUE(policy->evaluate_conditions(state, caches).empty());
+    DenotationsCaches expected_caches;
+    b0->get_element()->evaluate(state, expected_caches);
+    EXPECT_EQ(caches.get_num_misses(), expected_caches.get_num_misses());
+    // Otherwise, both conditions are evaluated.
+    State other_state(1, instance_info, AtomIndices{0, 2, 4, 6});
+    EXPECT_EQ(policy->evaluate_conditions(other_state, caches), std::vector<std::shared_ptr<const Rule>>({rule}));
+}
+
+TEST(DLPTests, PolicyEvaluateSuccessorsTest) {
+    auto vocabulary_info = gripper::construct_vocabulary_info();
+    auto instance_info = gripper::construct_instance_info(vocabulary_info);
+    auto element_factory = construct_syntactic_element_factory(vocabulary_info);
+    PolicyFactory policy_factory(element_factory);
+    auto policy = create_gripper_policy(policy_factory, element_factory);
+    auto states = create_gripper_states(instance_info);
+
+    DenotationsCaches caches;
+    for (const auto& source_state : states) {
+        std::vector<std::pair<int, std::shared_ptr<const Rule>>> expected;
+        for (size_t i = 0; i < states.size(); ++i) {
+            auto rule = evaluate_naive(*policy, source_state, states[i]);
+            if (rule) {
+                expected.emplace_back(i, rule);
+            }
+        }
+        EXPECT_EQ(policy->evaluate_successors(source_state, states), expected);
+        EXPECT_EQ(policy->evaluate_successors(source_state, states, caches), expected);
+        EXPECT_EQ(policy->evaluate_successors(source_state, states, 3), expected);
+        EXPECT_EQ(policy->evaluate_successors(source_state, states, caches, 3), expected);
+    }
+    EXPECT_TRUE(policy->evaluate_successors(states.front(), std::span<const State>()).empty());
+}
+
+TEST(DLPTests, PolicyDecisionDiagramTest) {
+    auto vocabulary_info = gripper::construct_vocabulary_info();
+    auto instance_info = gripper::construct_instance_info(vocabulary_info);
+    auto element_factory = construct_syntactic_element_factory(vocabulary_info);
+    PolicyFactory policy_factory(element_factory);
+    auto states = create_gripper_states(instance_info);
+
+    auto b0 = policy_factory.make_boolean("b0", element_factory->parse_boolean("b_empty(c_primitive(holding,0))"));
+    auto n0 = policy_factory.make_numerical("n0", element_factory->parse_numerical("n_count(c_some(r_primitive(at,0,1),c_primitive(at_roboter,0)))"));
+    auto c0 = policy_factory.make_concept("c0", element_factory->parse_concept("c_primitive(holding,0)"));
+    std::vector<std::vector<std::shared_ptr<const BaseCondition>>> conditions = {
+        {policy_factory.make_pos_condition(b0), policy_factory.make_neg_condition(b0)},
+        {policy_factory.make_gt_condition(n0), policy_factory.make_eq_condition(n0)},
+        {policy_factory.make_gt_condition(c0), policy_factory.make_eq_condition(c0)}};
+    std::vector<std::vector<std::shared_ptr<const BaseEffect>>> effects = {
+        {policy_factory.make_pos_effect(b0), policy_factory.make_neg_effect(b0), policy_factory.make_bot_effect(b0)},
+        {policy_factory.make_inc_effect(n0), policy_factory.make_dec_effect(n0), policy_factory.make_bot_effect(n0), policy_factory.make_gt_effect(n0), policy_factory.make_eq_effect(n0)},
+        {policy_factory.make_inc_effect(c0), policy_factory.make_dec_effect(c0), policy_factory.make_bot_effect(c0), policy_factory.make_gt_effect(c0), policy_factory.make_eq_effect(c0)}};
+
+    std::vector<std::shared_ptr<const Policy>> policies = {create_gripper_policy(policy_factory, element_factory)};
+    std::mt19937 generator(0);
+    for (int i = 0; i < 20; ++i) {
+        Rules rules;
+        int num_rules = 1 + generator() % 8;
+        for (int r = 0; r < num_rules; ++r) {
+            Conditions rule_conditions;
+            Effects rule_effects;
+            for (size_t f = 0; f < 3; ++f) {
+                if (generator() % 2) rule_conditions.insert(conditions[f][generator() % conditions[f].size()]);
+                if (generator() % 2) rule_effects.insert(effects[f][generator() % effects[f].size()]);
+            }
+            rules.insert(policy_factory.make_rule(rule_conditions, rule_effects));
+        }
+        policies.push_back(policy_factory.make_policy(rules));
+    }
+
+    DenotationsCaches caches;
+    for (const auto& policy : policies) {
+        PolicyDecisionDiagram diagram(policy);
+        EXPECT_GE(diagram.get_num_nodes(), static_cast<int>(policy->get_rules().size()) + 1);
+        for (const auto& source_state : states) {
+            for (const auto& target_state : states) {
+                auto expected = policy->evaluate(source_state, target_state);
+                EXPECT_EQ(diagram.evaluate(source_state, target_state), expected);
+                EXPECT_EQ(diagram.evaluate(source_state, target_state, caches), expected);
+            }
+        }
+    }
+}
+
+
+TEST(DLPTests, PolicyVerifierGripperTest) {
+    auto vocabulary_info = gripper::construct_vocabulary_info();
+    auto instance_info = gripper::construct_instance_info(vocabulary_info);
+    auto element_factory = construct_syntactic_element_factory(vocabulary_info);
+    auto policy_factory = PolicyFactory(element_factory);
+    auto policy = create_gripper_policy(policy_factory, element_factory);
+    auto state_space = create_gripper_state_space(instance_info);
+    auto goal_distances = state_space->compute_dense_goal_distances();
+
+    // Evaluate the policy per transition.
+    int num_alive_states = 0;
+    int num_compatible_transitions = 0;
+    dlplan::state_space::StateIndices unsolved_state_indices;
+    for (const auto& state : state_space->get_state_vector()) {
+        int source = state.get_index();
+        if (state_space->is_goal(source) || goal_distances[source] == dlplan::state_space::UNDEFINED) continue;
+        ++num_alive_states;
+        int num_compatible = 0;
+        for (int target : state_space->get_forward_successors().get_targets(source)) {
+            if (policy->evaluate(state, state_space->get_state(target))) ++num_compatible;
+        }
+        if (num_compatible == 0) unsolved_state_indices.push_back(source);
+        num_compatible_transitions += num_compatible;
+    }
+
+    auto result = PolicyVerifier().verify(policy, state_space);
+    EXPECT_EQ(result.num_alive_states, num_alive_states);
+    EXPECT_EQ(result.num_compatible_transitions, num_compatible_transitions);
+    EXPECT_EQ(result.unsolved_state_indices, unsolved_state_indices);
+    EXPECT_TRUE(result.unsafe_state_indices.empty());
+    // Moving while holding a package is allowed in both directions.
+    EXPECT_FALSE(result.cycles.empty());
+    EXPECT_FALSE(result.is_sound());
+
+    auto parallel_result = PolicyVerifier(4).verify(policy, state_space);
+    EXPECT_EQ(parallel_result.num_compatible_transitions, result.num_compatible_transitions);
+    EXPECT_EQ(parallel_result.unsolved_state_indices, result.unsolved_state_indices);
+    EXPECT_EQ(parallel_result.cycles, result.cycles);
+}
+
+TEST(DLPTests, PolicyVerifierChainTest) {
+    auto vocabulary_info = gripper::construct_vocabulary_info();
+    auto instance_info = gripper::construct_instance_info(vocabulary_info);
+    auto element_factory = construct_syntactic_element_factory(vocabulary_info);
+    auto policy_factory = PolicyFactory(element_factory);
+    // s0 <-> s1 -> s2 where s2 is the goal and s0 -> s3 where s3 is a dead end.
+    States states = {
+        State(0, instance_info, AtomIndices{4}),
+        State(1, instance_info, AtomIndices{4, 8}),
+        State(2, instance_info, AtomIndices{4, 8, 9}),
+        State(3, instance_info, AtomIndices{10})};
+    dlplan::state_space::AdjacencyList adjacency_list = {{0, {1, 3}}, {1, {0, 2}}};
+    auto state_space = std::make_shared<dlplan::state_space::StateSpace>(
+        std::shared_ptr<InstanceInfo>(instance_info),
+        std::move(states),
+        0,
+        dlplan::state_space::CompressedAdjacencyList(4, adjacency_list),
+        dlplan::state_space::StateIndicesSet{2});
+    auto n0 = policy_factory.make_numerical("n0", element_factory->parse_numerical("n_count(c_primitive(holding,0))"));
+    auto n1 = policy_factory.make_numerical("n1", element_factory->parse_numerical("n_count(c_primitive(at,0))"));
+    PolicyVerifier verifier;
+
+    auto sound_policy = policy_factory.make_policy({policy_factory.make_rule({}, {policy_factory.make_inc_effect(n0), policy_factory.make_bot_effect(n1)})});
+    auto result = verifier.verify(sound_policy, state_space);
+    EXPECT_EQ(result.num_alive_states, 2);
+    EXPECT_EQ(result.num_compatible_transitions, 2);
+    EXPECT_TRUE(result.is_sound());
+
+    auto unsafe_policy = policy_factory.make_policy({policy_factory.make_rule({}, {policy_factory.make_inc_effect(n0)})});
+    result = verifier.verify(unsafe_policy, state_space);
+    EXPECT_EQ(result.unsafe_state_indices, dlplan::state_space::StateIndices({0}));
+    EXPECT_TRUE(result.cycles.empty());
+
+    auto cyclic_policy = policy_factory.make_policy({policy_factory.make_rule({}, {policy_factory.make_bot_effect(n1)})});
+    result = verifier.verify(cyclic_policy, state_space);
+    EXPECT_EQ(result.cycles, std::vector<dlplan::state_space::StateIndices>({{0, 1}}));
+    EXPECT_TRUE(result.unsafe_state_indices.empty());
+
+    auto unsolved_policy = policy_factory.make_policy({policy_factory.make_rule({policy_factory.make_gt_condition(n0)}, {policy_factory.make_inc_effect(n0)})});
+    result = verifier.verify(unsolved_policy, state_space);
+    EXPECT_EQ(result.unsolved_state_indices, dlplan::state_space::StateIndices({0}));
+    EXPECT_TRUE(result.cycles.empty());
+}
+
+}
@@ -4,12 +4,113 @@
 
 #include "../../include/dlplan/policy.h"
 
+#include <random>
+
 using namespace dlplan::core;
 using namespace dlplan::policy;
 
 
 namespace dlplan::tests::policy {
 
+using LiteralSet = std::set<std::string>;
+
+/// @brief Creates a random policy with rules over the given number of gripper booleans and numericals.
+static std::shared_ptr<const Policy> create_random_policy(PolicyFactory& policy_factory, int num_booleans, int num_numericals, int num_rules, std::mt19937& generator) {
+    const std::vector<std::string> concepts = {
+        "c_primitive(holding,0)", "c_primitive(package,0)", "c_primitive(at_roboter,0)",
+        "c_primitive(at,0)", "c_primitive(at,1)", "c_primitive(at_g,0)", "c_primitive(at_g,1)"};
+    auto element_factory = policy_factory.get_element_factory();
+    std::vector<std::vector<std::shared_ptr<const BaseCondition>>> conditions;
+    std::vector<std::vector<std::shared_ptr<const BaseEffect>>> effects;
+    for (int i = 0; i < num_booleans; ++i) {
+        auto boolean = policy_factory.make_boolean("b" + std::to_string(i), element_factory->parse_boolean("b_empty(" + concepts[i] + ")"));
+        conditions.push_back({policy_factory.make_pos_condition(boolean), policy_factory.make_neg_condition(boolean)});
+        effects.push_back({policy_factory.make_pos_effect(boolean), policy_factory.make_neg_effect(boolean), policy_factory.make_bot_effect(boolean)});
+    }
+    for (int i = 0; i < num_numericals; ++i) {
+        auto numerical = policy_factory.make_numerical("n" + std::to_string(i), element_factory->parse_numerical("n_count(" + concepts[i] + ")"));
+        conditions.push_back({policy_factory.make_gt_condition(numerical), policy_factory.make_eq_condition(numerical)});
+        effects.push_back({policy_factory.make_inc_effect(numerical), policy_factory.make_dec_effect(numerical), policy_factory.make_bot_effect(numerical)});
+    }
+    Rules rules;
+    for (int i = 0; i < num_rules; ++i) {
+        Conditions rule_conditions;
+        for (const auto& choices : conditions) {
+            int choice = std::uniform_int_distribution<int>(0, choices.size())(generator);
+            if (choice < static_cast<int>(choices.size())) rule_conditions.insert(choices[choice]);
+        }
+        Effects rule_effects;
+        for (const auto& choices : effects) {
+            int choice = std::uniform_int_distribution<int>(0, choices.size())(generator);
+            if (choice < static_cast<int>(choices.size())) rule_effects.insert(choices[choice]);
+        }
+        rules.insert(policy_factory.make_rule(rule_conditions, rule_effects));
+    }
+    return policy_factory.make_policy(rules);
+}
+
+/// @brief Reference implementation that adds merged rules by scanning
+///        all rules until a fixpoint is reached and removes dominated rules.
+static std::shared_ptr<const Policy> minimize_naive(const std::shared_ptr<const Policy>& policy, PolicyFactory& policy_factory) {
+    std::map<std::string, std::shared_ptr<const BaseCondition>> conditions;
+    std::map<std::string, std::shared_ptr<const BaseEffect>> effects;
+    std::set<LiteralSet> rules;
+    for (const auto& rule : policy->get_rules()) {
+        LiteralSet literals;
+        for (const auto& condition : rule->get_conditions()) {
+            conditions.emplace(condition->str(), condition);
+            literals.insert(condition->str());
+        }
+        for (const auto& effect : rule->get_effects()) {
+            effects.emplace(effect->str(), effect);
+            literals.insert(effect->str());
+        }
+        rules.insert(literals);
+    }
+    std::vector<std::pair<std::string, std::vector<std::string>>> merges;
+    for (const auto& boolean : policy->get_booleans()) {
+        merges.push_back({policy_factory.make_neg_condition(boolean)->str(), {policy_factory.make_pos_condition(boolean)->str()}});
+        merges.push_back({policy_factory.make_neg_effect(boolean)->str(), {policy_factory.make_pos_effect(boolean)->str()}});
+        merges.push_back({policy_factory.make_bot_effect(boolean)->str(), {policy_factory.make_pos_effect(boolean)->str()}});
+        merges.push_back({policy_factory.make_bot_effect(boolean)->str(), {policy_factory.make_neg_effect(boolean)->str()}});
+    }
+    for (const auto& numerical : policy->get_numericals()) {
+        merges.push_back({policy_factory.make_eq_condition(numerical)->str(), {policy_factory.make_gt_condition(numerical)->str()}});
+        merges.push_back({policy_factory.make_inc_effect(numerical)->str(), {policy_factory.make_dec_effect(numerical)->str(), policy_factory.make_bot_effect(numerical)->str()}});
+    }
+    auto is_subset = [](const LiteralSet& l, const LiteralSet& r) { return std::includes(r.begin(), r.end(), l.begin(), l.end()); };
+    bool changed;
+    do {
+        changed = false;
+        for (const auto& rule : std::set<LiteralSet>(rules)) {
+            for (const auto& [base, partners] : merges) {
+                if (!rule.count(base)) continue;
+                LiteralSet remainder = rule;
+                remainder.erase(base);
+                bool mergeable = std::all_of(partners.begin(), partners.end(), [&](const std::string& partner) {
+                    return std::any_of(rules.begin(), rules.end(), [&](const LiteralSet& other) {
+                        LiteralSet other_remainder = other;
+                        return other_remainder.erase(partner) && is_subset(other_remainder, remainder);
+                    });
+                });
+                if (mergeable && rules.insert(remainder).second) changed = true;
+            }
+        }
+    } while (changed);
+    Rules result;
+    for (const auto& rule : rules) {
+        if (std::any_of(rules.begin(), rules.end(), [&](const LiteralSet& other){ return other != rule && is_subset(other, rule); })) continue;
+        Conditions rule_conditions;
+        Effects rule_effects;
+        for (const auto& literal : rule) {
+            if (conditions.count(literal)) rule_conditions.insert(conditions.at(literal));
+            else rule_effects.insert(effects.at(literal));
+        }
+        result.insert(policy_factory.make_rule(rule_conditions, rule_effects));
+    }
+    return policy_factory.make_policy(result);
+}
+
 TEST(DLPTests, StructuralMinimization) {
     std::string policy_textual =
         "(:policy\n"
@@ -184,6 +285,55 @@ TEST(DLPTests, EmpiricalMinimization) {
               << "Minimized policy:" << std::endl
               << minimized_policy->str() << std::endl;
     EXPECT_EQ(minimized_policy->str(), result_policy->str());
+    EXPECT_EQ(PolicyMinimizer(4).minimize(input_policy, true_state_pairs, false_state_pairs, policy_factory)->str(), result_policy->str());
+    // States that share an index are evaluated separately.
+    auto A_A_A_B_renumbered = State(2, instance_info, {at_roboter_A, at_p1_A, at_p2_A, at_p3_B});
+    StatePairs renumbered_false_state_pairs = {StatePair(A_A_A_B_renumbered, B_A_A_B), B_A_A_B_A_A_A_B};
+    EXPECT_EQ(PolicyMinimizer().minimize(input_policy, true_state_pairs, renumbered_false_state_pairs, policy_factory)->str(), result_policy->str());
+    // A cancelled token stops minimization while an active one does not interfere.
+    auto cancellation_token = std::make_shared<dlplan::utils::CancellationToken>();
+    EXPECT_EQ(PolicyMinimizer().minimize(input_policy, true_state_pairs, false_state_pairs, policy_factory, cancellation_token)->str(), result_policy->str());
+    cancellation_token->cancel();
+    EXPECT_THROW(PolicyMinimizer().minimize(input_policy, true_state_pairs, false_state_pairs, policy_factory, cancellation_token), dlplan::utils::OperationCancelled);
+    EXPECT_THROW(PolicyMinimizer().minimize(input_policy, policy_factory, cancellation_token), dlplan::utils::OperationCancelled);
+}
+
+
+TEST(DLPTests, StructuralMinimizationRandom) {
+    auto vocabulary_info = gripper::construct_vocabulary_info();
+    auto element_factory = construct_syntactic_element_factory(vocabulary_info);
+    auto policy_factory = PolicyFactory(element_factory);
+    std::mt19937 generator(0);
+    for (int i = 0; i < 20; ++i) {
+        auto input_policy = create_random_policy(policy_factory, 3, 2, 30, generator);
+        auto expected_policy = minimize_naive(input_policy, policy_factory);
+        EXPECT_EQ(PolicyMinimizer().minimize(input_policy, policy_factory)->str(), expected_policy->str());
+        EXPECT_EQ(PolicyMinimizer(4).minimize(input_policy, policy_factory)->str(), expected_policy->str());
+    }
+}
+
+
+TEST(DLPTests, StructuralMinimizationLarge) {
+    auto vocabulary_info = gripper::construct_vocabulary_info();
+    auto element_factory = construct_syntactic_element_factory(vocabulary_info);
+    auto policy_factory = PolicyFactory(element_factory);
+    std::mt19937 generator(0);
+    auto input_policy = create_random_policy(policy_factory, 7, 7, 1000, generator);
+    EXPECT_EQ(input_policy->get_rules().size(), 1000);
+    auto minimized_policy = PolicyMinimizer(4).minimize(input_policy, policy_factory);
+    auto is_subset = [](const Rule& l, const Rule& r) {
+        return std::all_of(l.get_conditions().begin(), l.get_conditions().end(), [&](const auto& condition){ return r.get_conditions().count(condition); })
+            && std::all_of(l.get_effects().begin(), l.get_effects().end(), [&](const auto& effect){ return r.get_effects().count(effect); });
+    };
+    // Each input rule is implied by a minimized rule and minimized rules are undominated.
+    for (const auto& rule : input_policy->get_rules()) {
+        EXPECT_TRUE(std::any_of(minimized_policy->get_rules().begin(), minimized_policy->get_rules().end(), [&](const auto& other){ return is_subset(*other, *rule); }));
+    }
+    for (const auto& rule : minimized_policy->get_rules()) {
+        for (const auto& other : minimized_policy->get_rules()) {
+            EXPECT_TRUE(rule == other || !is_subset(*other, *rule));
+        }
+    }
 }
 
 }
@@ -0,0 +1,262 @@
+#include <gtest/gtest.h>
+
+#include "../../include/dlplan/state_space.h"
+
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <limits>
+#include <random>
+
+using namespace dlplan::core;
+using namespace dlplan::state_space;
+
+
+namespace dlplan::tests::state_space {
+
+/// @brief Creates a state space over a chain 0 -> 1 -> 2 -> 3 with a
+///        self loop at 0, a deadend 4 reachable from 1, and goal 3.
+static StateSpace create_chain_state_space() {
+    auto vocabulary_info = std::make_shared<VocabularyInfo>();
+    vocabulary_info->add_predicate("at", 1);
+    auto instance_info = std::make_shared<InstanceInfo>(0, vocabulary_info);
+    StateMapping states;
+    for (int i = 0; i < 5; ++i) {
+        const auto& atom = instance_info->add_atom("at", {"l" + std::to_string(i)});
+        states.emplace(i, State(i, instance_info, AtomIndices{atom.get_index()}));
+    }
+    AdjacencyList forward_successors = {
+        {0, {0, 1}},
+        {1, {2, 4}},
+        {2, {3}},
+    };
+    return StateSpace(std::move(instance_info), std::move(states), 0, std::move(forward_successors), StateIndicesSet{3});
+}
+
+TEST(DLPTests, StateSpaceCompressedAdjacencyListTest) {
+    AdjacencyList adjacency_list = {{0, {2, 1}}, {2, {0}}};
+    CompressedAdjacencyList compressed(3, adjacency_list);
+    EXPECT_EQ(compressed.get_num_state_indices(), 3);
+    EXPECT_EQ(compressed.get_num_edges(), 3);
+    EXPECT_EQ(compressed.get_offsets(), std::vector<int>({0, 2, 2, 3}));
+    EXPECT_EQ(compressed.get_targets(), StateIndices({1, 2, 0}));
+    EXPECT_EQ(compressed.to_adjacency_list(), adjacency_list);
+    auto inverse = compressed.compute_inverse();
+    EXPECT_EQ(inverse.get_offsets(), std::vector<int>({0, 1, 2, 3}));
+    EXPECT_EQ(inverse.get_targets(), StateIndices({2, 0, 0}));
+}
+
+TEST(DLPTests, StateSpaceDistancesTest) {
+    auto state_space = create_chain_state_space();
+    EXPECT_EQ(state_space.get_num_state_indices(), 5);
+    EXPECT_EQ(state_space.compute_dense_goal_distances(), DenseDistances({3, 2, 1, 0, UNDEFINED}));
+    EXPECT_EQ(state_space.compute_goal_distances(), Distances({{0, 3}, {1, 2}, {2, 1}, {3, 0}}));
+    EXPECT_EQ(state_space.compute_dense_distances({0}, true, false), DenseDistances({0, 1, 2, 3, 2}));
+    EXPECT_EQ(state_space.compute_dense_distances({2}, true, true), DenseDistances({UNDEFINED, UNDEFINED, 0, 1, UNDEFINED}));
+    EXPECT_EQ(state_space.get_backward_successor_state_indices(), AdjacencyList({{0, {0}}, {1, {0}}, {2, {1}}, {3, {2}}, {4, {1}}}));
+    EXPECT_EQ(state_space.get_states().size(), 5);
+    EXPECT_EQ(state_space.get_state(4).get_index(), 4);
+}
+
+TEST(DLPTests, StateSpaceFragmentTest) {
+    auto state_space = create_chain_state_space();
+    auto fragment = StateSpace(state_space, StateIndicesSet{1, 2, 4});
+    EXPECT_EQ(fragment.get_initial_state_index(), UNDEFINED);
+    EXPECT_EQ(fragment.get_state_vector().size(), 3);
+    EXPECT_FALSE(fragment.has_state(0));
+    EXPECT_FALSE(fragment.has_state(3));
+    EXPECT_TRUE(fragment.get_goal_state_indices().empty());
+    EXPECT_EQ(fragment.get_forward_successor_state_indices(), AdjacencyList({{1, {2, 4}}}));
+    EXPECT_EQ(fragment.compute_distances({1}, true, false), Distances({{1, 0}, {2, 1}, {4, 1}}));
+}
+
+TEST(DLPTests, StateSpaceParallelDistancesTest) {
+    auto state_space = create_chain_state_space();
+    for (int num_threads : {2, 3}) {
+        EXPECT_EQ(state_space.compute_dense_goal_distances(num_threads), state_space.compute_dense_goal_distances());
+        EXPECT_EQ(state_space.compute_dense_distances({0}, true, false, num_threads), DenseDistances({0, 1, 2, 3, 2}));
+        EXPECT_EQ(state_space.compute_dense_distances({2}, true, true, num_threads), DenseDistances({UNDEFINED, UNDEFINED, 0, 1, UNDEFINED}));
+    }
+}
+
+TEST(DLPTests, StateSpaceParallelDistancesRandomTest) {
+    // Dense enough to trigger bottom-up levels.
+    auto vocabulary_info = std::make_shared<VocabularyInfo>();
+    auto instance_info = std::make_shared<InstanceInfo>(0, vocabulary_info);
+    const int num_states = 2000;
+    std::mt19937 generator(0);
+    std::uniform_int_distribution<int> distribution(0, num_states - 1);
+    StateMapping states;
+    AdjacencyList forward_successors;
+    for (int i = 0; i < num_states; ++i) {
+        states.emplace(i, State(i, instance_info, AtomIndices{}));
+        for (int j = 0; j < 8; ++j) {
+            forward_successors[i].insert(distribution(generator));
+        }
+    }
+    StateIndicesSet goal_state_indices = {1, 2, 3};
+    auto state_space = StateSpace(std::move(instance_info), std::move(states), 0, std::move(forward_successors), std::move(goal_state_indices));
+    for (int num_threads : {2, 4}) {
+        EXPECT_EQ(state_space.compute_dense_goal_distances(num_threads), state_space.compute_dense_goal_distances());
+        EXPECT_EQ(state_space.compute_dense_distances({0}, true, true, num_threads), state_space.compute_dense_distances({0}, true, true));
+        EXPECT_EQ(state_space.compute_dense_distances({0, 5}, true, false, num_threads), state_space.compute_dense_distances({0, 5}, true, false));
+    }
+}
+
+TEST(DLPTests, StateSpaceBinaryTest) {
+    const auto directory = std::filesystem::temp_directory_path();
+    const std::string filename = directory / "dlplan_state_space_binary_test_chain.bin";
+    const std::string corrupt_filename = directory / "dlplan_state_space_binary_test_corrupt.bin";
+    auto state_space = create_chain_state_space();
+    write_binary_state_space(state_space, filename);
+    auto loaded = read_binary_state_space(filename, nullptr, 0);
+    EXPECT_EQ(loaded->str(), state_space.str());
+    EXPECT_EQ(loaded->get_forward_successors().get_offsets(), state_space.get_forward_successors().get_offsets());
+    EXPECT_EQ(loaded->get_forward_successors().get_targets(), state_space.get_forward_successors().get_targets());
+    EXPECT_EQ(loaded->get_instance_info()->get_atoms().size(), 5);
+    EXPECT_EQ(loaded->get_instance_info()->get_atom("at(l3)").get_index(), 3);
+    // Reuse the vocabulary of the written state space.
+    auto vocabulary_info = state_space.get_instance_info()->get_vocabulary_info();
+    auto loaded_2 = read_binary_state_space(filename, vocabulary_info, 1);
+    EXPECT_EQ(loaded_2->get_instance_info()->get_vocabulary_info(), vocabulary_info);
+    EXPECT_EQ(loaded_2->compute_dense_goal_distances(), state_space.compute_dense_goal_distances());
+    // Truncated and corrupt files are rejected.
+    std::ifstream infile(filename, std::ios::binary);
+    const std::string bytes((std::istreambuf_iterator<char>(infile)), std::istreambuf_iterator<char>());
+    auto read_bytes = [&](const std::string& data) {
+        std::ofstream outfile(corrupt_filename, std::ios::binary | std::ios::trunc);
+        outfile.write(data.data(), data.size());
+        outfile.close();
+        return read_binary_state_space(corrupt_filename, nullptr, 0);
+    };
+    auto patch_int = [&](size_t position, int32_t value) {
+        std::string result = bytes;
+        std::memcpy(result.data() + position, &value, sizeof(value));
+        return result;
+    };
+    for (size_t size = 0; size < bytes.size(); ++size) {
+        EXPECT_THROW(read_bytes(bytes.substr(0, size)), std::runtime_error);
+    }
+    // The object index follows the name and the arity of the last atom.
+    const size_t object_position = bytes.find("at(l4)") + 6 + sizeof(int32_t);
+    EXPECT_EQ(read_bytes(patch_int(object_position, 4))->str(), loaded->str());
+    EXPECT_THROW(read_bytes(patch_int(object_position, 5)), std::runtime_error);
+    EXPECT_THROW(read_bytes(patch_int(object_position, -1)), std::runtime_error);
+    // The atom index of the last state precedes the initial state, the goals, and the transitions.
+    const size_t atom_position = bytes.size() - (1 + 2 + 1 + 6 + 5) * sizeof(int32_t) - sizeof(int32_t);
+    EXPECT_EQ(read_bytes(patch_int(atom_position, 4))->str(), loaded->str());
+    EXPECT_THROW(read_bytes(patch_int(atom_position, 5)), std::runtime_error);
+    EXPECT_THROW(read_bytes(patch_int(atom_position, -1)), std::runtime_error);
+    // Counts must fit into the file such that the number of offsets does not overflow.
+    const size_t num_states_position = bytes.size() - (1 + 5 + 6 + 5 + 15) * sizeof(int32_t);
+    EXPECT_THROW(read_bytes(patch_int(num_states_position, std::numeric_limits<int32_t>::max())), std::runtime_error);
+    const size_t num_state_indices_position = bytes.size() - (1 + 6 + 5) * sizeof(int32_t);
+    EXPECT_THROW(read_bytes(patch_int(num_state_indices_position, std::numeric_limits<int32_t>::max())), std::runtime_error);
+    infile.close();
+    std::filesystem::remove(filename);
+    std::filesystem::remove(corrupt_filename);
+}
+
+TEST(DLPTests, StateSpaceGroundedGeneratorTest) {
+    // Line of locations l0,...,l3 and a light that can be switched.
+    auto vocabulary_info = std::make_shared<VocabularyInfo>();
+    vocabulary_info->add_predicate("at", 1);
+    vocabulary_info->add_predicate("on", 0);
+    auto instance_info = std::make_shared<InstanceInfo>(0, vocabulary_info);
+    AtomIndices at;
+    for (int i = 0; i < 4; ++i) {
+        at.push_back(instance_info->add_atom("at", {"l" + std::to_string(i)}).get_index());
+    }
+    int on = instance_info->add_atom("on", {}).get_index();
+    GroundActions actions;
+    for (int i = 0; i < 3; ++i) {
+        actions.push_back(GroundAction{"move", {at[i]}, {at[i+1]}, {at[i]}});
+        actions.push_back(GroundAction{"move", {at[i+1]}, {at[i]}, {at[i+1]}});
+    }
+    actions.push_back(GroundAction{"switch_on", {}, {on}, {}});
+    actions.push_back(GroundAction{"switch_off", {on}, {}, {on}});
+
+    auto result = generate_grounded_state_space(instance_info, {at[0]}, actions, {at[3]});
+    EXPECT_EQ(result.exit_code, GeneratorExitCode::COMPLETE);
+    const auto& state_space = *result.state_space;
+    EXPECT_EQ(state_space.get_state_vector().size(), 8);
+    // 12 moves, 8 switch_on including self loops, 4 switch_off
+    EXPECT_EQ(state_space.get_forward_successors().get_num_edges(), 24);
+    EXPECT_EQ(state_space.get_goal_state_indices().size(), 2);
+    EXPECT_EQ(state_space.get_state(state_space.get_initial_state_index()).get_atom_indices(), AtomIndices({at[0]}));
+    for (StateIndex goal : state_space.get_goal_state_indices()) {
+        EXPECT_EQ(state_space.get_state(goal).get_atom_indices().front(), at[3]);
+    }
+    EXPECT_EQ(state_space.compute_goal_distances().at(state_space.get_initial_state_index()), 3);
+
+    EXPECT_EQ(generate_grounded_state_space(instance_info, {at[0]}, actions, {at[3]}, 1000, 7).exit_code, GeneratorExitCode::INCOMPLETE);
+    EXPECT_EQ(generate_grounded_state_space(instance_info, {at[0]}, actions, {at[3]}, 0, 100).exit_code, GeneratorExitCode::INCOMPLETE);
+    EXPECT_EQ(generate_grounded_state_space(instance_info, {at[0]}, actions, {at[3]}, 1000, 8).exit_code, GeneratorExitCode::COMPLETE);
+    EXPECT_THROW(generate_grounded_state_space(instance_info, {on + 1}, actions, {at[3]}), std::runtime_error);
+
+    auto cancellation_token = std::make_shared<dlplan::utils::CancellationToken>();
+    EXPECT_EQ(generate_grounded_state_space(instance_info, {at[0]}, actions, {at[3]}, 1000, 100, cancellation_token).exit_code, GeneratorExitCode::COMPLETE);
+    cancellation_token->cancel();
+    EXPECT_THROW(generate_grounded_state_space(instance_info, {at[0]}, actions, {at[3]}, 1000, 100, cancellation_token), dlplan::utils::OperationCancelled);
+    cancellation_token->reset();
+    EXPECT_EQ(generate_grounded_state_space(instance_info, {at[0]}, actions, {at[3]}, 1000, 100, cancellation_token).exit_code, GeneratorExitCode::COMPLETE);
+}
+
+TEST(DLPTests, StateSpaceStatePoolTest) {
+    auto vocabulary_info = std::make_shared<VocabularyInfo>();
+    vocabulary_info->add_predicate("at", 1);
+    auto instance_info = std::make_shared<InstanceInfo>(0, vocabulary_info);
+    // More than 64 atoms to span several blocks per state.
+    for (int i = 0; i < 100; ++i) {
+        instance_info->add_atom("at", {"l" + std::to_string(i)});
+    }
+    StatePool state_pool(instance_info);
+    auto [handle_1, inserted_1] = state_pool.insert({70, 3, 99});
+    auto [handle_2, inserted_2] = state_pool.insert({1});
+    auto [handle_3, inserted_3] = state_pool.insert({99, 70, 3, 3});
+    EXPECT_TRUE(inserted_1);
+    EXPECT_TRUE(inserted_2);
+    EXPECT_FALSE(inserted_3);
+    EXPECT_EQ(handle_1, handle_3);
+    EXPECT_NE(handle_1, handle_2);
+    EXPECT_EQ(std::hash<StateHandle>()(handle_1), std::hash<StateHandle>()(handle_3));
+    EXPECT_EQ(handle_1.get_index(), 0);
+    EXPECT_EQ(handle_2.get_index(), 1);
+    EXPECT_EQ(handle_1.get_atom_indices(), AtomIndices({3, 70, 99}));
+    EXPECT_TRUE(handle_1.contains(70));
+    EXPECT_FALSE(handle_1.contains(71));
+    EXPECT_EQ(handle_1.to_state(), State(0, instance_info, AtomIndices({3, 70, 99})));
+    EXPECT_EQ(state_pool.find({1})->get_index(), 1);
+    EXPECT_FALSE(state_pool.find({2}).has_value());
+    EXPECT_THROW(state_pool.insert({100}), std::runtime_error);
+    // State indices are checked.
+    for (const StateIndex index : {-1, 2}) {
+        EXPECT_THROW(state_pool.contains(index, 0), std::out_of_range);
+        EXPECT_THROW(state_pool.get_hash(index), std::out_of_range);
+        EXPECT_THROW(state_pool.get_atom_indices(index), std::out_of_range);
+        EXPECT_THROW(state_pool.get_handle(index), std::out_of_range);
+    }
+    // Grow the hash table.
+    for (int i = 0; i < 100; ++i) {
+        for (int j = i; j < 100; ++j) {
+            state_pool.insert({i, j});
+        }
+    }
+    EXPECT_EQ(state_pool.size(), 2 + 5050 - 1);
+    EXPECT_EQ(state_pool.find({1, 1})->get_index(), 1);
+    EXPECT_EQ(state_pool.find({42, 7})->get_atom_indices(), AtomIndices({7, 42}));
+    // Handles remain valid when the pool is moved.
+    StatePool moved_pool(std::move(state_pool));
+    EXPECT_EQ(handle_1.get_atom_indices(), AtomIndices({3, 70, 99}));
+    EXPECT_TRUE(handle_1.contains(70));
+    EXPECT_EQ(handle_1.to_state(), State(0, instance_info, AtomIndices({3, 70, 99})));
+    EXPECT_EQ(moved_pool.find({70, 3, 99}), handle_1);
+    EXPECT_EQ(moved_pool.get_handle(1), handle_2);
+    EXPECT_EQ(std::hash<StateHandle>()(moved_pool.get_handle(0)), std::hash<StateHandle>()(handle_1));
+    StatePool assigned_pool(instance_info);
+    assigned_pool = std::move(moved_pool);
+    EXPECT_EQ(assigned_pool.insert({1}).first, handle_2);
+    EXPECT_EQ(handle_2.get_atom_indices(), AtomIndices({1}));
+}
+
+}
@@ -0,0 +1,102 @@
+#include <gtest/gtest.h>
+
+#include "../utils/domain.h"
+
+#include "../../include/dlplan/weisfeiler_lehman.h"
+
+#include <set>
+
+using namespace dlplan::core;
+using namespace dlplan::weisfeiler_lehman;
+
+
+namespace dlplan::tests::weisfeiler_lehman {
+
+/// @brief Returns the gripper states without held packages where each
+///        package is in A or B and the robot is in A or B.
+static States create_gripper_states(std::shared_ptr<InstanceInfo> instance_info) {
+    States states;
+    for (int robot = 0; robot < 2; ++robot) {
+        for (int locations = 0; locations < 8; ++locations) {
+            AtomIndices atom_indices;
+            for (int package = 0; package < 3; ++package) {
+                atom_indices.push_back(2 * package + ((locations >> package) & 1));
+            }
+            atom_indices.push_back(6 + robot);
+            states.emplace_back(states.size(), instance_info, atom_indices);
+        }
+    }
+    return states;
+}
+
+TEST(DLPTests, WeisfeilerLehmanGripperTest) {
+    auto vocabulary_info = gripper::construct_vocabulary_info();
+    auto instance_info = gripper::construct_instance_info(vocabulary_info);
+    auto states = create_gripper_states(instance_info);
+    auto colors = WeisfeilerLehman().compute_colors(states);
+    ASSERT_EQ(colors.size(), states.size());
+    // Packages are interchangeable and the rooms are not because of the goal,
+    // hence, states are equal iff the robot room and the number of packages in B are equal.
+    for (size_t i = 0; i < states.size(); ++i) {
+        for (size_t j = 0; j < states.size(); ++j) {
+            int robot_i = i / 8, robot_j = j / 8;
+            int packages_i = __builtin_popcount(i % 8), packages_j = __builtin_popcount(j % 8);
+            EXPECT_EQ(colors[i] == colors[j], robot_i == robot_j && packages_i == packages_j);
+        }
+    }
+    EXPECT_EQ(std::set<int>(colors.begin(), colors.end()).size(), 8);
+    EXPECT_EQ(*std::max_element(colors.begin(), colors.end()), 7);
+}
+
+TEST(DLPTests, WeisfeilerLehmanParallelTest) {
+    auto vocabulary_info = gripper::construct_vocabulary_info();
+    auto instance_info = gripper::construct_instance_info(vocabulary_info);
+    auto states = create_gripper_states(instance_info);
+    // Colors are canonical and hence independent of the number of threads and the order.
+    auto colors = WeisfeilerLehman().compute_colors(states);
+    EXPECT_EQ(WeisfeilerLehman(4).compute_colors(states), colors);
+    States reversed_states(states.rbegin(), states.rend());
+    auto reversed_colors = WeisfeilerLehman(3).compute_colors(reversed_states);
+    EXPECT_EQ(CompressedColors(reversed_colors.rbegin(), reversed_colors.rend()), colors);
+}
+
+TEST(DLPTests, WeisfeilerLehmanStateSpaceTest) {
+    auto vocabulary_info = gripper::construct_vocabulary_info();
+    auto instance_info = gripper::construct_instance_info(vocabulary_info);
+    auto states = create_gripper_states(instance_info);
+    dlplan::state_space::AdjacencyList adjacency_list;
+    for (int i = 0; i < 8; ++i) {
+        adjacency_list[i].insert(i + 8);
+        adjacency_list[i + 8].insert(i);
+    }
+    dlplan::state_space::StateSpace state_space(
+        std::shared_ptr<InstanceInfo>(instance_info),
+        States(states),
+        0,
+        dlplan::state_space::CompressedAdjacencyList(states.size(), adjacency_list),
+        {15});
+    EXPECT_EQ(WeisfeilerLehman(2).compute_colors_for_state_space(state_space), WeisfeilerLehman().compute_colors(states));
+}
+
+}
+
+TEST(DLPTests, WeisfeilerLehmanConstantTest) {
+    // The states p(a) and p(b) are isomorphic unless a is a constant.
+    auto compute_colors = [](bool with_constant) {
+        auto vocabulary_info = std::make_shared<VocabularyInfo>();
+        vocabulary_info->add_predicate("p", 1);
+        if (with_constant) {
+            vocabulary_info->add_constant("a");
+        }
+        auto instance_info = std::make_shared<InstanceInfo>(0, vocabulary_info);
+        const int atom_a = instance_info->add_atom("p", {"a"}).get_index();
+        const int atom_b = instance_info->add_atom("p", {"b"}).get_index();
+        States states;
+        states.emplace_back(0, instance_info, AtomIndices{atom_a});
+        states.emplace_back(1, instance_info, AtomIndices{atom_b});
+        return WeisfeilerLehman().compute_colors(states);
+    };
+    EXPECT_EQ(compute_colors(false), CompressedColors({0, 0}));
+    auto colors = compute_colors(true);
+    EXPECT_NE(colors[0], colors[1]);
+}